@@ -33,6 +33,7 @@
 
 #include "waypoint.h"
 #include "listwidgetparent.h"
+#include "singlepointlistmodel.h"
 #include "mapcontents.h"
 
 class AirfieldListWidget : public ListWidgetParent
@@ -67,16 +68,9 @@ private:
     /** Identifiers for list access. */
     QVector<enum MapContents::ListID> m_itemList;
 
-    /** Waypoint temporary storage. */
-    Waypoint m_wp;
 
-class AirfieldItem : public QTreeWidgetItem
-  {
-    public:
-
-      AirfieldItem(Airfield* item);
-      Airfield* airfield;
-  };
+    /** Model over the point lists. */
+    SinglePointListModel* m_model;
 };
 
 #endif
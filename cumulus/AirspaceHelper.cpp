@@ -20,6 +20,7 @@
 #include "AirspaceHelper.h"
 #include "filetools.h"
 #include "generalconfig.h"
+#include "loaderpool.h"
 #include "mapcontents.h"
 #include "mapmatrix.h"
 #include "OpenAip.h"
@@ -35,15 +36,60 @@ QSet<int> AirspaceHelper::m_airspaceDictionary;
 
 QMutex AirspaceHelper::m_mutex;
 
+/**
+ * Loads one airspace file in a worker thread.
+ */
+class AirspaceLoadJob : public LoaderPool::Job
+{
+ public:
+
+  AirspaceLoadJob( const QString& srcName, const QString& binName ) :
+    m_srcName(srcName),
+    m_binName(binName)
+  {
+  };
+
+  virtual ~AirspaceLoadJob()
+  {
+    // Delete the airspaces, which were not taken over by the merge.
+    qDeleteAll( list );
+  };
+
+  /** The loaded airspaces of the file. */
+  QList<Airspace*> list;
+
+ protected:
+
+  bool work()
+  {
+    return AirspaceHelper::loadFile( m_srcName, m_binName, list );
+  };
+
+ private:
+
+  QString m_srcName;
+  QString m_binName;
+};
+
 int AirspaceHelper::loadAirspaces( QList<Airspace*>& list, bool readSource )
 {
   // Set a global lock during execution to avoid calls in parallel.
   QMutexLocker locker( &m_mutex );
-  QTime t; t.start();
+
+  LoaderPool pool( "ASH" );
+  pool.startStage( "scan" );
+
   uint loadCounter = 0; // number of successfully loaded files
 
   m_airspaceDictionary.clear();
 
+  // The type mapping is only read by the jobs, hence it must be set up
+  // before they are started.
+  if( m_airspaceTypeMap.isEmpty() )
+    {
+      loadAirspaceTypeMapping();
+    }
+
   QStringList mapDirs = GeneralConfig::instance()->getMapDirectories();
   QStringList preselect;
 
@@ -116,63 +162,27 @@ int AirspaceHelper::loadAirspaces( QList<Airspace*>& list, bool readSource )
         }
     }
 
-  OpenAirParser oap;
-  OpenAip oaip;
-  QString errorInfo;
-
+  // Every source file and its compiled file form one job. A compiled file
+  // is sorted in before its source file.
   while( ! preselect.isEmpty() )
     {
-      QString srcName;
+      QString srcName = preselect.takeFirst();
       QString binName;
 
-      if( preselect.first().endsWith(QString(".txt")) )
-        {
-          // there can't be the same name txc after this txt
-          // parse found txt file
-          srcName = preselect.first();
-
-          if( oap.parse(srcName, list, true) )
-            {
-              loadCounter++;
-            }
-
-          preselect.removeAt(0);
-          continue;
-        }
-
-      if( preselect.first().endsWith(QString(".aip")) )
+      if( srcName.endsWith(QString(".txt")) || srcName.endsWith(QString(".aip")) )
         {
-          // there can't be the same name aic after this aip
-          // parse found aip file
-          srcName = preselect.first();
-
-          if( oaip.readAirspaces(srcName, list, errorInfo, true) )
-            {
-              loadCounter++;
-            }
-
-          preselect.removeAt(0);
-          continue;
-        }
-
-      if( readSource == true )
-        {
-          // Source file read is required.
-          // Remove the binary file from the list.
-          preselect.removeAt(0);
+          // there can't be the same name txc or aic after this source file
+          pool.addJob( new AirspaceLoadJob( srcName, binName ) );
           continue;
         }
 
-      // At first we found a binary file with the extension aic or txc.
-      binName = preselect.first();
+      // We found a binary file with the extension aic or txc.
+      binName = srcName;
 
       // Get file suffix, can be txc or aic
       QString binSuffix = QFileInfo(binName).suffix();
       QString srcSuffix;
 
-      QDateTime h_creationDateTime;
-      ProjectionBase* h_projection = 0;
-
       if( binSuffix == "txc" )
         {
           srcSuffix = "txt";
@@ -186,72 +196,102 @@ int AirspaceHelper::loadAirspaces( QList<Airspace*>& list, bool readSource )
 
       // Now we have to check if there's to find a source file with
       // the related extension after the binary file
-      preselect.removeAt(0);
-      QFileInfo binFi(binName);
-
-      if( srcName == preselect.first() )
+      if( ! preselect.isEmpty() && srcName == preselect.first() )
         {
           preselect.removeAt(0);
-          // We found the related source file and will do some checks to
-          // decide which type of file will be read in.
+        }
+      else
+        {
+          srcName.clear();
+        }
 
-          // Lets check, if we can read the header of the compiled file
-          if( ! AirspaceHelper::readHeaderData( binName,
-                                                h_creationDateTime,
-                                                &h_projection ) )
+      if( readSource == true )
+        {
+          // Source file read is required, the binary file is ignored.
+          if( srcName.isEmpty() == false )
             {
-              // Compiled file format is not the expected one, remove
-              // wrong file and start a reparsing of source file.
-              QFile::remove(binName);
+              pool.addJob( new AirspaceLoadJob( srcName, QString() ) );
+            }
 
-              if (srcSuffix == "txt")
-                {
-                  if (oap.parse(srcName, list, true))
-                    {
-                      loadCounter++;
-                    }
-                }
-              else if (srcSuffix == "aip")
-                {
-                  if (oaip.readAirspaces(srcName, list, errorInfo, true))
-                    {
-                      loadCounter++;
-                    }
-                }
+          continue;
+        }
 
+      pool.addJob( new AirspaceLoadJob( srcName, binName ) );
+    }
+
+  // Parse or read all files in parallel.
+  pool.run();
+
+  // Merge the results in the order of the file names. Airspaces, which are
+  // contained in more than one file, are taken only from the first one.
+  pool.startStage( "merge" );
+
+  const QList<LoaderPool::Job *>& jobs = pool.jobs();
+
+  for( int i = 0; i < jobs.size(); i++ )
+    {
+      AirspaceLoadJob* job = static_cast<AirspaceLoadJob *>( jobs.at(i) );
+
+      if( job->ok() )
+        {
+          loadCounter++;
+        }
+
+      for( int j = 0; j < job->list.size(); j++ )
+        {
+          Airspace* as = job->list.at(j);
+
+          if( as->getId() >= 0 && addAirspaceIdentifier( as->getId() ) == false )
+            {
+              // Airspace is already known. Ignore object.
+              qDebug() << "ASH: Known Airspace" << as->getName() << "ignored!";
+              delete as;
               continue;
             }
+
+          list.append( as );
         }
 
+      job->list.clear();
+    }
+
+  pool.finish();
+
+  qDebug("ASH: %d Airspace file(s) loaded", loadCounter);
+
+//    for(int i=0; i < list.size(); i++ )
+//      {
+//        list.at(i)->debug();
+//      }
+
+  return loadCounter;
+}
+
+bool AirspaceHelper::loadFile( QString& srcName,
+                               QString& binName,
+                               QList<Airspace*>& list )
+{
+  if( binName.isEmpty() == false )
+    {
+      if( srcName.isEmpty() )
+        {
+          // There is no source file, the compiled file is read.
+          return readCompiledFile( binName, list );
+        }
+
+      QDateTime h_creationDateTime;
+
+      // Lets check, if we can read the header of the compiled file
+      bool ok = readHeaderData( binName, h_creationDateTime );
+
       // Do a date-time check. If the source file is younger in its
       // modification time as the compiled file, a new compilation
       // must be forced.
       QFileInfo fi(srcName);
-      QDateTime lastModTxt = fi.lastModified();
 
-      if( h_creationDateTime < lastModTxt )
+      if( ok && h_creationDateTime < fi.lastModified() )
         {
-          // Modification date-time of source is younger as from
-          // compiled file. Therefore we do start a reparsing of the
-          // source file.
-          QFile::remove(binName);
-
-          if (srcSuffix == "txt")
-            {
-              if (oap.parse(srcName, list, true))
-                {
-                  loadCounter++;
-                }
-            }
-          else if (srcSuffix == "aip")
-            {
-              if (oaip.readAirspaces(srcName, list, errorInfo, true))
-                {
-                  loadCounter++;
-                }
-            }
-
-          continue;
+          ok = false;
         }
 
       // Check date-time against the configuration files
@@ -260,83 +300,45 @@ int AirspaceHelper::loadAirspaces( QList<Airspace*>& list, bool readSource )
       QFileInfo fiConf1(confName1);
       QFileInfo fiConf2(confName2);
 
-      if( (fiConf1.exists() && fi.isReadable() &&
-           h_creationDateTime < fiConf1.lastModified()) ||
-          (fiConf2.exists() && fi.isReadable() &&
-           h_creationDateTime < fiConf2.lastModified()) )
+      if( ok &&
+          ((fiConf1.exists() && fi.isReadable() &&
+            h_creationDateTime < fiConf1.lastModified()) ||
+           (fiConf2.exists() && fi.isReadable() &&
+            h_creationDateTime < fiConf2.lastModified())) )
         {
           // Configuration file was modified, make a new compilation.
           // It is not deeper checked, what was modified due to the effort and
           // in the assumption that a configuration file will not be changed
           // every minute.
-          QFile::remove(binName);
-
-          if (srcSuffix == "txt")
-            {
-              if (oap.parse(srcName, list, true))
-                {
-                  loadCounter++;
-                }
-            }
-          else if (srcSuffix == "aip")
-            {
-              if (oaip.readAirspaces(srcName, list, errorInfo, true))
-                {
-                  loadCounter++;
-                }
-            }
-
-          continue;
+          ok = false;
         }
 
-      // Check, if the projection has been changed in the meantime
-      ProjectionBase *currentProjection = _globalMapMatrix->getProjection();
-
-      if( ! MapContents::compareProjections(h_projection, currentProjection) )
+      if( ok )
         {
-          // Projection has changed in the meantime
-          if( h_projection )
-            {
-              delete h_projection;
-              h_projection = 0;
-            }
-
-          QFile::remove(binName);
-
-          if (srcSuffix == "txt")
-            {
-              if (oap.parse(srcName, list, true))
-                {
-                  loadCounter++;
-                }
-            }
-          else if (srcSuffix == "aip")
-            {
-              if (oaip.readAirspaces(srcName, list, errorInfo, true))
-                {
-                  loadCounter++;
-                }
-            }
-
-          continue;
+          // All checks were successfully passed.
+          return readCompiledFile( binName, list );
         }
 
-      // We will read the compiled file, because a source file is not to
-      // find after it or all checks were successfully passed
-      if (AirspaceHelper::readCompiledFile( binName, list ) )
-        {
-          loadCounter++;
-        }
-    } // End of While
+      // Compiled file format is not the expected one or it is outdated.
+      // Remove the file and start a reparsing of the source file.
+      QFile::remove(binName);
+    }
 
-  qDebug("ASH: %d Airspace file(s) loaded in %dms", loadCounter, t.elapsed());
+  QString errorInfo;
 
-//    for(int i=0; i < list.size(); i++ )
-//      {
-//        list.at(i)->debug();
-//      }
+  if( srcName.endsWith( QString(".txt") ) )
+    {
+      OpenAirParser oap;
+      return oap.parse( srcName, list, true );
+    }
 
-  return loadCounter;
+  if( srcName.endsWith( QString(".aip") ) )
+    {
+      OpenAip oaip;
+      return oaip.readAirspaces( srcName, list, errorInfo, true );
+    }
+
+  return false;
 }
 
 bool AirspaceHelper::createCompiledFile( QString& fileName,
@@ -367,7 +369,6 @@ bool AirspaceHelper::createCompiledFile( QString& fileName,
   out << qint8( FILE_TYPE_AIRSPACE_C );
   out << quint16( FILE_VERSION_AIRSPACE_C );
   out << QDateTime::currentDateTime();
-  SaveProjection( out, _globalMapMatrix->getProjection() );
 
   // write number of airspace records to be stored
   out << quint32( airspaceList.size() - airspaceListStart );
@@ -406,7 +407,10 @@ bool AirspaceHelper::createCompiledFile( QString& fileName,
       out << float( lAlt );
       out << quint8( as->getUpperT() );
       out << float( uAlt );
-      ShortSave( out, as->getProjectedPolygon() );
+
+      // The border is stored unprojected, so the compiled file stays valid
+      // after a change of the map projection.
+      ShortSave( out, as->getWgsPolygon() );
     }
 
   file.close();
@@ -448,7 +452,6 @@ bool AirspaceHelper::readCompiledFile( QString &path, QList<Airspace*>& list )
   QRect boundingBox;
 #endif
 
-  ProjectionBase *projectionFromFile;
   quint32 noOfAirspaces;
 
   in >> magic;
@@ -480,13 +483,6 @@ bool AirspaceHelper::readCompiledFile( QString &path, QList<Airspace*>& list )
 
   in >> creationDateTime;
 
-  projectionFromFile = LoadProjection(in);
-
-  // projectionFromFile is allocated dynamically, we don't need it
-  // here. Therefore it is immediately deleted to avoid memory leaks.
-  delete projectionFromFile;
-  projectionFromFile = 0;
-
 #ifdef BOUNDING_BOX
 
   in >> boundingBox;
@@ -508,12 +504,13 @@ bool AirspaceHelper::readCompiledFile( QString &path, QList<Airspace*>& list )
   quint8 upperType;
   float upper;
   QPolygon pa;
+  QPolygon wgsPa;
   QByteArray utf8_temp;
   char country[3] = { 0, 0, 0 };
 
   while ( ! in.atEnd() )
     {
-      pa.resize(0);
+      wgsPa.resize(0);
 
       ShortLoad(in, utf8_temp);
       name = QString::fromUtf8(utf8_temp);
@@ -524,13 +521,14 @@ bool AirspaceHelper::readCompiledFile( QString &path, QList<Airspace*>& list )
       in >> lower;
       in >> upperType;
       in >> upper;
-      ShortLoad( in, pa );
+      ShortLoad( in, wgsPa );
 
-      if( id >= 0 && addAirspaceIdentifier(id) == false )
+      // Project the border to the current map projection.
+      pa.resize( wgsPa.size() );
+
+      for( int i = 0; i < wgsPa.size(); i++ )
         {
-          // Airspace is already known. Ignore object.
-          qDebug() << "ASH::readCompiledFile: Known Airspace" << name << "ignored!";
-          continue;
+          pa.setPoint( i, _globalMapMatrix->wgsToMap( wgsPa.at(i) ) );
         }
 
       Airspace *a = new Airspace( name,
@@ -540,6 +538,7 @@ bool AirspaceHelper::readCompiledFile( QString &path, QList<Airspace*>& list )
                                   lower, (BaseMapElement::elevationType) lowerType,
                                   id,
                                   QString(country) );
+      a->setWgsPolygon( wgsPa );
       list.append(a);
       counter++;
     }
@@ -562,13 +561,10 @@ bool AirspaceHelper::readCompiledFile( QString &path, QList<Airspace*>& list )
  *
  * \param creationDateTime Date and time of file creation
  *
- * \param ProjectionBase stored projection type
- *
  * \returns true (success) or false (error occurred)
  */
 bool AirspaceHelper::readHeaderData( QString &path,
-                                     QDateTime& creationDateTime,
-                                     ProjectionBase** projection )
+                                     QDateTime& creationDateTime )
 {
   quint32 h_magic = 0;
   qint8 h_fileType = 0;
@@ -614,8 +610,6 @@ bool AirspaceHelper::readHeaderData( QString &path,
 
   in >> creationDateTime;
 
-  *projection = LoadProjection(in);
-
 #ifdef BOUNDING_BOX
   in >> h_boundingBox;
 #endif
@@ -84,6 +84,19 @@ class AirspaceHelper
    */
   static int loadAirspaces( QList<Airspace*>& list, bool readSource=false );
 
+  /**
+   * Loads a single airspace file. The compiled file is read, if it is valid
+   * and not older as the source file and its mapping files. Otherwise the
+   * source file is parsed and compiled. Duplicates are not filtered out.
+   * The method can be called in parallel for different files.
+   *
+   * @param srcName Source file name, empty if there is only a compiled file
+   * @param binName Compiled file name, empty if there is only a source file
+   * @param list All airspace objects have to be stored in this list
+   * @return true (success) or false (error occurred)
+   */
+  static bool loadFile( QString& srcName, QString& binName, QList<Airspace*>& list );
+
   /**
    * Read the content of a compiled file and put it into the passed
    * list.
@@ -118,13 +131,10 @@ class AirspaceHelper
    *
    * \param creationDateTime Date and time of file creation
    *
-   * \param ProjectionBase stored projection type
-   *
    * \returns true (success) or false (error occured)
    */
   static bool readHeaderData( QString &path,
-                              QDateTime& creationDateTime,
-                              ProjectionBase** projection );
+                              QDateTime& creationDateTime );
 
   /**
    * Initialize a mapping from an airspace type string to the Cumulus integer type.
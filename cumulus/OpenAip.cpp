@@ -48,6 +48,68 @@ void OpenAip::loadUserFilterValues()
   m_filterRunwayLength = GeneralConfig::instance()->getAirfieldRunwayLengthFilter();
 }
 
+bool OpenAip::isFiltered( Airfield& af )
+{
+  if( af.getTypeID() == BaseMapElement::CivHeliport ||
+      af.getTypeID() == BaseMapElement::MilHeliport )
+    {
+      // Filter out heli ports.
+      return true;
+    }
+
+  if( isFiltered( static_cast<SinglePoint&>(af) ) )
+    {
+      return true;
+    }
+
+  if( m_filterRunwayLength > 0.0 )
+    {
+      QList<Runway>& rl = af.getRunwayList();
+
+      if( rl.isEmpty() )
+        {
+          // No runways are defined, ignore these data
+          return true;
+        }
+
+      float rwy2short = 0.0;
+
+      for( int i = 0; i < rl.size(); i++ )
+        {
+          if( rl.at(i).m_length >= m_filterRunwayLength )
+            {
+              // One runway fulfills the length condition.
+              return false;
+            }
+
+          rwy2short = rl.at(i).m_length;
+        }
+
+      qDebug() << "OpenAip::isFiltered:"
+               << af.getName() << af.getCountry()
+               << "runway length" << rwy2short << "to short!";
+      return true;
+    }
+
+  return false;
+}
+
+bool OpenAip::isFiltered( SinglePoint& sp )
+{
+  if( m_filterRadius > 0.0 )
+    {
+      double d = MapCalc::dist( &m_homePosition, sp.getWGSPositionPtr() );
+
+      if( d > m_filterRadius )
+        {
+          // The radius filter said no. To far away from home.
+          return true;
+        }
+    }
+
+  return false;
+}
+
 bool OpenAip::getRootElement( QString fileName,
                               QString& dataFormat,
                               QString& dataItem )
@@ -263,18 +325,9 @@ bool OpenAip::readNavAids( QString fileName,
                   break;
                 }
 
-              if( useFiltering == true )
+              if( useFiltering == true && isFiltered( rp ) )
                 {
-                  if( m_filterRadius > 0.0 )
-                    {
-                      double d = MapCalc::dist( &m_homePosition, rp.getWGSPositionPtr() );
-
-                      if( d > m_filterRadius )
-                        {
-                          // The radius filter said no. To far away from home.
-                          continue;
-                        }
-                    }
+                  continue;
                 }
 
               navAidList.append( rp );
@@ -711,18 +764,9 @@ bool OpenAip::readHotspots( QString fileName,
               // Increment name counter for the hotspot.
               hsno++;
 
-              if( useFiltering == true )
+              if( useFiltering == true && isFiltered( sp ) )
                 {
-                  if( m_filterRadius > 0.0 )
-                    {
-                      double d = MapCalc::dist( &m_homePosition, sp.getWGSPositionPtr() );
-
-                      if( d > m_filterRadius )
-                        {
-                          // The radius filter said no. To far away from home.
-                          continue;
-                        }
-                    }
+                  continue;
                 }
 
               // Set record number as WP name
@@ -914,60 +958,9 @@ bool OpenAip::readAirfields( QString fileName,
                   break;
                 }
 
-              if( useFiltering == true )
+              if( useFiltering == true && isFiltered( af ) )
                 {
-                  if( af.getTypeID() == BaseMapElement::CivHeliport ||
-                      af.getTypeID() == BaseMapElement::MilHeliport )
-                    {
-                      // Filter out heli ports.
-                      continue;
-                    }
-
-                  if( m_filterRadius > 0.0 )
-                    {
-                      double d = MapCalc::dist( &m_homePosition, af.getWGSPositionPtr() );
-
-                      if( d > m_filterRadius )
-                        {
-                          // The radius filter said no. To far away from home.
-                          continue;
-                        }
-                    }
-
-                  if( m_filterRunwayLength > 0.0 )
-                    {
-                      QList<Runway>& rl = af.getRunwayList();
-
-                      if( rl.isEmpty() )
-                        {
-                          // No runways are defined, ignore these data
-                          continue;
-                        }
-
-                      bool rwyLenOk = false;
-                      float rwy2short = 0.0;
-
-                      for( int i = 0; i < rl.size(); i++ )
-                        {
-                          if( rl.at(i).m_length < m_filterRunwayLength )
-                            {
-                              rwy2short = rl.at(i).m_length;
-                              continue;
-                            }
-
-                          // One runway fulfills the length condition, break loop.
-                          rwyLenOk = true;
-                          break;
-                        }
-
-                      if( rwyLenOk == false )
-                        {
-                          qDebug() << "OpenAip::readAirfields:"
-                                   << af.getName() << af.getCountry()
-                                   << "runway length" << rwy2short << "to short!";
-                          continue;
-                        }
-                    }
+                  continue;
                 }
 
 
@@ -1788,18 +1781,10 @@ bool OpenAip::readAirspaces( QString fileName,
                       continue;
                     }
 
-                  if( AirspaceHelper::addAirspaceIdentifier(as.getId()) )
-                    {
-                      Airspace* elem = as.createAirspaceObject();
-                      airspaceList.append( elem );
-                    }
-                  else
-                    {
-                      // Airspace is already known. Ignore object.
-                      qDebug() << "QIAP:: Known Airspace"
-                               << as.getName()
-                               << "ignored!";
-                    }
+                  // Duplicates of other files are removed by the
+                  // airspace loader, the compiled file keeps all objects.
+                  Airspace* elem = as.createAirspaceObject();
+                  airspaceList.append( elem );
                 }
             }
 
@@ -2125,6 +2110,7 @@ bool OpenAip::readAirspaceGeometrie( QXmlStreamReader& xml, Airspace& as )
     }
 
   QPolygon asPolygon( polygonList.size() / 2 );
+  QPolygon wgsPolygon( polygonList.size() / 2 );
   extern MapMatrix* _globalMapMatrix;
 
   for( int i = 0; i < polygonList.size(); i += 2 )
@@ -2165,6 +2151,7 @@ bool OpenAip::readAirspaceGeometrie( QXmlStreamReader& xml, Airspace& as )
 
       // Project coordinates to map datum and store them in a polygon
       asPolygon.setPoint( i/2, _globalMapMatrix->wgsToMap( latInt, lonInt ) );
+      wgsPolygon.setPoint( i/2, latInt, lonInt );
     }
 
   if( asPolygon.count() < 2 )
@@ -2181,8 +2168,10 @@ bool OpenAip::readAirspaceGeometrie( QXmlStreamReader& xml, Airspace& as )
     {
       // remove the last point because it is identical to the first point
       asPolygon.remove(asPolygon.count()-1);
+      wgsPolygon.remove(wgsPolygon.count()-1);
     }
 
   as.setProjectedPolygon( asPolygon );
+  as.setWgsPolygon( wgsPolygon );
   return true;
 }
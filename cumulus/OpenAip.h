@@ -159,6 +159,47 @@ class OpenAip
       return m_shortNameSet;
     };
 
+  /**
+   * Loads the user's defined filter values from the configuration data.
+   */
+  void loadUserFilterValues();
+
+  /**
+   * Checks the airfield against the user's heliport, radius and runway
+   * length filters. \ref loadUserFilterValues must be called before.
+   *
+   * \param af Airfield to be checked
+   *
+   * \return true, if the airfield shall not be used otherwise false
+   */
+  bool isFiltered( Airfield& af );
+
+  /**
+   * Checks the point against the user's radius filter.
+   * \ref loadUserFilterValues must be called before.
+   *
+   * \param sp Point to be checked
+   *
+   * \return true, if the point shall not be used otherwise false
+   */
+  bool isFiltered( SinglePoint& sp );
+
+  /**
+   * \return The home position used by the radius filter.
+   */
+  const QPoint& getHomePosition() const
+    {
+      return m_homePosition;
+    };
+
+  /**
+   * \return The filter radius around the home position in kilometers.
+   */
+  double getFilterRadius() const
+    {
+      return m_filterRadius;
+    };
+
  private:
 
   /**
@@ -233,11 +274,6 @@ class OpenAip
    */
   bool getUnitValueAsFloat( const QString number, const QString unit, float& result );
 
-  /**
-   * Loads the user's defined filter values from the configuration data.
-   */
-  void loadUserFilterValues();
-
   /**
    * Containing all supported OpenAip data formats.
    */
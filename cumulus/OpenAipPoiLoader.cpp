@@ -18,9 +18,12 @@
 #include "airfield.h"
 #include "filetools.h"
 #include "generalconfig.h"
+#include "loaderpool.h"
+#include "mapcalc.h"
 #include "mapcontents.h"
 #include "OpenAip.h"
 #include "OpenAipPoiLoader.h"
+#include "pointcache.h"
 #include "resource.h"
 
 #ifdef BOUNDING_BOX
@@ -43,31 +46,77 @@ OpenAipPoiLoader::~OpenAipPoiLoader()
 {
 }
 
-int OpenAipPoiLoader::load( QList<Airfield>& airfieldList, bool readSource )
+/**
+ * Loads one openAIP point file in a worker thread. Every job uses an own
+ * copy of the loader, because the loader keeps the header data of the
+ * last read file.
+ */
+template<class T> class PoiLoadJob : public LoaderPool::Job
+{
+ public:
+
+  PoiLoadJob( const OpenAipPoiLoader& loader,
+              const QString& aipName,
+              const QString& aicName ) :
+    m_loader(loader),
+    m_aipName(aipName),
+    m_aicName(aicName)
+  {
+  };
+
+  virtual ~PoiLoadJob()
+  {
+  };
+
+  /** The loaded points of the file. */
+  QList<T> list;
+
+ protected:
+
+  bool work()
+  {
+    return m_loader.loadFile( m_aipName, m_aicName, list );
+  };
+
+ private:
+
+  OpenAipPoiLoader m_loader;
+  QString m_aipName;
+  QString m_aicName;
+};
+
+template<class T>
+int OpenAipPoiLoader::loadFiles( QList<T>& list,
+                                 bool readSource,
+                                 const QString& fileKind,
+                                 const char* pointKind )
 {
   // Set a global lock during execution to avoid calls in parallel.
   QMutexLocker locker( &m_mutex );
 
-  QTime t;
-  t.start();
+  LoaderPool pool( QString("OAIP %1").arg(pointKind) );
+  pool.startStage( "scan" );
+
   int loadCounter = 0; // number of successfully loaded files
 
+  m_filter.loadUserFilterValues();
+
   QStringList mapDirs = GeneralConfig::instance()->getMapDirectories();
   QStringList preselect;
 
   for( int i = 0; i < mapDirs.size(); ++i )
     {
-      MapContents::addDir( preselect, mapDirs.at( i ) + "/points", "*_wpt.aip" );
+      MapContents::addDir( preselect, mapDirs.at( i ) + "/points", "*" + fileKind + ".aip" );
 
       if( readSource == false )
         {
-          MapContents::addDir( preselect, mapDirs.at( i ) + "/points", "*_wpt.aic" );
+          MapContents::addDir( preselect, mapDirs.at( i ) + "/points", "*" + fileKind + ".aic" );
         }
     }
 
   if( preselect.count() == 0 )
     {
-      qWarning( "OAIP: No airfield files found in the map directories!" );
+      qWarning( "OAIP: No %s files found in the map directories!", pointKind );
       return loadCounter;
     }
 
@@ -80,7 +129,7 @@ int OpenAipPoiLoader::load( QList<Airfield>& airfieldList, bool readSource )
   if( files.isEmpty() )
     {
       // No files shall be loaded
-      qWarning() << "OAIP: No airfield files defined for loading by the user!";
+      qWarning( "OAIP: No %s files defined for loading by the user!", pointKind );
       return loadCounter;
     }
 
@@ -98,480 +147,231 @@ int OpenAipPoiLoader::load( QList<Airfield>& airfieldList, bool readSource )
         }
     }
 
-  while( !preselect.isEmpty() )
+  // Every source file and its compiled file form one job. A compiled file
+  // is sorted in before its source file.
+  while( ! preselect.isEmpty() )
     {
       QString aipName;
       QString aicName;
-      OpenAip openAip;
-      QString errorInfo;
-      int listBegin;
-
-      if( preselect.first().endsWith( QString( ".aip" ) ) )
-        {
-          // There can't be the same name .aic after this .aip. Parse aip file.
-          aipName = preselect.first();
-
-          // Remove source file to be read from the list.
-          preselect.removeAt(0);
-
-          listBegin = airfieldList.size();
 
-          bool ok = openAip.readAirfields( aipName,
-                                           airfieldList,
-                                           errorInfo,
-                                           true );
-          if( ok )
-            {
-              QString aicName = aipName.replace( aipName.size() - 1, 1 , QChar('c') );
-              createCompiledFile( aicName, airfieldList, listBegin );
-              loadCounter++;
-            }
-
-          continue;
-        }
-
-      // At first we found a binary file with the extension aic.
-      aicName = preselect.first();
-      preselect.removeAt( 0 );
-      aipName = aicName;
-      aipName.replace( aipName.size() - 1, 1, QChar('p')  );
-
-      if( ! preselect.isEmpty() && aipName == preselect.first() )
+      if( preselect.first().endsWith( QString( ".aic" ) ) )
         {
-          // We found the related source file and will do some checks to
-          // decide which type of file will be read in.
-
-          // Lets check, if we can read the header of the compiled file
-          if( ! getHeaderData( aicName, FILE_TYPE_AIRFIELD_OAIP_C, FILE_VERSION_AIRFIELD_C ) )
-            {
-              // Compiled file format is not the expected one, remove
-              // wrong file and require a reparsing of source files.
-              continue;
-            }
+          aicName = preselect.takeFirst();
+          aipName = aicName;
+          aipName.replace( aipName.size() - 1, 1, QChar('p') );
 
-          // Do a date-time check. If the source file is younger in its
-          // modification time as the compiled file, a new compilation
-          // must be forced.
-          QFileInfo fi(aipName);
-          QDateTime lastModTxt = fi.lastModified();
-
-          if ( m_hd.h_creationDateTime < lastModTxt )
-            {
-              // Modification date-time of source is younger as from
-              // compiled file. Therefore we require a reparsing of the
-              // source files.
-              qDebug() << "OAIP:" << QFileInfo(aicName).fileName() << "Time mismatch";
-              continue;
-            }
-
-          // Check, if the projection has been changed in the meantime
-          ProjectionBase *currentProjection = _globalMapMatrix->getProjection();
-
-          if( ! MapContents::compareProjections( m_hd.h_projection, currentProjection ) )
+          if( ! preselect.isEmpty() && aipName == preselect.first() )
             {
-              // Projection has changed in the meantime. That requires a reparse
-              // of the source files.
-              if( m_hd.h_projection )
-                {
-                  delete m_hd.h_projection;
-                  m_hd.h_projection = 0;
-                }
-
-              qDebug() << "OAIP:" << QFileInfo(aicName).fileName() << "Projection mismatch";
-              continue;
+              preselect.removeAt( 0 );
             }
-
-          if( m_hd.h_homeCoord != _globalMapMatrix->getHomeCoord() )
+          else
             {
-              // Home position has been changed. That requires a reparse
-              // of the source files.
-              qDebug() << "OAIP:" << QFileInfo(aicName).fileName() << "Home mismatch";
-              continue;
+              // There is no source file to the compiled file.
+              aipName.clear();
             }
+        }
+      else
+        {
+          aipName = preselect.takeFirst();
+        }
 
-          float filterRadius = GeneralConfig::instance()->getAirfieldHomeRadius();
+      pool.addJob( new PoiLoadJob<T>( *this, aipName, aicName ) );
+    }
 
-          if( m_hd.h_homeRadius != filterRadius )
-            {
-              // Home radius has been changed. That requires a reparse
-              // of the source files.
-              qDebug() << "OAIP:" << QFileInfo(aicName).fileName() << "Radius mismatch";
-              continue;
-            }
+  // Parse or read all files in parallel.
+  pool.run();
 
-          float filterRunwayLength = GeneralConfig::instance()->getAirfieldRunwayLengthFilter();
+  // Merge the results in the order of the file names.
+  pool.startStage( "merge" );
 
-          if( m_hd.h_runwayLengthFilter != filterRunwayLength )
-            {
-              // Runway length filter has been changed. That requires a reparse
-              // of the source files.
-              qDebug() << "OAIP:" << QFileInfo(aicName).fileName() << "Runway length mismatch";
-              continue;
-            }
+  const QList<LoaderPool::Job *>& jobs = pool.jobs();
 
-          // All checks passed, there is no need to read the source file and
-          // we can remove it from the list.
-          preselect.removeAt( 0 );
-        }
+  for( int i = 0; i < jobs.size(); i++ )
+    {
+      PoiLoadJob<T>* job = static_cast<PoiLoadJob<T> *>( jobs.at(i) );
 
-      // We will read the compiled file, because a source file is not to
-      // find after it or all checks were successfully passed.
-      if( readCompiledFile( aicName, airfieldList ) )
+      if( job->ok() )
         {
           loadCounter++;
+          list.append( job->list );
         }
-    } // End of While
+    }
 
-  qDebug( "OAIP: %d airfield file(s) with %d items loaded in %dms",
-          loadCounter, airfieldList.size(), t.elapsed() );
+  pool.finish();
+
+  qDebug( "OAIP: %d %s file(s) with %d items loaded",
+          loadCounter, pointKind, list.size() );
 
   return loadCounter;
 }
 
-int OpenAipPoiLoader::load( QList<RadioPoint>& navAidList, bool readSource )
+int OpenAipPoiLoader::load( QList<Airfield>& airfieldList, bool readSource )
 {
-  // Set a global lock during execution to avoid calls in parallel.
-  QMutexLocker locker( &m_mutex );
+  return loadFiles( airfieldList, readSource, "_wpt", "airfield" );
+}
 
-  QTime t;
-  t.start();
-  int loadCounter = 0; // number of successfully loaded files
+int OpenAipPoiLoader::load( QList<RadioPoint>& navAidList, bool readSource )
+{
+  return loadFiles( navAidList, readSource, "_nav", "navAid" );
+}
 
-  QStringList mapDirs = GeneralConfig::instance()->getMapDirectories();
-  QStringList preselect;
+int OpenAipPoiLoader::load( QList<SinglePoint>& spList, bool readSource )
+{
+  return loadFiles( spList, readSource, "_hot", "single point" );
+}
 
-  for( int i = 0; i < mapDirs.size(); ++i )
+bool OpenAipPoiLoader::useCompiledFile( QString& aipName,
+                                        QString& aicName,
+                                        QString fileType,
+                                        int fileVersion )
+{
+  if( aicName.isEmpty() )
     {
-      MapContents::addDir( preselect, mapDirs.at( i ) + "/points", "*_nav.aip" );
-
-      if( readSource == false )
-        {
-          MapContents::addDir( preselect, mapDirs.at( i ) + "/points", "*_nav.aic" );
-        }
+      // There is only a source file.
+      return false;
     }
 
-  if( preselect.count() == 0 )
+  if( aipName.isEmpty() )
     {
-      qWarning( "OAIP: No navAid files found in the map directories!" );
-      return loadCounter;
+      // There is only a compiled file.
+      return true;
     }
 
-  // source files follows compiled files
-  preselect.sort();
+  // We found the related source file and will do some checks to
+  // decide which type of file will be read in.
 
-  // Check, which files shall be loaded.
-  QStringList& files = GeneralConfig::instance()->getOpenAipPoiFileList();
-
-  if( files.isEmpty() )
+  // Lets check, if we can read the header of the compiled file
+  if( ! getHeaderData( aicName, fileType, fileVersion ) )
     {
-      // No files shall be loaded
-      qWarning() << "OAIP: No navAid files defined for loading by the user!";
-      return loadCounter;
+      // Compiled file format is not the expected one, require a
+      // reparsing of the source file.
+      return false;
     }
 
-  if( files.first() != "All" )
-    {
-      // Tidy up the preselection list, if not all found files shall be loaded.
-      for( int i = preselect.size() - 1; i >= 0; i-- )
-        {
-          QString file = QFileInfo(preselect.at(i)).completeBaseName() + ".aip";
-
-          if( files.contains( file ) == false )
-            {
-              preselect.removeAt(i);
-            }
-        }
-    }
+  // Do a date-time check. If the source file is younger in its
+  // modification time as the compiled file, a new compilation
+  // must be forced.
+  QFileInfo fi(aipName);
+  QDateTime lastModTxt = fi.lastModified();
 
-  while( !preselect.isEmpty() )
+  if ( m_hd.h_creationDateTime < lastModTxt )
     {
-      QString aipName;
-      QString aicName;
-      OpenAip openAip;
-      QString errorInfo;
-      int listBegin;
-
-      if( preselect.first().endsWith( QString( ".aip" ) ) )
-        {
-          // There can't be the same name .aic after this .aip. Parse aip file.
-          aipName = preselect.first();
-
-          // Remove source file to be read from the list.
-          preselect.removeAt(0);
-
-          listBegin = navAidList.size();
-
-          bool ok = openAip.readNavAids( aipName, navAidList, errorInfo, true );
-
-          if( ok )
-            {
-              QString aicName = aipName.replace( aipName.size() - 1, 1 , QChar('c') );
-              createCompiledFile( aicName, navAidList, listBegin );
-              loadCounter++;
-            }
-
-          continue;
-        }
-
-      // At first we found a binary file with the extension aic.
-      aicName = preselect.first();
-      preselect.removeAt( 0 );
-      aipName = aicName;
-      aipName.replace( aipName.size() - 1, 1, QChar('p')  );
-
-      if( ! preselect.isEmpty() && aipName == preselect.first() )
-        {
-          // We found the related source file and will do some checks to
-          // decide which type of file will be read in.
-
-          // Lets check, if we can read the header of the compiled file
-          if( ! getHeaderData( aicName, FILE_TYPE_NAV_AIDS_OAIP_C, FILE_VERSION_NAV_AIDS_C ) )
-            {
-              // Compiled file format is not the expected one, remove
-              // wrong file and require a reparsing of source files.
-              continue;
-            }
-
-          // Do a date-time check. If the source file is younger in its
-          // modification time as the compiled file, a new compilation
-          // must be forced.
-          QFileInfo fi(aipName);
-          QDateTime lastModTxt = fi.lastModified();
-
-          if ( m_hd.h_creationDateTime < lastModTxt )
-            {
-              // Modification date-time of source is younger as from
-              // compiled file. Therefore we require a reparsing of the
-              // source files.
-              qDebug() << "OAIP:" << QFileInfo(aicName).fileName() << "Time mismatch";
-              continue;
-            }
-
-          // Check, if the projection has been changed in the meantime
-          ProjectionBase *currentProjection = _globalMapMatrix->getProjection();
-
-          if( ! MapContents::compareProjections( m_hd.h_projection, currentProjection ) )
-            {
-              // Projection has changed in the meantime. That requires a reparse
-              // of the source files.
-              if( m_hd.h_projection )
-                {
-                  delete m_hd.h_projection;
-                  m_hd.h_projection = 0;
-                }
-
-              qDebug() << "OAIP:" << QFileInfo(aicName).fileName() << "Projection mismatch";
-              continue;
-            }
-
-          if( m_hd.h_homeCoord != _globalMapMatrix->getHomeCoord() )
-            {
-              // Home position has been changed. That requires a reparse
-              // of the source files.
-              qDebug() << "OAIP:" << QFileInfo(aicName).fileName() << "Home mismatch";
-              continue;
-            }
-
-          float filterRadius = GeneralConfig::instance()->getAirfieldHomeRadius();
-
-          if( m_hd.h_homeRadius != filterRadius )
-            {
-              // Home radius has been changed. That requires a reparse
-              // of the source files.
-              qDebug() << "OAIP:" << QFileInfo(aicName).fileName() << "Radius mismatch";
-              continue;
-            }
-
-          // All checks passed, there is no need to read the source file and
-          // we can remove it from the list.
-          preselect.removeAt( 0 );
-        }
-
-      // We will read the compiled file, because a source file is not to
-      // find after it or all checks were successfully passed.
-      if( readCompiledFile( aicName, navAidList ) )
-        {
-          loadCounter++;
-        }
-    } // End of While
-
-  qDebug( "OAIP: %d navAid file(s) with %d items loaded in %dms",
-          loadCounter, navAidList.size(), t.elapsed() );
+      // Modification date-time of source is younger as from
+      // compiled file. Therefore we require a reparsing of the
+      // source files.
+      qDebug() << "OAIP:" << QFileInfo(aicName).fileName() << "Time mismatch";
+      return false;
+    }
 
-  return loadCounter;
+  return true;
 }
 
-int OpenAipPoiLoader::load( QList<SinglePoint>& spList, bool readSource )
+bool OpenAipPoiLoader::loadFile( QString& aipName,
+                                 QString& aicName,
+                                 QList<Airfield>& airfieldList )
 {
-  // Set a global lock during execution to avoid calls in parallel.
-  QMutexLocker locker( &m_mutex );
-
-  QTime t;
-  t.start();
-  int loadCounter = 0; // number of successfully loaded files
+  if( useCompiledFile( aipName, aicName,
+                       FILE_TYPE_AIRFIELD_OAIP_C, FILE_VERSION_AIRFIELD_C ) )
+    {
+      return readCompiledFile( aicName, airfieldList );
+    }
 
-  QStringList mapDirs = GeneralConfig::instance()->getMapDirectories();
-  QStringList preselect;
+  OpenAip openAip;
+  QString errorInfo;
+  QList<Airfield> parsedList;
 
-  for( int i = 0; i < mapDirs.size(); ++i )
+  // The compiled file contains all points of the source file. The
+  // user filters are applied during loading of the compiled file.
+  if( openAip.readAirfields( aipName, parsedList, errorInfo, false ) == false )
     {
-      MapContents::addDir( preselect, mapDirs.at( i ) + "/points", "*_hot.aip" );
+      return false;
+    }
 
-      if( readSource == false )
+  QString cName = aipName;
+  cName.replace( cName.size() - 1, 1 , QChar('c') );
+  createCompiledFile( cName, parsedList, 0 );
+
+  for( int i = 0; i < parsedList.size(); i++ )
+    {
+      if( m_filter.isFiltered( parsedList[i] ) == false )
         {
-          MapContents::addDir( preselect, mapDirs.at( i ) + "/points", "*_hot.aic" );
+          airfieldList.append( parsedList.at(i) );
         }
     }
 
-  if( preselect.count() == 0 )
+  return true;
+}
+
+bool OpenAipPoiLoader::loadFile( QString& aipName,
+                                 QString& aicName,
+                                 QList<RadioPoint>& navAidList )
+{
+  if( useCompiledFile( aipName, aicName,
+                       FILE_TYPE_NAV_AIDS_OAIP_C, FILE_VERSION_NAV_AIDS_C ) )
     {
-      qWarning( "OAIP: No single point files found in the map directories!" );
-      return loadCounter;
+      return readCompiledFile( aicName, navAidList );
     }
 
-  // source files follows compiled files
-  preselect.sort();
-
-  // Check, which files shall be loaded.
-  QStringList& files = GeneralConfig::instance()->getOpenAipPoiFileList();
+  OpenAip openAip;
+  QString errorInfo;
+  QList<RadioPoint> parsedList;
 
-  if( files.isEmpty() )
+  // The compiled file contains all points of the source file. The
+  // user filters are applied during loading of the compiled file.
+  if( openAip.readNavAids( aipName, parsedList, errorInfo, false ) == false )
     {
-      // No files shall be loaded
-      qWarning() << "OAIP: No single point files defined for loading by the user!";
-      return loadCounter;
+      return false;
     }
 
-  if( files.first() != "All" )
-    {
-      // Tidy up the preselection list, if not all found files shall be loaded.
-      for( int i = preselect.size() - 1; i >= 0; i-- )
-        {
-          QString file = QFileInfo(preselect.at(i)).completeBaseName() + ".aip";
-
-          if( files.contains( file ) == false )
-            {
-              preselect.removeAt(i);
-            }
-        }
-    }
+  QString cName = aipName;
+  cName.replace( cName.size() - 1, 1 , QChar('c') );
+  createCompiledFile( cName, parsedList, 0 );
 
-  while( !preselect.isEmpty() )
+  for( int i = 0; i < parsedList.size(); i++ )
     {
-      QString aipName;
-      QString aicName;
-      OpenAip openAip;
-      QString errorInfo;
-      int listBegin;
-
-      if( preselect.first().endsWith( QString( ".aip" ) ) )
+      if( m_filter.isFiltered( parsedList[i] ) == false )
         {
-          // There can't be the same name .aic after this .aip. Parse aip file.
-          aipName = preselect.first();
-
-          // Remove source file to be read from the list.
-          preselect.removeAt(0);
-
-          listBegin = spList.size();
-
-          bool ok = openAip.readHotspots( aipName, spList, errorInfo, true );
-
-          if( ok )
-            {
-              QString aicName = aipName.replace( aipName.size() - 1, 1 , QChar('c') );
-              createCompiledFile( aicName, spList, listBegin );
-              loadCounter++;
-            }
-
-          continue;
+          navAidList.append( parsedList.at(i) );
         }
+    }
 
-      // At first we found a binary file with the extension aic.
-      aicName = preselect.first();
-      preselect.removeAt( 0 );
-      aipName = aicName;
-      aipName.replace( aipName.size() - 1, 1, QChar('p')  );
-
-      if( ! preselect.isEmpty() && aipName == preselect.first() )
-        {
-          // We found the related source file and will do some checks to
-          // decide which type of file will be read in.
-
-          // Lets check, if we can read the header of the compiled file
-          if( ! getHeaderData( aicName, FILE_TYPE_HOTSPOTS_OAIP_C, FILE_VERSION_HOTSPOT_C ) )
-            {
-              // Compiled file format is not the expected one, remove
-              // wrong file and require a reparsing of source files.
-              continue;
-            }
-
-          // Do a date-time check. If the source file is younger in its
-          // modification time as the compiled file, a new compilation
-          // must be forced.
-          QFileInfo fi(aipName);
-          QDateTime lastModTxt = fi.lastModified();
-
-          if ( m_hd.h_creationDateTime < lastModTxt )
-            {
-              // Modification date-time of source is younger as from
-              // compiled file. Therefore we require a reparsing of the
-              // source files.
-              qDebug() << "OAIP:" << QFileInfo(aicName).fileName() << "Time mismatch";
-              continue;
-            }
-
-          // Check, if the projection has been changed in the meantime
-          ProjectionBase *currentProjection = _globalMapMatrix->getProjection();
-
-          if( ! MapContents::compareProjections( m_hd.h_projection, currentProjection ) )
-            {
-              // Projection has changed in the meantime. That requires a reparse
-              // of the source files.
-              if( m_hd.h_projection )
-                {
-                  delete m_hd.h_projection;
-                  m_hd.h_projection = 0;
-                }
-
-              qDebug() << "OAIP:" << QFileInfo(aicName).fileName() << "Projection mismatch";
-              continue;
-            }
+  return true;
+}
 
-          if( m_hd.h_homeCoord != _globalMapMatrix->getHomeCoord() )
-            {
-              // Home position has been changed. That requires a reparse
-              // of the source files.
-              qDebug() << "OAIP:" << QFileInfo(aicName).fileName() << "Home mismatch";
-              continue;
-            }
+bool OpenAipPoiLoader::loadFile( QString& aipName,
+                                 QString& aicName,
+                                 QList<SinglePoint>& spList )
+{
+  if( useCompiledFile( aipName, aicName,
+                       FILE_TYPE_HOTSPOTS_OAIP_C, FILE_VERSION_HOTSPOT_C ) )
+    {
+      return readCompiledFile( aicName, spList );
+    }
 
-          float filterRadius = GeneralConfig::instance()->getAirfieldHomeRadius();
+  OpenAip openAip;
+  QString errorInfo;
+  QList<SinglePoint> parsedList;
 
-          if( m_hd.h_homeRadius != filterRadius )
-            {
-              // Home radius has been changed. That requires a reparse
-              // of the source files.
-              qDebug() << "OAIP:" << QFileInfo(aicName).fileName() << "Radius mismatch";
-              continue;
-            }
+  // The compiled file contains all points of the source file. The
+  // user filters are applied during loading of the compiled file.
+  if( openAip.readHotspots( aipName, parsedList, errorInfo, false ) == false )
+    {
+      return false;
+    }
 
-          // All checks passed, there is no need to read the source file and
-          // we can remove it from the list.
-          preselect.removeAt( 0 );
-        }
+  QString cName = aipName;
+  cName.replace( cName.size() - 1, 1 , QChar('c') );
+  createCompiledFile( cName, parsedList, 0 );
 
-      // We will read the compiled file, because a source file is not to
-      // find after it or all checks were successfully passed.
-      if( readCompiledFile( aicName, spList ) )
+  for( int i = 0; i < parsedList.size(); i++ )
+    {
+      if( m_filter.isFiltered( parsedList[i] ) == false )
         {
-          loadCounter++;
+          spList.append( parsedList.at(i) );
         }
-    } // End of While
-
-  qDebug( "OAIP: %d single point file(s) with %d items loaded in %dms",
-          loadCounter, spList.size(), t.elapsed() );
+    }
 
-  return loadCounter;
+  return true;
 }
 
 bool OpenAipPoiLoader::createCompiledFile( QString& fileName,
@@ -597,10 +397,6 @@ bool OpenAipPoiLoader::createCompiledFile( QString& fileName,
       return false;
     }
 
-  float filterRadius = GeneralConfig::instance()->getAirfieldHomeRadius();
-
-  float filterRunwayLength = GeneralConfig::instance()->getAirfieldRunwayLengthFilter();
-
   qDebug() << "OAIP: creating airfield file" << QFileInfo(fileName).fileName()
            << "with" << (airfieldList.size() - listBegin) << "elements";
 
@@ -608,9 +404,6 @@ bool OpenAipPoiLoader::createCompiledFile( QString& fileName,
   out << QByteArray( FILE_TYPE_AIRFIELD_OAIP_C );
   out << quint8( FILE_VERSION_AIRFIELD_C );
   out << QDateTime::currentDateTime();
-  out << filterRadius;
-  out << filterRunwayLength;
-  out << QPoint( _globalMapMatrix->getHomeCoord() );
 
 #ifdef BOUNDING_BOX
   // boundingbox is never used during read in, we don't need to write out it
@@ -619,64 +412,65 @@ bool OpenAipPoiLoader::createCompiledFile( QString& fileName,
   out << boundingBox;
 #endif
 
-  SaveProjection( out, _globalMapMatrix->getProjection() );
-
-  // write number of records to be stored
-  out << quint32( airfieldList.size() - listBegin );
+  // The records are stored in buckets with their WGS84 coordinates only.
+  // Projection and user filters are applied during loading.
+  PointCache::Writer writer;
 
   // Storing starts at the given index.
   for( int i = listBegin; i < airfieldList.size(); i++ )
     {
       Airfield& af = airfieldList[i];
 
+      QDataStream& rec = writer.record( af.getWGSPosition() );
+
       // element type
-      out << quint8( af.getTypeID() );
+      rec << quint8( af.getTypeID() );
       // element name
-      ShortSave(out, af.getName().toUtf8());
+      ShortSave(rec, af.getName().toUtf8());
       // short waypoint name
-      ShortSave(out, af.getWPName().toUtf8());
+      ShortSave(rec, af.getWPName().toUtf8());
       // country
-      ShortSave(out, af.getCountry().toUtf8());
+      ShortSave(rec, af.getCountry().toUtf8());
       // icao
-      ShortSave(out, af.getICAO().toUtf8());
+      ShortSave(rec, af.getICAO().toUtf8());
       // comment
-      ShortSave(out, af.getComment().toUtf8());
+      ShortSave(rec, af.getComment().toUtf8());
       // WGS84 coordinates
-      out << af.getWGSPosition();
-      // projected WGS84 coordinates
-      out << af.getPosition();
+      rec << af.getWGSPosition();
       // elevation in meters
-      out << af.getElevation();
+      rec << af.getElevation();
 
       // frequency is written as e.g. 126.575, is reduced to 16 bits
       if( af.getFrequency() == 0.0 )
         {
-          out << quint16(0);
+          rec << quint16(0);
         }
       else
         {
-          out << quint16( rint((af.getFrequency() - 100.0) * 1000.0 ));
+          rec << quint16( rint((af.getFrequency() - 100.0) * 1000.0 ));
         }
 
       // The runway list is saved
       QList<Runway>& rwyList = af.getRunwayList();
 
       // Number of runways
-      out << quint8( rwyList.size() );
+      rec << quint8( rwyList.size() );
 
       for( int i = 0; i < rwyList.size(); i++ )
        {
          Runway rwy = rwyList.at(i);
 
-         out << rwy.m_length;
-         out << rwy.m_width;
-         out << quint16( rwy.m_heading );
-         out << quint8( rwy.m_surface );
-         out << quint8( rwy.m_isOpen );
-         out << quint8( rwy.m_isBidirectional );
+         rec << rwy.m_length;
+         rec << rwy.m_width;
+         rec << quint16( rwy.m_heading );
+         rec << quint8( rwy.m_surface );
+         rec << quint8( rwy.m_isOpen );
+         rec << quint8( rwy.m_isBidirectional );
        }
     }
 
+  writer.save( out );
+
   file.close();
   return true;
 }
@@ -704,11 +498,6 @@ bool OpenAipPoiLoader::createCompiledFile( QString& fileName,
       return false;
     }
 
-  float filterRadius = GeneralConfig::instance()->getAirfieldHomeRadius();
-
-  // Navaid uses not this filter but to have a unique header, it is considered.
-  float filterRunwayLength = GeneralConfig::instance()->getAirfieldRunwayLengthFilter();
-
   qDebug() << "OAIP: creating navAid file" << QFileInfo(fileName).fileName()
            << "with" << (navAidList.size() - listBegin) << "elements";
 
@@ -716,9 +505,6 @@ bool OpenAipPoiLoader::createCompiledFile( QString& fileName,
   out << QByteArray( FILE_TYPE_NAV_AIDS_OAIP_C );
   out << quint8( FILE_VERSION_NAV_AIDS_C );
   out << QDateTime::currentDateTime();
-  out << filterRadius;
-  out << filterRunwayLength;
-  out << QPoint( _globalMapMatrix->getHomeCoord() );
 
 #ifdef BOUNDING_BOX
   // boundingbox is never used during read in, we don't need to write out it
@@ -727,46 +513,47 @@ bool OpenAipPoiLoader::createCompiledFile( QString& fileName,
   out << boundingBox;
 #endif
 
-  SaveProjection( out, _globalMapMatrix->getProjection() );
-
-  // write number of records to be stored
-  out << quint32( navAidList.size() - listBegin );
+  // The records are stored in buckets with their WGS84 coordinates only.
+  // Projection and user filters are applied during loading.
+  PointCache::Writer writer;
 
   // Storing starts at the given index.
   for( int i = listBegin; i < navAidList.size(); i++ )
     {
       RadioPoint& rp = navAidList[i];
 
+      QDataStream& rec = writer.record( rp.getWGSPosition() );
+
       // element type
-      out << quint8( rp.getTypeID() );
+      rec << quint8( rp.getTypeID() );
       // element name
-      ShortSave(out, rp.getName().toUtf8());
+      ShortSave(rec, rp.getName().toUtf8());
       // short waypoint name
-      ShortSave(out, rp.getWPName().toUtf8());
+      ShortSave(rec, rp.getWPName().toUtf8());
       // country
-      ShortSave(out, rp.getCountry().toUtf8());
+      ShortSave(rec, rp.getCountry().toUtf8());
       // icao
-      ShortSave(out, rp.getICAO().toUtf8());
+      ShortSave(rec, rp.getICAO().toUtf8());
       // comment
-      ShortSave(out, rp.getComment().toUtf8());
+      ShortSave(rec, rp.getComment().toUtf8());
       // WGS84 coordinates
-      out << rp.getWGSPosition();
-      // projected WGS84 coordinates
-      out << rp.getPosition();
+      rec << rp.getWGSPosition();
       // elevation in meters
-      out << rp.getElevation();
+      rec << rp.getElevation();
       // frequency is save in MHz
-      out << rp.getFrequency();
+      rec << rp.getFrequency();
       // Channel info
-      ShortSave(out, rp.getChannel().toUtf8());
+      ShortSave(rec, rp.getChannel().toUtf8());
       // Service range as float
-      out << rp.getRange();
+      rec << rp.getRange();
       // Declination
-      out << rp.getDeclination();
+      rec << rp.getDeclination();
       // Aligned2TrueNorth
-      out << quint8( rp.isAligned2TrueNorth() );
+      rec << quint8( rp.isAligned2TrueNorth() );
     }
 
+  writer.save( out );
+
   file.close();
   return true;
 }
@@ -794,11 +581,6 @@ bool OpenAipPoiLoader::createCompiledFile( QString& fileName,
       return false;
     }
 
-  float filterRadius = GeneralConfig::instance()->getAirfieldHomeRadius();
-
-  // Hotspot uses not this filter but to have a unique header, it is considered.
-  float filterRunwayLength = GeneralConfig::instance()->getAirfieldRunwayLengthFilter();
-
   qDebug() << "OAIP: creating single point file" << QFileInfo(fileName).fileName()
            << "with" << (spList.size() - listBegin) << "elements";
 
@@ -806,9 +588,6 @@ bool OpenAipPoiLoader::createCompiledFile( QString& fileName,
   out << QByteArray( FILE_TYPE_HOTSPOTS_OAIP_C );
   out << quint8( FILE_VERSION_HOTSPOT_C );
   out << QDateTime::currentDateTime();
-  out << filterRadius;
-  out << filterRunwayLength;
-  out << QPoint( _globalMapMatrix->getHomeCoord() );
 
 #ifdef BOUNDING_BOX
   // boundingbox is never used during read in, we don't need to write out it
@@ -817,34 +596,35 @@ bool OpenAipPoiLoader::createCompiledFile( QString& fileName,
   out << boundingBox;
 #endif
 
-  SaveProjection( out, _globalMapMatrix->getProjection() );
-
-  // write number of records to be stored
-  out << quint32( spList.size() - listBegin );
+  // The records are stored in buckets with their WGS84 coordinates only.
+  // Projection and user filters are applied during loading.
+  PointCache::Writer writer;
 
   // Storing starts at the given index.
   for( int i = listBegin; i < spList.size(); i++ )
     {
       SinglePoint& sp = spList[i];
 
+      QDataStream& rec = writer.record( sp.getWGSPosition() );
+
       // element type
-      out << quint8( sp.getTypeID() );
+      rec << quint8( sp.getTypeID() );
       // element name
-      ShortSave(out, sp.getName().toUtf8());
+      ShortSave(rec, sp.getName().toUtf8());
       // element short name
-      ShortSave(out, sp.getWPName().toUtf8());
+      ShortSave(rec, sp.getWPName().toUtf8());
       // country
-      ShortSave(out, sp.getCountry().toUtf8());
+      ShortSave(rec, sp.getCountry().toUtf8());
       // comment
-      ShortSave(out, sp.getComment().toUtf8());
+      ShortSave(rec, sp.getComment().toUtf8());
       // WGS84 coordinates
-      out << sp.getWGSPosition();
-      // projected WGS84 coordinates
-      out << sp.getPosition();
+      rec << sp.getWGSPosition();
       // elevation in meters
-      out << sp.getElevation();
+      rec << sp.getElevation();
     }
 
+  writer.save( out );
+
   file.close();
   return true;
 }
@@ -855,117 +635,117 @@ bool OpenAipPoiLoader::readCompiledFile( QString &fileName,
   QTime t;
   t.start();
 
-  QFile inFile( fileName );
+  // The compiled file is memory mapped.
+  PointCache cache;
 
-  if( !inFile.open(QIODevice::ReadOnly) )
+  if( cache.open( fileName ) == false )
     {
       qWarning("OAIP: Cannot open airfield file %s!", fileName.toLatin1().data());
       return false;
     }
 
-  QDataStream in( &inFile );
-  in.setVersion( Q_DATA_STREAM );
+  QDataStream& in = cache.stream();
+
+  m_filter.loadUserFilterValues();
 
   bool ok = readHeaderData( in, FILE_TYPE_AIRFIELD_OAIP_C, FILE_VERSION_AIRFIELD_C );
 
-  if( ok == false )
+  if( ok == false || cache.readDirectory() == false )
     {
-      inFile.close();
       return false;
     }
 
-  // read number of records in the file
-  quint32 lrn; in >> lrn;
-
-  // Preallocate list memory for new elements to be added.
-  if( lrn )
-    {
-      airfieldList.reserve( airfieldList.size() + lrn );
-    }
-
   quint8 afType;
   QByteArray utf8_temp;
   WGSPoint wgsPos;
-  QPoint position;
   float elevation;
   quint16 inFrequency;
 
   uint counter = 0;
+  int records;
 
-  while( ! in.atEnd() )
+  // Read all buckets within the filter radius. The other ones are skipped.
+  while( (records = cache.nextBucket( m_filter.getHomePosition(), m_filter.getFilterRadius() )) >= 0 )
     {
-      counter++;
+      for( int r = 0; r < records; r++ )
+        {
+          counter++;
 
-      Airfield af;
+          Airfield af;
 
-      in >> afType; af.setTypeID( static_cast<BaseMapElement::objectType>(afType) );
+          in >> afType; af.setTypeID( static_cast<BaseMapElement::objectType>(afType) );
 
-      // read long name
-      ShortLoad(in, utf8_temp);
-      af.setName(QString::fromUtf8(utf8_temp));
+          // read long name
+          ShortLoad(in, utf8_temp);
+          af.setName(QString::fromUtf8(utf8_temp));
 
-      // read short name
-      ShortLoad(in, utf8_temp);
-      af.setWPName(QString::fromUtf8(utf8_temp));
+          // read short name
+          ShortLoad(in, utf8_temp);
+          af.setWPName(QString::fromUtf8(utf8_temp));
 
-      // read the 2 letter country code
-      ShortLoad(in, utf8_temp);
-      af.setCountry(QString::fromUtf8(utf8_temp));
+          // read the 2 letter country code
+          ShortLoad(in, utf8_temp);
+          af.setCountry(QString::fromUtf8(utf8_temp));
 
-      // read ICAO
-      ShortLoad(in, utf8_temp);
-      af.setICAO(QString::fromUtf8(utf8_temp));
+          // read ICAO
+          ShortLoad(in, utf8_temp);
+          af.setICAO(QString::fromUtf8(utf8_temp));
 
-      // read comment
-      ShortLoad(in, utf8_temp);
-      af.setComment(QString::fromUtf8(utf8_temp));
+          // read comment
+          ShortLoad(in, utf8_temp);
+          af.setComment(QString::fromUtf8(utf8_temp));
 
-      in >> wgsPos; af.setWGSPosition(wgsPos);
+          in >> wgsPos; af.setWGSPosition(wgsPos);
 
-      in >> position; af.setPosition(position);
+          in >> elevation; af.setElevation(elevation);
 
-      in >> elevation; af.setElevation(elevation);
+          in >> inFrequency;
 
-      in >> inFrequency;
+          if( inFrequency == 0 )
+            {
+              af.setFrequency( 0.0 );
+            }
+          else
+            {
+              af.setFrequency((((float) inFrequency) / 1000.0) + 100.);
+            }
 
-      if( inFrequency == 0 )
-        {
-          af.setFrequency( 0.0 );
-        }
-      else
-        {
-          af.setFrequency((((float) inFrequency) / 1000.0) + 100.);
-        }
+          // The runway list has to be read
+          quint8 listSize; in >> listSize;
 
-      // The runway list has to be read
-      quint8 listSize; in >> listSize;
+          for( short i = 0; i < (short) listSize; i++ )
+            {
+              float length;
+              float width;
+              quint16 heading;
+              quint8 surface;
+              quint8 isOpen;
+              quint8 isBidirectional;
+
+              in >> length;
+              in >> width;
+              in >> heading;
+              in >> surface;
+              in >> isOpen;
+              in >> isBidirectional;
+
+              Runway rwy( length, heading, surface, isOpen, isBidirectional, width );
+
+              af.addRunway( rwy );
+            }
 
-      for( short i = 0; i < (short) listSize; i++ )
-        {
-          float length;
-          float width;
-          quint16 heading;
-          quint8 surface;
-          quint8 isOpen;
-          quint8 isBidirectional;
-
-          in >> length;
-          in >> width;
-          in >> heading;
-          in >> surface;
-          in >> isOpen;
-          in >> isBidirectional;
-
-          Runway rwy( length, heading, surface, isOpen, isBidirectional, width );
-
-          af.addRunway( rwy );
-        }
+          if( m_filter.isFiltered( af ) )
+            {
+              continue;
+            }
 
-      // Add the airfield site to the list.
-      airfieldList.append( af );
-    }
+          // Project the position to the current map projection.
+          af.setPosition( _globalMapMatrix->wgsToMap( wgsPos ) );
 
-  inFile.close();
+          // Add the airfield site to the list.
+          airfieldList.append( af );
+        }
+    }
 
   qDebug( "OAIP: %d airfields read from %s in %dms",
           counter, fileName.toLatin1().data(), t.elapsed() );
@@ -979,38 +759,29 @@ bool OpenAipPoiLoader::readCompiledFile( QString &fileName,
   QTime t;
   t.start();
 
-  QFile inFile( fileName );
+  // The compiled file is memory mapped.
+  PointCache cache;
 
-  if( !inFile.open(QIODevice::ReadOnly) )
+  if( cache.open( fileName ) == false )
     {
       qWarning("OAIP: Cannot open navAid file %s!", fileName.toLatin1().data());
       return false;
     }
 
-  QDataStream in( &inFile );
-  in.setVersion( Q_DATA_STREAM );
+  QDataStream& in = cache.stream();
+
+  m_filter.loadUserFilterValues();
 
   bool ok = readHeaderData( in, FILE_TYPE_NAV_AIDS_OAIP_C, FILE_VERSION_NAV_AIDS_C );
 
-  if( ok == false )
+  if( ok == false || cache.readDirectory() == false )
     {
-      inFile.close();
       return false;
     }
 
-  // read number of records in the file
-  quint32 lrn; in >> lrn;
-
-  // Preallocate list memory for new elements to be added.
-  if( lrn )
-    {
-      navAidList.reserve( navAidList.size() + lrn );
-    }
-
   quint8 type;
   QByteArray utf8_temp;
   WGSPoint wgsPos;
-  QPoint position;
   float elevation;
   float inFrequency;
   float range;
@@ -1018,62 +789,71 @@ bool OpenAipPoiLoader::readCompiledFile( QString &fileName,
   quint8 isAligned2TrueNorth;
 
   uint counter = 0;
+  int records;
 
-  while( ! in.atEnd() )
+  // Read all buckets within the filter radius. The other ones are skipped.
+  while( (records = cache.nextBucket( m_filter.getHomePosition(), m_filter.getFilterRadius() )) >= 0 )
     {
-      counter++;
+      for( int r = 0; r < records; r++ )
+        {
+          counter++;
 
-      RadioPoint rp;
+          RadioPoint rp;
 
-      in >> type; rp.setTypeID( static_cast<BaseMapElement::objectType>(type) );
+          in >> type; rp.setTypeID( static_cast<BaseMapElement::objectType>(type) );
 
-      // read long name
-      ShortLoad(in, utf8_temp);
-      rp.setName(QString::fromUtf8(utf8_temp));
+          // read long name
+          ShortLoad(in, utf8_temp);
+          rp.setName(QString::fromUtf8(utf8_temp));
 
-      // read short name
-      ShortLoad(in, utf8_temp);
-      rp.setWPName(QString::fromUtf8(utf8_temp));
+          // read short name
+          ShortLoad(in, utf8_temp);
+          rp.setWPName(QString::fromUtf8(utf8_temp));
 
-      // read the 2 letter country code
-      ShortLoad(in, utf8_temp);
-      rp.setCountry(QString::fromUtf8(utf8_temp));
+          // read the 2 letter country code
+          ShortLoad(in, utf8_temp);
+          rp.setCountry(QString::fromUtf8(utf8_temp));
 
-      // read ICAO
-      ShortLoad(in, utf8_temp);
-      rp.setICAO(QString::fromUtf8(utf8_temp));
+          // read ICAO
+          ShortLoad(in, utf8_temp);
+          rp.setICAO(QString::fromUtf8(utf8_temp));
 
-      // read comment
-      ShortLoad(in, utf8_temp);
-      rp.setComment(QString::fromUtf8(utf8_temp));
+          // read comment
+          ShortLoad(in, utf8_temp);
+          rp.setComment(QString::fromUtf8(utf8_temp));
 
-      in >> wgsPos; rp.setWGSPosition(wgsPos);
+          in >> wgsPos; rp.setWGSPosition(wgsPos);
 
-      in >> position; rp.setPosition(position);
+          in >> elevation; rp.setElevation(elevation);
 
-      in >> elevation; rp.setElevation(elevation);
+          // Frequency in MHz
+          in >> inFrequency; rp.setFrequency( inFrequency );
 
-      // Frequency in MHz
-      in >> inFrequency; rp.setFrequency( inFrequency );
+          // Channel info
+          ShortLoad(in, utf8_temp);
+          rp.setChannel(QString::fromUtf8(utf8_temp));
 
-      // Channel info
-      ShortLoad(in, utf8_temp);
-      rp.setChannel(QString::fromUtf8(utf8_temp));
+          // Service range as float
+          in >> range; rp.setRange(range);
 
-      // Service range as float
-      in >> range; rp.setRange(range);
+          // Declination
+          in >> declination; rp.setDeclination(declination);
 
-      // Declination
-      in >> declination; rp.setDeclination(declination);
+          // Aligned2TrueNorth
+          in >> isAligned2TrueNorth; rp.setAligned2TrueNorth(isAligned2TrueNorth);
 
-      // Aligned2TrueNorth
-      in >> isAligned2TrueNorth; rp.setAligned2TrueNorth(isAligned2TrueNorth);
+          if( m_filter.isFiltered( rp ) )
+            {
+              continue;
+            }
 
-      // Add the radio point element to the list.
-      navAidList.append( rp );
-    }
+          // Project the position to the current map projection.
+          rp.setPosition( _globalMapMatrix->wgsToMap( wgsPos ) );
 
-  inFile.close();
+          // Add the radio point element to the list.
+          navAidList.append( rp );
+        }
+    }
 
   qDebug( "OAIP: %d navAids read from %s in %dms",
           counter, fileName.toLatin1().data(), t.elapsed() );
@@ -1087,75 +867,76 @@ bool OpenAipPoiLoader::readCompiledFile( QString &fileName,
   QTime t;
   t.start();
 
-  QFile inFile( fileName );
+  // The compiled file is memory mapped.
+  PointCache cache;
 
-  if( !inFile.open(QIODevice::ReadOnly) )
+  if( cache.open( fileName ) == false )
     {
       qWarning("OAIP: Cannot open single point file %s!", fileName.toLatin1().data());
       return false;
     }
 
-  QDataStream in( &inFile );
-  in.setVersion( Q_DATA_STREAM );
+  QDataStream& in = cache.stream();
+
+  m_filter.loadUserFilterValues();
 
   bool ok = readHeaderData( in, FILE_TYPE_HOTSPOTS_OAIP_C, FILE_VERSION_HOTSPOT_C );
 
-  if( ok == false )
+  if( ok == false || cache.readDirectory() == false )
     {
-      inFile.close();
       return false;
     }
 
-  // read number of records in the file
-  quint32 lrn; in >> lrn;
-
-  // Preallocate list memory for new elements to be added.
-  if( lrn )
-    {
-      spList.reserve( spList.size() + lrn );
-    }
-
   quint8 type;
   QByteArray utf8_temp;
   WGSPoint wgsPos;
-  QPoint position;
   float elevation;
 
   uint counter = 0;
+  int records;
 
-  while( ! in.atEnd() )
+  // Read all buckets within the filter radius. The other ones are skipped.
+  while( (records = cache.nextBucket( m_filter.getHomePosition(), m_filter.getFilterRadius() )) >= 0 )
     {
-      counter++;
+      for( int r = 0; r < records; r++ )
+        {
+          counter++;
 
-      SinglePoint sp;
+          SinglePoint sp;
 
-      in >> type; sp.setTypeID( static_cast<BaseMapElement::objectType>(type) );
+          in >> type; sp.setTypeID( static_cast<BaseMapElement::objectType>(type) );
 
-      // read long name
-      ShortLoad(in, utf8_temp);
-      sp.setName(QString::fromUtf8(utf8_temp));
+          // read long name
+          ShortLoad(in, utf8_temp);
+          sp.setName(QString::fromUtf8(utf8_temp));
 
-      // read short name
-      ShortLoad(in, utf8_temp);
-      sp.setWPName(QString::fromUtf8(utf8_temp));
+          // read short name
+          ShortLoad(in, utf8_temp);
+          sp.setWPName(QString::fromUtf8(utf8_temp));
 
-      // read the 2 letter country code
-      ShortLoad(in, utf8_temp);
-      sp.setCountry(QString::fromUtf8(utf8_temp));
+          // read the 2 letter country code
+          ShortLoad(in, utf8_temp);
+          sp.setCountry(QString::fromUtf8(utf8_temp));
 
-      // read comment
-      ShortLoad(in, utf8_temp);
-      sp.setComment(QString::fromUtf8(utf8_temp));
+          // read comment
+          ShortLoad(in, utf8_temp);
+          sp.setComment(QString::fromUtf8(utf8_temp));
 
-      in >> wgsPos;    sp.setWGSPosition(wgsPos);
-      in >> position;  sp.setPosition(position);
-      in >> elevation; sp.setElevation(elevation);
+          in >> wgsPos;    sp.setWGSPosition(wgsPos);
+          in >> elevation; sp.setElevation(elevation);
 
-      // Add the single point element to the list.
-      spList.append( sp );
-    }
+          if( m_filter.isFiltered( sp ) )
+            {
+              continue;
+            }
 
-  inFile.close();
+          // Project the position to the current map projection.
+          sp.setPosition( _globalMapMatrix->wgsToMap( wgsPos ) );
+
+          // Add the single point element to the list.
+          spList.append( sp );
+        }
+    }
 
   qDebug( "OAIP: %d single points read from %s in %dms",
           counter, fileName.toLatin1().data(), t.elapsed() );
@@ -1192,17 +973,6 @@ bool OpenAipPoiLoader::readHeaderData( QDataStream& dataStream,
   m_hd.h_magic              = 0;
   m_hd.h_fileType.clear();
   m_hd.h_fileVersion        = 0;
-  m_hd.h_homeRadius         = 0.0;
-  m_hd.h_runwayLengthFilter = 0.0;
-  m_hd.h_homeCoord.setX(0);
-  m_hd.h_homeCoord.setY(0);
-
-  if( m_hd.h_projection )
-    {
-      // delete an older projection object
-      delete  m_hd.h_projection;
-      m_hd.h_projection = 0;
-    }
 
   dataStream >> m_hd.h_magic;
 
@@ -1229,15 +999,11 @@ bool OpenAipPoiLoader::readHeaderData( QDataStream& dataStream,
     }
 
   dataStream >> m_hd.h_creationDateTime;
-  dataStream >> m_hd.h_homeRadius;
-  dataStream >> m_hd.h_runwayLengthFilter;
-  dataStream >> m_hd.h_homeCoord;
 
 #ifdef BOUNDING_BOX
   dataStream >> m_hd.h_boundingBox;
 #endif
 
-  m_hd.h_projection = LoadProjection(dataStream);
   m_hd.h_headerIsValid = true;
   return true;
 }
@@ -25,6 +25,11 @@
  *
  * See here for more info: http://www.openaip.net
  *
+ * The compiled files contain all points of a source file with their WGS84
+ * coordinates, grouped in spatial buckets. The map projection and the user
+ * filters for home radius and runway length are applied during loading,
+ * hence a compiled file stays valid, if these settings are changed.
+ *
  * \date 2013-2014
  *
  * \version 1.0
@@ -44,7 +49,7 @@
 #include <QRect>
 
 #include "airfield.h"
-#include "projectionbase.h"
+#include "OpenAip.h"
 #include "radiopoint.h"
 #include "singlepoint.h"
 
@@ -98,6 +103,35 @@ class OpenAipPoiLoader
    */
   int load( QList<SinglePoint>& hotspotList, bool readSource=false );
 
+  /**
+   * Loads a single openAIP airfield file. The compiled file is read, if it
+   * is valid and not older as the source file. Otherwise the source file is
+   * parsed and compiled. The method can be called in parallel on different
+   * loader instances.
+   *
+   * \param aipName Source file name, empty if there is only a compiled file
+   *
+   * \param aicName Compiled file name, empty if there is only a source file
+   *
+   * \param airfieldList All read airfields have to be appended to this list.
+   *
+   * \return true (success) or false (error occurred)
+   */
+  bool loadFile( QString& aipName, QString& aicName,
+                 QList<Airfield>& airfieldList );
+
+  /**
+   * Loads a single openAIP navAid file, see the airfield method.
+   */
+  bool loadFile( QString& aipName, QString& aicName,
+                 QList<RadioPoint>& navAidList );
+
+  /**
+   * Loads a single openAIP hotspot file, see the airfield method.
+   */
+  bool loadFile( QString& aipName, QString& aicName,
+                 QList<SinglePoint>& spList );
+
   /**
    * Creates a compiled file from the passed airfield list beginning at the
    * given start position and ending at the end of the list.
@@ -199,6 +233,34 @@ class OpenAipPoiLoader
 
  private:
 
+  /**
+   * Searches on default places the openAIP files of one point kind and loads
+   * them on the loader pool. Every file is handled by an own job and the
+   * results are appended in the order of the file names.
+   *
+   * \param list All read points have to be appended to this list.
+   *
+   * \param readSource If true the source files have to be read instead of
+   * compiled sources.
+   *
+   * \param fileKind File name ending of the point kind, e.g. _wpt
+   *
+   * \param pointKind Name of the point kind used in messages
+   *
+   * \return number of loaded files
+   */
+  template<class T>
+  int loadFiles( QList<T>& list, bool readSource,
+                 const QString& fileKind, const char* pointKind );
+
+  /**
+   * Checks, if the compiled file can be used instead of its source file.
+   *
+   * \return true, if the compiled file shall be read
+   */
+  bool useCompiledFile( QString& aipName, QString& aicName,
+                        QString fileType, int fileVersion );
+
   /**
    * Reads the header data of a compiled file from the opened data stream and
    * put them in the class variables.
@@ -224,30 +286,15 @@ class OpenAipPoiLoader
 	h_magic(0),
 	h_fileType(),
 	h_fileVersion(0),
-	h_homeRadius(0.0),
-	h_runwayLengthFilter(0.0),
-	h_projection(static_cast<ProjectionBase *> (0)),
 	h_headerIsValid(false)
 	{
 	};
 
-      ~HeaderData()
-	{
-	  if( h_projection )
-	    {
-	      delete h_projection;
-	    }
-	};
-
       quint32         h_magic;
       QByteArray      h_fileType;
       quint8          h_fileVersion;
       QDateTime       h_creationDateTime;
-      float           h_homeRadius;
-      float           h_runwayLengthFilter;
-      QPoint          h_homeCoord;
       QRect           h_boundingBox;
-      ProjectionBase* h_projection;
 
       /** Flag to signal that set header data are valid. */
       bool h_headerIsValid;
@@ -255,6 +302,9 @@ class OpenAipPoiLoader
 
   HeaderData m_hd;
 
+  /** Parser instance providing the user's point filters. */
+  OpenAip m_filter;
+
   /** Mutex to ensure thread safety. */
   static QMutex m_mutex;
 };
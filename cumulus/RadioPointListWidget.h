@@ -34,6 +34,7 @@
 #include "radiopoint.h"
 #include "waypoint.h"
 #include "listwidgetparent.h"
+#include "singlepointlistmodel.h"
 #include "mapcontents.h"
 
 class RadioPointListWidget : public ListWidgetParent
@@ -78,16 +79,9 @@ private:
   /** Identifiers for list access. */
   QVector<enum MapContents::ListID> m_itemList;
 
-  /** Waypoint temporary storage. */
-  Waypoint m_wp;
 
-  class RadioPointItem : public QTreeWidgetItem
-    {
-      public:
-
-      RadioPointItem(RadioPoint *);
-      RadioPoint* m_radioPoint;
-    };
+  /** Model over the point lists. */
+  SinglePointListModel* m_model;
 };
 
 #endif
@@ -22,12 +22,8 @@
 #endif
 
 #include "generalconfig.h"
-#include "mapconfig.h"
 #include "calculator.h"
 
-extern MapContents *_globalMapContents;
-extern MapConfig   *_globalMapConfig;
-
 SinglePointListWidget::SinglePointListWidget( QVector<enum MapContents::ListID> &itemList,
 					      QWidget *parent,
 					      bool showMovePage ) :
@@ -37,8 +33,8 @@ SinglePointListWidget::SinglePointListWidget( QVector<enum MapContents::ListID>
   setObjectName("SinglePointListWidget");
   list->setObjectName("SinglePointTreeWidget");
 
-  QTreeWidgetItem *headerItem = list->headerItem();
-  headerItem->setText( 3, tr("Comment") );
+  m_model = new SinglePointListModel( SinglePointListModel::Comment, this );
+  setListModel( m_model );
 }
 
 SinglePointListWidget::~SinglePointListWidget()
@@ -51,79 +47,20 @@ void SinglePointListWidget::fillItemList()
   // call base class
   ListWidgetParent::fillItemList();
 
-  list->setUpdatesEnabled(false);
-  list->clear();
-
   configRowHeight();
 
-  for ( int item = 0; item < m_itemList.size(); item++ )
-    {
-      int nr = _globalMapContents->getListLength( m_itemList.at(item) );
-
-      for (int i = 0; i < nr; i++ )
-        {
-          SinglePoint* site = dynamic_cast<SinglePoint *> (_globalMapContents->getElement( m_itemList.at(item), i ));
-
-          if( site == 0 )
-            {
-              continue;
-            }
-
-          filter->addListItem( new SinglePointItem(site) );
-        }
-    }
+  // Only pointers to the points are loaded, the rows are materialized by
+  // the view on demand.
+  m_model->reload( m_itemList );
 
   // sorting is done in filter->reset()
-  resizeListColumns();
-
   filter->reset();
-  list->setUpdatesEnabled(true);
+  resizeListColumns();
 }
 
 /** Returns a pointer to the currently highlighted airfield. */
 Waypoint* SinglePointListWidget::getCurrentWaypoint()
 {
-  // qDebug("SinglePointListWidget::getCurrentWaypoint()");
-  QTreeWidgetItem* li = list->currentItem();
-
-  if( li == 0 )
-    {
-      return 0;
-    }
-
-  SinglePointItem* item = dynamic_cast<SinglePointItem *> (li);
-
-  // May be null if the cast failed.
-  if( item == static_cast<SinglePointItem *> (0) )
-    {
-      return static_cast<Waypoint *> (0);
-    }
-
-  SinglePoint* site = item->m_singlePoint;
-
-  m_wp.name = site->getWPName();
-  m_wp.wgsPoint = site->getWGSPosition();
-  m_wp.elevation = site->getElevation();
-  m_wp.projPoint = site->getPosition();
-  m_wp.description = site->getName();
-  m_wp.type = site->getTypeID();
-  m_wp.elevation = site->getElevation();
-  m_wp.comment = site->getComment();
-  m_wp.country = site->getCountry();
-
-  return &m_wp;
-}
-
-SinglePointListWidget::SinglePointItem::SinglePointItem(SinglePoint* site) :
-  QTreeWidgetItem(), m_singlePoint(site)
-{
-  setText(0, site->getWPName());
-  setText(1, site->getName());
-  setText(2, site->getCountry());
-  setTextAlignment(2, Qt::AlignCenter);
-  setText(3, site->getComment());
-
-  // set type icon
-  QPixmap pm = _globalMapConfig->getPixmap(site->getTypeID(), false);
-  setIcon( 0, QIcon( pm) );
+  // May be null if no row is selected.
+  return m_model->waypoint( currentRow() );
 }
@@ -34,6 +34,7 @@
 #include "singlepoint.h"
 #include "waypoint.h"
 #include "listwidgetparent.h"
+#include "singlepointlistmodel.h"
 #include "mapcontents.h"
 
 class SinglePointListWidget : public ListWidgetParent
@@ -78,17 +79,9 @@ private:
   /** Identifiers for list access. */
   QVector<enum MapContents::ListID> m_itemList;
 
-  /** Waypoint temporary storage. */
-  Waypoint m_wp;
 
-  class SinglePointItem : public QTreeWidgetItem
-    {
-      public:
-
-      SinglePointItem( SinglePoint *sp );
-
-      SinglePoint* m_singlePoint;
-    };
+  /** Model over the point lists. */
+  SinglePointListModel* m_model;
 };
 
 #endif
@@ -28,7 +28,9 @@ Airspace::Airspace() :
   m_lLimitType(BaseMapElement::NotSet),
   m_uLimitType(BaseMapElement::NotSet),
   m_lastVConflict(none),
+  m_lastHConflict(none),
   m_airRegion(0),
+  m_screenPathGeneration(0),
   m_id(-1)
 {
   // All Airspaces are closed regions ...
@@ -48,7 +50,9 @@ Airspace::Airspace( QString name,
   m_lLimitType(lType),
   m_uLimitType(uType),
   m_lastVConflict(none),
+  m_lastHConflict(none),
   m_airRegion(0),
+  m_screenPathGeneration(0),
   m_id(identifier)
 {
   // All Airspaces are closed regions ...
@@ -104,6 +108,7 @@ Airspace::Airspace( QString name,
 
   m_uLimit.setMeters( uLim );
   m_lastVConflict=none;
+  m_lastHConflict=none;
 }
 
 Airspace* Airspace::createAirspaceObject()
@@ -122,6 +127,7 @@ Airspace* Airspace::createAirspaceObject()
                                getCountry() );
 
   as->setFlarmAlertZone( m_flarmAlertZone );
+  as->setWgsPolygon( m_wgsPolygon );
   return as;
 }
 
@@ -166,24 +172,13 @@ void Airspace::drawRegion( QPainter* targetP, qreal opacity )
       return;
     }
 
-  QPolygon mP = glMapMatrix->map(projPolygon);
+  const QPainterPath& pp = screenPath();
 
-  if( mP.size() < 3 )
+  if( pp.isEmpty() )
     {
       return;
     }
 
-  QPainterPath pp;
-
-  pp.moveTo( mP.at(0) );
-
-  for( int i = 1; i < mP.size(); i++ )
-    {
-      pp.lineTo( mP.at(i) );
-    }
-
-  pp.closeSubpath();
-
   QBrush drawB( glConfig->getDrawBrush(typeID) );
 
   if( opacity <= 100.0 )
@@ -213,7 +208,7 @@ void Airspace::drawRegion( QPainter* targetP, qreal opacity )
     {
       // Draw airspace filled with opacity factor
       targetP->setOpacity( opacity/100.0 );
-      targetP->drawPolygon(mP);
+      targetP->drawPath(pp);
 
       // Reset opacity, that a solid line is drawn as next
       targetP->setBrush(Qt::NoBrush);
@@ -304,12 +299,34 @@ void Airspace::drawFlarmAlertZone( QPainter* targetP, qreal opacity )
  */
 QPainterPath* Airspace::createRegion()
 {
-  QPolygon mP = glMapMatrix->map(projPolygon);
+  return new QPainterPath( screenPath() );
+}
+
+const QPainterPath& Airspace::screenPath()
+{
+  if( projPolygon.size() < 3 )
+    {
+      m_screenPath = QPainterPath();
+      return m_screenPath;
+    }
+
+  if( m_projPath.isEmpty() || m_projPathBox != bBox )
+    {
+      // The projected polygon is new, e.g. after a projection change.
+      m_projPath = QPainterPath();
+      m_projPath.addPolygon( projPolygon );
+      m_projPath.closeSubpath();
+      m_projPathBox = bBox;
+      m_screenPathGeneration = 0;
+    }
+
+  if( m_screenPathGeneration != glMapMatrix->getMatrixGeneration() )
+    {
+      m_screenPath = glMapMatrix->getWorldMatrix().map( m_projPath );
+      m_screenPathGeneration = glMapMatrix->getMatrixGeneration();
+    }
 
-  QPainterPath *path = new QPainterPath;
-  path->addPolygon(mP);
-  path->closeSubpath();
-  return path;
+  return m_screenPath;
 }
 
 /**
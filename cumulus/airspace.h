@@ -133,6 +133,13 @@ public:
    */
   QPainterPath* createRegion();
 
+  /**
+   * Returns the airspace border as path in screen coordinates. The path is
+   * built once from the projected polygon. After a pan or zoom it is only
+   * mapped anew by the world matrix.
+   */
+  const QPainterPath& screenPath();
+
   /**
    * Sets the upper limit of the airspace.
    */
@@ -237,6 +244,22 @@ public:
       return m_lastVConflict;
   };
 
+  /**
+   * Returns the last horizontal conflict type
+   */
+  ConflictType lastHConflict() const
+  {
+      return m_lastHConflict;
+  };
+
+  /**
+   * Sets the last horizontal conflict type
+   */
+  void setLastHConflict( const ConflictType conflict ) const
+  {
+      m_lastHConflict = conflict;
+  };
+
   /**
    * sets the touch time of air space to current time
    */
@@ -340,6 +363,27 @@ public:
     m_flarmAlertZone = faz;
   };
 
+  /**
+   * Get the WGS84 coordinates of the airspace border.
+   *
+   * \return Polygon with WGS84 coordinates in KFLog format.
+   */
+  const QPolygon& getWgsPolygon() const
+  {
+    return m_wgsPolygon;
+  };
+
+  /**
+   * Set the WGS84 coordinates of the airspace border. They are used to
+   * store compiled airspace files independent of the map projection.
+   *
+   * \param polygon Polygon with WGS84 coordinates in KFLog format.
+   */
+  void setWgsPolygon( const QPolygon& polygon )
+  {
+    m_wgsPolygon = polygon;
+  };
+
   /**
    * Prints out all relevant airspace data.
    */
@@ -371,6 +415,8 @@ private:
 
   mutable ConflictType m_lastVConflict;
 
+  mutable ConflictType m_lastHConflict;
+
   /** save time of last touch of airspace */
   QTime m_lastNear;
   QTime m_lastVeryNear;
@@ -379,6 +425,18 @@ private:
   // pointer to associated airRegion object
   AirRegion* m_airRegion;
 
+  /** Border as path in projected coordinates. */
+  QPainterPath m_projPath;
+
+  /** Bounding box of the projected polygon, from which m_projPath was built. */
+  QRect m_projPathBox;
+
+  /** Border as path in screen coordinates. */
+  QPainterPath m_screenPath;
+
+  /** Matrix generation, for which m_screenPath was mapped. */
+  uint m_screenPathGeneration;
+
   /**
    * Unique identifier used by openAip.
    */
@@ -388,6 +446,11 @@ private:
    * Flarm Alert Zone object.
    */
   FlarmBase::FlarmAlertZone m_flarmAlertZone;
+
+  /**
+   * Unprojected airspace border in WGS84 coordinates.
+   */
+  QPolygon m_wgsPolygon;
 };
 
 /**
@@ -0,0 +1,322 @@
+/***********************************************************************
+ **
+ **   airspaceindex.cpp
+ **
+ **   This file is part of Cumulus.
+ **
+ ************************************************************************
+ **
+ **   Copyright (c):  2026 by the Cumulus contributors
+ **
+ **   This file is distributed under the terms of the General Public
+ **   License. See the file COPYING for more information.
+ **
+ ***********************************************************************/
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include "airspaceindex.h"
+#include "mapcalc.h"
+
+// Kilometers per KFLog unit along a meridian.
+static const double KmPerUnit = RADIUS / 1000.0 * M_PI / 180.0 / 600000.0;
+
+AirspaceIndex::AirspaceIndex() :
+  m_stamp(0),
+  m_cellSize(CellSize)
+{
+}
+
+AirspaceIndex::~AirspaceIndex()
+{
+}
+
+void AirspaceIndex::build( const QList<Airspace *>& airspaces )
+{
+  clear();
+
+  m_entries.reserve( airspaces.size() );
+
+  for( int i = 0; i < airspaces.size(); i++ )
+    {
+      Airspace* as = airspaces.at(i);
+
+      if( as == 0 || as->getWgsPolygon().size() < 3 )
+        {
+          continue;
+        }
+
+      insert( as, as->getWgsPolygon().boundingRect() );
+    }
+}
+
+void AirspaceIndex::buildProjected( const QList<Airspace *>& airspaces )
+{
+  clear();
+
+  QRect all;
+
+  for( int i = 0; i < airspaces.size(); i++ )
+    {
+      Airspace* as = airspaces.at(i);
+
+      if( as != 0 && as->getProjectedPolygon().size() >= 3 )
+        {
+          all |= as->getProjectedPolygon().boundingRect();
+        }
+    }
+
+  if( all.isEmpty() )
+    {
+      return;
+    }
+
+  // The projected coordinates depend on the projection, therefore the grid
+  // is laid over the area covered by all airspaces.
+  m_origin   = all.topLeft();
+  m_cellSize = qMax( 1, qMax( all.width(), all.height() ) / ProjectedCells + 1 );
+
+  m_entries.reserve( airspaces.size() );
+
+  for( int i = 0; i < airspaces.size(); i++ )
+    {
+      Airspace* as = airspaces.at(i);
+
+      if( as == 0 || as->getProjectedPolygon().size() < 3 )
+        {
+          continue;
+        }
+
+      insert( as, as->getProjectedPolygon().boundingRect() );
+    }
+}
+
+void AirspaceIndex::insert( Airspace* as, const QRect& box )
+{
+  Entry entry;
+  entry.airspace = as;
+  entry.box = box;
+
+  int idx = m_entries.size();
+  m_entries.append( entry );
+
+  int x1 = cellCoord( box.left(), m_origin.x() );
+  int x2 = cellCoord( box.right(), m_origin.x() );
+  int y1 = cellCoord( box.top(), m_origin.y() );
+  int y2 = cellCoord( box.bottom(), m_origin.y() );
+
+  for( int x = x1; x <= x2; x++ )
+    {
+      for( int y = y1; y <= y2; y++ )
+        {
+          m_cells[cellKey( x, y )].append( idx );
+        }
+    }
+}
+
+void AirspaceIndex::clear()
+{
+  m_entries.clear();
+  m_cells.clear();
+  m_stamp = 0;
+  m_cellSize = CellSize;
+  m_origin = QPoint();
+}
+
+int AirspaceIndex::cellCoord( const int value, const int origin ) const
+{
+  const int v = value - origin;
+
+  // Round down also for negative coordinates.
+  return v >= 0 ? v / m_cellSize : (v - m_cellSize + 1) / m_cellSize;
+}
+
+int AirspaceIndex::cellKey( const int x, const int y )
+{
+  // Packs the x and y cell coordinates into one key. Keys are unique as
+  // long as y stays within -1024...1023, i.e. the 2048 wide packing step.
+  // That holds for the longitude cells of the WGS84 grid (-720...720) and
+  // for the 64 cells of the projected grid. Aliased keys can only deliver
+  // additional entries, which are rejected by their bounding box.
+  return x * 2048 + y;
+}
+
+void AirspaceIndex::query( const QRect& search, QVector<int>* found )
+{
+  m_stamp++;
+
+  int x1 = cellCoord( search.left(), m_origin.x() );
+  int x2 = cellCoord( search.right(), m_origin.x() );
+  int y1 = cellCoord( search.top(), m_origin.y() );
+  int y2 = cellCoord( search.bottom(), m_origin.y() );
+
+  for( int x = x1; x <= x2; x++ )
+    {
+      for( int y = y1; y <= y2; y++ )
+        {
+          QHash<int, QVector<int> >::const_iterator it = m_cells.constFind( cellKey( x, y ) );
+
+          if( it == m_cells.constEnd() )
+            {
+              continue;
+            }
+
+          const QVector<int>& cell = it.value();
+
+          for( int i = 0; i < cell.size(); i++ )
+            {
+              Entry& entry = m_entries[cell.at(i)];
+
+              if( entry.stamp == m_stamp || entry.box.intersects( search ) == false )
+                {
+                  continue;
+                }
+
+              entry.stamp = m_stamp;
+              found->append( cell.at(i) );
+            }
+        }
+    }
+}
+
+void AirspaceIndex::candidates( const QPoint& wgsPos,
+                                const double radius,
+                                QVector<Airspace *>& result )
+{
+  if( m_entries.isEmpty() )
+    {
+      return;
+    }
+
+  double cosLat = cos( wgsPos.x() / 600000.0 * M_PI / 180.0 );
+
+  int dLat = (int) ceil( radius / KmPerUnit );
+  int dLon = cosLat > 0.01 ? (int) ceil( radius / (KmPerUnit * cosLat) ) : 180 * 600000;
+
+  QRect search( QPoint( wgsPos.x() - dLat, wgsPos.y() - dLon ),
+                QPoint( wgsPos.x() + dLat, wgsPos.y() + dLon ) );
+
+  QVector<int> found;
+
+  query( search, &found );
+
+  for( int i = 0; i < found.size(); i++ )
+    {
+      result.append( m_entries.at( found.at(i) ).airspace );
+    }
+}
+
+void AirspaceIndex::candidates( const QRect& area, QVector<Airspace *>& result )
+{
+  if( m_entries.isEmpty() || area.isEmpty() )
+    {
+      return;
+    }
+
+  // Clamp the search to the grid, a zoomed out map could cover many cells
+  // without any airspace.
+  QRect grid( m_origin, QSize( (ProjectedCells + 1) * m_cellSize,
+                               (ProjectedCells + 1) * m_cellSize ) );
+
+  QRect search = area & grid;
+
+  if( search.isEmpty() )
+    {
+      return;
+    }
+
+  QVector<int> found;
+
+  query( search, &found );
+
+  // The drawing order of the airspaces must be kept.
+  std::sort( found.begin(), found.end() );
+
+  for( int i = 0; i < found.size(); i++ )
+    {
+      result.append( m_entries.at( found.at(i) ).airspace );
+    }
+}
+
+Airspace::ConflictType AirspaceIndex::horizontalConflict( const QPolygon& wgsPolygon,
+                                                          const QPoint& wgsPos,
+                                                          const double veryNear,
+                                                          const double near )
+{
+  int size = wgsPolygon.size();
+
+  if( size < 3 )
+    {
+      return Airspace::none;
+    }
+
+  // Local plane around the position in km, x points to east, y to north.
+  double kx = KmPerUnit * cos( wgsPos.x() / 600000.0 * M_PI / 180.0 );
+  double ky = KmPerUnit;
+
+  bool inside = false;
+  double minDist2 = DBL_MAX;
+
+  const QPoint* pts = wgsPolygon.constData();
+
+  double xj = (pts[size - 1].y() - wgsPos.y()) * kx;
+  double yj = (pts[size - 1].x() - wgsPos.x()) * ky;
+
+  for( int i = 0; i < size; i++ )
+    {
+      double xi = (pts[i].y() - wgsPos.y()) * kx;
+      double yi = (pts[i].x() - wgsPos.x()) * ky;
+
+      // Count the crossings of the edge with the ray from the position
+      // to the east.
+      if( (yi > 0.0) != (yj > 0.0) )
+        {
+          double xc = xi + (0.0 - yi) * (xj - xi) / (yj - yi);
+
+          if( xc > 0.0 )
+            {
+              inside = ! inside;
+            }
+        }
+
+      // Distance of the position to the edge
+      double dx = xj - xi;
+      double dy = yj - yi;
+      double len2 = dx * dx + dy * dy;
+      double t = 0.0;
+
+      if( len2 > 0.0 )
+        {
+          t = qBound( 0.0, -(xi * dx + yi * dy) / len2, 1.0 );
+        }
+
+      double px = xi + t * dx;
+      double py = yi + t * dy;
+
+      minDist2 = qMin( minDist2, px * px + py * py );
+
+      xj = xi;
+      yj = yi;
+    }
+
+  if( inside )
+    {
+      return Airspace::inside;
+    }
+
+  double dist = sqrt( minDist2 );
+
+  if( dist <= veryNear )
+    {
+      return Airspace::veryNear;
+    }
+
+  if( dist <= near )
+    {
+      return Airspace::near;
+    }
+
+  return Airspace::none;
+}
@@ -0,0 +1,169 @@
+/***********************************************************************
+ **
+ **   airspaceindex.h
+ **
+ **   This file is part of Cumulus.
+ **
+ ************************************************************************
+ **
+ **   Copyright (c):  2026 by the Cumulus contributors
+ **
+ **   This file is distributed under the terms of the General Public
+ **   License. See the file COPYING for more information.
+ **
+ ***********************************************************************/
+
+#ifndef AIRSPACE_INDEX_H
+#define AIRSPACE_INDEX_H
+
+#include <QHash>
+#include <QList>
+#include <QPoint>
+#include <QPolygon>
+#include <QRect>
+#include <QVector>
+
+#include "airspace.h"
+
+/**
+ * \class AirspaceIndex
+ *
+ * \author Cumulus contributors
+ *
+ * \brief Grid index over the WGS84 bounding boxes of airspaces.
+ *
+ * The airspace conflict check asks the index for all airspaces, whose
+ * bounding box is within the largest warning distance around the current
+ * position. Only these candidates are checked exactly with
+ * \ref horizontalConflict. That check works on the WGS84 polygon of the
+ * airspace and is independent of the map projection, the scale and the
+ * current screen.
+ *
+ * A second instance indexes the projected bounding boxes of the airspaces.
+ * The map drawing asks it for the airspaces intersecting the visible map
+ * area.
+ *
+ * The index does not own the airspaces. It must be rebuilt, if the
+ * airspace list is reloaded.
+ *
+ * \date 2026
+ */
+class AirspaceIndex
+{
+ public:
+
+  AirspaceIndex();
+
+  virtual ~AirspaceIndex();
+
+  /**
+   * Rebuilds the index from the passed airspaces. Airspaces without a
+   * WGS84 polygon are ignored.
+   */
+  void build( const QList<Airspace *>& airspaces );
+
+  /**
+   * Rebuilds the index from the projected bounding boxes of the passed
+   * airspaces. The grid is adapted to the area covered by the airspaces.
+   */
+  void buildProjected( const QList<Airspace *>& airspaces );
+
+  /**
+   * Removes all airspaces from the index.
+   */
+  void clear();
+
+  /**
+   * @return The number of indexed airspaces.
+   */
+  int count() const
+  {
+    return m_entries.size();
+  };
+
+  /**
+   * Collects all airspaces, whose bounding box is within the passed radius
+   * around the position. Every airspace is returned only once.
+   *
+   * @param wgsPos Position as WGS84 coordinate
+   * @param radius Search radius in km
+   * @param result List, to which the found airspaces are appended
+   */
+  void candidates( const QPoint& wgsPos,
+                   const double radius,
+                   QVector<Airspace *>& result );
+
+  /**
+   * Collects all airspaces, whose bounding box intersects the passed area.
+   * The airspaces are returned in the order of the indexed list.
+   *
+   * @param area Search area in the coordinates of the index
+   * @param result List, to which the found airspaces are appended
+   */
+  void candidates( const QRect& area, QVector<Airspace *>& result );
+
+  /**
+   * Determines the horizontal conflict between a position and an airspace
+   * polygon. The polygon is projected into a local plane around the position,
+   * which is exact enough for the warning distances.
+   *
+   * @param wgsPolygon Airspace border as WGS84 coordinates
+   * @param wgsPos Position as WGS84 coordinate
+   * @param veryNear Very near warning distance in km
+   * @param near Near warning distance in km
+   * @return The horizontal conflict type
+   */
+  static Airspace::ConflictType horizontalConflict( const QPolygon& wgsPolygon,
+                                                    const QPoint& wgsPos,
+                                                    const double veryNear,
+                                                    const double near );
+
+ private:
+
+  /** Cell size in KFLog units, that is a quarter of a degree. */
+  enum { CellSize = 150000 };
+
+  /** Number of cells per side of the projected grid. */
+  enum { ProjectedCells = 64 };
+
+  class Entry
+  {
+   public:
+
+    Entry() : airspace(0), stamp(0) {};
+
+    Airspace* airspace;
+
+    /** Bounding box, x is the latitude and y the longitude. */
+    QRect box;
+
+    /** Number of the last query, which has returned this entry. */
+    uint stamp;
+  };
+
+  /** Adds an airspace with its bounding box to the grid. */
+  void insert( Airspace* as, const QRect& box );
+
+  /** Marks the entries intersecting the search area with a new stamp. */
+  void query( const QRect& search, QVector<int>* found );
+
+  static int cellKey( const int x, const int y );
+
+  int cellCoord( const int value, const int origin ) const;
+
+  QVector<Entry> m_entries;
+
+  /** Indices of the entries overlapping a cell. */
+  QHash<int, QVector<int> > m_cells;
+
+  /** Number of the current query. */
+  uint m_stamp;
+
+  /** Cell size in units of the indexed boxes. */
+  int m_cellSize;
+
+  /** Origin of the grid. */
+  QPoint m_origin;
+};
+
+#endif
@@ -36,6 +36,7 @@
 #include "mapcalc.h"
 #include "mapmatrix.h"
 #include "reachablelist.h"
+#include "replaybenchmark.h"
 #include "tpinfowidget.h"
 #include "whatsthat.h"
 #include "windanalyser.h"
@@ -51,7 +52,7 @@ extern MapMatrix   *_globalMapMatrix;
 
 Calculator::Calculator(QObject* parent) :
   QObject(parent),
-  samplelist( LimitedList<FlightSample>( MAX_SAMPLECOUNT ) )
+  samplelist( MAX_SAMPLECOUNT )
 {
   setObjectName( "Calculator" );
   GeneralConfig *conf = GeneralConfig::instance();
@@ -120,6 +121,8 @@ Calculator::Calculator(QObject* parent) :
   // hook up the internal backend components
   connect( m_vario, SIGNAL(newVario(const Speed&)),
            this, SLOT(slot_Variometer(const Speed&)));
+  connect( m_vario, SIGNAL(newNettoVario(const Speed&, const Speed&)),
+           this, SLOT(slot_NettoVariometer(const Speed&, const Speed&)));
 
   // The former calls to slot_newSample and slot_newFlightMode of the wind
   // analyzer are replaced by direct calls, when a new sample or flight
@@ -242,6 +245,8 @@ void Calculator::slot_Speed( Speed& newSpeedValue )
 /** called if a new position-fix has been established. */
 void Calculator::slot_Position( QPoint& newPositionValue )
 {
+  ReplayBenchmark::Probe probe( ReplayBenchmark::StageCalculator );
+
   lastGPSPosition = newPositionValue;
 
   if( ! m_manualInFlight )
@@ -433,7 +438,17 @@ void Calculator::calcDistance( bool autoWpSwitch )
 
   TaskPoint* tp = tpList.at( targetWp->taskPointIndex );
 
-  passageState = tp->checkPassage( curDistance, lastPosition );
+  // The fix time is only known for a GPS position. Then the task point can
+  // test the segment from the previous fix and interpolate the passage time.
+  QTime fixTime;
+
+  if( m_manualInFlight == false && GpsNmea::gps != 0 &&
+      lastPosition == lastGPSPosition )
+    {
+      fixTime = GpsNmea::gps->getLastTime();
+    }
+
+  passageState = tp->checkPassage( curDistance, lastPosition, fixTime );
 
   if( passageState == TaskPoint::Near )
     {
@@ -469,8 +484,14 @@ void Calculator::calcDistance( bool autoWpSwitch )
               emit taskInfo( tr("TP in sight"), true );
             }
 
+#ifdef CUMULUS_DEBUG
+          qDebug() << "Calculator: TP" << tp->getWPName() << "touched at"
+                   << tp->getPassageTime().toString("HH:mm:ss.zzz");
+#endif
+
           // Send a signal to the IGC logger to increase logging interval
-          emit taskpointSectorTouched();
+          // and to log the passage time.
+          emit taskpointSectorTouched( tp->getPassageTime() );
 
           // Send a pilot event to the Flarm, if Flarm is recognized.
           // That increases the IGC logger interval to 1s for 30s.
@@ -665,9 +686,8 @@ void Calculator::calcLD()
       return;
     }
 
-  const FlightSample *start = 0;
-  const FlightSample *end = &samplelist.at(0);
-  int timeDiff = 0;
+  int start = -1;
+  qint64 timeDiff = 0;
   double distance = 0.0;
   double newCurrentLD = -1.0;
   double newRequiredLD = -1.0;
@@ -682,7 +702,7 @@ void Calculator::calcLD()
   for ( int i = 1; i < samplelist.count(); i++ )
     {
 
-      timeDiff = (samplelist.at(i).time).msecsTo(end->time);
+      timeDiff = samplelist.time(0) - samplelist.time(i);
 
       if ( timeDiff >= ldCalcTime * 1000 )
         {
@@ -690,14 +710,14 @@ void Calculator::calcLD()
         }
 
       // summarize single distances from speed
-      distance += samplelist[i].vector.getSpeed().getMps();
+      distance += samplelist.speed(i);
 
       // qDebug( "i=%d, dist=%f", i, distance );
       // store start record
-      start = &samplelist[i];
+      start = i;
     }
 
-  if ( ! start )
+  if ( start < 0 )
     {
       // time distance too short
       lastCurrentLD = -1.0;
@@ -705,7 +725,7 @@ void Calculator::calcLD()
   else
     {
       // calculate altitude difference
-      double altDiff = start->altitude.getMeters() - end->altitude.getMeters();
+      double altDiff = samplelist.altitude(start) - samplelist.altitude(0);
 
       if ( altDiff <= 0.2 )
         {
@@ -762,53 +782,46 @@ bool Calculator::glidePath(int aLastBearing, Distance aDistance,
                            Altitude aElevation, Altitude &arrivalAlt,
                            Speed &bestSpeed )
 {
+  GlideTable::Target target;
+  target.bearing   = aLastBearing;
+  target.distance  = aDistance.getMeters();
+  target.elevation = aElevation.getMeters();
 
-  if (!m_polar)
+  if( ! glidePaths( &target, 1 ) )
     {
       arrivalAlt.setInvalid();
       bestSpeed.setInvalid();
       return false;
     }
 
-  //  qDebug("Glider=%s", _glider->type().toLatin1().data());
-
-  // we use the method described by Bob Hansen
-  // get best speed for zero wind V0
-  Speed speed = m_polar->bestSpeed(0.0, 0.0, lastMc);
-  //qDebug ("rough best speed: %f", speed.getKph());
+  arrivalAlt.setMeters( target.arrival );
+  bestSpeed.setMps( target.speed );
 
-  // wind has a negative vector!
-  //qDebug ("wind: %d/%f", lastWind.getAngleDeg(), lastWind.getSpeed().getKph());
+  //qDebug ("bestSpeed: %f", bestSpeed.getKph());
+  return true;
+}
 
-  // assume we are heading for the wp
-  Vector groundspeed (aLastBearing, speed);
-  //qDebug ("groundspeed: %d/%f", groundspeed.getAngleDeg(), groundspeed.getSpeed().getKph());
+/** Calculates the glide paths to many targets at once */
+bool Calculator::glidePaths( GlideTable::Target* targets, const int count )
+{
+  if( ! m_polar )
+    {
+      return false;
+    }
 
-  // we add wind because of the negative direction
-  Vector airspeed = groundspeed + getLastWind();
-  //qDebug ("airspeed: %d/%f", airspeed.getAngleDeg(), airspeed.getSpeed().getKph());
+  // We use the method described by Bob Hansen. The best speed for the
+  // head wind component and the related sink rate are taken from the
+  // table of the polar, that is built for the current McCready value.
+  const GlideTable& table = m_polar->glideTable( lastMc );
 
-  // this is the first iteration of the Bob Hansen method
-  Speed headwind = groundspeed.getSpeed() - airspeed.getSpeed() ;
-  //qDebug ("headwind: %f", headwind.getKph());
+  // wind has a negative vector!
+  Vector& wind = getLastWind();
 
   Altitude minimalArrival( GeneralConfig::instance()->getSafetyAltitude().getMeters() );
-  Altitude givenAlt (lastAltitude - Altitude (aElevation) - minimalArrival);
-
-  // improved speed for wind V1
-  speed = m_polar->bestSpeed(headwind, 0.0, lastMc);
-  //qDebug ("improved best speed: %f", speed.getKph());
-  bestSpeed = speed;
-  // the ld is over ground, so we take groundspeed
-  double ld =m_polar->bestLD(speed, groundspeed.getSpeed(), 0.0);
-
-  arrivalAlt = (givenAlt - (aDistance / ld));
 
-  //qDebug ("ld = %f", ld);
-  //qDebug ("bestSpeed: %f", speed.getKph());
-  //  qDebug ("lastSpeed: %f", lastSpeed.getKph());
-
-  return true;
+  return table.arrivalAltitudes( targets, count,
+                                 wind.getXMps(), wind.getYMps(),
+                                 (lastAltitude - minimalArrival).getMeters() );
 }
 
 void Calculator::calcGlidePath()
@@ -1126,6 +1139,20 @@ void Calculator::slot_Variometer(const Speed& lift)
     }
 }
 
+/**
+ * Netto and relative variometer receiver and distributor to map display.
+ */
+void Calculator::slot_NettoVariometer(const Speed& netto, const Speed& relative)
+{
+  if( lastNetto != netto || lastRelative != relative ||
+      lastNetto.isValid() != netto.isValid() )
+    {
+      lastNetto = netto;
+      lastRelative = relative;
+      emit newNettoVario( netto, relative );
+    }
+}
+
 /**
  * This slot triggers a variometer calculation based on Android pressure
  * altitude values.
@@ -1156,6 +1183,12 @@ void Calculator::slot_GpsVariometer(const Speed& lift)
   // Hey we got a variometer value directly from the GPS.
   // Therefore internal calculation is not needed and can be
   // switched off.
+  if( m_calculateVario == true && lastNetto.isValid() )
+    {
+      // Netto values are only calculated by the internal variometer.
+      slot_NettoVariometer( Speed(), Speed() );
+    }
+
   m_calculateVario = false;
 
   if (lastVario != lift)
@@ -1217,6 +1250,8 @@ void Calculator::slot_settingsChanged()
 /** This slot is called by the NMEA interpreter if a new fix has been received.  */
 void Calculator::slot_newFix( const QDateTime& newFixTime )
 {
+  ReplayBenchmark::Probe probe( ReplayBenchmark::StageCalculator );
+
   // before we start making samples, let's be sure we have all the
   // data we need for that. So, we wait for the second Fix.
   if (!m_pastFirstFix)
@@ -1256,8 +1291,9 @@ void Calculator::slot_newFix( const QDateTime& newFixTime )
 
   // Call variometer calculation derived from GPS altitude. Can be switched off,
   // when an external device delivers variometer information derived from a
-  // baro sensor.
-  if ( m_calculateVario == true && m_androidPressureAltitude == false )
+  // baro sensor. A fusing variometer needs the GPS altitude in every case.
+  if ( m_calculateVario == true &&
+       ( m_androidPressureAltitude == false || m_vario->isFusing() ) )
     {
       m_vario->newAltitude();
     }
@@ -1341,11 +1377,11 @@ void Calculator::determineFlightStatus()
   FlightMode flightMode = unknown;
 
   // get headings from the last two samples
-  int lastHead = samplelist[0].vector.getAngleDeg();
-  int prevHead = samplelist[1].vector.getAngleDeg();
+  int lastHead = samplelist.heading(0);
+  int prevHead = samplelist.heading(1);
 
   // get the time difference between these samples
-  int timediff = samplelist[1].time.secsTo(samplelist[0].time);
+  int timediff = int( (samplelist.time(0) - samplelist.time(1)) / 1000 );
 
   if (timediff == 0)
     {
@@ -1358,23 +1394,27 @@ void Calculator::determineFlightStatus()
   switch (lastFlightMode)
     {
     case standstill: // we are not moving at all!
-
-      if ( (samplelist[0].position == samplelist[1].position ||
-          ( MapCalc::dist(&samplelist[0].position, &samplelist[1].position) / double(timediff) ) < 0.005) &&
-           lastSpeed.getMps() <= 0.5 )
-        {
-          // may be too ridged, GPS errors could cause problems here
-          return;
-        }
-      else
-        {
-          flightMode = unknown;
-        }
+      {
+        QPoint pos0 = samplelist.position(0);
+        QPoint pos1 = samplelist.position(1);
+
+        if ( (pos0 == pos1 ||
+            ( MapCalc::dist(&pos0, &pos1) / double(timediff) ) < 0.005) &&
+             lastSpeed.getMps() <= 0.5 )
+          {
+            // may be too ridged, GPS errors could cause problems here
+            return;
+          }
+        else
+          {
+            flightMode = unknown;
+          }
+      }
       break;
 
     case cruising: // we are flying from point A to point B
       if (abs(MapCalc::angleDiff(lastHead, m_cruiseDirection)) <=  MAXCRUISEANGDIFF &&
-          samplelist[0].vector.getSpeed().getMps() > 0.5 )
+          samplelist.speed(0) > 0.5 )
         {
           return;
         }
@@ -1419,13 +1459,10 @@ void Calculator::determineFlightStatus()
       // qDebug() << "Flight mode unknown --> Start Analysis";
 
       // we need some real analysis
-      QDateTime refTime = samplelist[0].time.addSecs(-TIMEFRAME);
-      int samples = 1;
+      qint64 refTime = samplelist.time(0) - TIMEFRAME * 1000;
 
-      while ((samplelist[samples].time > refTime) && ( samples < samplelist.count() - 1) )
-        {
-          samples++;
-        }
+      // Index of the first sample, which is not newer than the reference time.
+      int samples = qMin( samplelist.countSince( refTime + 1 ), samplelist.count() - 1 );
 
       if( samples < 2 )
         {
@@ -1453,9 +1490,9 @@ void Calculator::determineFlightStatus()
           if( i < (samples - 1) )
             {
               // angDiff can be positive or negative according to the turn direction
-              angDiff = (int) rint(MapCalc::angleDiff( samplelist[i].vector.getAngleDeg(), samplelist[i+1].vector.getAngleDeg() ));
+              angDiff = (int) rint(MapCalc::angleDiff( samplelist.heading(i), samplelist.heading(i+1) ));
 
-              altChange = int( samplelist[i].altitude.getMeters() - samplelist[i+1].altitude.getMeters() );
+              altChange = int( samplelist.altitude(i) - samplelist.altitude(i+1) );
               //qDebug("analysis: position=(%d, %d)", samplelist->at(i)->position.x(),samplelist->at(i)->position.y() );
             }
           else
@@ -1468,7 +1505,7 @@ void Calculator::determineFlightStatus()
           // Can be positive or negation.
           totalDirChange += angDiff;
 
-          maxSpeed = qMax( maxSpeed, samplelist[i].vector.getSpeed().getMps() );
+          maxSpeed = qMax( maxSpeed, samplelist.speed(i) );
           totalAltChange += altChange;
           maxAltChange = qMax(abs(altChange), maxAltChange);
 
@@ -1484,12 +1521,12 @@ void Calculator::determineFlightStatus()
 #if 0
           qDebug("#Analysis(%d): angle1=%d, angle2=%d, angDiff=%d, speed=%f, alt1=%f, alt2=%f, altDiff=%d, tac=%d, tdc=%d, Vmax=%f",
                  i,
-                 samplelist[i].vector.getAngleDeg(),
-                 (i < samples - 1) ? samplelist[i+1].vector.getAngleDeg() : 0,
+                 samplelist.heading(i),
+                 (i < samples - 1) ? samplelist.heading(i+1) : 0,
                  angDiff,
-                 samplelist[i].vector.getSpeed().getMps(),
-                 samplelist[i].altitude.getMeters(),
-                 (i < samples - 1) ? samplelist[i+1].altitude.getMeters() : 0,
+                 samplelist.speed(i),
+                 samplelist.altitude(i),
+                 (i < samples - 1) ? samplelist.altitude(i+1) : 0,
                  altChange,
                  totalAltChange,
                  totalDirChange,
@@ -1517,7 +1554,7 @@ void Calculator::determineFlightStatus()
         {
           // Get the time difference between the first and the last sample.
           // This might not be the 20 secs we were planning to use at all!
-          timediff = samplelist[samples-1].time.secsTo(samplelist[0].time);
+          timediff = int( (samplelist.time(0) - samplelist.time(samples-1)) / 1000 );
 
           // So, we are not standing still, nor are we cruising. Circling then maybe?
           if ( abs(totalDirChange) > (MINTURNANGDIFF * timediff) )
@@ -1550,7 +1587,7 @@ void Calculator::determineFlightStatus()
           break_analysis = true;
 
           // save current heading for cruise check.
-          m_cruiseDirection = samplelist[0].vector.getAngleDeg();
+          m_cruiseDirection = samplelist.heading(0);
           // qDebug("-->Cruise direction: %d.", _cruiseDirection);
         }
     }
@@ -1558,7 +1595,7 @@ void Calculator::determineFlightStatus()
   if (flightMode != lastFlightMode)
     {
       lastFlightMode = flightMode;
-      samplelist[0].marker = ++m_marker;
+      samplelist.setMarker( 0, ++m_marker );
       newFlightMode( flightMode );
       // qDebug( "new FlightMode: %d", lastFlightMode );
     }
@@ -1573,7 +1610,7 @@ void Calculator::slot_GpsStatus(GpsNmea::GpsStatus newState)
   if (flightMode != lastFlightMode)
     {
       lastFlightMode       = flightMode;
-      samplelist[0].marker = ++m_marker;
+      samplelist.setMarker( 0, ++m_marker );
       // qDebug("new FlightMode: %d",lastFlightMode);
       newFlightMode(flightMode);
     }
@@ -1870,7 +1907,7 @@ bool Calculator::moving()
   const double SpeedLimit = GeneralConfig::instance()->getAutoLoggerStartSpeed() * 1000.0 / 3600.0;
   const int TimeLimit     = 5; // time limit in seconds
 
-  if( samplelist.size() <= TimeLimit )
+  if( samplelist.count() <= TimeLimit )
     {
       // We need to have some samples in order to be able to analyze speed.
       return false;
@@ -1879,9 +1916,9 @@ bool Calculator::moving()
   double speed = 0.0;
 
   // Note, that the newest samples are inserted at the list beginning.
-  for( int i = 0; i < TimeLimit && samplelist.size(); i++ )
+  for( int i = 0; i < TimeLimit && i < samplelist.count(); i++ )
     {
-      speed += samplelist[i].vector.getSpeed().getMps();
+      speed += samplelist.speed(i);
     }
 
   if( (speed / double(TimeLimit)) > SpeedLimit )
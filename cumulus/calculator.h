@@ -27,11 +27,11 @@
 #include "altitude.h"
 #include "basemapelement.h"
 #include "distance.h"
+#include "flightsamplelist.h"
 #include "flighttask.h"
 #include "generalconfig.h"
 #include "glider.h"
 #include "gpsnmea.h"
-#include "limitedlist.h"
 #include "polar.h"
 #include "reachablelist.h"
 #include "speed.h"
@@ -280,6 +280,15 @@ public:
     return lastTas;
   };
 
+  /**
+   * @return true, if the TAS is delivered by an external device. Otherwise
+   * it is estimated from the wind.
+   */
+  bool isTasMeasured() const
+  {
+    return ! m_calculateTas;
+  };
+
   /**
    * Read property of variometer setting.
    */
@@ -324,9 +333,9 @@ public:
   void setPosition(const QPoint& newPos);
 
   /**
-   * Contains a list of samples from the flight
+   * Contains the last samples from the flight, newest first.
    */
-  LimitedList<FlightSample> samplelist;
+  FlightSampleList samplelist;
 
   /**
    * Returns the current flight mode
@@ -363,6 +372,14 @@ public:
   bool glidePath(int aLastBearing, Distance aDistance,
                  Altitude aElevation, Altitude &arrival, Speed &BestSpeed );
 
+  /**
+   * Calculates the arrival altitudes and best speeds of many targets by one
+   * call regarding wind, McCready and last altitude.
+   *
+   * \return false, if no glider is defined
+   */
+  bool glidePaths( GlideTable::Target* targets, const int count );
+
   /**
    * \return the Glider Polar
    */
@@ -580,6 +597,11 @@ public:
    */
   void slot_Variometer(const Speed&);
 
+  /**
+   * Netto and relative variometer receiver and distributor to map display.
+   */
+  void slot_NettoVariometer(const Speed& netto, const Speed& relative);
+
   /**
    * A new altitude derived from the Android pressure sensor is delivered.
    * We use this value for the variometer calculation. The default variometer
@@ -761,6 +783,12 @@ public:
    */
   void newVario (const Speed&);
 
+  /**
+   * Sent if new netto and relative variometer values have been set. The
+   * values are invalid, if they cannot be calculated.
+   */
+  void newNettoVario (const Speed& netto, const Speed& relative);
+
   /**
    * Sent if a new wind has been obtained
    */
@@ -789,8 +817,11 @@ public:
   /**
    * Sent if a task point sector is touched. Will be used by the IGC
    * logger to increase logger sequence for a certain time.
+   *
+   * \param passageTime Interpolated UTC time of the passage. It is invalid,
+   *        if the position was not delivered by the GPS.
    */
-  void taskpointSectorTouched();
+  void taskpointSectorTouched( const QTime& passageTime );
 
   /** sent on activate/deactivate of manualInFlight mode */
   void switchManualInFlight();
@@ -899,6 +930,10 @@ private: // Private attributes
   bool m_calculateTas;
   /** Contains the last variometer value */
   Speed lastVario;
+  /** Contains the last netto variometer value */
+  Speed lastNetto;
+  /** Contains the last relative variometer value */
+  Speed lastRelative;
   /** Contains the last known glide path information */
   Altitude lastGlidePath;
   /** Contains the last known altitude */
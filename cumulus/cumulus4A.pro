@@ -120,6 +120,7 @@ HEADERS = \
     airregion.h \
     airspace.h \
     AirspaceHelper.h \
+    airspaceindex.h \
     airspacewarningdistance.h \
     altimeterdialog.h \
     altitude.h \
@@ -134,7 +135,9 @@ HEADERS = \
     datatypes.h \
     distance.h \
     elevationcolorimage.h \
+    elevationindex.h \
     filetools.h \
+    flightsamplelist.h \
     flighttask.h \
     fontdialog.h \
     generalconfig.h \
@@ -142,6 +145,7 @@ HEADERS = \
     glider.h \
     gliderlistwidget.h \
     GliderSelectionList.h \
+    glidetable.h \
     gpsconandroid.h \
     gpsnmea.h \
     gpsstatusdialog.h \
@@ -150,7 +154,6 @@ HEADERS = \
     igclogger.h \
     interfaceelements.h \
     isohypse.h \
-    isolist.h \
     jnisupport.h \
     layout.h \
     limitedlist.h \
@@ -158,6 +161,7 @@ HEADERS = \
     listviewfilter.h \
     ListViewTabs.h \
     listwidgetparent.h \
+    loaderpool.h \
     logbook.h \
     mainwindow.h \
     mapcalc.h \
@@ -166,15 +170,19 @@ HEADERS = \
     mapdefaults.h \
     map.h \
     mapinfobox.h \
+    maplabellayout.h \
     mapmatrix.h \
     mapview.h \
     messagehandler.h \
     messagewidget.h \
     multilayout.h \
+    nmeatokenizer.h \
     OpenAip.h \
     OpenAipLoaderThread.h \
     OpenAipPoiLoader.h \
     openairparser.h \
+    pointcache.h \
+    pointlistmodel.h \
     PointListView.h \
     polardialog.h \
     polar.h \
@@ -194,7 +202,9 @@ HEADERS = \
     RadioPointListWidget.h \
     reachablelist.h \
     reachablepoint.h \
+    reachpointlistmodel.h \
     reachpointlistview.h \
+    replaybenchmark.h \
     resource.h \
     rowdelegate.h \
     runway.h \
@@ -216,6 +226,8 @@ HEADERS = \
     settingspageunits.h \
     signalhandler.h \
     singlepoint.h \
+    singlepointlistmodel.h \
+    siteindex.h \
     sonne.h \
     sound.h \
     speed.h \
@@ -228,6 +240,7 @@ HEADERS = \
     taskpoint.h \
     taskpointeditor.h \
     taskpointtypes.h \
+    tilecache.h \
     time_cu.h \
     tpinfowidget.h \
     vario.h \
@@ -237,6 +250,8 @@ HEADERS = \
     waitscreen.h \
     waypointcatalog.h \
     waypoint.h \
+    waypointindex.h \
+    waypointlistmodel.h \
     waypointlistview.h \
     waypointlistwidget.h \
     welt2000.h \
@@ -258,6 +273,7 @@ SOURCES = \
     airregion.cpp \
     airspace.cpp \
     AirspaceHelper.cpp \
+    airspaceindex.cpp \
     altimeterdialog.cpp \
     altitude.cpp \
     androidstyle.cpp \
@@ -270,7 +286,9 @@ SOURCES = \
     CuLabel.cpp \
     distance.cpp \
     elevationcolorimage.cpp \
+    elevationindex.cpp \
     filetools.cpp \
+    flightsamplelist.cpp \
     flighttask.cpp \
     fontdialog.cpp \
     generalconfig.cpp \
@@ -278,6 +296,7 @@ SOURCES = \
     gliderflightdialog.cpp \
     gliderlistwidget.cpp \
     GliderSelectionList.cpp \
+    glidetable.cpp \
     gpsconandroid.cpp \
     gpsnmea.cpp \
     gpsstatusdialog.cpp \
@@ -285,13 +304,13 @@ SOURCES = \
     hwinfo.cpp \
     igclogger.cpp \
     isohypse.cpp \
-    isolist.cpp \
     jnisupport.cpp \
     layout.cpp \
     lineelement.cpp \
     listviewfilter.cpp \
     ListViewTabs.cpp \
     listwidgetparent.cpp \
+    loaderpool.cpp \
     logbook.cpp \
     main.cpp \
     mainwindow.cpp \
@@ -300,14 +319,18 @@ SOURCES = \
     mapcontents.cpp \
     map.cpp \
     mapinfobox.cpp \
+    maplabellayout.cpp \
     mapmatrix.cpp \
     mapview.cpp \
     messagehandler.cpp \
     messagewidget.cpp \
+    nmeatokenizer.cpp \
     OpenAip.cpp \
     OpenAipLoaderThread.cpp \
     OpenAipPoiLoader.cpp \
     openairparser.cpp \
+    pointcache.cpp \
+    pointlistmodel.cpp \
     PointListView.cpp \
     polar.cpp \
     polardialog.cpp \
@@ -326,7 +349,9 @@ SOURCES = \
     RadioPointListWidget.cpp \
     reachablelist.cpp \
     reachablepoint.cpp \
+    reachpointlistmodel.cpp \
     reachpointlistview.cpp \
+    replaybenchmark.cpp \
     rowdelegate.cpp \
     runway.cpp \
     SinglePointListWidget.cpp \
@@ -347,6 +372,8 @@ SOURCES = \
     settingspageunits.cpp \
     signalhandler.cpp \
     singlepoint.cpp \
+    singlepointlistmodel.cpp \
+    siteindex.cpp \
     sonne.cpp \
     sound.cpp \
     speed.cpp \
@@ -357,6 +384,7 @@ SOURCES = \
     tasklistview.cpp \
     taskpoint.cpp \
     taskpointeditor.cpp \
+    tilecache.cpp \
     time_cu.cpp \
     tpinfowidget.cpp \
     vario.cpp \
@@ -366,6 +394,8 @@ SOURCES = \
     waitscreen.cpp \
     waypointcatalog.cpp \
     waypoint.cpp \
+    waypointindex.cpp \
+    waypointlistmodel.cpp \
     waypointlistview.cpp \
     waypointlistwidget.cpp \
     welt2000.cpp \
@@ -391,6 +421,7 @@ flarm {
                flarmdisplay.h \
                flarmlistview.h \
                flarmradarview.h \
+               flarmtraffictable.h \
                flarmwidget.h \
                preflightflarmpage.h \
                flarmlogbook.h
@@ -404,6 +435,7 @@ flarm {
                flarmdisplay.cpp \
                flarmlistview.cpp \
                flarmradarview.cpp \
+               flarmtraffictable.cpp \
                flarmwidget.cpp \
                preflightflarmpage.cpp \
                flarmlogbook.cpp
@@ -53,6 +53,7 @@ HEADERS = \
     airregion.h \
     airspace.h \
     AirspaceHelper.h \
+    airspaceindex.h \
     airspacewarningdistance.h \
     altimeterdialog.h \
     altitude.h \
@@ -65,7 +66,9 @@ HEADERS = \
     datatypes.h \
     distance.h \
     elevationcolorimage.h \
+    elevationindex.h \
     filetools.h \
+    flightsamplelist.h \
     flighttask.h \
     fontdialog.h \
     generalconfig.h \
@@ -73,6 +76,7 @@ HEADERS = \
     glider.h \
     gliderlistwidget.h \
     GliderSelectionList.h \
+    glidetable.h \
     gpscon.h \
     gpsnmea.h \
     gpsstatusdialog.h \
@@ -82,13 +86,13 @@ HEADERS = \
     interfaceelements.h \
     ipc.h \
     isohypse.h \
-    isolist.h \
     layout.h \
     limitedlist.h \
     lineelement.h \
     listviewfilter.h \
     ListViewTabs.h \
     listwidgetparent.h \
+    loaderpool.h \
     logbook.h \
     maemostyle.h \
     mainwindow.h \
@@ -98,15 +102,19 @@ HEADERS = \
     mapdefaults.h \
     map.h \
     mapinfobox.h \
+    maplabellayout.h \
     mapmatrix.h \
     mapview.h \
     messagehandler.h \
     messagewidget.h \
     multilayout.h \
+    nmeatokenizer.h \
     OpenAip.h \
     OpenAipLoaderThread.h \
     OpenAipPoiLoader.h \
     openairparser.h \
+    pointcache.h \
+    pointlistmodel.h \
     PointListView.h \
     polardialog.h \
     polar.h \
@@ -125,7 +133,9 @@ HEADERS = \
     RadioPointListWidget.h \
     reachablelist.h \
     reachablepoint.h \
+    reachpointlistmodel.h \
     reachpointlistview.h \
+    replaybenchmark.h \
     resource.h \
     rowdelegate.h \
     runway.h \
@@ -147,6 +157,8 @@ HEADERS = \
     settingspageunits.h \
     signalhandler.h \
     singlepoint.h \
+    singlepointlistmodel.h \
+    siteindex.h \
     sonne.h \
     sound.h \
     speed.h \
@@ -159,6 +171,7 @@ HEADERS = \
     taskpointeditor.h \
     taskpointtypes.h \
     taskpoint.h \
+    tilecache.h \
     time_cu.h \
     tpinfowidget.h \
     vario.h \
@@ -168,6 +181,8 @@ HEADERS = \
     waitscreen.h \
     waypointcatalog.h \
     waypoint.h \
+    waypointindex.h \
+    waypointlistmodel.h \
     waypointlistview.h \
     waypointlistwidget.h \
     welt2000.h \
@@ -189,6 +204,7 @@ SOURCES = \
     airregion.cpp \
     airspace.cpp \
     AirspaceHelper.cpp \    
+    airspaceindex.cpp \
     altimeterdialog.cpp \
     altitude.cpp \
     authdialog.cpp \
@@ -200,7 +216,9 @@ SOURCES = \
     CuLabel.cpp \
     distance.cpp \
     elevationcolorimage.cpp \
+    elevationindex.cpp \
     filetools.cpp \
+    flightsamplelist.cpp \
     flighttask.cpp \
     fontdialog.cpp \
     generalconfig.cpp \
@@ -208,6 +226,7 @@ SOURCES = \
     gliderflightdialog.cpp \
     gliderlistwidget.cpp \
     GliderSelectionList.cpp \
+    glidetable.cpp \
     gpscon.cpp \
     gpsnmea.cpp \
     gpsstatusdialog.cpp \
@@ -216,12 +235,12 @@ SOURCES = \
     igclogger.cpp \
     ipc.cpp \
     isohypse.cpp \
-    isolist.cpp \
     layout.cpp \
     lineelement.cpp \
     listviewfilter.cpp \
     ListViewTabs.cpp \
     listwidgetparent.cpp \
+    loaderpool.cpp \
     logbook.cpp \
     maemostyle.cpp \
     main.cpp \
@@ -231,14 +250,18 @@ SOURCES = \
     mapcontents.cpp \
     map.cpp \
     mapinfobox.cpp \
+    maplabellayout.cpp \
     mapmatrix.cpp \
     mapview.cpp \
     messagehandler.cpp \
     messagewidget.cpp \
+    nmeatokenizer.cpp \
     OpenAip.cpp \
     OpenAipLoaderThread.cpp \
     OpenAipPoiLoader.cpp \
     openairparser.cpp \
+    pointcache.cpp \
+    pointlistmodel.cpp \
     PointListView.cpp \
     polar.cpp \
     polardialog.cpp \
@@ -256,7 +279,9 @@ SOURCES = \
     RadioPointListWidget.cpp \
     reachablelist.cpp \
     reachablepoint.cpp \
+    reachpointlistmodel.cpp \
     reachpointlistview.cpp \
+    replaybenchmark.cpp \
     rowdelegate.cpp \
     runway.cpp \
     SinglePointListWidget.cpp \
@@ -277,6 +302,8 @@ SOURCES = \
     settingspageunits.cpp \
     signalhandler.cpp \
     singlepoint.cpp \
+    singlepointlistmodel.cpp \
+    siteindex.cpp \
     sonne.cpp \
     sound.cpp \
     speed.cpp \
@@ -287,6 +314,7 @@ SOURCES = \
     tasklistview.cpp \
     taskpoint.cpp \
     taskpointeditor.cpp \
+    tilecache.cpp \
     time_cu.cpp \
     tpinfowidget.cpp \
     vario.cpp \
@@ -296,6 +324,8 @@ SOURCES = \
     waitscreen.cpp \
     waypointcatalog.cpp \
     waypoint.cpp \
+    waypointindex.cpp \
+    waypointlistmodel.cpp \
     waypointlistview.cpp \
     waypointlistwidget.cpp \
     welt2000.cpp \
@@ -317,6 +347,7 @@ flarm {
 		           flarmlistview.h \
 		           flarmlogbook.h \
 		           flarmradarview.h \
+		           flarmtraffictable.h \
 		           flarmwidget.h \
 		           preflightflarmpage.h
 		           
@@ -327,6 +358,7 @@ flarm {
 		           flarmlistview.cpp \
 		           flarmlogbook.cpp \
 		           flarmradarview.cpp \
+		           flarmtraffictable.cpp \
 		           flarmwidget.cpp \
 		           preflightflarmpage.cpp
 		           
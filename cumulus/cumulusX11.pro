@@ -89,6 +89,7 @@ HEADERS = \
     airregion.h \
     airspace.h \
     AirspaceHelper.h \
+    airspaceindex.h \
     airspacewarningdistance.h \
     altimeterdialog.h \
     altitude.h \
@@ -101,7 +102,9 @@ HEADERS = \
     datatypes.h \
     distance.h \
     elevationcolorimage.h \
+    elevationindex.h \
     filetools.h \
+    flightsamplelist.h \
     flighttask.h \
     fontdialog.h \
     generalconfig.h \
@@ -109,6 +112,7 @@ HEADERS = \
     glider.h \
     gliderlistwidget.h \
     GliderSelectionList.h \
+    glidetable.h \
     gpscon.h \
     gpsnmea.h \
     gpsstatusdialog.h \
@@ -118,13 +122,13 @@ HEADERS = \
     interfaceelements.h \
     ipc.h \
     isohypse.h \
-    isolist.h \
     layout.h \
     limitedlist.h \
     lineelement.h \
     listviewfilter.h \
     ListViewTabs.h \
     listwidgetparent.h \
+    loaderpool.h \
     logbook.h \
     mainwindow.h \
     mapcalc.h \
@@ -133,15 +137,19 @@ HEADERS = \
     mapdefaults.h \
     map.h \
     mapinfobox.h \
+    maplabellayout.h \
     mapmatrix.h \
     mapview.h \
     messagehandler.h \
     messagewidget.h \
     multilayout.h \
+    nmeatokenizer.h \
     OpenAip.h \
     OpenAipPoiLoader.h \
     OpenAipLoaderThread.h \
     openairparser.h \
+    pointcache.h \
+    pointlistmodel.h \
     PointListView.h \
     polardialog.h \
     polar.h \
@@ -160,7 +168,9 @@ HEADERS = \
     RadioPointListWidget.h \
     reachablelist.h \
     reachablepoint.h \
+    reachpointlistmodel.h \
     reachpointlistview.h \
+    replaybenchmark.h \
     resource.h \
     rowdelegate.h \
     runway.h \
@@ -182,6 +192,8 @@ HEADERS = \
     settingspageunits.h \
     signalhandler.h \
     singlepoint.h \
+    singlepointlistmodel.h \
+    siteindex.h \
     sonne.h \
     sound.h \
     speed.h \
@@ -194,6 +206,7 @@ HEADERS = \
     taskpointeditor.h \
     taskpoint.h \
     taskpointtypes.h \
+    tilecache.h \
     time_cu.h \
     tpinfowidget.h \
     vario.h \
@@ -203,6 +216,8 @@ HEADERS = \
     waitscreen.h \
     waypointcatalog.h \
     waypoint.h \
+    waypointindex.h \
+    waypointlistmodel.h \
     waypointlistview.h \
     waypointlistwidget.h \
     welt2000.h \
@@ -224,6 +239,7 @@ SOURCES = \
     airregion.cpp \
     airspace.cpp \
     AirspaceHelper.cpp \
+    airspaceindex.cpp \
     altimeterdialog.cpp \
     altitude.cpp \
     authdialog.cpp \
@@ -235,7 +251,9 @@ SOURCES = \
     CuLabel.cpp \
     distance.cpp \
     elevationcolorimage.cpp \
+    elevationindex.cpp \
     filetools.cpp \
+    flightsamplelist.cpp \
     flighttask.cpp \
     fontdialog.cpp \
     generalconfig.cpp \
@@ -243,6 +261,7 @@ SOURCES = \
     gliderflightdialog.cpp \
     gliderlistwidget.cpp \
     GliderSelectionList.cpp \
+    glidetable.cpp \
     gpscon.cpp \
     gpsnmea.cpp \
     gpsstatusdialog.cpp \
@@ -251,12 +270,12 @@ SOURCES = \
     igclogger.cpp \
     ipc.cpp \
     isohypse.cpp \
-    isolist.cpp \
     layout.cpp \
     lineelement.cpp \
     listviewfilter.cpp \
     ListViewTabs.cpp \
     listwidgetparent.cpp \
+    loaderpool.cpp \
     logbook.cpp \
     main.cpp \
     mainwindow.cpp \
@@ -265,14 +284,18 @@ SOURCES = \
     mapcontents.cpp \
     map.cpp \
     mapinfobox.cpp \
+    maplabellayout.cpp \
     mapmatrix.cpp \
     mapview.cpp \
     messagehandler.cpp \
     messagewidget.cpp \
+    nmeatokenizer.cpp \
     OpenAip.cpp \
     OpenAipPoiLoader.cpp \
     OpenAipLoaderThread.cpp \
     openairparser.cpp \
+    pointcache.cpp \
+    pointlistmodel.cpp \
     PointListView.cpp \
     polar.cpp \
     polardialog.cpp \
@@ -290,7 +313,9 @@ SOURCES = \
     RadioPointListWidget.cpp \
     reachablelist.cpp \
     reachablepoint.cpp \
+    reachpointlistmodel.cpp \
     reachpointlistview.cpp \
+    replaybenchmark.cpp \
     rowdelegate.cpp \
     runway.cpp \
     SinglePointListWidget.cpp \
@@ -311,6 +336,8 @@ SOURCES = \
     settingspageunits.cpp \
     signalhandler.cpp \
     singlepoint.cpp \
+    singlepointlistmodel.cpp \
+    siteindex.cpp \
     sonne.cpp \
     sound.cpp \
     speed.cpp \
@@ -321,6 +348,7 @@ SOURCES = \
     tasklistview.cpp \
     taskpoint.cpp \
     taskpointeditor.cpp \
+    tilecache.cpp \
     time_cu.cpp \
     tpinfowidget.cpp \
     vario.cpp \
@@ -330,6 +358,8 @@ SOURCES = \
     waitscreen.cpp \
     waypointcatalog.cpp \
     waypoint.cpp \
+    waypointindex.cpp \
+    waypointlistmodel.cpp \
     waypointlistview.cpp \
     waypointlistwidget.cpp \
     welt2000.cpp \
@@ -353,6 +383,7 @@ flarm {
 		           flarmlistview.h \
 		           flarmlogbook.h \
 		           flarmradarview.h \
+		           flarmtraffictable.h \
 		           flarmwidget.h \
 		           preflightflarmpage.h
 
@@ -363,6 +394,7 @@ flarm {
 		           flarmlistview.cpp \
                flarmlogbook.cpp \
 		           flarmradarview.cpp \
+		           flarmtraffictable.cpp \
 		           flarmwidget.cpp \
 		           preflightflarmpage.cpp
 }
@@ -0,0 +1,191 @@
+/***********************************************************************
+ **
+ **   elevationindex.cpp
+ **
+ **   This file is part of Cumulus.
+ **
+ ************************************************************************
+ **
+ **   Copyright (c):  2026 by the Cumulus contributors
+ **
+ **   This file is distributed under the terms of the General Public
+ **   License. See the file COPYING for more information.
+ **
+ ***********************************************************************/
+
+#include <algorithm>
+
+#include "elevationindex.h"
+
+ElevationIndex::ElevationIndex()
+{
+}
+
+ElevationIndex::~ElevationIndex()
+{
+}
+
+void ElevationIndex::addIsohypse( const int tile,
+                                  const QPolygon& polygon,
+                                  const short elevation )
+{
+  if( polygon.size() < 3 )
+    {
+      return;
+    }
+
+  Tile& t = m_tiles[tile];
+
+  Entry entry( polygon, elevation );
+
+  t.bBox = t.bBox.isValid() ? t.bBox.united( entry.bBox ) : entry.bBox;
+  t.entries.append( entry );
+}
+
+void ElevationIndex::finishTile( const int tile )
+{
+  QMap<int, Tile>::iterator it = m_tiles.find( tile );
+
+  if( it == m_tiles.end() )
+    {
+      return;
+    }
+
+  Tile& t = it.value();
+
+  std::stable_sort( t.entries.begin(), t.entries.end() );
+
+  t.cells.clear();
+  t.cells.resize( GridSize * GridSize );
+
+  // Register every polygon in all cells overlapped by its bounding box.
+  // Because the entries are sorted, the cell lists are sorted too.
+  for( int i = 0; i < t.entries.size(); i++ )
+    {
+      const QRect& box = t.entries.at(i).bBox;
+
+      int c1 = cellIndex( t, box.topLeft() );
+      int c2 = cellIndex( t, box.bottomRight() );
+
+      if( c1 < 0 || c2 < 0 )
+        {
+          continue;
+        }
+
+      for( int row = c1 / GridSize; row <= c2 / GridSize; row++ )
+        {
+          for( int col = c1 % GridSize; col <= c2 % GridSize; col++ )
+            {
+              t.cells[row * GridSize + col].append( i );
+            }
+        }
+    }
+
+  for( int i = 0; i < t.cells.size(); i++ )
+    {
+      t.cells[i].squeeze();
+    }
+}
+
+void ElevationIndex::retainTiles( const QSet<int>& tiles )
+{
+  QMap<int, Tile>::iterator it = m_tiles.begin();
+
+  while( it != m_tiles.end() )
+    {
+      if( tiles.contains( it.key() ) )
+        {
+          ++it;
+          continue;
+        }
+
+      it = m_tiles.erase( it );
+    }
+}
+
+qint64 ElevationIndex::usedBytes( const int tile ) const
+{
+  QMap<int, Tile>::const_iterator it = m_tiles.constFind( tile );
+
+  if( it == m_tiles.constEnd() )
+    {
+      return 0;
+    }
+
+  qint64 bytes = 0;
+
+  for( int i = 0; i < it.value().entries.size(); i++ )
+    {
+      bytes += sizeof(Entry) + it.value().entries.at(i).polygon.size() * sizeof(QPoint);
+    }
+
+  return bytes;
+}
+
+void ElevationIndex::clear()
+{
+  m_tiles.clear();
+}
+
+int ElevationIndex::cellIndex( const Tile& tile, const QPoint& point ) const
+{
+  if( tile.bBox.contains( point ) == false )
+    {
+      return -1;
+    }
+
+  qint64 col = qint64( point.x() - tile.bBox.left() ) * GridSize / ( qint64( tile.bBox.width() ) );
+  qint64 row = qint64( point.y() - tile.bBox.top() ) * GridSize / ( qint64( tile.bBox.height() ) );
+
+  col = qMin( col, qint64(GridSize - 1) );
+  row = qMin( row, qint64(GridSize - 1) );
+
+  return int(row) * GridSize + int(col);
+}
+
+bool ElevationIndex::findElevation( const QPoint& point, int& elevation ) const
+{
+  bool covered = false;
+
+  elevation = 0;
+
+  // Isohypses are clipped at the tile borders but the projected tile boxes
+  // can overlap. Therefore all tiles covering the point are asked.
+  QMap<int, Tile>::const_iterator it;
+
+  for( it = m_tiles.constBegin(); it != m_tiles.constEnd(); ++it )
+    {
+      const Tile& tile = it.value();
+
+      int cell = cellIndex( tile, point );
+
+      if( cell < 0 || tile.cells.isEmpty() )
+        {
+          continue;
+        }
+
+      covered = true;
+
+      const QVector<int>& candidates = tile.cells.at( cell );
+
+      for( int i = 0; i < candidates.size(); i++ )
+        {
+          const Entry& entry = tile.entries.at( candidates.at(i) );
+
+          if( entry.elevation <= elevation )
+            {
+              // Candidates are sorted, no higher level can follow.
+              break;
+            }
+
+          if( entry.bBox.contains( point ) &&
+              entry.polygon.containsPoint( point, Qt::OddEvenFill ) )
+            {
+              elevation = entry.elevation;
+              break;
+            }
+        }
+    }
+
+  return covered;
+}
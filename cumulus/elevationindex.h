@@ -0,0 +1,145 @@
+/***********************************************************************
+ **
+ **   elevationindex.h
+ **
+ **   This file is part of Cumulus.
+ **
+ ************************************************************************
+ **
+ **   Copyright (c):  2026 by the Cumulus contributors
+ **
+ **   This file is distributed under the terms of the General Public
+ **   License. See the file COPYING for more information.
+ **
+ ***********************************************************************/
+
+#ifndef ELEVATION_INDEX_H
+#define ELEVATION_INDEX_H
+
+#include <QMap>
+#include <QPoint>
+#include <QPolygon>
+#include <QRect>
+#include <QSet>
+#include <QVector>
+
+/**
+ * \class ElevationIndex
+ *
+ * \author Cumulus contributors
+ *
+ * \brief Render independent index over the loaded isohypse polygons.
+ *
+ * The index is filled by the map loader with the projected isohypse
+ * polygons of every terrain and ground tile. It is completely independent
+ * of the map drawing, the current zoom level and the screen transformation,
+ * so elevation queries can be answered for every loaded position at any
+ * time, also while the map is redrawn.
+ *
+ * Every tile is divided into a coarse grid. Each grid cell stores the
+ * indices of the polygons overlapping it, sorted by descending elevation.
+ * A point query looks up its cell and tests only these candidates. The
+ * highest polygon containing the point defines the elevation.
+ *
+ * \date 2026
+ */
+class ElevationIndex
+{
+ public:
+
+  ElevationIndex();
+
+  virtual ~ElevationIndex();
+
+  /**
+   * Adds an isohypse polygon to the index of the given tile. After all
+   * polygons of a tile have been added, \ref finishTile must be called.
+   *
+   * @param tile The tile section identifier
+   * @param polygon The projected polygon of the isohypse
+   * @param elevation The elevation of the isohypse in meters
+   */
+  void addIsohypse( const int tile, const QPolygon& polygon, const short elevation );
+
+  /**
+   * Sorts the polygons of the tile and builds its cell grid.
+   *
+   * @param tile The tile section identifier
+   */
+  void finishTile( const int tile );
+
+  /**
+   * Removes all tiles from the index, which are not contained in the
+   * passed tile set.
+   *
+   * @param tiles Set of tile section identifiers to be kept
+   */
+  void retainTiles( const QSet<int>& tiles );
+
+  /**
+   * @param tile The tile section identifier
+   * @return The estimated number of bytes used by the polygons of the tile.
+   */
+  qint64 usedBytes( const int tile ) const;
+
+  /**
+   * Removes all tiles from the index.
+   */
+  void clear();
+
+  /**
+   * Looks up the elevation at the given projected position.
+   *
+   * @param point Position in projected map coordinates
+   * @param elevation The elevation of the highest isohypse containing the point
+   * @return true, if a loaded tile covers the point otherwise false
+   */
+  bool findElevation( const QPoint& point, int& elevation ) const;
+
+ private:
+
+  /** Number of grid cells per tile in each direction. */
+  enum { GridSize = 16 };
+
+  class Entry
+  {
+   public:
+
+    Entry() : elevation(0) {};
+
+    Entry( const QPolygon& p, const short e ) :
+      polygon(p),
+      bBox(p.boundingRect()),
+      elevation(e)
+    {};
+
+    bool operator < (const Entry& other) const
+    {
+      // highest elevation first
+      return elevation > other.elevation;
+    };
+
+    QPolygon polygon;
+    QRect bBox;
+    short elevation;
+  };
+
+  class Tile
+  {
+   public:
+
+    QRect bBox;
+    QVector<Entry> entries;
+    QVector< QVector<int> > cells;
+  };
+
+  /**
+   * Returns the grid cell index of the point in the tile or -1.
+   */
+  int cellIndex( const Tile& tile, const QPoint& point ) const;
+
+  /** Indexed tiles, the tile section identifier is the key. */
+  QMap<int, Tile> m_tiles;
+};
+
+#endif
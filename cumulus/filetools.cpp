@@ -15,6 +15,7 @@
  ***********************************************************************/
 
 #include <QtGlobal>
+#include <QIODevice>
 #include <QRect>
 
 #include "filetools.h"
@@ -146,11 +147,21 @@ void ShortLoad(QDataStream & s, QPolygon& a)
       s >> topLeft;
       s >> pointcount;
 
+      // A corrupted point count must not lead to a huge allocation.
+      if( s.status() != QDataStream::Ok ||
+          ( s.device() && pointcount > s.device()->bytesAvailable() / 4 ) )
+        {
+          return;
+        }
+
+      // Allocate the polygon once instead of growing it point by point.
+      a.resize( pointcount );
+
       for (uint i = 0; i < pointcount; i++)
         {
           s >> px2;
           s >> py2;
-          a.append( QPoint(px2, py2) );
+          a[i] = QPoint(px2, py2);
         }
 
       a.translate(topLeft.x(), topLeft.y()); //translate back to original coordinates
@@ -161,11 +172,19 @@ void ShortLoad(QDataStream & s, QPolygon& a)
       s >> topLeft;
       s >> pointcount;
 
+      if( s.status() != QDataStream::Ok ||
+          ( s.device() && pointcount > s.device()->bytesAvailable() / 2 ) )
+        {
+          return;
+        }
+
+      a.resize( pointcount );
+
       for (uint i = 0; i < pointcount; i++)
         {
           s >> px1;
           s >> py1;
-          a.append( QPoint(px1, py1) );
+          a[i] = QPoint(px1, py1);
         }
 
       a.translate(topLeft.x(), topLeft.y()); //translate back to original coordinates
@@ -21,8 +21,10 @@
 #include "flarm.h"
 #include "flarmdisplay.h"
 #include "flarmaliaslist.h"
+#include "flarmtraffictable.h"
 #include "generalconfig.h"
 #include "layout.h"
+#include "nmeatokenizer.h"
 
 Flarm::Flarm(QObject* parent) : QObject(parent), FlarmBase()
 {
@@ -141,9 +143,9 @@ bool Flarm::extractPflau( const QStringList& stringList )
 /**
  * Extracts all items from the $PFLAA sentence sent by the Flarm device.
  */
-bool Flarm::extractPflaa( const QStringList& stringList, FlarmAcft& aircraft )
+bool Flarm::extractPflaa( const NmeaTokenizer& tok, FlarmAcft& aircraft )
 {
-  if ( stringList[0] != "$PFLAA" || stringList.size() < 12 )
+  if ( tok.sentenceId() != NmeaTokenizer::PFLAA || tok.count() < 12 )
     {
       qWarning("$PFLAA contains too less parameters!");
       return false;
@@ -164,104 +166,66 @@ bool Flarm::extractPflaa( const QStringList& stringList, FlarmAcft& aircraft )
     11: <AcftType>
   */
 
-  bool ok;
+  int iValue;
 
-  aircraft.TimeStamp = QTime::currentTime();
+  aircraft.TimeStamp = FlarmTrafficTable::now();
 
   // AlarmLevel
-  aircraft.Alarm = static_cast<enum AlarmLevel> (stringList[1].toInt( &ok ));
+  aircraft.Alarm = tok.toInt( 1, iValue ) ? static_cast<enum AlarmLevel> (iValue) : No;
 
-  if( ! ok )
-    {
-      aircraft.Alarm = No;
-    }
-
-  aircraft.RelativeNorth = stringList[2].toInt( &ok );
-
-  if( ! ok )
+  if( ! tok.toInt( 2, aircraft.RelativeNorth ) )
     {
       aircraft.RelativeNorth = INT_MIN;
     }
 
-  aircraft.RelativeEast = stringList[3].toInt( &ok );
-
-  if( ! ok )
+  if( ! tok.toInt( 3, aircraft.RelativeEast ) )
     {
       aircraft.RelativeEast = INT_MIN;
     }
 
-  aircraft.RelativeVertical = stringList[4].toInt( &ok );
-
-  if( ! ok )
+  if( ! tok.toInt( 4, aircraft.RelativeVertical ) )
     {
       aircraft.RelativeVertical = INT_MIN;
     }
 
-  aircraft.IdType = stringList[5].toShort( &ok );
+  aircraft.IdType = tok.toInt( 5, iValue ) ? short( iValue ) : 0;
 
-  if( ! ok )
-    {
-      aircraft.IdType = 0;
-    }
-
-  aircraft.ID = stringList[6];
+  aircraft.ID = tok.toString( 6 );
 
   // 0-359 or INT_MIN in stealth mode
-  aircraft.Track = stringList[7].toInt( &ok );
-
-  if( ! ok )
+  if( ! tok.toInt( 7, aircraft.Track ) )
     {
       aircraft.Track = INT_MIN;
     }
 
   // degrees per second or INT_MIN in stealth mode
-  aircraft.TurnRate = stringList[8].toDouble( &ok );
-
-  if( ! ok )
+  if( ! tok.toDouble( 8, aircraft.TurnRate ) )
     {
       aircraft.TurnRate = INT_MIN;
     }
 
   // meters per second or INT_MIN in stealth mode
-  aircraft.GroundSpeed = stringList[9].toDouble( &ok );
-
-  if( ! ok )
+  if( ! tok.toDouble( 9, aircraft.GroundSpeed ) )
     {
       aircraft.GroundSpeed = INT_MIN;
     }
 
   // meters per second or INT_MIN in stealth mode
-  aircraft.ClimbRate = stringList[10].toDouble( &ok );
-
-  if( ! ok )
+  if( ! tok.toDouble( 10, aircraft.ClimbRate ) )
     {
       aircraft.ClimbRate = INT_MIN;
     }
 
-  aircraft.AcftType = stringList[11].toShort( &ok );
-
-  if( ! ok )
-    {
-      aircraft.AcftType = 0; // unknown
-    }
+  aircraft.AcftType = tok.toInt( 11, iValue ) ? short( iValue ) : 0; // 0 = unknown
 
   // Check, if parsed data should be collected. In this case the data record
-  // is put or updated in the pflaaHash hash dictionary.
-  QString key = createHashKey( aircraft.IdType, aircraft.ID );
-
-  if( m_collectPflaa == true || key == FlarmDisplay::getSelectedObject() )
+  // is put or updated in the traffic table. It is published at the end of
+  // the PFLAA burst.
+  if( m_collectPflaa == true || aircraft.ID == FlarmDisplay::getSelectedObject() )
     {
-      // first check, if record is already contained in the hash.
-      if( m_pflaaHash.contains( key ) == true )
-        {
-          // update entry
-          FlarmAcft& aircraftEntry = m_pflaaHash[key];
-          aircraftEntry = aircraft;
-        }
-      else
+      if( m_trafficTable.update( aircraft ) == false )
         {
-          // insert new entry
-          m_pflaaHash.insert( key, aircraft );
+          qWarning() << "Flarm: Traffic table is full, ignoring" << aircraft.ID;
         }
     }
 
@@ -621,26 +585,15 @@ bool Flarm::getFlarmRelativeDistance( int &relativeDistance )
  */
 void Flarm::collectPflaaFinished()
 {
-  // Check the hash dictionary for expired data. This old data items have to
+  // Check the traffic table for expired data. This old data items have to
   // be removed. Seems to be the best place, to do it after the end trigger as
-  // to trust that following methods will do that.
-  QMutableHashIterator<QString, Flarm::FlarmAcft> it(m_pflaaHash);
-
-  while( it.hasNext() )
-    {
-      it.next();
+  // to trust that following methods will do that. Objects, which were not
+  // updated within 3s, are removed. No other way available as the time
+  // expire check.
+  m_trafficTable.expire( 3000 );
 
-      // Get next aircraft
-      Flarm::FlarmAcft& acft = it.value();
-
-      // Make time expire check, check time unit is in milli seconds.
-      if( acft.TimeStamp.elapsed() > 3000 )
-        {
-          // Object was longer time not updated, so we do remove it from the
-          // hash. No other way available as the time expire check.
-          it.remove();
-        }
-    }
+  // Make the collected data visible to the readers.
+  m_trafficTable.publish();
 
   // Start Flarm PFLAA data clearing supervision. There is no other way
   // of solution because the PFLAA sentences are only sent if other
@@ -657,7 +610,7 @@ void Flarm::collectPflaaFinished()
 /** Called if timer has expired. Used for Flarm PFLAA data clearing. */
 void Flarm::slotTimeout()
 {
-  m_pflaaHash.clear();
+  m_trafficTable.clear();
 
   // Emit signal, if further processing in radar view is required.
   if( Flarm::getCollectPflaa() )
@@ -36,6 +36,7 @@
 
 #include "flarmbase.h"
 
+class NmeaTokenizer;
 class QPoint;
 class QStringList;
 class QTimer;
@@ -99,11 +100,11 @@ class Flarm : public QObject, public FlarmBase
   /**
    * Extracts all items from the $PFLAA sentence sent by the Flarm device.
    *
-   * @param stringList Flarm sentence $PFLAA as string list
+   * @param tok Flarm sentence $PFLAA split by the tokenizer
    * @param aircraft extracted aircraft data from sentence
    * @return true if a valid value exists otherwise false
    */
-  bool extractPflaa( const QStringList& stringList, FlarmAcft& aircraft );
+  bool extractPflaa( const NmeaTokenizer& tok, FlarmAcft& aircraft );
 
   /**
    * Extracts all items from the $PFLAV sentence sent by the Flarm device.
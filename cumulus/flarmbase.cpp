@@ -16,6 +16,7 @@
 #include <QtCore>
 
 #include "flarmbase.h"
+#include "flarmtraffictable.h"
 
 // initialize static data items
 bool FlarmBase::m_collectPflaa = false;
@@ -25,7 +26,7 @@ FlarmBase::FlarmVersion FlarmBase::m_flarmVersion;
 FlarmBase::FlarmError   FlarmBase::m_flarmError;
 FlarmBase::ProtocolMode FlarmBase::m_protocolMode = text;
 
-QHash<QString, FlarmBase::FlarmAcft>      FlarmBase::m_pflaaHash;
+FlarmTrafficTable FlarmBase::m_trafficTable;
 
 QMutex FlarmBase::m_mutex;
 
@@ -38,6 +39,19 @@ FlarmBase::~FlarmBase()
 {
 }
 
+QVector<FlarmBase::FlarmAcft> FlarmBase::getPflaaSnapshot()
+{
+  return m_trafficTable.snapshot();
+}
+
+void FlarmBase::reset()
+{
+  m_trafficTable.clear();
+  m_flarmStatus.valid = false;
+  m_flarmVersion.reset();
+  m_flarmError.reset();
+}
+
 QByteArray FlarmBase::replaceUmlauts( QByteArray string )
 {
   QByteArray array( string );
@@ -35,7 +35,9 @@
 #include <QMutex>
 #include <QMutexLocker>
 #include <QString>
+#include <QVector>
 
+class FlarmTrafficTable;
 class QPoint;
 class QStringList;
 class QTimer;
@@ -173,7 +175,7 @@ class FlarmBase
    */
   struct FlarmAcft
   {
-    QTime   TimeStamp;  // Creation time of this structure
+    qint64  TimeStamp;  // Creation time of this structure, monotonic in ms
     enum AlarmLevel Alarm;
     int     RelativeNorth;
     int     RelativeEast;
@@ -314,23 +316,15 @@ class FlarmBase
   };
 
   /**
-   * @return the m_pflaaHash to the caller.
+   * @return The last published snapshot of the collected PFLAA records. It
+   * can be used in every thread.
    */
-  static const QHash<QString, FlarmAcft>& getPflaaHash()
-  {
-    return m_pflaaHash;
-  };
+  static QVector<FlarmAcft> getPflaaSnapshot();
 
   /**
    * Resets the internal stored Flarm data.
    */
-  static void reset()
-  {
-    m_pflaaHash.clear();
-    m_flarmStatus.valid = false;
-    m_flarmVersion.reset();
-    m_flarmError.reset();
-  };
+  static void reset();
 
   static enum ProtocolMode getProtocolMode()
   {
@@ -384,10 +378,9 @@ class FlarmBase
   static bool m_collectPflaa;
 
   /**
-   * Hash map with collected PFLAA records. The key is a concatenation of
-   * the Flarm tags 'ID-Type' and 'ID'.
+   * Table with the collected PFLAA records. The key is the Flarm tag 'ID'.
    */
-  static QHash<QString, FlarmAcft> m_pflaaHash;
+  static FlarmTrafficTable m_trafficTable;
 
   /** Flarm protocol mode.  */
   static enum ProtocolMode m_protocolMode;
@@ -288,12 +288,12 @@ void FlarmDisplay::paintEvent( QPaintEvent *event )
   painter.drawPixmap( rect(), background );
 
   // Here starts the Flarm object analysis and drawing
-  QHash<QString, Flarm::FlarmAcft> flarmAcfts = Flarm::getPflaaHash();
+  const QVector<Flarm::FlarmAcft> flarmAcfts = Flarm::getPflaaSnapshot();
 
   if( flarmAcfts.size() == 0 )
     {
-      // qDebug() << "FlarmDisplay::paintEvent: empty hash";
-      // hash is empty
+      // qDebug() << "FlarmDisplay::paintEvent: empty snapshot";
+      // snapshot is empty
       return;
     }
 
@@ -348,14 +348,10 @@ void FlarmDisplay::paintEvent( QPaintEvent *event )
 
   objectHash.clear();
 
-  QMutableHashIterator<QString, Flarm::FlarmAcft> it(flarmAcfts);
-
-  while( it.hasNext() )
+  for( int i = 0; i < flarmAcfts.size(); i++ )
     {
-      it.next();
-
       // Get next aircraft
-      Flarm::FlarmAcft& acft = it.value();
+      const Flarm::FlarmAcft& acft = flarmAcfts.at(i);
 
       int north = acft.RelativeNorth;
       int east  = acft.RelativeEast;
@@ -461,7 +457,7 @@ void FlarmDisplay::paintEvent( QPaintEvent *event )
 
       QPen pen( Qt::black );
 
-      if( it.key() == selectedObject )
+      if( acft.ID == selectedObject )
         {
           // If a Flarm object is selected, we use another border color
           pen.setColor( Qt::magenta );
@@ -503,7 +499,7 @@ void FlarmDisplay::paintEvent( QPaintEvent *event )
           MapConfig::createSquare( object, is, color, 1.0, pen );
         }
 
-      if( it.key() == selectedObject )
+      if( acft.ID == selectedObject )
         {
           // If a Flarm object is selected, we draw some additional information
           QFont f = painter.font();
@@ -568,7 +564,7 @@ void FlarmDisplay::paintEvent( QPaintEvent *event )
                           object );
 
       // store the draw coordinates for mouse snapping
-      objectHash.insert( it.key(), QPoint(centerX + east, centerY - north) );
+      objectHash.insert( acft.ID, QPoint(centerX + east, centerY - north) );
     }
 }
 
@@ -169,11 +169,11 @@ void FlarmListView::fillItemList( QString& object2Select )
   list->clear();
 
   // Here starts the Flarm object analysis and drawing
-  QHash<QString, Flarm::FlarmAcft> flarmAcfts = Flarm::getPflaaHash();
+  const QVector<Flarm::FlarmAcft> flarmAcfts = Flarm::getPflaaSnapshot();
 
   if( flarmAcfts.size() == 0 )
     {
-      // hash is empty
+      // snapshot is empty
       resizeListColumns();
       return;
     }
@@ -181,14 +181,10 @@ void FlarmListView::fillItemList( QString& object2Select )
   int iconSize = QFontMetrics(font()).height() - 4;
   list->setIconSize( QSize(iconSize, iconSize) );
 
-  QMutableHashIterator<QString, Flarm::FlarmAcft> it(flarmAcfts);
-
-  while( it.hasNext() )
+  for( int i = 0; i < flarmAcfts.size(); i++ )
     {
-      it.next();
-
       // Get next aircraft
-      Flarm::FlarmAcft& acft = it.value();
+      const Flarm::FlarmAcft& acft = flarmAcfts.at(i);
 
       QStringList sl;
 
@@ -228,7 +224,7 @@ void FlarmListView::fillItemList( QString& object2Select )
        const QHash<QString, QString> &aliasHash = FlarmAliasList::getAliasHash();
 
       // Add hash key as invisible column
-      sl << it.key()
+      sl << acft.ID
          << aliasHash.value( acft.ID, acft.ID )
          << Distance::getText( distAcft, true, -1 )
          << vertical
@@ -266,7 +262,7 @@ void FlarmListView::fillItemList( QString& object2Select )
           // correct angle because the different coordinate systems.
           int heading2Object = (360 - calculator->getlastHeading()) + (90 - alpha);
 
-          // qDebug() << "ID=" << it.key() << "Alpha" << alpha << "H2O=" << heading2Object;
+          // qDebug() << "ID=" << acft.ID << "Alpha" << alpha << "H2O=" << heading2Object;
           MapConfig::createTriangle( pixmap,
                                      iconSize,
                                      QColor(Qt::black),
@@ -281,7 +277,7 @@ void FlarmListView::fillItemList( QString& object2Select )
 
       list->addTopLevelItem( item );
 
-      if( object2Select == it.key() )
+      if( object2Select == acft.ID )
         {
           // This item is the current selected one.
           list->setCurrentItem( item );
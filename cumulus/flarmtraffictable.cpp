@@ -0,0 +1,194 @@
+/***********************************************************************
+ **
+ **   flarmtraffictable.cpp
+ **
+ **   This file is part of Cumulus.
+ **
+ ************************************************************************
+ **
+ **   Copyright (c):  2026 by the Cumulus contributors
+ **
+ **   This file is distributed under the terms of the General Public
+ **   License. See the file COPYING for more information.
+ **
+ ***********************************************************************/
+
+#include <QtCore>
+
+#include "flarmtraffictable.h"
+
+FlarmTrafficTable::FlarmTrafficTable() :
+  m_size(0)
+{
+  for( int i = 0; i < Capacity; i++ )
+    {
+      m_slots[i].used = false;
+      m_slots[i].key  = 0;
+    }
+}
+
+FlarmTrafficTable::~FlarmTrafficTable()
+{
+}
+
+qint64 FlarmTrafficTable::now()
+{
+  // The clock is started by the first call, that is done by the thread,
+  // which parses the Flarm sentences.
+  static QElapsedTimer clock;
+
+  if( ! clock.isValid() )
+    {
+      clock.start();
+    }
+
+  return clock.elapsed();
+}
+
+uint FlarmTrafficTable::toKey( const QString& id )
+{
+  bool ok;
+  uint key = id.toUInt( &ok, 16 );
+
+  if( ! ok )
+    {
+      key = qHash( id );
+    }
+
+  return key & 0xffffff;
+}
+
+bool FlarmTrafficTable::update( const FlarmBase::FlarmAcft& acft )
+{
+  uint key = toKey( acft.ID );
+  int index = home( key );
+
+  while( m_slots[index].used )
+    {
+      if( m_slots[index].key == key )
+        {
+          m_slots[index].acft = acft;
+          return true;
+        }
+
+      index = (index + 1) & (Capacity - 1);
+    }
+
+  if( m_size >= MaxTargets )
+    {
+      return false;
+    }
+
+  m_slots[index].used = true;
+  m_slots[index].key  = key;
+  m_slots[index].acft = acft;
+  m_size++;
+
+  return true;
+}
+
+void FlarmTrafficTable::remove( int index )
+{
+  // Backward shift deletion: the following entries of the probe sequence
+  // are moved into the gap, so that no tombstones are necessary.
+  int next = index;
+
+  while( true )
+    {
+      m_slots[index].used = false;
+      m_slots[index].acft.ID.clear();
+
+      while( true )
+        {
+          next = (next + 1) & (Capacity - 1);
+
+          if( ! m_slots[next].used )
+            {
+              m_size--;
+              return;
+            }
+
+          int h = home( m_slots[next].key );
+
+          // The entry stays, if its home slot lies cyclically in (index, next].
+          bool stays = ( index <= next ) ? ( index < h && h <= next )
+                                         : ( index < h || h <= next );
+          if( ! stays )
+            {
+              break;
+            }
+        }
+
+      m_slots[index] = m_slots[next];
+      index = next;
+    }
+}
+
+void FlarmTrafficTable::expire( const qint64 maxAge )
+{
+  qint64 limit = now() - maxAge;
+
+  int i = 0;
+
+  while( i < Capacity && m_size > 0 )
+    {
+      if( m_slots[i].used && m_slots[i].acft.TimeStamp < limit )
+        {
+          // The slot can be refilled by the removal, check it again.
+          remove( i );
+          continue;
+        }
+
+      i++;
+    }
+}
+
+void FlarmTrafficTable::clear()
+{
+  for( int i = 0; i < Capacity; i++ )
+    {
+      m_slots[i].used = false;
+      m_slots[i].acft.ID.clear();
+    }
+
+  m_size = 0;
+
+  publish();
+}
+
+void FlarmTrafficTable::publish()
+{
+  Snapshot snapshot;
+  snapshot.reserve( m_size );
+
+  for( int i = 0; i < Capacity; i++ )
+    {
+      if( m_slots[i].used )
+        {
+          snapshot.append( m_slots[i].acft );
+        }
+    }
+
+  QMutexLocker locker( &m_mutex );
+  m_snapshot = snapshot;
+}
+
+FlarmTrafficTable::Snapshot FlarmTrafficTable::snapshot() const
+{
+  QMutexLocker locker( &m_mutex );
+  return m_snapshot;
+}
+
+const FlarmBase::FlarmAcft* FlarmTrafficTable::find( const Snapshot& snapshot,
+                                                     const QString& id )
+{
+  for( int i = 0; i < snapshot.size(); i++ )
+    {
+      if( snapshot.at(i).ID == id )
+        {
+          return &snapshot.at(i);
+        }
+    }
+
+  return 0;
+}
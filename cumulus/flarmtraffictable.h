@@ -0,0 +1,153 @@
+/***********************************************************************
+ **
+ **   flarmtraffictable.h
+ **
+ **   This file is part of Cumulus.
+ **
+ ************************************************************************
+ **
+ **   Copyright (c):  2026 by the Cumulus contributors
+ **
+ **   This file is distributed under the terms of the General Public
+ **   License. See the file COPYING for more information.
+ **
+ ***********************************************************************/
+
+#ifndef FLARM_TRAFFIC_TABLE_H
+#define FLARM_TRAFFIC_TABLE_H
+
+#include <QMutex>
+#include <QString>
+#include <QVector>
+
+#include "flarmbase.h"
+
+/**
+ * \class FlarmTrafficTable
+ *
+ * \author Cumulus contributors
+ *
+ * \brief Table of the Flarm targets reported by $PFLAA sentences.
+ *
+ * The table has a fixed capacity and is addressed by the 24-bit Flarm id.
+ * It uses open addressing with linear probing, so that an update, an insert
+ * and a removal need no memory allocation and touch only a few slots. The
+ * time stamps of the targets are taken from a monotonic millisecond clock.
+ *
+ * The table itself is only accessed by the thread, which parses the
+ * sentences. After a $PFLAA burst the content is published as an immutable
+ * snapshot. Readers, also in other threads, fetch the snapshot and can
+ * iterate over it without any further locking. The mutex guards only the
+ * exchange of the shared snapshot handle.
+ *
+ * \date 2026
+ */
+class FlarmTrafficTable
+{
+ public:
+
+  /** An immutable list of all published targets. */
+  typedef QVector<FlarmBase::FlarmAcft> Snapshot;
+
+  FlarmTrafficTable();
+
+  virtual ~FlarmTrafficTable();
+
+  /**
+   * Inserts a new target or updates an existing one.
+   *
+   * @param acft The target data. The ID must be set.
+   * @return true in case of success, false if the table is full
+   */
+  bool update( const FlarmBase::FlarmAcft& acft );
+
+  /**
+   * Removes all targets, which were not updated since the passed time.
+   *
+   * @param maxAge Maximum age of a target in milliseconds
+   */
+  void expire( const qint64 maxAge );
+
+  /**
+   * Removes all targets. The empty table is published.
+   */
+  void clear();
+
+  /**
+   * Publishes the current table content as new snapshot.
+   */
+  void publish();
+
+  /**
+   * @return The last published snapshot.
+   */
+  Snapshot snapshot() const;
+
+  /**
+   * @return The number of targets in the table.
+   */
+  int size() const
+  {
+    return m_size;
+  };
+
+  /**
+   * Looks up a target in a snapshot.
+   *
+   * @param snapshot The snapshot to be searched
+   * @param id The Flarm ID as hex string
+   * @return A pointer to the target or null, if the target is not contained
+   */
+  static const FlarmBase::FlarmAcft* find( const Snapshot& snapshot,
+                                           const QString& id );
+
+  /**
+   * @return The time of a monotonic clock in milliseconds.
+   */
+  static qint64 now();
+
+  /**
+   * Converts the 6-digit hex ID of a Flarm sentence into the 24-bit id.
+   * IDs, which are not hex numbers, are mapped by a hash function.
+   */
+  static uint toKey( const QString& id );
+
+ private:
+
+  Q_DISABLE_COPY ( FlarmTrafficTable )
+
+  /** Number of slots as power of two. */
+  enum { CapacityBits = 7, Capacity = 1 << CapacityBits };
+
+  /** Maximum number of targets, keeps the probe sequences short. */
+  enum { MaxTargets = 96 };
+
+  struct Slot
+  {
+    bool used;
+    uint key;
+    FlarmBase::FlarmAcft acft;
+  };
+
+  /** @return The home slot of the passed key. */
+  static int home( const uint key )
+  {
+    // Fibonacci hashing, the upper bits are well mixed.
+    return static_cast<int> ((key * 2654435769U) >> (32 - CapacityBits));
+  };
+
+  /** Removes the target in the passed slot. */
+  void remove( int index );
+
+  Slot m_slots[Capacity];
+
+  int m_size;
+
+  /** The last published snapshot. */
+  Snapshot m_snapshot;
+
+  /** Guards the exchange of the snapshot handle. */
+  mutable QMutex m_mutex;
+};
+
+#endif
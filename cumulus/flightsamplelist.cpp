@@ -0,0 +1,111 @@
+/***********************************************************************
+ **
+ **   flightsamplelist.cpp
+ **
+ **   This file is part of Cumulus.
+ **
+ ************************************************************************
+ **
+ **   Copyright (c):  2026 by the Cumulus contributors
+ **
+ **   This file is distributed under the terms of the General Public
+ **   License. See the file COPYING for more information.
+ **
+ ***********************************************************************/
+
+#include <cmath>
+
+#include "calculator.h"
+#include "flightsamplelist.h"
+
+FlightSampleList::FlightSampleList( const int capacity ) :
+  m_capacity( qMax( capacity, 1 ) ),
+  m_count(0),
+  m_head(-1),
+  m_time( m_capacity ),
+  m_position( m_capacity ),
+  m_altitude( m_capacity ),
+  m_stdAltitude( m_capacity ),
+  m_gnssAltitude( m_capacity ),
+  m_heading( m_capacity ),
+  m_speed( m_capacity ),
+  m_airspeed( m_capacity ),
+  m_marker( m_capacity )
+{
+}
+
+FlightSampleList::~FlightSampleList()
+{
+}
+
+void FlightSampleList::add( const FlightSample& sample )
+{
+  m_head++;
+
+  if( m_head >= m_capacity )
+    {
+      m_head = 0;
+    }
+
+  if( m_count < m_capacity )
+    {
+      m_count++;
+    }
+
+  // The getters of class Vector are not const.
+  Vector vector = sample.vector;
+
+  m_time[m_head]         = sample.time.toMSecsSinceEpoch();
+  m_position[m_head]     = sample.position;
+  m_altitude[m_head]     = qint32( rint( sample.altitude.getMeters() * 100.0 ) );
+  m_stdAltitude[m_head]  = qint32( rint( sample.STDAltitude.getMeters() * 100.0 ) );
+  m_gnssAltitude[m_head] = qint32( rint( sample.GNSSAltitude.getMeters() * 100.0 ) );
+  m_heading[m_head]      = qint16( vector.getAngleDeg() );
+  m_speed[m_head]        = qint32( rint( vector.getSpeed().getMps() * 1000.0 ) );
+  m_airspeed[m_head]     = qint32( rint( sample.airspeed.getMps() * 1000.0 ) );
+  m_marker[m_head]       = sample.marker;
+}
+
+void FlightSampleList::setMarker( const int i, const int marker )
+{
+  if( i < 0 || i >= m_count )
+    {
+      return;
+    }
+
+  m_marker[slot(i)] = marker;
+}
+
+int FlightSampleList::countWithin( const qint64 msecs ) const
+{
+  if( m_count == 0 )
+    {
+      return 0;
+    }
+
+  return countSince( time(0) - msecs );
+}
+
+int FlightSampleList::countSince( const qint64 since ) const
+{
+  // The samples are ordered by time, newest first. Search the first
+  // sample, which is older than the passed time.
+  int low = 0;
+  int high = m_count;
+
+  while( low < high )
+    {
+      int mid = (low + high) / 2;
+
+      if( time(mid) >= since )
+        {
+          low = mid + 1;
+        }
+      else
+        {
+          high = mid;
+        }
+    }
+
+  return low;
+}
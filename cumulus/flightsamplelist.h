@@ -0,0 +1,219 @@
+/***********************************************************************
+ **
+ **   flightsamplelist.h
+ **
+ **   This file is part of Cumulus.
+ **
+ ************************************************************************
+ **
+ **   Copyright (c):  2026 by the Cumulus contributors
+ **
+ **   This file is distributed under the terms of the General Public
+ **   License. See the file COPYING for more information.
+ **
+ ***********************************************************************/
+
+#ifndef FLIGHT_SAMPLE_LIST_H
+#define FLIGHT_SAMPLE_LIST_H
+
+#include <QPoint>
+#include <QVector>
+
+#include "speed.h"
+#include "vector.h"
+
+class FlightSample;
+
+/**
+ * \class FlightSampleList
+ *
+ * \author Cumulus contributors
+ *
+ * \brief Fixed-capacity ring buffer of the last flight samples.
+ *
+ * The list replaces a LimitedList of FlightSample objects. All storage is
+ * allocated once in the constructor, adding a sample only overwrites the
+ * oldest slot. The sample members are kept in separate arrays as packed
+ * integers:
+ *
+ * - time as milliseconds since the epoch (UTC)
+ * - position in KFLog format
+ * - altitudes in centimeters
+ * - heading in degrees
+ * - ground speed and airspeed in millimeters per second
+ *
+ * As before, index 0 is the newest sample and index count() - 1 the oldest.
+ *
+ * \date 2026
+ */
+class FlightSampleList
+{
+ public:
+
+  /**
+   * @param capacity Maximum number of stored samples
+   */
+  FlightSampleList( const int capacity );
+
+  virtual ~FlightSampleList();
+
+  /**
+   * Adds a new sample as newest element. If the list is full, the oldest
+   * sample is overwritten.
+   */
+  void add( const FlightSample& sample );
+
+  /**
+   * Removes all samples. The storage is kept.
+   */
+  void clear()
+  {
+    m_count = 0;
+  };
+
+  int count() const
+  {
+    return m_count;
+  };
+
+  bool isEmpty() const
+  {
+    return m_count == 0;
+  };
+
+  int capacity() const
+  {
+    return m_capacity;
+  };
+
+  /**
+   * @return Time of the sample in milliseconds since the epoch (UTC).
+   */
+  qint64 time( const int i ) const
+  {
+    return m_time[slot(i)];
+  };
+
+  /**
+   * @return Position of the sample in KFLog format.
+   */
+  const QPoint& position( const int i ) const
+  {
+    return m_position[slot(i)];
+  };
+
+  /**
+   * @return User altitude of the sample in meters.
+   */
+  double altitude( const int i ) const
+  {
+    return m_altitude[slot(i)] / 100.0;
+  };
+
+  /**
+   * @return Pressure altitude of the sample in meters.
+   */
+  double stdAltitude( const int i ) const
+  {
+    return m_stdAltitude[slot(i)] / 100.0;
+  };
+
+  /**
+   * @return GPS altitude of the sample in meters.
+   */
+  double gnssAltitude( const int i ) const
+  {
+    return m_gnssAltitude[slot(i)] / 100.0;
+  };
+
+  /**
+   * @return Heading of the sample in degrees.
+   */
+  int heading( const int i ) const
+  {
+    return m_heading[slot(i)];
+  };
+
+  /**
+   * @return Ground speed of the sample in m/s.
+   */
+  double speed( const int i ) const
+  {
+    return m_speed[slot(i)] / 1000.0;
+  };
+
+  /**
+   * @return Airspeed of the sample in m/s.
+   */
+  double airspeed( const int i ) const
+  {
+    return m_airspeed[slot(i)] / 1000.0;
+  };
+
+  /**
+   * @return Speed and direction of the sample.
+   */
+  Vector vector( const int i ) const
+  {
+    return Vector( heading(i), Speed( speed(i) ) );
+  };
+
+  int marker( const int i ) const
+  {
+    return m_marker[slot(i)];
+  };
+
+  /**
+   * Sets the marker of the sample. Ignored, if the index is not valid.
+   */
+  void setMarker( const int i, const int marker );
+
+  /**
+   * Returns the number of samples, which are not older than the passed
+   * time span, counted from the newest sample. Because the samples are
+   * ordered by time, this is also the index of the first sample outside
+   * of the time window.
+   *
+   * @param msecs Time span in milliseconds
+   * @return Number of samples inside of the time window
+   */
+  int countWithin( const qint64 msecs ) const;
+
+  /**
+   * Returns the number of samples taken at or after the passed time.
+   *
+   * @param since Time in milliseconds since the epoch (UTC)
+   * @return Number of samples taken at or after the passed time
+   */
+  int countSince( const qint64 since ) const;
+
+ private:
+
+  /** Translates a list index into a slot of the storage arrays. */
+  int slot( const int i ) const
+  {
+    int s = m_head - i;
+
+    return s < 0 ? s + m_capacity : s;
+  };
+
+  int m_capacity;
+
+  /** Number of stored samples. */
+  int m_count;
+
+  /** Slot of the newest sample. */
+  int m_head;
+
+  QVector<qint64> m_time;
+  QVector<QPoint> m_position;
+  QVector<qint32> m_altitude;
+  QVector<qint32> m_stdAltitude;
+  QVector<qint32> m_gnssAltitude;
+  QVector<qint16> m_heading;
+  QVector<qint32> m_speed;
+  QVector<qint32> m_airspeed;
+  QVector<int>    m_marker;
+};
+
+#endif
@@ -252,6 +252,7 @@ void GeneralConfig::load()
   _qnh                    = value( "QNH", 1013 ).toInt();
   _bRecordInterval        = value( "B-RecordLoggerInterval", 3 ).toInt();
   _kRecordInterval        = value( "K-RecordLoggerInterval", 0 ).toInt();
+  _loggerFlushInterval    = value( "LoggerFlushInterval", 10 ).toInt();
   _loggerAutostartMode    = value( "LoggerAutostartMode", true ).toBool();
   _tas                    = Speed(value( "TAS", 100.0 ).toDouble());
   _currentTaskName        = value( "CurrentTask", "").toString();
@@ -466,6 +467,7 @@ void GeneralConfig::load()
   _varioIntegrationTime = value( "IntegrationTime", 5 ).toInt();
   _varioTekCompensation = value( "TekCompensation", false ).toBool();
   _varioTekAdjust       = value( "TekAdjust", 0 ).toInt();
+  _varioFilter          = value( "Filter", 0 ).toInt();
   endGroup();
 
   beginGroup("Altimeter");
@@ -511,6 +513,7 @@ void GeneralConfig::load()
   beginGroup("GPS");
   _gpsDevice          = value( "Device", getGpsDefaultDevice() ).toString();
   _gpsBtDevice        = value( "BT-Device", "" ).toString();
+  _gpsExtraDevices    = value( "ExtraDevices", QStringList() ).toStringList();
   _gpsSpeed           = value( "Speed", 4800 ).toInt();
   _gpsAltitudeType    = value( "AltitudeType", (int) GpsNmea::GPS ).toInt();
   _gpsAltitudeUserCorrection.setMeters(value( "AltitudeCorrection", 0 ).toDouble());
@@ -725,6 +728,7 @@ void GeneralConfig::save()
   setValue( "QNH", _qnh );
   setValue( "B-RecordLoggerInterval", _bRecordInterval );
   setValue( "K-RecordLoggerInterval", _kRecordInterval );
+  setValue( "LoggerFlushInterval", _loggerFlushInterval );
   setValue( "LoggerAutostartMode", _loggerAutostartMode );
   setValue( "TAS", _tas.getMps() );
   setValue( "CurrentTask", _currentTaskName);
@@ -919,6 +923,7 @@ void GeneralConfig::save()
   setValue( "IntegrationTime", _varioIntegrationTime );
   setValue( "TekCompensation", _varioTekCompensation );
   setValue( "TekAdjust", _varioTekAdjust );
+  setValue( "Filter", _varioFilter );
   endGroup();
 
   beginGroup("Altimeter");
@@ -953,6 +958,7 @@ void GeneralConfig::save()
   beginGroup("GPS");
   setValue( "Device", _gpsDevice );
   setValue( "BT-Device", _gpsBtDevice );
+  setValue( "ExtraDevices", _gpsExtraDevices );
   setValue( "Speed", _gpsSpeed );
   setValue( "AltitudeType", _gpsAltitudeType );
   setValue( "AltitudeCorrection", _gpsAltitudeUserCorrection.getMeters() );
@@ -1048,6 +1048,17 @@ class GeneralConfig : protected QSettings
     _kRecordInterval = newValue;
   };
 
+  /** gets logger flush interval in seconds */
+  int getLoggerFlushInterval() const
+  {
+    return _loggerFlushInterval;
+  };
+  /** sets logger flush interval in seconds */
+  void setLoggerFlushInterval( const int newValue )
+  {
+    _loggerFlushInterval = newValue;
+  };
+
   /** gets logger autostart mode */
   bool getLoggerAutostartMode() const
   {
@@ -1755,6 +1766,17 @@ class GeneralConfig : protected QSettings
     _varioTekAdjust = newValue;
   };
 
+  /** gets variometer filter, 0 = sliding window, 1 = Kalman filter */
+  int getVarioFilter() const
+  {
+    return _varioFilter;
+  };
+  /** sets variometer filter */
+  void setVarioFilter(const int newValue)
+  {
+    _varioFilter = newValue;
+  };
+
   /** gets variometer tek compensation */
   bool getVarioTekCompensation() const
   {
@@ -1936,6 +1958,22 @@ class GeneralConfig : protected QSettings
     _gpsBtDevice = newValue;
   };
 
+  /**
+   * Gets the additional GPS input devices. Every entry consists of a device
+   * name and an optional speed separated by a space. A device can be a
+   * serial device, a named pipe or a TCP source in the form tcp:address:port.
+   * The address must be numeric or localhost, host names are not resolved.
+   */
+  QStringList& getGpsExtraDevices()
+  {
+    return _gpsExtraDevices;
+  };
+  /** Sets the additional GPS input devices */
+  void setGpsExtraDevices( const QStringList& newValue )
+  {
+    _gpsExtraDevices = newValue;
+  };
+
   /** Gets the Gps Speed */
   int getGpsSpeed() const;
   /** Sets the Gps Speed */
@@ -3093,6 +3131,8 @@ class GeneralConfig : protected QSettings
   int _bRecordInterval;
   // K-Record logger interval
   int _kRecordInterval;
+  // Interval in seconds, after that the IGC logger writes its records to disk
+  int _loggerFlushInterval;
   // auto logger start mode
   bool _loggerAutostartMode;
   // Auto logger start speed
@@ -3237,6 +3277,8 @@ class GeneralConfig : protected QSettings
   bool _varioTekCompensation;
   // variometer tek adjust
   int _varioTekAdjust;
+  // variometer filter
+  int _varioFilter;
 
   // altimeter mode
   int _altimeterMode;
@@ -3280,6 +3322,8 @@ class GeneralConfig : protected QSettings
   QString _gpsDevice;
   // Gps BT device
   QString _gpsBtDevice;
+  // Additional GPS input devices
+  QStringList _gpsExtraDevices;
   // Gps speed
   int _gpsSpeed;
   // Gps delivered altitude
@@ -0,0 +1,128 @@
+/***********************************************************************
+ **
+ **   glidetable.cpp
+ **
+ **   This file is part of Cumulus.
+ **
+ ************************************************************************
+ **
+ **   Copyright (c):  2026 by the Cumulus contributors
+ **
+ **   This file is distributed under the terms of the General Public
+ **   License. See the file COPYING for more information.
+ **
+ ***********************************************************************/
+
+#include <cmath>
+
+#include <QtCore>
+
+#include "glidetable.h"
+#include "polar.h"
+
+const double GlideTable::MinHeadwind = -40.0;
+const double GlideTable::Step = 0.25;
+
+double GlideTable::ms_sin[360];
+double GlideTable::ms_cos[360];
+
+GlideTable::GlideTable() :
+  m_valid(false),
+  m_mc(0.0),
+  m_calmSpeed(0.0)
+{
+  initTrigTables();
+}
+
+GlideTable::~GlideTable()
+{
+}
+
+void GlideTable::initTrigTables()
+{
+  static bool initialized = false;
+
+  if( initialized )
+    {
+      return;
+    }
+
+  for( int i = 0; i < 360; i++ )
+    {
+      ms_sin[i] = sin( i * M_PI / 180.0 );
+      ms_cos[i] = cos( i * M_PI / 180.0 );
+    }
+
+  initialized = true;
+}
+
+void GlideTable::build( const Polar& polar, const Speed& mc )
+{
+  m_mc = mc.getMps();
+  m_calmSpeed = polar.bestSpeed( 0.0, 0.0, mc ).getMps();
+
+  for( int i = 0; i < Size; i++ )
+    {
+      Speed speed = polar.bestSpeed( MinHeadwind + i * Step, 0.0, mc );
+
+      m_speed[i] = speed.getMps();
+      m_sink[i]  = polar.getSink( speed ).getMps();
+    }
+
+  m_valid = true;
+}
+
+void GlideTable::lookup( const double headwind, double& speed, double& sink ) const
+{
+  double pos = (headwind - MinHeadwind) / Step;
+
+  // Stronger winds are not realistic, the table border is used.
+  pos = qBound( 0.0, pos, double(Size - 1) );
+
+  int i = qMin( static_cast<int> (pos), Size - 2 );
+  double f = pos - i;
+
+  speed = m_speed[i] + f * (m_speed[i + 1] - m_speed[i]);
+  sink  = m_sink[i]  + f * (m_sink[i + 1]  - m_sink[i]);
+}
+
+bool GlideTable::arrivalAltitudes( Target* targets,
+                                   const int count,
+                                   const double windX,
+                                   const double windY,
+                                   const double altitude ) const
+{
+  if( m_valid == false || m_calmSpeed <= 0.0 )
+    {
+      return false;
+    }
+
+  const double v0 = m_calmSpeed;
+
+  for( int i = 0; i < count; i++ )
+    {
+      Target& t = targets[i];
+
+      int bearing = t.bearing % 360;
+
+      if( bearing < 0 )
+        {
+          bearing += 360;
+        }
+
+      // Air speed vector is the ground speed vector at calm speed plus the
+      // wind vector, which points against the wind direction.
+      const double ax = v0 * ms_cos[bearing] + windX;
+      const double ay = v0 * ms_sin[bearing] + windY;
+
+      const double headwind = v0 - sqrt( ax * ax + ay * ay );
+
+      double sink;
+      lookup( headwind, t.speed, sink );
+
+      // The glide ratio over ground is v0 / sink.
+      t.arrival = altitude - t.elevation - t.distance * sink / v0;
+    }
+
+  return true;
+}
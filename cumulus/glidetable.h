@@ -0,0 +1,153 @@
+/***********************************************************************
+ **
+ **   glidetable.h
+ **
+ **   This file is part of Cumulus.
+ **
+ ************************************************************************
+ **
+ **   Copyright (c):  2026 by the Cumulus contributors
+ **
+ **   This file is distributed under the terms of the General Public
+ **   License. See the file COPYING for more information.
+ **
+ ***********************************************************************/
+
+#ifndef GLIDE_TABLE_H
+#define GLIDE_TABLE_H
+
+#include "speed.h"
+
+class Polar;
+
+/**
+ * \class GlideTable
+ *
+ * \author Cumulus contributors
+ *
+ * \brief Precomputed speed to fly and sink rates of a polar.
+ *
+ * The table contains the best speed and the related sink rate for head wind
+ * components between -40 m/s and +40 m/s at one McCready value. Values
+ * between the table steps are interpolated linearly. The table is built by
+ * the \ref Polar on demand and is dropped, if the load of the polar or the
+ * McCready value are changed.
+ *
+ * The glide path calculation follows the method of Bob Hansen, which is
+ * also used by \ref Calculator::glidePath. The arrival altitudes of many
+ * targets can be calculated by one call, that needs no trigonometric
+ * functions and no polar evaluations.
+ *
+ * \date 2026
+ */
+class GlideTable
+{
+ public:
+
+  /**
+   * Input and output data of a glide path calculation.
+   */
+  struct Target
+  {
+    /** Course to the target in degrees. */
+    int bearing;
+    /** Distance to the target in meters. */
+    double distance;
+    /** Elevation of the target in meters. */
+    double elevation;
+    /** Calculated arrival altitude in meters. */
+    double arrival;
+    /** Calculated best speed in m/s. */
+    double speed;
+  };
+
+  GlideTable();
+
+  virtual ~GlideTable();
+
+  /**
+   * Builds the table for the passed polar and McCready value.
+   */
+  void build( const Polar& polar, const Speed& mc );
+
+  /**
+   * Drops the table content.
+   */
+  void invalidate()
+  {
+    m_valid = false;
+  };
+
+  /**
+   * @return True, if the table was built for the passed McCready value.
+   */
+  bool isValidFor( const Speed& mc ) const
+  {
+    return m_valid && m_mc == mc.getMps();
+  };
+
+  /**
+   * @return The best speed at zero wind in m/s.
+   */
+  double calmSpeed() const
+  {
+    return m_calmSpeed;
+  };
+
+  /**
+   * Looks up the best speed and the sink rate for a head wind component.
+   * Head wind counts negative like in \ref Polar::bestSpeed.
+   *
+   * @param headwind Head wind component in m/s
+   * @param speed Best speed in m/s
+   * @param sink Sink rate at the best speed in m/s, positive for sinking
+   */
+  void lookup( const double headwind, double& speed, double& sink ) const;
+
+  /**
+   * Calculates the arrival altitudes and the best speeds of the passed
+   * targets.
+   *
+   * @param targets Array of the targets
+   * @param count Number of targets in the array
+   * @param windX Wind component in north direction in m/s
+   * @param windY Wind component in east direction in m/s
+   * @param altitude Usable altitude in meters, the safety altitude is
+   *                 already subtracted.
+   * @return false, if the polar delivers no usable best speed
+   */
+  bool arrivalAltitudes( Target* targets,
+                         const int count,
+                         const double windX,
+                         const double windY,
+                         const double altitude ) const;
+
+ private:
+
+  /** Table range and resolution of the head wind component in m/s. */
+  enum { Size = 321 };
+
+  static const double MinHeadwind;
+  static const double Step;
+
+  /** Initializes the static sine and cosine table. */
+  static void initTrigTables();
+
+  bool m_valid;
+
+  /** McCready value of the table in m/s. */
+  double m_mc;
+
+  /** Best speed at zero wind in m/s. */
+  double m_calmSpeed;
+
+  double m_speed[Size];
+
+  double m_sink[Size];
+
+  /** Sine and cosine of the full degrees. */
+  static double ms_sin[360];
+  static double ms_cos[360];
+};
+
+#endif
@@ -100,6 +100,10 @@ GpsCon::GpsCon(QObject* parent, const char *pathIn) :
   timer = new QTimer(this);
   timer->connect( timer, SIGNAL(timeout()), this, SLOT(slot_Timeout()) );
 
+  // Reserve the receiver buffers, they are reused for all GPS data.
+  rxBuffer.reserve( 4096 );
+  sentence.reserve( 256 );
+
   initSignalHandler();
 
   // Port can be read from the configuration file for debugging purposes. If it
@@ -271,6 +275,33 @@ bool GpsCon::startGpsReceiving()
 #endif
         }
 
+      // Additional input sources are opened after the main device. Their
+      // sentences are merged by the client into one stream.
+      const QStringList& extraDevices = conf->getGpsExtraDevices();
+
+      for( int i = 0; i < extraDevices.size(); i++ )
+        {
+          QStringList devArgs = extraDevices.at(i).simplified().split( QChar(' ') );
+
+          if( devArgs.at(0).isEmpty() )
+            {
+              continue;
+            }
+
+          QString speed = devArgs.size() > 1 ? devArgs.at(1) : QString::number(ioSpeed);
+
+          msg = QString("%1 %2 %3").arg(MSG_OPEN_SOURCE).arg(devArgs.at(0)).arg(speed);
+
+          writeClientMessage(0, msg.toLatin1().data());
+          readClientMessage(0, msg);
+
+          if( msg == MSG_NEG )
+            {
+              qWarning() << "GpsCon::startGpsReceiving(): Source"
+                         << extraDevices.at(i) << "rejected!";
+            }
+        }
+
       // We switch on the data forwarding on the client side.
       writeClientMessage(0, MSG_FGPS_ON );
       readClientMessage(0, msg);
@@ -821,23 +852,46 @@ void GpsCon::getDataFromClient()
           break;
         }
 
-      QString msg;
+      int msgLen = readClientMessage( 1, rxBuffer );
 
-      readClientMessage( 1, msg );
-
-      if( server.getClientSock( 1 ) == -1 )
+      if( msgLen < 0 || server.getClientSock( 1 ) == -1 )
         {
           // socket will be closed in case of any problems, e.g. client has
           // crashed. we check that to avoid a dead lock here.
           return;
         }
 
-      if( msg.startsWith( MSG_GPS_DATA ) )
+      const char *data = rxBuffer.constData();
+
+      // The GPS data messages are the most frequent ones. They are handled
+      // directly from the receive buffer.
+      if( strncmp( data, MSG_GPS_BATCH, strlen(MSG_GPS_BATCH) ) == 0 )
         {
-          msg = msg.right(msg.length() - strlen(MSG_GPS_DATA) - 1);
-          emit newSentence(msg);
+          int offset = strlen(MSG_GPS_BATCH) + 1;
+
+          if( msgLen > offset )
+            {
+              dispatchGpsBatch( data + offset, msgLen - offset );
+            }
+
+          continue;
+        }
+
+      if( strncmp( data, MSG_GPS_DATA, strlen(MSG_GPS_DATA) ) == 0 )
+        {
+          int offset = strlen(MSG_GPS_DATA) + 1;
+
+          if( msgLen > offset )
+            {
+              emitSentence( data + offset, msgLen - offset );
+            }
+
+          continue;
         }
-      else if (msg == MSG_CON_OFF) // GPS connection has gone off
+
+      QString msg( data );
+
+      if (msg == MSG_CON_OFF) // GPS connection has gone off
         {
           emit gpsConnectionOff();
           qDebug(MSG_CON_OFF);
@@ -847,6 +901,12 @@ void GpsCon::getDataFromClient()
           emit gpsConnectionOn();
           qDebug(MSG_CON_ON);
         }
+      else if( msg.startsWith(MSG_SOURCE_STATS) )
+        {
+          // The input source statistics of the client were received.
+          sourceStats = msg.mid( strlen(MSG_SOURCE_STATS) + 1 );
+          emit newSourceStats( sourceStats );
+        }
       else if( msg.startsWith(MSG_FLARM_FLIGHT_LIST_RES) )
         {
           // A Flarm flight list was received.
@@ -923,6 +983,78 @@ void GpsCon::readClientMessage( uint index, QString &result )
   delete [] buf;
 }
 
+/**
+ * Reads a client message from the socket into the reusable buffer. The
+ * protocol is the same as described above.
+ */
+int GpsCon::readClientMessage( uint index, QVector<char> &buffer )
+{
+  uint msgLen = 0;
+
+  int done = server.readMsg( index, &msgLen, sizeof(msgLen) );
+
+  if( done <= 0 )
+    {
+      server.closeClientSock(index);
+      qWarning() << "GpsCon::readClientMessage ERROR"
+                 << errno
+                 << strerror(errno);
+      return -1; // Error occurred
+    }
+
+  // The buffer keeps its reserved capacity, a resize does not allocate
+  // memory as long as the message fits into it.
+  buffer.resize( msgLen + 1 );
+
+  if( msgLen > 0 )
+    {
+      done = server.readMsg( index, buffer.data(), msgLen );
+
+      if( done <= 0 )
+        {
+          server.closeClientSock(index);
+          return -1; // Error occurred
+        }
+    }
+
+  buffer[msgLen] = '\0';
+
+  return msgLen;
+}
+
+void GpsCon::dispatchGpsBatch( const char *data, const int length )
+{
+  const char *start = data;
+  const char *end = data + length;
+
+  while( start < end )
+    {
+      const char *nl = static_cast<const char *>( memchr( start, '\n', end - start ) );
+
+      // The newline belongs to the sentence like in the single data message.
+      const char *next = nl ? nl + 1 : end;
+
+      emitSentence( start, next - start );
+
+      start = next;
+    }
+}
+
+void GpsCon::emitSentence( const char *data, const int length )
+{
+  // The string is only reallocated, if a receiver has kept a copy of it.
+  sentence.resize( length );
+
+  QChar *dst = sentence.data();
+
+  for( int i = 0; i < length; i++ )
+    {
+      dst[i] = QLatin1Char( data[i] );
+    }
+
+  emit newSentence( sentence );
+}
+
 /**
  * Writes a client message to the socket. The protocol consists of two
  * parts. First the message length is read as unsigned integer, after that the
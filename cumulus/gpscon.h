@@ -38,6 +38,7 @@
 #include <QObject>
 #include <QString>
 #include <QMap>
+#include <QVector>
 #include <QSocketNotifier>
 #include <QDateTime>
 #include <QTimer>
@@ -94,6 +95,15 @@ class GpsCon : public QObject
         return device;
       };
 
+    /**
+     * This function returns the last reported statistics of the input
+     * sources, one line per source.
+     */
+    QString currentSourceStats()const
+      {
+        return sourceStats;
+      };
+
     /** This function returns the current PID of the client process or
      * -1 if there isn't any
      */
@@ -173,6 +183,12 @@ class GpsCon : public QObject
      */
     void gpsConnectionOn();
 
+    /**
+     * This signal is emitted, when new statistics of the input sources
+     * were received from the client, one line per source.
+     */
+    void newSourceStats(const QString& stats);
+
     /**
      * This signal is emitted, when a new Flarm flight list was received.
      */
@@ -205,6 +221,15 @@ class GpsCon : public QObject
      */
     void readClientMessage( uint index, QString &result );
 
+    /**
+     * Reads a client message from the socket into the passed buffer. The
+     * buffer is reused and only enlarged, if the message does not fit. The
+     * message is terminated by a null character, which is not counted.
+     *
+     * \return The message length or -1 in case of an error.
+     */
+    int readClientMessage( uint index, QVector<char> &buffer );
+
     /**
      * Writes a client message to the socket. The protocol consists of two
      * parts. First the message length is read as unsigned integer, after that
@@ -218,6 +243,18 @@ class GpsCon : public QObject
      */
     void getDataFromClient();
 
+    /**
+     * Emits every sentence of a GPS data batch message. The sentences are
+     * separated by newlines.
+     */
+    void dispatchGpsBatch( const char *data, const int length );
+
+    /**
+     * Emits a single GPS sentence. The emitted string is reused for all
+     * sentences.
+     */
+    void emitSentence( const char *data, const int length );
+
     /**
      * Triggers a connection retry in case of error.
      */
@@ -294,6 +331,15 @@ class GpsCon : public QObject
 
     // GPS device name
     QString device;
+
+    // Receive buffer of the data channel, reused for all messages
+    QVector<char> rxBuffer;
+
+    // Sentence string, reused for all emitted GPS sentences
+    QString sentence;
+
+    // Last statistics of the input sources reported by the client
+    QString sourceStats;
  };
 
 #endif
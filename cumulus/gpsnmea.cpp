@@ -69,9 +69,6 @@ GpsNmea *GpsNmea::gps = static_cast<GpsNmea *> (0);
 // number of created class instances
 short GpsNmea::instances = 0;
 
-// Dictionary with known sentence keywords
-QHash<QString, short> GpsNmea::gpsHash;
-
 // Mutex for thread synchronization
 QMutex GpsNmea::mutex;
 
@@ -95,9 +92,6 @@ GpsNmea::GpsNmea(QObject* parent) :
 
   resetDataObjects();
 
-  // Load desired GPS sentence identifier into the hash filter.
-  getGpsMessageKeys(gpsHash);
-
   // GPS fix supervision, is started after the first fix was received
   timeOutFix = new QTimer(this);
   connect (timeOutFix, SIGNAL(timeout()), this, SLOT(_slotTimeoutFix()));
@@ -145,55 +139,9 @@ void GpsNmea::getGpsMessageKeys( QHash<QString, short>& gpsKeys)
   mutex.lock();
   gpsKeys.clear();
 
-  // Load all desired GPS sentence identifiers into the hash table
-  // NMEA Talkers
-  // GP = GPS
-  // GL = GLONASS
-  // GN = GPS/GLONASS
-  gpsKeys.insert( "$GPRMC", 0);
-  gpsKeys.insert( "$GLRMC", 0);
-  gpsKeys.insert( "$GNRMC", 0);
-
-  gpsKeys.insert( "$GPGLL", 1);
-  gpsKeys.insert( "$GLGLL", 1);
-  gpsKeys.insert( "$GNGLL", 1);
-
-  gpsKeys.insert( "$GPGGA", 2);
-  gpsKeys.insert( "$GLGGA", 2);
-  gpsKeys.insert( "$GNGGA", 2);
-
-  gpsKeys.insert( "$GPGSA", 3);
-  gpsKeys.insert( "$GLGSA", 3);
-  gpsKeys.insert( "$GNGSA", 3);
-
-  gpsKeys.insert( "$GPGSV", 4);
-  gpsKeys.insert( "$GLGSV", 4);
-  gpsKeys.insert( "$GNGSV", 4);
-
-  gpsKeys.insert( "$PGRMZ", 5);
-  gpsKeys.insert( "$PCAID", 6);
-  gpsKeys.insert( "!w",     7);
-  gpsKeys.insert( "$PGCS",  8);
-  gpsKeys.insert( "$LXWP0", 9);
-  gpsKeys.insert( "$LXWP2", 10);
-  gpsKeys.insert( "$GPDTM", 11);
-
-#ifdef FLARM
-  gpsKeys.insert( "$PFLAA", 20);
-  gpsKeys.insert( "$PFLAU", 21);
-  gpsKeys.insert( "$PFLAV", 22);
-  gpsKeys.insert( "$PFLAE", 23);
-  gpsKeys.insert( "$PFLAC", 24);
-  gpsKeys.insert( "$PFLAR", 25);
-  gpsKeys.insert( "$PFLAI", 26);
-  gpsKeys.insert( "$PFLAO", 27);
-  gpsKeys.insert( "$ERROR", 29);
-#endif
-
-#ifdef MAEMO5
-  gpsKeys.insert( "$MAEMO0", 40);
-  gpsKeys.insert( "$MAEMO1", 41);
-#endif
+  // Load all desired GPS sentence identifiers into the hash table. The
+  // identifiers are taken from the table of the tokenizer.
+  NmeaTokenizer::sentenceKeys( gpsKeys );
 
   gpsKeys.squeeze();
   mutex.unlock();
@@ -273,6 +221,10 @@ void GpsNmea::createGpsConnection()
   connect (gpsObject, SIGNAL(newSentence(const QString&)),
            this, SIGNAL(newSentence(const QString&)) );
 
+  // Broadcasts the statistics of the client's input sources
+  connect (gpsObject, SIGNAL(newSourceStats(const QString&)),
+           this, SIGNAL(newSourceStats(const QString&)) );
+
   // Broadcasts that a new Flarm flight list is available
   connect (gpsObject, SIGNAL(newFlarmFlightList(const QString&)),
            this, SIGNAL(newFlarmFlightList(const QString&)) );
@@ -398,15 +350,23 @@ void GpsNmea::slot_sentence(const QString& sentenceIn)
     }
 
   // Split sentence in single parts for each comma and the checksum. The first
-  // part will contain the identifier, the rest the arguments.
-  QStringList slst = sentenceIn.split( QRegExp("[,*]"), QString::KeepEmptyParts );
+  // part will contain the identifier, the rest the arguments. The tokenizer
+  // stores only the field positions, no strings are created.
+  NmeaTokenizer tok;
+
+  if( tok.tokenize( sentenceIn ) == false )
+    {
+      return;
+    }
 
-  if( ! gpsHash.contains(slst[0]) )
+  if( tok.sentenceId() == NmeaTokenizer::Unknown )
     {
-      if( ! reportedUnknownKeys.contains(slst[0]) )
+      QString key = tok.toString( 0 );
+
+      if( ! reportedUnknownKeys.contains(key) )
         {
-          qWarning() << "GpsNmea::slot_sentence: No Id found for" << slst[0];
-          reportedUnknownKeys.insert(slst[0]);
+          qWarning() << "GpsNmea::slot_sentence: No Id found for" << key;
+          reportedUnknownKeys.insert(key);
         }
 
       return;
@@ -416,7 +376,7 @@ void GpsNmea::slot_sentence(const QString& sentenceIn)
 
 #ifdef FLARM
 
-  if( slst[0] == "$PFLAA" )
+  if( tok.sentenceId() == NmeaTokenizer::PFLAA )
     {
       // PFLAA receiving starts
       pflaaIsReceiving = true;
@@ -435,7 +395,7 @@ void GpsNmea::slot_sentence(const QString& sentenceIn)
 #if 0
 //aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa
 
-  if( slst[0] == "$GPRMC" )
+  if( tok.sentenceId() == NmeaTokenizer::GPRMC )
     {
       /**
        *   1     2    3    4      5         6            7                8
@@ -552,84 +512,99 @@ void GpsNmea::slot_sentence(const QString& sentenceIn)
 //aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa
 #endif
 
-  // Call the decode methods for the known sentences
-  switch( gpsHash.value( slst[0] ) )
+  // Decode the position sentences and the Flarm traffic directly from the
+  // tokenizer. They are the most frequent ones.
+  switch( tok.sentenceId() )
   {
-    case 0: // GPRMC
-      __ExtractGprmc( slst );
+    case NmeaTokenizer::GPRMC:
+      __ExtractGprmc( tok );
       return;
-    case 1: // GPGLL
-      __ExtractGpgll( slst );
+    case NmeaTokenizer::GPGLL:
+      __ExtractGpgll( tok );
       return;
-    case 2: // GPGGA
-      __ExtractGpgga( slst );
+    case NmeaTokenizer::GPGGA:
+      __ExtractGpgga( tok );
       return;
-    case 3: // GPGSA
+
+#ifdef FLARM
+
+    case NmeaTokenizer::PFLAA:
+      {
+        Flarm::FlarmAcft aircraft;
+        Flarm::instance()->extractPflaa( tok, aircraft );
+        return;
+      }
+
+#endif
+
+    default:
+      break;
+  }
+
+  // All other sentences are decoded from a string list.
+  QStringList slst = tok.toStringList();
+
+  switch( tok.sentenceId() )
+  {
+    case NmeaTokenizer::GPGSA:
       __ExtractConstellation( slst );
       return;
-    case 4: // GPGSV or GLGSV
+    case NmeaTokenizer::GPGSV:
       __ExtractSatsInView( slst );
       return;
-    case 5: // PGRMZ
+    case NmeaTokenizer::PGRMZ:
       __ExtractPgrmz( slst );
       return;
-    case 6: // PCAID
+    case NmeaTokenizer::PCAID:
       __ExtractPcaid( slst );
       return;
-    case 7: // !w
+    case NmeaTokenizer::CambridgeW: // !w
       __ExtractCambridgeW( slst );
       return;
-    case 8: // $PGCS
+    case NmeaTokenizer::PGCS:
       __ExtractPgcs( slst );
       return;
-    case 9: // $LXWP0
+    case NmeaTokenizer::LXWP0:
       __ExtractLxwp0( slst );
       return;
-    case 10: // $LXWP2
+    case NmeaTokenizer::LXWP2:
       __ExtractLxwp2( slst );
       return;
-    case 11: // $GPDTM
+    case NmeaTokenizer::GPDTM:
       __ExtractGpdtm( slst );
       return;
 
 #ifdef FLARM
 
-    case 20: // $PFLAA
-      {
-        Flarm::FlarmAcft aircraft;
-        Flarm::instance()->extractPflaa( slst, aircraft );
-        return;
-      }
-
-    case 21: // $PFLAU
+    case NmeaTokenizer::PFLAU:
       __ExtractPflau( slst );
       return;
 
-    case 22: // $PFLAV
+    case NmeaTokenizer::PFLAV:
       Flarm::instance()->extractPflav( slst );
       return;
 
-    case 23: // $PFLAE
+    case NmeaTokenizer::PFLAE:
       Flarm::instance()->extractPflae( slst );
       return;
 
-    case 24: // $PFLAC
+    case NmeaTokenizer::PFLAC:
       Flarm::instance()->extractPflac( slst );
       return;
 
-    case 25: // $PFLAR
+    case NmeaTokenizer::PFLAR:
       Flarm::instance()->extractPflar( slst );
       return;
 
-    case 26: // $PFLAI
+    case NmeaTokenizer::PFLAI:
       Flarm::instance()->extractPflai( slst );
       return;
 
-    case 27: // $PFLAO
+    case NmeaTokenizer::PFLAO:
       Flarm::instance()->extractPflao( slst );
       return;
 
-    case 29: // $ERROR
+    case NmeaTokenizer::FlarmError: // $ERROR
       Flarm::instance()->extractError( slst );
       return;
 
@@ -637,13 +612,13 @@ void GpsNmea::slot_sentence(const QString& sentenceIn)
 
 #ifdef MAEMO5
 
-    case 40:
+    case NmeaTokenizer::MAEMO0:
       // Handle sentences created by GPS Maemo Client process. These sentenceIns
       // contain no checksum items.
       __ExtractMaemo0( slst );
       return;
 
-    case 41:
+    case NmeaTokenizer::MAEMO1:
       // Handle sentences created by GPS Maemo Client process. These sentenceIns
       // contain no checksum items.
       __ExtractMaemo1( slst );
@@ -686,26 +661,25 @@ void GpsNmea::slot_sentence(const QString& sentenceIn)
    12) Signal integrity, A=Autonomous mode
    13) Checksum, hh
 */
-void GpsNmea::__ExtractGprmc( const QStringList& slst )
+void GpsNmea::__ExtractGprmc( const NmeaTokenizer& tok )
 {
-  if( slst.size() < 10 )
+  if( tok.count() < 10 )
     {
-      qWarning() << slst[0] << "contains too less parameters!";
+      qWarning() << tok.toString(0) << "contains too less parameters!";
       return;
     }
 
   _gprmcSeen = true;
 
-  //qDebug("%s",slst[2].toLatin1().data());
-  if( slst[2] == "A" )
+  if( tok.fieldEquals( 2, "A" ) )
     { /* Data status A=OK, V=warning */
       fixOK( "RMC" );
 
-      __ExtractTime(slst[1]);
-      __ExtractDate(slst[9]);
-      __ExtractKnotSpeed(slst[7]);
-      __ExtractCoord(slst[3],slst[4],slst[5],slst[6]);
-      __ExtractHeading(slst[8]);
+      __ExtractTime( tok.field(1) );
+      __ExtractDate( tok.field(9) );
+      __ExtractKnotSpeed( tok.field(7) );
+      __ExtractCoord( tok, 3, 5 );
+      __ExtractHeading( tok.field(8) );
 
       if( _lastTime.isValid() && _lastDate.isValid() )
         {
@@ -742,8 +716,8 @@ void GpsNmea::__ExtractGprmc( const QStringList& slst )
     {
       fixNOK( "RMC" );
 
-      QTime time = __ExtractTime( slst[1] );
-      QDate date = __ExtractDate( slst[9] );
+      QTime time = __ExtractTime( tok.field(1) );
+      QDate date = __ExtractDate( tok.field(9) );
 
       if( time.isValid() && date.isValid() )
         {
@@ -774,19 +748,19 @@ void GpsNmea::__ExtractGprmc( const QStringList& slst )
     6) Status A - Data Valid, V - Data Invalid
     7) Checksum
 */
-void GpsNmea::__ExtractGpgll( const QStringList& slst )
+void GpsNmea::__ExtractGpgll( const NmeaTokenizer& tok )
 {
-  if( slst.size() < 7 )
+  if( tok.count() < 7 )
     {
-      qWarning() << slst[0] << "contains too less parameters!";
+      qWarning() << tok.toString(0) << "contains too less parameters!";
       return;
     }
 
-  if (slst[6] == "A")
+  if( tok.fieldEquals( 6, "A" ) )
     {
       fixOK( "GGL" );
-      __ExtractTime(slst[5]);
-      __ExtractCoord(slst[1],slst[2],slst[3],slst[4]);
+      __ExtractTime( tok.field(5) );
+      __ExtractCoord( tok, 1, 3 );
     }
   else
     {
@@ -825,15 +799,15 @@ void GpsNmea::__ExtractGpgll( const QStringList& slst )
    14) Differential reference station ID, 0000-1023
    15) Checksum
 */
-void GpsNmea::__ExtractGpgga( const QStringList& slst )
+void GpsNmea::__ExtractGpgga( const NmeaTokenizer& tok )
 {
-  if ( slst.size() < 15 )
+  if ( tok.count() < 15 )
     {
-      qWarning() << slst[0] << "contains too less parameters!";
+      qWarning() << tok.toString(0) << "contains too less parameters!";
       return;
     }
 
-  if ( slst[6] != "0" && ! slst[6].isEmpty() )
+  if ( ! tok.fieldEquals( 6, "0" ) && ! tok.isEmpty(6) )
     {
       /*a value of 0 means invalid fix and we don't need that one */
       if( _gprmcSeen == false )
@@ -843,12 +817,12 @@ void GpsNmea::__ExtractGpgga( const QStringList& slst )
           fixOK( "GGA" );
         }
 
-      __ExtractTime(slst[1]);
-      __ExtractCoord(slst[2],slst[3],slst[4],slst[5]);
-      __ExtractAltitude(slst[9],slst[10]);
-      __ExtractSatsInView(slst[7]);
+      __ExtractTime( tok.field(1) );
+      __ExtractCoord( tok, 2, 4 );
+      __ExtractAltitude( tok.field(9), tok.field(10) );
+      __ExtractSatsInView( tok.field(7) );
     }
-  else if( slst[6] == "0" )
+  else if( tok.fieldEquals( 6, "0" ) )
     {
       if( _gprmcSeen == false )
         {
@@ -1413,28 +1387,20 @@ void GpsNmea::__ExtractLxwp2( const QStringList& stringList )
 /**
  * This function returns a QTime from the time encoded in a MNEA sentence.
  */
-QTime GpsNmea::__ExtractTime(const QString& timeString)
+QTime GpsNmea::__ExtractTime(const QStringRef& timeString)
 {
-  if( timeString.isEmpty() && timeString.size() < 6 )
+  if( timeString.isEmpty() )
     {
-      // qWarning("Invalid GPS time %s", timeString.toLatin1().data());
       return QTime();
     }
 
-  QString hh (timeString.left(2));
-  QString mm (timeString.mid(2,2));
-  QString ss (timeString.mid(4,2));
-
-  // @AP: newer CF Cards can also provide milliseconds. In this case the time
-  // format is defined as hhmmss.sss. But we will not use it to avoid problems
-  // with our fixes.
-  QTime res = QTime( hh.toInt(), mm.toInt(), ss.toInt() );
+  QTime res;
 
   // @AP: don't overtake invalid times. They will cause invalid fixes!
-  if ( ! res.isValid() )
+  if ( NmeaTokenizer::parseTime( timeString, res ) == false )
     {
       qWarning("GpsNmea::__ExtractTime(): Invalid time %s! Ignoring it (%s, %d)",
-               timeString.toLatin1().data(), __FILE__, __LINE__ );
+               timeString.toString().toLatin1().data(), __FILE__, __LINE__ );
       return QTime();
     }
 
@@ -1445,53 +1411,39 @@ QTime GpsNmea::__ExtractTime(const QString& timeString)
 
 /** This function returns a QDate from the date string encoded in a
     NWEA sentence as "ddmmyy". */
-QDate GpsNmea::__ExtractDate(const QString& dateString)
+QDate GpsNmea::__ExtractDate(const QStringRef& dateString)
 {
-  if( dateString.isEmpty() && dateString.size() != 6 )
+  if( dateString.isEmpty() )
     {
-      // qWarning("Invalid GPS date %s", dateString.toLatin1().data());
       return QDate();
     }
 
-  QString dd (dateString.left(2));
-  QString mm (dateString.mid(2,2));
-  QString yy (dateString.right(2));
-
   /*we assume that we only use this after the year 2000, which is
     reasonable since this is made 2002 ...*/
-
-  bool ok1, ok2, ok3;
-
-  QDate res (yy.toInt(&ok1) + 2000, mm.toInt(&ok2), dd.toInt(&ok3) );
+  QDate res;
 
   // @AP: don't take over invalid dates
-  if ( ok1 && ok2 && ok3 && res.isValid() )
+  if ( NmeaTokenizer::parseDate( dateString, res ) )
     {
       _lastDate = res;
     }
   else
     {
       qWarning("GpsNmea::__ExtractDate(): Invalid date %s! Ignoring it (%s, %d)",
-               dateString.toLatin1().data(), __FILE__, __LINE__ );
+               dateString.toString().toLatin1().data(), __FILE__, __LINE__ );
     }
 
   return res;
 }
 
 /** This function returns a Speed from the speed encoded in knots */
-Speed GpsNmea::__ExtractKnotSpeed(const QString& speedString)
+Speed GpsNmea::__ExtractKnotSpeed(const QStringRef& speedString)
 {
   Speed res;
 
-  if( speedString.isEmpty() )
-    {
-      return res;
-    }
-
-  bool ok;
-  double speed = speedString.toDouble( &ok );
+  double speed;
 
-  if( ok == false )
+  if( NmeaTokenizer::parseDouble( speedString, speed ) == false )
     {
       return res;
     }
@@ -1508,63 +1460,19 @@ Speed GpsNmea::__ExtractKnotSpeed(const QString& speedString)
 }
 
 /** This function converts the coordinate data from the NMEA sentence to the internal QPoint format. */
-QPoint GpsNmea::__ExtractCoord(const QString& slat, const QString& slatNS,
-                               const QString& slon, const QString& slonEW)
+QPoint GpsNmea::__ExtractCoord( const NmeaTokenizer& tok, const int latIdx, const int lonIdx )
 {
-  /* The internal KFLog format for coordinates represents coordinates in 10.000'st of a minute.
-     So, one minute corresponds to 10.000, one degree to 600.000 and one second to 167.
-     KFLogCoord = degrees * 600000 + minutes * 10000
-  */
-
-  if( slat.isEmpty() || slatNS.isEmpty() ||
-      slon.isEmpty() || slonEW.isEmpty() )
-      {
-        return QPoint();
-      }
-
-  int lat = 0;
-  int lon = 0;
-  float fLat = 0.0;
-  float fLon = 0.0;
-
-  bool ok1, ok2, ok3, ok4;
-
-  lat  = slat.left(2).toInt(&ok1);
-  fLat = slat.mid(2).toFloat(&ok2);
+  int latTemp;
+  int lonTemp;
 
-  // qDebug ("slat: %s", slat.toLatin1().data());
-  // qDebug ("lat/fLat: %d/%f", lat, fLat);
-
-  lon  = slon.left(3).toInt(&ok3);
-  fLon = slon.mid(3).toFloat(&ok4);
-
-  if( !ok1 || !ok2 || !ok3 || !ok4 )
+  if( tok.toCoordinate( latIdx, latIdx + 1, latTemp ) == false ||
+      tok.toCoordinate( lonIdx, lonIdx + 1, lonTemp ) == false )
     {
       return QPoint();
     }
 
-  // qDebug ("slon: %s", slon.toLatin1().data());
-  // qDebug ("lon/fLon: %d/%f", lon, fLon);
-
-  int latMin = (int) rint(fLat * 10000);
-  int lonMin = (int) rint(fLon * 10000);
-
-  // convert to internal KFLog format
-  int latTemp = lat * 600000 + latMin;
-  int lonTemp = lon * 600000 + lonMin;
-
   // qDebug("latTemp=%d, lonTemp=%d", latTemp, lonTemp);
 
-  if (slatNS == "S")
-    {
-      latTemp = -latTemp;
-    }
-
-  if (slonEW == "W")
-    {
-      lonTemp = -lonTemp;
-    }
-
   QPoint res (latTemp, lonTemp);
 
   if ( _lastCoord != res )
@@ -1577,20 +1485,13 @@ QPoint GpsNmea::__ExtractCoord(const QString& slat, const QString& slatNS,
 }
 
 /** Extract the heading from the NMEA sentence. */
-double GpsNmea::__ExtractHeading(const QString& headingstring)
+double GpsNmea::__ExtractHeading(const QStringRef& headingstring)
 {
   static uint report = 0;
 
-  if( headingstring.isEmpty() )
-    {
-      return 0.0;
-    }
-
-  bool ok;
-
-  double heading = headingstring.toDouble(&ok);
+  double heading;
 
-  if( ok == false )
+  if( NmeaTokenizer::parseDouble( headingstring, heading ) == false )
     {
       return 0.0;
     }
@@ -1607,22 +1508,19 @@ double GpsNmea::__ExtractHeading(const QString& headingstring)
 /**
  * Extracts the altitude from a NMEA GGA sentence.
  */
-Altitude GpsNmea::__ExtractAltitude( const QString& altitude, const QString& unit )
+Altitude GpsNmea::__ExtractAltitude( const QStringRef& altitude, const QStringRef& unit )
 {
-  // qDebug("alt=%s, unit=%s", altitude.toLatin1().data(), unitAlt.toLatin1().data() );
-  bool ok;
-
   Altitude res(0);
-  double alt = altitude.toDouble(&ok);
+  double alt;
 
-  if( ok == false )
+  if( NmeaTokenizer::parseDouble( altitude, alt ) == false )
     {
       return res;
     }
 
   // Check for other unit as meters, meters is the default.
   // Consider user's altitude correction
-  if ( unit.toLower() == "f" )
+  if ( unit.size() == 1 && unit.unicode()[0].toLower() == QChar('f') )
     {
       res.setFeet( alt );
     }
@@ -1751,18 +1649,16 @@ QString GpsNmea::__ExtractConstellation(const QStringList& sentence)
 }
 
 /** Extracts the satellite count in view from the NMEA sentence. */
-bool GpsNmea::__ExtractSatsInView(const QString& satcount)
+bool GpsNmea::__ExtractSatsInView(const QStringRef& satcount)
 {
-  bool ok;
+  int count;
 
-  int count = satcount.toInt(&ok);
-
-  if( ! ok )
+  if( NmeaTokenizer::parseInt( satcount, count ) == false )
     {
       return false;
     }
 
-  if( ok && count != _lastSatInfo.satsInView )
+  if( count != _lastSatInfo.satsInView )
     {
       _lastSatInfo.satsInView = count;
       emit newSatCount( _lastSatInfo );
@@ -2232,6 +2128,18 @@ bool GpsNmea::sendSentence(const QString command)
 
 #endif
 
+QString GpsNmea::getSourceStats()
+{
+#ifndef ANDROID
+  if( serial )
+    {
+      return serial->currentSourceStats();
+    }
+#endif
+
+  return QString();
+}
+
 //------------------------------------------------------------------------------
 
 #ifdef FLARM
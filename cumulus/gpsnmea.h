@@ -50,6 +50,7 @@
 #include "speed.h"
 #include "altitude.h"
 #include "wgspoint.h"
+#include "nmeatokenizer.h"
 
 #ifndef ANDROID
 #include "gpscon.h"
@@ -387,6 +388,12 @@ class GpsNmea : public QObject
       */
     bool sendSentence(const QString command);
 
+    /**
+     * \return The last reported statistics of the GPS input sources,
+     * one line per source. Empty, if nothing was reported.
+     */
+    QString getSourceStats();
+
 #ifdef FLARM
 
     /** Requests a flight list from a Flarm device. */
@@ -579,6 +586,12 @@ class GpsNmea : public QObject
      */
     void newFlarmCount( int newCount );
 
+    /**
+     * This signal is emitted, when new statistics of the GPS input
+     * sources were received, one line per source.
+     */
+    void newSourceStats(const QString& stats);
+
     /**
      * This signal is emitted, when a new Flarm flight list was received.
      */
@@ -604,11 +617,11 @@ class GpsNmea : public QObject
     void writeConfig();
 
     /** Extracts GPRMC sentence. */
-    void __ExtractGprmc( const QStringList& slst );
+    void __ExtractGprmc( const NmeaTokenizer& tok );
     /** Extracts GPGLL sentence. */
-    void __ExtractGpgll( const QStringList& slst );
+    void __ExtractGpgll( const NmeaTokenizer& tok );
     /** Extracts GPGGA sentence. */
-    void __ExtractGpgga( const QStringList& slst );
+    void __ExtractGpgga( const NmeaTokenizer& tok );
     /** Extracts PGRMZ sentence. */
     void __ExtractPgrmz( const QStringList& slst );
     /** Extracts PCAID sentence. */
@@ -624,21 +637,40 @@ class GpsNmea : public QObject
 #endif
 
     /** This function return a QTime from the time encoded in a MNEA sentence. */
-    QTime __ExtractTime(const QString& timestring);
+    QTime __ExtractTime(const QStringRef& timestring);
     /** This function return a QDate from the date encoded in a MNEA sentence. */
-    QDate __ExtractDate(const QString& datestring);
+    QDate __ExtractDate(const QStringRef& datestring);
     /** This function return a Speed from the speed encoded in knots */
-    Speed __ExtractKnotSpeed(const QString& speedstring);
-    /** This function converts the coordinate data from the NMEA sentence to the internal QPoint coordinate format. */
-    QPoint __ExtractCoord(const QString& slat, const QString& slatNS, const QString& slon, const QString& slonEW);
+    Speed __ExtractKnotSpeed(const QStringRef& speedstring);
+    /** This function converts the coordinate data from the NMEA sentence to
+     *  the internal QPoint coordinate format. The hemisphere fields must follow
+     *  the latitude and longitude fields. */
+    QPoint __ExtractCoord(const NmeaTokenizer& tok, const int latIdx, const int lonIdx);
     /** Extract the heading from the NMEA sentence. */
-    double __ExtractHeading(const QString& headingstring);
+    double __ExtractHeading(const QStringRef& headingstring);
+
+    double __ExtractHeading(const QString& headingstring)
+    {
+      return __ExtractHeading( QStringRef(&headingstring) );
+    };
+
     /** Extracts the altitude from a NMEA GGA or Gramin/Flarm PGRMZ sentence */
-    Altitude __ExtractAltitude(const QString& altitude, const QString& unit);
+    Altitude __ExtractAltitude(const QStringRef& altitude, const QStringRef& unit);
+
+    Altitude __ExtractAltitude(const QString& altitude, const QString& unit)
+    {
+      return __ExtractAltitude( QStringRef(&altitude), QStringRef(&unit) );
+    };
+
     /** Extracts the constellation from the NMEA sentence. */
     QString __ExtractConstellation(const QStringList& sentence);
     /** Extracts the satellites in view from the NMEA sentence. */
-    bool __ExtractSatsInView(const QString& satcount);
+    bool __ExtractSatsInView(const QStringRef& satcount);
+
+    bool __ExtractSatsInView(const QString& satcount)
+    {
+      return __ExtractSatsInView( QStringRef(&satcount) );
+    };
     /** Extracts satellites In View (SIV) info from a NMEA sentence. */
     void __ExtractSatsInView(const QStringList& sentence);
     /** Extracts satellites In View (SIV) info from a NMEA sentence. */
@@ -801,9 +833,6 @@ class GpsNmea : public QObject
     // number of created class instances
     static short instances;
 
-    // Dictionary with known sentence keywords
-    static QHash<QString, short> gpsHash;
-
     // Set with reported unknown GPS keys
     QSet<QString> reportedUnknownKeys;
 
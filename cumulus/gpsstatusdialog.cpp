@@ -99,6 +99,12 @@ GpsStatusDialog::GpsStatusDialog(QWidget * parent) :
   QtScroller::grabGesture( nmeaScrollArea->viewport(), QtScroller::LeftMouseButtonGesture );
 #endif
 
+  // Statistics of the GPS input sources, reported by the GPS client.
+  statsBox = new QLabel;
+  statsBox->setTextFormat(Qt::PlainText);
+  statsBox->setMargin(5);
+  slot_SourceStats( GpsNmea::gps->getSourceStats() );
+
   QVBoxLayout* nmeaBoxLayout = new QVBoxLayout;
   nmeaBoxLayout->setSpacing( 0 );
   nmeaBoxLayout->addWidget( nmeaScrollArea );
@@ -124,6 +130,7 @@ GpsStatusDialog::GpsStatusDialog(QWidget * parent) :
 
   QVBoxLayout* topLayout = new QVBoxLayout( this );
   topLayout->addLayout( hBox );
+  topLayout->addWidget( statsBox );
   topLayout->addLayout( nmeaBoxLayout );
 
   QShortcut* keySpace = new QShortcut( QKeySequence(Qt::Key_Space), this);
@@ -135,6 +142,8 @@ GpsStatusDialog::GpsStatusDialog(QWidget * parent) :
            this, SLOT(slot_Sentence(const QString&)) );
   connect( GpsNmea::gps, SIGNAL(newSatInViewInfo(QList<SIVInfo>&)),
            this, SLOT(slot_SIV(QList<SIVInfo>&)) );
+  connect( GpsNmea::gps, SIGNAL(newSourceStats(const QString&)),
+           this, SLOT(slot_SourceStats(const QString&)) );
 
   connect( startStop, SIGNAL(clicked()), this, SLOT(slot_ToggleStartStop()) );
 
@@ -155,6 +164,12 @@ void GpsStatusDialog::slot_SIV( QList<SIVInfo>& siv )
   snrDisplay->setSatInfo( siv );
 }
 
+void GpsStatusDialog::slot_SourceStats( const QString& stats )
+{
+  statsBox->setText( stats.trimmed() );
+  statsBox->setVisible( ! stats.trimmed().isEmpty() );
+}
+
 void GpsStatusDialog::slot_Sentence(const QString& sentence)
 {
   int maxLines = 100;
@@ -97,6 +97,11 @@ public slots:
    */
   void slot_SIV( QList<SIVInfo>& siv );
 
+  /**
+   * Called if new statistics of the GPS input sources are available.
+   */
+  void slot_SourceStats( const QString& stats );
+
 private slots:
 
   /**
@@ -136,6 +141,7 @@ protected:
   GpsElevationAzimuthDisplay *elevAziDisplay;
   GpsSnrDisplay              *snrDisplay;
   QLabel                     *nmeaBox;
+  QLabel                     *statsBox;
   QPushButton                *startStop;
   QPushButton                *save;
 
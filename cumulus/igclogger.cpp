@@ -21,6 +21,8 @@
  ***************************************************************************/
 
 #include <cstdlib>
+#include <cstring>
+#include <unistd.h>
 
 #include <QtGui>
 #include <QMessageBox>
@@ -33,6 +35,7 @@
 #include "generalconfig.h"
 #include "mainwindow.h"
 #include "mapcontents.h"
+#include "replaybenchmark.h"
 #include "flighttask.h"
 #include "taskpoint.h"
 
@@ -53,8 +56,11 @@ QMutex IgcLogger::mutex;
 IgcLogger::IgcLogger(QObject* parent) :
   QObject(parent),
   closeTimer(0),
+  _writeLength(0),
   _kRecordLogging(false),
-  _backtrack( LimitedList<QStringList>(60) ),
+  _backtrack( BacktrackSize ),
+  _backtrackHead(0),
+  _backtrackCount(0),
   flightNumber(0),
   _flightMode( Calculator::unknown)
 {
@@ -72,6 +78,7 @@ IgcLogger::IgcLogger(QObject* parent) :
   // load user configuration items
   _bRecordInterval = GeneralConfig::instance()->getBRecordInterval();
   _kRecordInterval = GeneralConfig::instance()->getKRecordInterval();
+  _flushInterval   = GeneralConfig::instance()->getLoggerFlushInterval();
 
   lastLoggedBRecord = new QTime();
   lastLoggedFRecord = new QTime();
@@ -138,6 +145,7 @@ void IgcLogger::slotReadConfig()
 
   _bRecordInterval = GeneralConfig::instance()->getBRecordInterval();
   _kRecordInterval = GeneralConfig::instance()->getKRecordInterval();
+  _flushInterval   = GeneralConfig::instance()->getLoggerFlushInterval();
 }
 
 /**
@@ -154,13 +162,16 @@ void IgcLogger::slotResetLoggingTime()
  */
 void IgcLogger::slotMakeFixEntry()
 {
+  ReplayBenchmark::Probe probe( ReplayBenchmark::StageIgc );
+
   if ( _logMode == off || calculator->samplelist.count() == 0 )
     {
       // make sure logger is not off and and entries are in the sample list
       return;
     }
 
-  const FlightSample &lastfix = calculator->samplelist.at(0);
+  // The last flight sample is identical to the newest entry of the sample list.
+  const FlightSample &lastfix = calculator->getLastFlightSample();
 
   // check if we have to log a new B-Record
   if ( ! lastLoggedBRecord->isNull() &&
@@ -173,35 +184,37 @@ void IgcLogger::slotMakeFixEntry()
 
   *lastLoggedBRecord = lastfix.time.time();
 
-  QString bRecord( "B" + formatTime(lastfix.time.time()) + formatPosition(lastfix.position) + "A" +
-                   formatAltitude(lastfix.STDAltitude) + formatAltitude(lastfix.GNSSAltitude) +
-                   QString("%1").arg(GpsNmea::gps->getLastSatInfo().fixAccuracy, 3, 10, QChar('0')) +
-                   QString("%1").arg(GpsNmea::gps->getLastSatInfo().satsInUse, 2, 10, QChar('0')) );
+  const SatInfo& satInfo = GpsNmea::gps->getLastSatInfo();
+
+  Fix fix;
+  fix.time          = lastfix.time.time();
+  fix.position      = lastfix.position;
+  fix.stdAltitude   = qRound( lastfix.STDAltitude.getMeters() );
+  fix.gnssAltitude  = qRound( lastfix.GNSSAltitude.getMeters() );
+  fix.fixAccuracy   = satInfo.fixAccuracy;
+  fix.satsInUse     = satInfo.satsInUse;
+  fix.constellation = satInfo.constellation;
 
   if ( _logMode == standby &&
        ( calculator->moving() == false ||
          _flightMode == Calculator::unknown ||
          _flightMode == Calculator::standstill ) )
     {
-      // save B and F record and time in backtrack, if we are not in move
-      QString fRecord = "F" +
-                         formatTime( lastfix.time.time() ) +
-                         GpsNmea::gps->getLastSatInfo().constellation;
-      QStringList list;
-      list << bRecord << fRecord << QTime::currentTime ().toString("hhmmss");
-      _backtrack.add( list );
+      // save the raw fix in the backtrack, if we are not in move
+      fix.recorded = QTime::currentTime();
+      addBacktrack( fix );
 
-      // qDebug( "Backtrack add: backtrack.size=%d", _backtrack.size() );
+      // qDebug( "Backtrack add: backtrack.size=%d", _backtrackCount );
 
       // Set last F recording time from the oldest log entry. Looks a little bit
       // tricky but should work so. ;-)
-      *lastLoggedFRecord = QTime::fromString( _backtrack.last().at(2), "hhmmss" );
+      *lastLoggedFRecord = oldestBacktrack().recorded;
       return;
     }
 
   if( isLogFileOpen() )
     {
-      if( _logMode == standby || _backtrack.size() > 0 )
+      if( _logMode == standby || _backtrackCount > 0 )
         {
           // There is a special case. The user can switch on the logger via toggle L
           // but the logger was before in state standby and the backtrack contains
@@ -215,26 +228,20 @@ void IgcLogger::slotMakeFixEntry()
           emit takeoffTime( startLogging );
 
           // If log mode was before in standby we have to write out the backtrack entries.
-          if( _backtrack.size() > 0 )
+          if( _backtrackCount > 0 )
             {
-              if( _backtrack.last().at( 0 ).startsWith( "B" ) )
-                {
-                  // The backtrack contains at the last position a B record but IGC log
-                  // should start with a F record. Therefore we take the corresponding
-                  // F record from the stored string list.
-                  _stream << _backtrack.last().at( 1 ) << "\r\n";
-                }
+              // The IGC log should start with a F record. Therefore we take
+              // the constellation of the oldest fix.
+              const Fix& oldest = oldestBacktrack();
 
-              for( int i = _backtrack.count() - 1; i >= 0; i-- )
-                {
-                  // qDebug( "backtrack %d: %s, %s", i,
-                  // _backtrack.at(i).at(0).toLatin1().data(),
-                  // _backtrack.at(i).at(1).toLatin1().data() );
+              writeFRecord( oldest.time, oldest.constellation );
 
-                  _stream << _backtrack.at(i).at(0) << "\r\n";
+              for( int i = _backtrackCount; i > 0; i-- )
+                {
+                  writeBRecord( _backtrack[(_backtrackHead - i + BacktrackSize) % BacktrackSize] );
                 }
 
-              _backtrack.clear(); // make sure we aren't leaving old data behind.
+              clearBacktrack(); // make sure we aren't leaving old data behind.
             }
           else
             {
@@ -257,15 +264,189 @@ void IgcLogger::slotMakeFixEntry()
           makeSatConstEntry( lastfix.time.time() );
         }
 
-      _stream << bRecord << "\r\n";
+      writeBRecord( fix );
 
       // write K-Record
       writeKRecord( lastfix.time.time() );
 
+      flushRecords( lastfix.time.time(), false );
+
       emit madeEntry();
     }
 }
 
+/**
+ * Writes the passed number with a fixed number of digits. Leading positions
+ * are filled with zeros. Returns the position behind the last digit.
+ */
+static char* putNumber( char* p, unsigned int value, const int digits )
+{
+  for( int i = digits - 1; i >= 0; i-- )
+    {
+      p[i] = '0' + (value % 10);
+      value /= 10;
+    }
+
+  return p + digits;
+}
+
+/** Writes a time as HHMMSS. */
+static char* putTime( char* p, const QTime& time )
+{
+  p = putNumber( p, time.hour(), 2 );
+  p = putNumber( p, time.minute(), 2 );
+  return putNumber( p, time.second(), 2 );
+}
+
+/** Writes an altitude in meters as XXXXX or as -XXXX. */
+static char* putAltitude( char* p, const int meters )
+{
+  if( meters < 0 )
+    {
+      *p++ = '-';
+      return putNumber( p, qMin( -meters, 9999 ), 4 );
+    }
+
+  return putNumber( p, qMin( meters, 99999 ), 5 );
+}
+
+/** Writes a value with 3 digits, limited to the range 0...999. */
+static char* putThreeDigits( char* p, const int value )
+{
+  return putNumber( p, qBound( 0, value, 999 ), 3 );
+}
+
+/**
+ * Writes a B-Record of the passed fix into the write buffer.
+ *
+ *  0           1          2            3
+ *  0 123456 78901234 567890123 4 56789 01234 567 89
+ *  B 155706 5229791N 01331393E A 00000 00081 001 08
+ */
+void IgcLogger::writeBRecord( const Fix& fix )
+{
+  char record[48];
+  char* p = record;
+
+  *p++ = 'B';
+  p = putTime( p, fix.time );
+
+  // The internal KFLog format for coordinates represents coordinates in
+  // 10.000'st of a minute. The IGC format needs the minutes in 1000'st.
+  int lat = fix.position.x();
+  int lon = fix.position.y();
+
+  p = putNumber( p, qAbs(lat) / 600000, 2 );
+  p = putNumber( p, (qAbs(lat) % 600000) / 10, 5 );
+  *p++ = lat < 0 ? 'S' : 'N';
+
+  p = putNumber( p, qAbs(lon) / 600000, 3 );
+  p = putNumber( p, (qAbs(lon) % 600000) / 10, 5 );
+  *p++ = lon < 0 ? 'W' : 'E';
+
+  *p++ = 'A';
+  p = putAltitude( p, fix.stdAltitude );
+  p = putAltitude( p, fix.gnssAltitude );
+  p = putThreeDigits( p, fix.fixAccuracy );
+  p = putNumber( p, qBound( 0, fix.satsInUse, 99 ), 2 );
+
+  appendRecord( record, p - record );
+}
+
+/**
+ * Writes a F-Record into the write buffer.
+ */
+void IgcLogger::writeFRecord( const QTime& time, const QString& constellation )
+{
+  char record[80];
+  char* p = record;
+
+  *p++ = 'F';
+  p = putTime( p, time );
+
+  // The constellation contains the two digit ids of the used satellites.
+  int len = qMin( constellation.size(), int(sizeof(record)) - 7 );
+
+  for( int i = 0; i < len; i++ )
+    {
+      *p++ = constellation.at(i).toLatin1();
+    }
+
+  appendRecord( record, p - record );
+}
+
+/**
+ * Appends a record and the line end to the write buffer.
+ */
+void IgcLogger::appendRecord( const char* record, const int length )
+{
+  if( _writeLength + length + 2 > WriteBufferSize )
+    {
+      flushRecords( QTime(), true );
+    }
+
+  memcpy( _writeBuffer + _writeLength, record, length );
+  _writeLength += length;
+
+  _writeBuffer[_writeLength++] = '\r';
+  _writeBuffer[_writeLength++] = '\n';
+}
+
+/**
+ * Writes the buffered records into the log file and synchronizes the file
+ * data with the disk.
+ */
+void IgcLogger::flushRecords( const QTime& fixTime, const bool force )
+{
+  if( _writeLength == 0 || ! _logfile.isOpen() )
+    {
+      return;
+    }
+
+  if( force == false && _lastFlush.isValid() && fixTime.isValid() )
+    {
+      int elapsed = _lastFlush.secsTo( fixTime );
+
+      // A negative value means a passed midnight.
+      if( elapsed >= 0 && elapsed < _flushInterval )
+        {
+          return;
+        }
+    }
+
+  if( _logfile.write( _writeBuffer, _writeLength ) != _writeLength )
+    {
+      qWarning() << "IGC-Logger: Cannot write to" << _logfile.fileName()
+                 << _logfile.errorString();
+    }
+
+  _writeLength = 0;
+
+  if( fixTime.isValid() )
+    {
+      _lastFlush = fixTime;
+    }
+
+  // Bring the data to the disk, so that a crash or a power loss does not
+  // loose more than one flush interval.
+  _logfile.flush();
+  fsync( _logfile.handle() );
+}
+
+/**
+ * Adds a fix to the backtrack ring.
+ */
+void IgcLogger::addBacktrack( const Fix& fix )
+{
+  _backtrack[_backtrackHead] = fix;
+  _backtrackHead = (_backtrackHead + 1) % BacktrackSize;
+
+  if( _backtrackCount < BacktrackSize )
+    {
+      _backtrackCount++;
+    }
+}
+
 /**
  * Writes a K-Record, if all conditions for that are true.
  */
@@ -304,27 +485,71 @@ void IgcLogger::writeKRecord( const QTime& timeFix )
       23-29 VAT, vario speed in meters as sign +/-, 3 numbers with 3 decimal numbers
    *
    */
-  QString kRecord( "K" + formatTime(timeFix) +
-                   QString("%1").arg( (int) rint(GpsNmea::gps->getLastHeading()), 3, 10, QChar('0')) +
-                   QString("%1").arg( (int) rint(GpsNmea::gps->getLastTas().getKph()), 3, 10, QChar('0')) + "kph" +
-                   QString("%1").arg( calculator->getLastWind().getAngleDeg(), 3, 10, QChar('0')) +
-                   QString("%1").arg( (int) rint(calculator->getLastWind().getSpeed().getKph()), 3, 10, QChar('0')) +
-                   formatVario(calculator->getlastVario()) );
-
-  _stream << kRecord << "\r\n";
+  char record[48];
+  char* p = record;
+
+  *p++ = 'K';
+  p = putTime( p, timeFix );
+  p = putThreeDigits( p, (int) rint(GpsNmea::gps->getLastHeading()) );
+  p = putThreeDigits( p, (int) rint(GpsNmea::gps->getLastTas().getKph()) );
+  memcpy( p, "kph", 3 );
+  p += 3;
+  p = putThreeDigits( p, calculator->getLastWind().getAngleDeg() );
+  p = putThreeDigits( p, (int) rint(calculator->getLastWind().getSpeed().getKph()) );
+
+  // The vario speed in meters per second is multiplied with 1000 to get a
+  // number with 6 digits and without a decimal point.
+  int vario = (int) rint( calculator->getlastVario().getMps() * 1000.0 );
+
+  *p++ = vario == 0 ? ' ' : (vario > 0 ? '+' : '-');
+  p = putNumber( p, qMin( qAbs(vario), 999999 ), 6 );
+
+  appendRecord( record, p - record );
+}
+
+/**
+ * Writes an E-Record with the passed event code.
+ *
+ *  0 123456 789
+ *  E 104512 TPC
+ */
+void IgcLogger::writeERecord( const QTime& time, const char* code )
+{
+  if( ! _logfile.isOpen() )
+    {
+      return;
+    }
+
+  char record[16];
+  char* p = record;
+
+  *p++ = 'E';
+  p = putTime( p, time );
+  memcpy( p, code, 3 );
+  p += 3;
+
+  appendRecord( record, p - record );
 }
 
 /** Call this slot, if a task sector has been touched to increase
  *  logger interval for a certain time.
  */
 
-void IgcLogger::slotTaskSectorTouched()
+void IgcLogger::slotTaskSectorTouched( const QTime& passageTime )
 {
   if ( _logMode != on )
     {
       return;
     }
 
+  if( passageTime.isValid() )
+    {
+      // The passage time is interpolated between two fixes. It is logged
+      // as turn point confirmation event, which is followed by the B record
+      // of the current position.
+      writeERecord( passageTime, "TPC" );
+    }
+
   // activate timer to reset logger interval after 30s to default
   resetTimer->setSingleShot(true);
   resetTimer->start( 30*1000 );
@@ -346,7 +571,7 @@ void IgcLogger::Stop()
     }
 
   _logMode = off;
-  _backtrack.clear();
+  clearBacktrack();
 
   // Reset time classes to initial state
   delete lastLoggedBRecord;
@@ -370,7 +595,7 @@ void IgcLogger::Standby()
     }
 
   _logMode = standby;
-  _backtrack.clear();
+  clearBacktrack();
 
   // Reset time classes to initial state
   delete lastLoggedBRecord;
@@ -423,6 +648,12 @@ bool IgcLogger::isLogFileOpen()
 
   writeHeader();
 
+  // The records are written directly into the file, the header must be
+  // out of the stream before.
+  _stream.flush();
+  _writeLength = 0;
+  _lastFlush = QTime();
+
   // As first create a F record
   slotConstellation( GpsNmea::gps->getLastSatInfo() );
 
@@ -434,9 +665,12 @@ void IgcLogger::CloseFile()
 {
   if( _logfile.isOpen() )
     {
+      flushRecords( QTime(), true );
       _logfile.close();
     }
 
+  _writeLength = 0;
+
   // reset logger start time
   startLogging = QDateTime();
 }
@@ -713,13 +947,9 @@ void IgcLogger::makeSatConstEntry(const QTime &time)
           return;
         }
 
-      QString entry = "F" +
-                       formatTime( time ) +
-                       GpsNmea::gps->getLastSatInfo().constellation;
-
       if( isLogFileOpen() )
         {
-          _stream << entry << "\r\n";
+          writeFRecord( time, GpsNmea::gps->getLastSatInfo().constellation );
           emit madeEntry();
         }
 
@@ -735,41 +965,6 @@ QString IgcLogger::formatTime(const QTime& time)
   return result;
 }
 
-/**
- * This function formats the variometer speed value in meters with sign +/-,
- * 3 numbers with 3 decimal numbers.
- */
-QString IgcLogger::formatVario(const Speed vSpeed)
-{
-  QString result;
-
-  double mps = vSpeed.getMps();
-
-  if( mps == 0.0 )
-    {
-      result += " ";
-    }
-  else if( mps > 0.0 )
-    {
-      result += "+";
-    }
-
-  // We need a number with 6 digits and without a decimal point. Therefore
-  // the value meter per second is multiplied with 1000.
-  result += QString("%1").arg( (int) rint(mps*1000.0), 6, 10, QChar('0') );
-
-  return result;
-}
-
-/** This function formats an Altitude to the correct format for IGC files (XXXXX) */
-QString IgcLogger::formatAltitude(Altitude altitude)
-{
-  QString result;
-  result.sprintf("%05.0f",altitude.getMeters());
-  return result;
-
-}
-
 /** This function formats the position to the correct format for igc files. Latitude and Longitude are encoded as DDMMmmmADDDMMmmmO, with A=N or S and O=E or W. */
 QString IgcLogger::formatPosition(const QPoint& position)
 {
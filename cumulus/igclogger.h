@@ -61,10 +61,10 @@
 #include <QStringList>
 #include <QTextStream>
 #include <QTime>
+#include <QVector>
 
 #include "altitude.h"
 #include "calculator.h"
-#include "limitedlist.h"
 
 class QMutex;
 
@@ -170,9 +170,10 @@ public slots:
   void slotMakeFixEntry();
 
   /** Call this slot, if a task sector has been touched to increase
-   *  logger interval for a certain time.
+   *  logger interval for a certain time. A valid passage time is logged
+   *  as turn point confirmation event.
    */
-  void slotTaskSectorTouched();
+  void slotTaskSectorTouched( const QTime& passageTime );
 
   /**
    * This slot is called to indicate that a new satellite constellation is
@@ -259,11 +260,91 @@ private:
    */
   IgcLogger(QObject* parent = static_cast<QObject *>(0) );
 
+  /**
+   * The raw data of a B-Record. Fixes are kept in this form in the backtrack
+   * and are formatted only, when they are written to the log file.
+   */
+  struct Fix
+  {
+    QTime time;
+    QPoint position;
+    int stdAltitude;
+    int gnssAltitude;
+    int fixAccuracy;
+    int satsInUse;
+    QString constellation;
+
+    /** Wall clock time, when the fix was taken into the backtrack. */
+    QTime recorded;
+  };
+
+  /** Maximum number of fixes in the backtrack. */
+  enum { BacktrackSize = 60 };
+
+  /** Size of the record write buffer in bytes. */
+  enum { WriteBufferSize = 4096 };
+
+  /**
+   * Writes a B-Record of the passed fix into the write buffer.
+   */
+  void writeBRecord( const Fix& fix );
+
+  /**
+   * Writes a F-Record with the passed time and constellation into the write
+   * buffer.
+   */
+  void writeFRecord( const QTime& time, const QString& constellation );
+
   /**
    * Writes a K-Record, if all conditions are true.
    */
   void writeKRecord( const QTime& timeFix );
 
+  /**
+   * Writes an E-Record with the passed time and three letter event code
+   * into the write buffer.
+   */
+  void writeERecord( const QTime& time, const char* code );
+
+  /**
+   * Appends a record and the line end to the write buffer. If the record does
+   * not fit into the buffer, the buffer is written out before.
+   */
+  void appendRecord( const char* record, const int length );
+
+  /**
+   * Writes the buffered records into the log file. The records are only
+   * written, if the flush interval is elapsed since the last flush or if
+   * force is true. The file data are synchronized with the disk afterwards.
+   *
+   * \param fixTime Time of the current fix
+   * \param force Write the buffered records in every case
+   */
+  void flushRecords( const QTime& fixTime, const bool force );
+
+  /**
+   * Adds a fix to the backtrack. If the backtrack is full, the oldest fix
+   * is overwritten.
+   */
+  void addBacktrack( const Fix& fix );
+
+  /**
+   * @return The oldest fix in the backtrack. The backtrack must not be empty.
+   */
+  const Fix& oldestBacktrack() const
+  {
+    return _backtrack[ (_backtrackHead - _backtrackCount + BacktrackSize) % BacktrackSize ];
+  };
+
+  /**
+   * Removes all fixes from the backtrack.
+   */
+  void clearBacktrack()
+  {
+    _backtrackHead = 0;
+    _backtrackCount = 0;
+  };
+
   /**
    * Creates a log file, if it not yet already exists and writes the header items
    * into it.
@@ -292,12 +373,6 @@ private:
    */
   void makeSatConstEntry(const QTime &time);
 
-  /**
-   * This function formats an Altitude to the correct format
-   * for IGC files (XXXXX)
-   */
-  QString formatAltitude(Altitude altitude);
-
   /**
    * This function formats a QTime to the correct format for igc
    * files (HHMMSS)
@@ -311,12 +386,6 @@ private:
    */
   QString formatPosition(const QPoint& position);
 
-  /**
-   * This function formats the variometer speed value in meters with sign +/-,
-   * 3 numbers with 3 decimal numbers.
-   */
-  QString formatVario(const Speed vSpeed);
-
   /**
    * Creates a new filename for the IGC file according to the IGC
    * standards (IGC GNSS FR Specification, may 2002, Section 2.5)
@@ -344,12 +413,25 @@ private:
   /** A timer for closing the logfile after a certain timeout.*/
   QTimer* closeTimer;
 
-  /** The text stream object to write our data to. */
+  /** The text stream object to write the header to. */
   QTextStream _stream;
 
-  /** This is our log file. It is being used via the _stream object. */
+  /** This is our log file. The header is written via the _stream object,
+   *  the records via the write buffer. */
   QFile _logfile;
 
+  /** Buffer for the records, which are not yet written to the log file. */
+  char _writeBuffer[WriteBufferSize];
+
+  /** Number of used bytes in the write buffer. */
+  int _writeLength;
+
+  /** Interval in seconds, after that the buffered records are written out. */
+  int _flushInterval;
+
+  /** Fix time of the last write out of the buffered records. */
+  QTime _lastFlush;
+
   /** Contains the current active logging mode. */
   LogMode _logMode;
 
@@ -374,13 +456,19 @@ private:
   /** Date and time of logging start. */
   QDateTime startLogging;
 
-  /** List of last would-be log entries.
-    * This list is filled when in standby mode with strings that would be
+  /** Ring of the last would-be log entries.
+    * This ring is filled when in standby mode with the fixes that would be
     * in the log were logging enabled. When a change in flight mode is detected
-    * and logging is triggered, the list is used to write out some older events
+    * and logging is triggered, the ring is used to write out some older events
     * to the log. This way, we can be sure that the complete start sequence is
     * available in the log. */
-  LimitedList<QStringList> _backtrack;
+  QVector<Fix> _backtrack;
+
+  /** Index in the backtrack, where the next fix is stored. */
+  int _backtrackHead;
+
+  /** Number of fixes in the backtrack. */
+  int _backtrackCount;
 
   /** Stores the flight number for this day */
   int flightNumber;
@@ -305,40 +305,46 @@ int Ipc::Server::connect2Client(uint index)
  */
 int Ipc::Server::readMsg(  uint index, void *data, int length )
 {
-  QString method = QString( "Ipc::Server::readMsg(%1): ").arg(index );
-
+  // Note, the method name is only formatted in the error case. This method
+  // is called for every GPS data message.
   if ( getClientSock(index) == -1 )
     {
-      cerr << method.toLatin1().data()
+      cerr << "Ipc::Server::readMsg(" << index << "): "
            << "No client connection is established!" << endl;
 
       errno = ENOTCONN;
       return -1;
     }
 
+  char *buf = static_cast<char *>( data );
   int done = 0;
 
-  memset( data, 0, length ); // clear data buffer
-
-  while (1)
+  // A message can arrive in several parts. We read until the requested
+  // length is complete or the peer has closed the connection.
+  while ( done < length )
     {
-      done = read( clientSocks[index], data, length );
+      int bytes = read( clientSocks[index], buf + done, length - done );
 
-      if ( done < 0 )
+      if ( bytes < 0 )
         {
           if ( errno == EINTR )
             {
               continue; // Ignore interrupts
             }
 
-          cerr << method.toLatin1().data()
+          cerr << "Ipc::Server::readMsg(" << index << "): "
                << "read() returns with ERROR: errno="
                << errno
                << ", " << strerror(errno) << endl;
           return -1;
         }
 
-      break;
+      if ( bytes == 0 )
+        {
+          break; // connection closed by peer
+        }
+
+      done += bytes;
     }
 
   return done;
@@ -128,7 +128,8 @@ public:
         int closeListenSock();
 
         /**
-         * Reads once data from the connected client socket and returns.
+         * Reads the requested number of bytes from the connected client socket.
+         * Less bytes are returned, if the client has closed the connection.
          * @return -1 in error case or number of read bytes
          */
         int readMsg( uint index, void *data, int length );
@@ -20,7 +20,7 @@
 
 #include <QtCore>
 
-#include <QPainterPath>
+#include <QPainter>
 #include <QString>
 #include <QSize>
 
@@ -42,35 +42,23 @@ Isohypse::Isohypse( QPolygon elevationCoordinates,
 Isohypse::~Isohypse()
 {}
 
-QPainterPath* Isohypse::drawRegion( QPainter* targetP,
-                                       bool isolines )
+bool Isohypse::drawRegion( QPainter* targetP, bool isolines )
 {
-  QPainterPath *ppath = static_cast<QPainterPath *> (0);
-
   if( !glMapMatrix->isVisible(bBox, getTypeID() ) || projPolygon.size() < 3 )
     {
-      return ppath;
+      return false;
     }
 
-  QPolygon mP = glMapMatrix->map(projPolygon);
+  // The polygon is simplified according to the map scale and clipped at
+  // the map border. It is reused, if the map matrix was not changed.
+  const QVector<QPolygon>& polygons = mapPolygons();
 
-  if (mP.boundingRect().isNull())
+  if( polygons.isEmpty() || polygons.at(0).boundingRect().isNull() )
     {
       // ignore null values
-      return ppath;
+      return false;
     }
 
-  ppath = new QPainterPath;
-
-  ppath->moveTo( mP.at(0) );
-
-  for( int i = 1; i < mP.size(); i++ )
-    {
-      ppath->lineTo( mP.at(i) );
-    }
-
-  ppath->closeSubpath();
-
   targetP->save();
 
   if( isolines )
@@ -82,8 +70,8 @@ QPainterPath* Isohypse::drawRegion( QPainter* targetP,
       targetP->setPen(pen);
     }
 
-  targetP->drawPath( *ppath );
+  targetP->drawPolygon( polygons.at(0) );
   targetP->restore();
 
-  return ppath;
+  return true;
 }
@@ -61,11 +61,9 @@ class Isohypse : public LineElement
      * @param targetP The painter to draw the element into.
      * @param isolines Switches outline drawing on/off
      *
-     * @return The projected region polygon as QPainterPath object usable
-     *         for later elevation finding.
+     * @return true, if the region was drawn otherwise false.
      */
-    QPainterPath* drawRegion( QPainter* targetP,
-                               bool isolines = false );
+    bool drawRegion( QPainter* targetP, bool isolines = false );
 
     /**
      * @return the elevation of the line
@@ -14,6 +14,8 @@
  **
  ***********************************************************************/
 
+#include <cmath>
+
 #include <QtCore>
 
 #include "lineelement.h"
@@ -22,7 +24,8 @@
 LineElement::LineElement() :
   BaseMapElement(),
   valley(false),
-  closed(false)
+  closed(false),
+  screenGeneration(0)
 {
 }
 
@@ -36,7 +39,8 @@ LineElement::LineElement( const QString& name,
     projPolygon(pP),
     bBox(pP.boundingRect()),
     valley(isV),
-    closed(false)
+    closed(false),
+    screenGeneration(0)
 {
   if( typeID == BaseMapElement::Lake ||
       typeID == BaseMapElement::City ||
@@ -126,10 +130,18 @@ bool LineElement::drawMapElement(QPainter* targetP)
       break;
     }
 
-  QPolygon mP( glMapMatrix->map(projPolygon) );
+  const QVector<QPolygon>& polygons = mapPolygons();
 
   // Save screen bounding box
-  sbBox = mP.boundingRect();
+  for( int i = 0; i < polygons.size(); i++ )
+    {
+      sbBox |= polygons.at(i).boundingRect();
+    }
+
+  if( polygons.isEmpty() )
+    {
+      return false;
+    }
 
   if(typeID == BaseMapElement::City)
     {
@@ -139,7 +151,7 @@ bool LineElement::drawMapElement(QPainter* targetP)
       // @AP: Not clear what is meant.
       targetP->setPen(glConfig->getDrawPen(typeID));
       targetP->setBrush(glConfig->getDrawBrush(typeID));
-      targetP->drawPolygon(mP);
+      targetP->drawPolygon(polygons.at(0));
       return true;
     }
 
@@ -151,18 +163,311 @@ bool LineElement::drawMapElement(QPainter* targetP)
       // Lakes do not have a brush, because they are divided into normal
       // sections and we do not want to see section borders in a lake ...
       targetP->setBrush(glConfig->getDrawBrush(typeID));
-      targetP->drawPolygon(mP);
+      targetP->drawPolygon(polygons.at(0));
       return true;
   }
 
-  targetP->drawPolyline(mP);
+  for( int i = 0; i < polygons.size(); i++ )
+    {
+      targetP->drawPolyline(polygons.at(i));
+    }
 
   if(typeID == BaseMapElement::Motorway && drawP.width() > 4)
     {
       // draw the white line in the middle
       targetP->setPen( QPen(Qt::white, Layout::getIntScaledDensity()) );
-      targetP->drawPolyline(mP);
+
+      for( int i = 0; i < polygons.size(); i++ )
+        {
+          targetP->drawPolyline(polygons.at(i));
+        }
     }
 
   return true;
 }
+
+const QVector<QPolygon>& LineElement::mapPolygons()
+{
+  if( screenGeneration == glMapMatrix->getMatrixGeneration() )
+    {
+      // The map matrix is unchanged, the last result can be reused.
+      return screenPolygons;
+    }
+
+  screenPolygons.clear();
+  screenGeneration = glMapMatrix->getMatrixGeneration();
+
+  const QTransform& matrix = glMapMatrix->getWorldMatrix();
+
+  // Size of a pixel in projected units
+  const double pixelSize = 1.0 / sqrt( matrix.m11() * matrix.m11() +
+                                       matrix.m12() * matrix.m12() );
+
+  // Use the coarsest level, which deviates not more than half a pixel.
+  int level = 0;
+
+  while( level + 1 < LodLevels && ldexp( 0.25, level + 1 ) <= pixelSize * 0.5 )
+    {
+      level++;
+    }
+
+  const QPolygon& polygon = lodPolygon( level );
+  const bool closedPolygon = isClosedPolygon();
+
+  if( polygon.size() < (closedPolygon ? 3 : 2) )
+    {
+      return screenPolygons;
+    }
+
+  // The clip border lies some pixels outside of the map, so that no line
+  // ends or pen edges become visible.
+  const int margin = static_cast<int> (ceil( pixelSize * 8.0 ));
+  const QRect border = glMapMatrix->getMapBorder().adjusted( -margin, -margin,
+                                                              margin, margin );
+
+  if( border.contains( bBox ) )
+    {
+      screenPolygons.append( matrix.map( polygon ) );
+      return screenPolygons;
+    }
+
+  if( closedPolygon )
+    {
+      QPolygon clipped = clipPolygon( polygon, border );
+
+      if( clipped.size() >= 3 )
+        {
+          screenPolygons.append( matrix.map( clipped ) );
+        }
+
+      return screenPolygons;
+    }
+
+  clipPolyline( polygon, border, screenPolygons );
+
+  for( int i = 0; i < screenPolygons.size(); i++ )
+    {
+      screenPolygons[i] = matrix.map( screenPolygons.at(i) );
+    }
+
+  return screenPolygons;
+}
+
+const QPolygon& LineElement::lodPolygon( const int level )
+{
+  if( level == 0 )
+    {
+      return projPolygon;
+    }
+
+  if( lodPolygons.size() != LodLevels )
+    {
+      lodPolygons.resize( LodLevels );
+    }
+
+  if( lodPolygons.at(level).isEmpty() && projPolygon.isEmpty() == false )
+    {
+      lodPolygons[level] = simplify( projPolygon, ldexp( 0.25, level ) );
+    }
+
+  return lodPolygons.at(level);
+}
+
+QPolygon LineElement::simplify( const QPolygon& polygon, const double tolerance )
+{
+  const int size = polygon.size();
+
+  if( size < 3 )
+    {
+      return polygon;
+    }
+
+  QVector<bool> keep( size, false );
+  keep[0] = true;
+  keep[size - 1] = true;
+
+  // Ranges, which have still to be examined. An explicit stack is used,
+  // because long lines would need a deep recursion.
+  QVector<QPair<int, int> > stack;
+  stack.append( qMakePair( 0, size - 1 ) );
+
+  const double tolerance2 = tolerance * tolerance;
+
+  while( stack.isEmpty() == false )
+    {
+      const QPair<int, int> range = stack.last();
+      stack.removeLast();
+
+      const QPoint& a = polygon.at( range.first );
+      const QPoint& b = polygon.at( range.second );
+
+      const double dx = b.x() - a.x();
+      const double dy = b.y() - a.y();
+      const double len2 = dx * dx + dy * dy;
+
+      double maxDist2 = 0.0;
+      int index = -1;
+
+      for( int i = range.first + 1; i < range.second; i++ )
+        {
+          const double px = polygon.at(i).x() - a.x();
+          const double py = polygon.at(i).y() - a.y();
+
+          double dist2;
+
+          if( len2 == 0.0 )
+            {
+              // Start and end are equal, that is normal for a closed line.
+              dist2 = px * px + py * py;
+            }
+          else
+            {
+              const double cross = px * dy - py * dx;
+              dist2 = cross * cross / len2;
+            }
+
+          if( dist2 > maxDist2 )
+            {
+              maxDist2 = dist2;
+              index = i;
+            }
+        }
+
+      if( index != -1 && maxDist2 > tolerance2 )
+        {
+          keep[index] = true;
+          stack.append( qMakePair( range.first, index ) );
+          stack.append( qMakePair( index, range.second ) );
+        }
+    }
+
+  QPolygon result;
+
+  for( int i = 0; i < size; i++ )
+    {
+      if( keep.at(i) )
+        {
+          result.append( polygon.at(i) );
+        }
+    }
+
+  return result;
+}
+
+QPolygon LineElement::clipPolygon( const QPolygon& polygon, const QRect& rect )
+{
+  QPolygon input = polygon;
+  QPolygon output;
+
+  // The polygon is clipped at the four edges one after another.
+  for( int edge = 0; edge < 4 && input.isEmpty() == false; edge++ )
+    {
+      output.clear();
+
+      QPoint prev = input.last();
+
+      for( int i = 0; i < input.size(); i++ )
+        {
+          const QPoint& cur = input.at(i);
+
+          bool curIn, prevIn;
+          double limit;
+
+          switch( edge )
+            {
+              case 0:
+                limit = rect.left();
+                curIn = cur.x() >= limit;
+                prevIn = prev.x() >= limit;
+                break;
+              case 1:
+                limit = rect.right();
+                curIn = cur.x() <= limit;
+                prevIn = prev.x() <= limit;
+                break;
+              case 2:
+                limit = rect.top();
+                curIn = cur.y() >= limit;
+                prevIn = prev.y() >= limit;
+                break;
+              default:
+                limit = rect.bottom();
+                curIn = cur.y() <= limit;
+                prevIn = prev.y() <= limit;
+                break;
+            }
+
+          if( curIn != prevIn )
+            {
+              // Add the intersection point of the edge
+              QPoint cut;
+
+              if( edge < 2 )
+                {
+                  const double t = (limit - prev.x()) / double(cur.x() - prev.x());
+                  cut = QPoint( static_cast<int> (limit),
+                                qRound( prev.y() + t * (cur.y() - prev.y()) ) );
+                }
+              else
+                {
+                  const double t = (limit - prev.y()) / double(cur.y() - prev.y());
+                  cut = QPoint( qRound( prev.x() + t * (cur.x() - prev.x()) ),
+                                static_cast<int> (limit) );
+                }
+
+              output.append( cut );
+            }
+
+          if( curIn )
+            {
+              output.append( cur );
+            }
+
+          prev = cur;
+        }
+
+      input = output;
+    }
+
+  return output;
+}
+
+void LineElement::clipPolyline( const QPolygon& polygon,
+                                const QRect& rect,
+                                QVector<QPolygon>& parts )
+{
+  QPolygon part;
+
+  for( int i = 1; i < polygon.size(); i++ )
+    {
+      const QPoint& a = polygon.at(i - 1);
+      const QPoint& b = polygon.at(i);
+
+      // A segment is kept, if its bounding box touches the rectangle. That is
+      // not exact but the rest is done by the painter.
+      const bool visible = qMax( a.x(), b.x() ) >= rect.left() &&
+                           qMin( a.x(), b.x() ) <= rect.right() &&
+                           qMax( a.y(), b.y() ) >= rect.top() &&
+                           qMin( a.y(), b.y() ) <= rect.bottom();
+
+      if( visible )
+        {
+          if( part.isEmpty() )
+            {
+              part.append( a );
+            }
+
+          part.append( b );
+        }
+      else if( part.isEmpty() == false )
+        {
+          parts.append( part );
+          part.clear();
+        }
+    }
+
+  if( part.isEmpty() == false )
+    {
+      parts.append( part );
+    }
+}
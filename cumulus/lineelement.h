@@ -19,6 +19,9 @@
 #ifndef LINE_ELEMENT_H
 #define LINE_ELEMENT_H
 
+#include <QPolygon>
+#include <QVector>
+
 #include "basemapelement.h"
 
 /**
@@ -119,9 +122,34 @@ class LineElement : public BaseMapElement
     {
       projPolygon = newPolygon;
       bBox = newPolygon.boundingRect();
+
+      // The cached geometry belongs to the old polygon.
+      lodPolygons.clear();
+      screenPolygons.clear();
+      screenGeneration = 0;
     };
 
 protected:
+
+    /**
+     * Returns the element as screen polygons. The projected polygon is
+     * simplified to a level of detail, which fits to the current map scale.
+     * Parts lying outside of the map are clipped before the mapping. A closed
+     * element results in one polygon, a line in one polygon per visible part.
+     * The result is cached until the map matrix is changed.
+     *
+     * @return The screen polygons, can be empty.
+     */
+    const QVector<QPolygon>& mapPolygons();
+
+    /**
+     * @return True, if the element is drawn as closed polygon.
+     */
+    bool isClosedPolygon() const
+    {
+      return closed || typeID == BaseMapElement::Isohypse;
+    };
+
     /**
      * Contains the projected positions of the line element.
      */
@@ -147,6 +175,50 @@ protected:
      * "true", if the element is a closed polygon (like cities).
      */
     bool closed;
+
+private:
+
+    /** Number of simplified polygon levels. */
+    enum { LodLevels = 7 };
+
+    /**
+     * @return The projected polygon simplified with the tolerance of the
+     * passed level. Level 0 is the original polygon.
+     */
+    const QPolygon& lodPolygon( const int level );
+
+    /**
+     * Simplifies a polygon with the algorithm of Douglas and Peucker.
+     *
+     * @param polygon The polygon to be simplified
+     * @param tolerance The maximum deviation in projected units
+     * @return The simplified polygon
+     */
+    static QPolygon simplify( const QPolygon& polygon, const double tolerance );
+
+    /**
+     * Clips a closed polygon at a rectangle (Sutherland-Hodgman).
+     */
+    static QPolygon clipPolygon( const QPolygon& polygon, const QRect& rect );
+
+    /**
+     * Splits a line into the parts, which lie inside of the rectangle.
+     */
+    static void clipPolyline( const QPolygon& polygon,
+                              const QRect& rect,
+                              QVector<QPolygon>& parts );
+
+    /**
+     * Simplified polygons, level k has a tolerance of 2^k/4 projected units.
+     * They are built on demand.
+     */
+    QVector<QPolygon> lodPolygons;
+
+    /** Screen polygons of the last draw. */
+    QVector<QPolygon> screenPolygons;
+
+    /** Map matrix generation of the screen polygons, 0 means invalid. */
+    uint screenGeneration;
 };
 
 #endif
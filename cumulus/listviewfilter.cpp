@@ -26,9 +26,9 @@
 // Button[1] can be the home button
 const int ListViewFilter::buttonCount = 5;
 
-ListViewFilter::ListViewFilter(QTreeWidget *tw, QWidget *parent) : QWidget(parent)
+ListViewFilter::ListViewFilter(QTreeView *tv, QWidget *parent) : QWidget(parent)
 {
-  _tw = tw;
+  _tv = tv;
   QHBoxLayout* layout=new QHBoxLayout(this);
   layout->setContentsMargins( 0, 0, 0, 5 );
   setMinimumWidth( 5*40 );
@@ -41,6 +41,12 @@ ListViewFilter::ListViewFilter(QTreeWidget *tw, QWidget *parent) : QWidget(paren
   _filterIndex=0;
   m_isTopButtonContained=false;
 
+  _sortModel = new QSortFilterProxyModel( this );
+  _sortModel->setDynamicSortFilter( true );
+
+  _rangeModel = new ListViewFilterModel( this );
+  _rangeModel->setSourceModel( _sortModel );
+
   for( int i = 0; i != buttonCount; i++)
     {
       QPushButton *cmd = new QPushButton(this);
@@ -51,16 +57,14 @@ ListViewFilter::ListViewFilter(QTreeWidget *tw, QWidget *parent) : QWidget(paren
       connect(cmd, SIGNAL(pressed()), smap, SLOT(map()));
     }
 
-  if( tw->topLevelItemCount() < 8 )
-    {
-      this->setVisible( false );
-    }
+  // The list is empty up to now.
+  this->setVisible( false );
 
   // calculate the needed icon size
   QFontMetrics qfm( font() );
   int iconSize = qfm.height() - 8;
 
-  tw->setIconSize( QSize(iconSize, iconSize) );
+  tv->setIconSize( QSize(iconSize, iconSize) );
 }
 
 ListViewFilter::~ListViewFilter()
@@ -74,36 +78,20 @@ ListViewFilter::~ListViewFilter()
     }
 }
 
-void ListViewFilter::addListItem( QTreeWidgetItem* it )
+void ListViewFilter::setSourceModel( QAbstractItemModel* model )
 {
-  if( it == static_cast<QTreeWidgetItem *> (0) )
-    {
-      return;
-    }
-
-  _tw->addTopLevelItem( it );
+  _sortModel->setSourceModel( model );
+  _tv->setModel( _rangeModel );
 }
 
-void ListViewFilter::removeListItem( QTreeWidgetItem* it )
+QModelIndex ListViewFilter::mapToSource( const QModelIndex& viewIndex ) const
 {
-  if( it == static_cast<QTreeWidgetItem *> (0) )
-    {
-      return;
-    }
-
-  // Note! According to QtForum removeItemWidget removes not the item in the tree.
-  // The method takeTopLevelItem has to be used instead.
-  int idx = _tw->indexOfTopLevelItem(it);
-
-  if( idx != -1 )
-    {
-      QTreeWidgetItem* item = _tw->takeTopLevelItem( idx );
+  return _sortModel->mapToSource( _rangeModel->mapToSource( viewIndex ) );
+}
 
-      if( item )
-        {
-          delete item;
-        }
-    }
+QModelIndex ListViewFilter::mapFromSource( const QModelIndex& sourceIndex ) const
+{
+  return _rangeModel->mapFromSource( _sortModel->mapFromSource( sourceIndex ) );
 }
 
 void ListViewFilter::reset()
@@ -111,20 +99,25 @@ void ListViewFilter::reset()
   // qDebug() << "ListViewFilter::reset()";
   clear();
 
-  if( _tw == static_cast<QTreeWidget *> (0) || _tw->topLevelItemCount() == 0 )
+  if( _sortModel->sourceModel() == static_cast<QAbstractItemModel *> (0) )
     {
       return;
     }
 
-  _tw->sortItems( 0, Qt::AscendingOrder );
+  // The proxy keeps the sort order, when rows are added or changed.
+  _sortModel->sort( 0, Qt::AscendingOrder );
+
+  int rows = _sortModel->rowCount();
 
   // switch on all list elements
-  for( int i = 0; i < _tw->topLevelItemCount(); i++ )
+  _rangeModel->setRange( 0, rows );
+
+  if( rows == 0 )
     {
-      _tw->topLevelItem( i )->setHidden( false );
+      return;
     }
 
-  if( _tw->topLevelItemCount() < 6 )
+  if( rows < 6 )
     {
       this->setVisible( false );
     }
@@ -134,10 +127,10 @@ void ListViewFilter::reset()
     }
 
   // setup a new root filter
-  _rootFilter = new ListViewFilterItem( _tw, 0 );
+  _rootFilter = new ListViewFilterItem( _tv, _sortModel, _rangeModel, 0 );
 
   _rootFilter->beginIdx = 0;
-  _rootFilter->endIdx   = _tw->topLevelItemCount();
+  _rootFilter->endIdx   = rows;
 
   QList<ListViewFilterItem *> itemList;
   itemList.append( _rootFilter );
@@ -485,9 +478,14 @@ void ListViewFilter::off()
   _rootFilter->showFilterItems();
 }
 
-ListViewFilterItem::ListViewFilterItem(QTreeWidget *tw, ListViewFilterItem *parent) :
+ListViewFilterItem::ListViewFilterItem( QTreeView *tv,
+                                        QAbstractItemModel *model,
+                                        ListViewFilterModel *range,
+                                        ListViewFilterItem *parent ) :
   _parent( parent ),
-  _tw(tw),
+  _tv(tv),
+  _model(model),
+  _range(range),
   from(""),
   to(""),
   buttonText(""),
@@ -609,7 +607,7 @@ void ListViewFilterItem::divide( int partCount, QList<ListViewFilterItem *> &sub
   // into the result list.
   for( int i = 1; i <= partCount; i++ )
     {
-      ListViewFilterItem *itm = new ListViewFilterItem( _tw, this );
+      ListViewFilterItem *itm = new ListViewFilterItem( _tv, _model, _range, this );
 
       itm->from = itemTextAt( pos[i - 1] + 1 ).left( diff[i - 1] );
       itm->to   = itemTextAt( pos[i] ).left( diff[i] );
@@ -632,15 +630,13 @@ void ListViewFilterItem::divide( int partCount, QList<ListViewFilterItem *> &sub
 /** Returns the first text element at the item position */
 QString ListViewFilterItem::itemTextAt( const int pos )
 {
-  QTreeWidgetItem *it = _tw->topLevelItem( pos );
-
-  if( it )
+  if( pos < 0 || pos >= _model->rowCount() )
     {
-      // qDebug() << "Pos=" << pos << "Text=" << it->text(0);
-      return it->text(0);
+      return "";
     }
 
-  return "";
+  // Only the name of the requested row is fetched from the list model.
+  return _model->index( pos, 0 ).data().toString();
 }
 
 int ListViewFilterItem::diffLevel(const QString& s1, const QString& s2)
@@ -668,27 +664,42 @@ int ListViewFilterItem::diffLevel(const QString& s1, const QString& s2)
 /** Make all items of the filter visible. */
 void ListViewFilterItem::showFilterItems()
 {
-  // switch off all list elements
-  for( int i = 0; i < beginIdx && i < _tw->topLevelItemCount(); i++ )
-    {
-      _tw->topLevelItem( i )->setHidden( true );
-    }
-
-  // switch on all list elements
-  for( int i = beginIdx; i < endIdx && i < _tw->topLevelItemCount(); i++ )
-    {
-      _tw->topLevelItem( i )->setHidden( false );
-    }
-
-  // switch off all list elements
-  for( int i = endIdx; i < _tw->topLevelItemCount(); i++ )
-    {
-      _tw->topLevelItem( i )->setHidden( true );
-    }
+  // The range model passes only the rows of this filter to the view.
+  _range->setRange( beginIdx, endIdx );
 
   if( itemCount() > 0 )
     {
       // Set focus at first list item
-      _tw->setCurrentItem( _tw->topLevelItem( beginIdx ) );
+      _tv->setCurrentIndex( _tv->model()->index( 0, 0 ) );
     }
 }
+
+ListViewFilterModel::ListViewFilterModel( QObject* parent ) :
+  QSortFilterProxyModel( parent ),
+  m_begin( 0 ),
+  m_end( 0 )
+{
+  setDynamicSortFilter( true );
+}
+
+ListViewFilterModel::~ListViewFilterModel()
+{
+}
+
+void ListViewFilterModel::setRange( const int begin, const int end )
+{
+  // The filter is always evaluated again because the rows of the source
+  // model can be moved by an insertion or removal.
+  m_begin = begin;
+  m_end   = end;
+
+  invalidateFilter();
+}
+
+bool ListViewFilterModel::filterAcceptsRow( int sourceRow,
+                                            const QModelIndex& sourceParent ) const
+{
+  Q_UNUSED( sourceParent )
+
+  return sourceRow >= m_begin && sourceRow < m_end;
+}
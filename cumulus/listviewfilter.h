@@ -19,21 +19,24 @@
 
 #include <QWidget>
 #include <QList>
-#include <QTreeWidget>
+#include <QTreeView>
 #include <QPushButton>
+#include <QSortFilterProxyModel>
 #include <QString>
 
+class ListViewFilterModel;
+
 /**
  * \class ListViewFilterItem
  *
  * \author André Somers, Axel Pauli
  *
- * \brief Filter item of a QTreeWidget list.
+ * \brief Filter item of a sorted list model.
  *
  * \see ListViewFilter
  *
  * Creates a filter item as subset of a bigger list. This class is used by the
- * \ref ListViewFilter class.
+ * \ref ListViewFilter class. The indexes are rows of the sorted model.
  *
  * \date 2004-2015
  */
@@ -50,7 +53,9 @@ class ListViewFilterItem : QObject
 
 public:
 
-  ListViewFilterItem( QTreeWidget *tw,
+  ListViewFilterItem( QTreeView *tv,
+                      QAbstractItemModel *model,
+                      ListViewFilterModel *range,
                       ListViewFilterItem* parent=static_cast<ListViewFilterItem *>(0) );
 
   virtual ~ListViewFilterItem();
@@ -83,8 +88,14 @@ public:
   /** Reference to ListViewFilterItem one level higher than this instance. */
   ListViewFilterItem *_parent;
 
-  /** Pointer to tree widget with all list elements. */
-  QTreeWidget *_tw;
+  /** Pointer to the tree view displaying the list elements. */
+  QTreeView *_tv;
+
+  /** Sorted model with all list elements. */
+  QAbstractItemModel *_model;
+
+  /** Range model, which restricts the view to the filter items. */
+  ListViewFilterModel *_range;
 
   /** Holds the first letter(s) for the filter. */
   QString from;
@@ -95,10 +106,10 @@ public:
   /** Holds the text of the assigned button. */
   QString buttonText;
 
-  /** Begin index of this filter item in the tree widget. */
+  /** Begin index of this filter item in the sorted model. */
   int beginIdx;
 
-  /** End index of this filter item in the tree widget. */
+  /** End index of this filter item in the sorted model. */
   int endIdx;
 
   /** Set of filters that further subdivides the result of this filter. */
@@ -109,16 +120,65 @@ private:
   int diffLevel(const QString&, const QString&);
 };
 
+/**
+ * \class ListViewFilterModel
+ *
+ * \author Cumulus contributors
+ *
+ * \brief Proxy model, which passes a range of rows of its source model.
+ *
+ * \see ListViewFilter
+ *
+ * \date 2026
+ */
+class ListViewFilterModel : public QSortFilterProxyModel
+{
+  Q_OBJECT
+
+private:
+  /**
+   * That macro forbids the copy constructor and the assignment operator.
+   */
+  Q_DISABLE_COPY( ListViewFilterModel )
+
+public:
+
+  ListViewFilterModel( QObject* parent=static_cast<QObject *>(0) );
+
+  virtual ~ListViewFilterModel();
+
+  /**
+   * Sets the range of the passed source rows.
+   *
+   * \param begin First row of the range.
+   * \param end Row behind the last row of the range.
+   */
+  void setRange( const int begin, const int end );
+
+protected:
+
+  virtual bool filterAcceptsRow( int sourceRow, const QModelIndex& sourceParent ) const;
+
+private:
+
+  int m_begin;
+  int m_end;
+};
+
 /**
  * \class ListViewFilter
  *
  * \author André Somers, Axel Pauli
  *
- * \brief Creates a filter bar for a QTreeWidget
+ * \brief Creates a filter bar for a QTreeView
  *
  * \see ListViewFilterItem
  *
- * Creates a filter bar for a QTreeWidget in order to quickly filter the list view.
+ * Creates a filter bar for a QTreeView in order to quickly filter the list
+ * view. The list model is sorted by a proxy model. A second proxy model
+ * passes only the rows of the active filter to the view. Both proxies
+ * update their mappings incrementally, if rows are added, removed or
+ * changed in the list model.
  *
  * \date 2004-2015
  */
@@ -140,19 +200,30 @@ private:
 public:
 
   /**
-   * \param tw A pointer to the list view this filter works on.
+   * \param tv A pointer to the list view this filter works on.
    *
    * \param parent A pointer to the parent widget.
    */
-  ListViewFilter( QTreeWidget* tw, QWidget* parent=static_cast<QWidget *>(0) );
+  ListViewFilter( QTreeView* tv, QWidget* parent=static_cast<QWidget *>(0) );
 
   virtual ~ListViewFilter();
 
-  /** Adds a item to the list. */
-  void addListItem(QTreeWidgetItem* it);
+  /**
+   * Sets the list model. The view displays it sorted by the first column
+   * and restricted to the rows of the active filter.
+   */
+  void setSourceModel( QAbstractItemModel* model );
+
+  /**
+   * Maps an index of the view to the index of the list model.
+   */
+  QModelIndex mapToSource( const QModelIndex& viewIndex ) const;
 
-  /** Removes an item from the list. */
-  void removeListItem(QTreeWidgetItem* it);
+  /**
+   * Maps an index of the list model to the index of the view. The returned
+   * index is invalid, if the row is not part of the active filter.
+   */
+  QModelIndex mapFromSource( const QModelIndex& sourceIndex ) const;
 
   /**
    * Resets all filters to the root filter.
@@ -208,7 +279,13 @@ private:
   };
 
   /** Pointer to display table view */
-  QTreeWidget* _tw;
+  QTreeView* _tv;
+
+  /** Sorts the list model by the first column. */
+  QSortFilterProxyModel* _sortModel;
+
+  /** Restricts the sorted model to the active filter. */
+  ListViewFilterModel* _rangeModel;
 
   /** List of filter buttons. */
   QList<QPushButton *> _buttonList;
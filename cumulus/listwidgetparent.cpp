@@ -30,28 +30,25 @@
 
 ListWidgetParent::ListWidgetParent( QWidget *parent, bool showMovePage ) :
   QWidget(parent),
-  m_enableScroller(0)
+  m_enableScroller(0),
+  model(0)
 {
   setObjectName("ListWidgetParent");
 
   QVBoxLayout *topLayout = new QVBoxLayout( this );
   topLayout->setContentsMargins( 0, 0, 0, 0  );
 
-  list = new QTreeWidget( this );
+  list = new QTreeView( this );
   list->setObjectName("WpListWidgetParent");
   list->setRootIsDecorated(false);
   list->setItemsExpandable(false);
+  // Uniform rows allow the view to request only the visible rows.
   list->setUniformRowHeights(true);
   list->setAlternatingRowColors(true);
-  list->setColumnCount(4);
   list->setAllColumnsShowFocus(true);
   list->setSelectionMode(QAbstractItemView::SingleSelection);
   list->setSelectionBehavior(QAbstractItemView::SelectRows);
   list->setFocusPolicy( Qt::StrongFocus );
-
-  QStringList sl;
-  sl << tr("Name") << tr("Description") << tr("Country") << tr("ICAO");
-  list->setHeaderLabels(sl);
   list->setFocus();
 
   filter = new ListViewFilter( list, this );
@@ -121,8 +118,8 @@ ListWidgetParent::ListWidgetParent( QWidget *parent, bool showMovePage ) :
       down->setVisible( false );
     }
 
-  connect( list, SIGNAL( itemClicked(QTreeWidgetItem*,int) ),
-           this, SLOT( slot_listItemClicked(QTreeWidgetItem*,int) ) );
+  connect( list, SIGNAL( clicked(const QModelIndex&) ),
+           this, SLOT( slot_listItemClicked(const QModelIndex&) ) );
 
   connect( up, SIGNAL(pressed()), this, SLOT(slot_PageUp()) );
   connect( down, SIGNAL(pressed()), this, SLOT(slot_PageDown()) );
@@ -136,6 +133,60 @@ ListWidgetParent::~ListWidgetParent()
   delete filter;
 }
 
+void ListWidgetParent::setListModel( PointListModel* newModel )
+{
+  model = newModel;
+  model->setParent( this );
+  filter->setSourceModel( model );
+}
+
+int ListWidgetParent::currentRow() const
+{
+  QModelIndex index = filter->mapToSource( list->currentIndex() );
+
+  return index.isValid() ? index.row() : -1;
+}
+
+QList<int> ListWidgetParent::selectedRows() const
+{
+  QList<int> rows;
+
+  if( list->selectionModel() == 0 )
+    {
+      return rows;
+    }
+
+  QModelIndexList indexes = list->selectionModel()->selectedRows();
+
+  for( int i = 0; i < indexes.size(); i++ )
+    {
+      QModelIndex index = filter->mapToSource( indexes.at(i) );
+
+      if( index.isValid() )
+        {
+          rows.append( index.row() );
+        }
+    }
+
+  return rows;
+}
+
+void ListWidgetParent::setCurrentRow( const int row )
+{
+  if( model == 0 )
+    {
+      return;
+    }
+
+  QModelIndex index = filter->mapFromSource( model->index( row, 0 ) );
+
+  if( index.isValid() )
+    {
+      list->setCurrentIndex( index );
+      list->scrollTo( index );
+    }
+}
+
 void ListWidgetParent::showEvent( QShowEvent *event )
 {
   Q_UNUSED(event)
@@ -197,15 +248,20 @@ void ListWidgetParent::slot_Done()
 {
   // Remove all list and filter items.
   filter->clear();
-  list->clear();
+
+  if( model )
+    {
+      model->clear();
+    }
+
   firstLoadDone = false;
 }
 
 /** This slot sends a signal to indicate that a selection has been made. */
-void ListWidgetParent::slot_listItemClicked(QTreeWidgetItem* li, int)
+void ListWidgetParent::slot_listItemClicked( const QModelIndex& index )
 {
   // qDebug("ListWidgetParent::slot_listItemClicked");
-  if( li == 0)
+  if( ! index.isValid() )
     {
       return;
     }
@@ -220,29 +276,21 @@ void ListWidgetParent::slot_PageUp()
 {
   if( up->isDown() )
     {
-      QTreeWidgetItem *item = list->currentItem();
+      QModelIndex index = list->currentIndex();
 
-      if( item )
+      if( index.isValid() )
         {
-          QModelIndex index = list->currentIndex();
           QRect rect = list->visualRect( index );
 
           // Calculate rows per page. Headline must be subtracted.
           int pageRows = ( list->height() / rect.height() ) - 1;
 
-          int itemIdx = list->indexOfTopLevelItem( item );
-          int newIdx  = itemIdx - pageRows;
+          // The view contains only the rows of the active filter.
+          int newIdx = qMax( index.row() - pageRows, 0 );
 
-          if( filter->activeFilter() )
-            {
-              if( newIdx < filter->activeFilter()->beginIdx )
-                {
-                  newIdx = filter->activeFilter()->beginIdx;
-                }
-
-              list->setCurrentItem( list->topLevelItem(newIdx) );
-              list->scrollToItem( list->topLevelItem(newIdx) );
-            }
+          QModelIndex newIndex = list->model()->index( newIdx, 0 );
+          list->setCurrentIndex( newIndex );
+          list->scrollTo( newIndex );
         }
 
       // Start repetition timer, to check, if button is longer pressed.
@@ -257,29 +305,22 @@ void ListWidgetParent::slot_PageDown()
 {
   if( down->isDown() )
     {
-      QTreeWidgetItem *item = list->currentItem();
+      QModelIndex index = list->currentIndex();
 
-      if( item )
+      if( index.isValid() )
         {
-          QModelIndex index = list->currentIndex();
           QRect rect = list->visualRect( index );
 
           // Calculate rows per page. Headline must be subtracted.
           int pageRows = ( list->height() / rect.height() ) - 1;
 
-          int itemIdx = list->indexOfTopLevelItem( item );
-          int newIdx  = itemIdx + pageRows;
-
-          if( filter->activeFilter() )
-            {
-              if( newIdx >= filter->activeFilter()->endIdx )
-                {
-                  newIdx = filter->activeFilter()->endIdx - 1;
-                }
+          // The view contains only the rows of the active filter.
+          int newIdx = qMin( index.row() + pageRows,
+                             list->model()->rowCount() - 1 );
 
-              list->setCurrentItem( list->topLevelItem(newIdx) );
-              list->scrollToItem( list->topLevelItem(newIdx) );
-            }
+          QModelIndex newIndex = list->model()->index( newIdx, 0 );
+          list->setCurrentIndex( newIndex );
+          list->scrollTo( newIndex );
         }
 
       // Start repetition timer, to check, if button is longer pressed.
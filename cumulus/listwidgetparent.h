@@ -25,7 +25,8 @@
  * This widget provides a new widget base class to remove double code in
  * the point list views and the task editor.
  * Contains standard point list and attached filters (filter button row on
- * demand).
+ * demand). The list is a view on a \ref PointListModel, which is set by
+ * the subclass. Only the visible rows are requested from the model.
  *
  * Subclassed by \ref AirfieldListWidget, \ref WaypointListWidget
  *               \ref SinglePointListWidget
@@ -39,12 +40,13 @@
 #define LISTWIDGET_PARENT_H
 
 #include <QWidget>
-#include <QTreeWidget>
+#include <QTreeView>
 #include <QItemDelegate>
 #include <QVBoxLayout>
 
 #include "waypoint.h"
 #include "listviewfilter.h"
+#include "pointlistmodel.h"
 #include "rowdelegate.h"
 
 class QCheckBox;
@@ -90,19 +92,19 @@ class ListWidgetParent : public QWidget
     void refillItemList();
 
     /**
-     * @returns a pointer to the list widget
+     * @returns a pointer to the list view
      */
-    QTreeWidget* listWidget()
+    QTreeView* listWidget()
     {
       return list;
     };
 
     /**
-     * \return The top level item count of the tree list.
+     * \return The number of rows shown in the list view.
      */
     int topLevelItemCount()
     {
-      return list->topLevelItemCount();
+      return list->model() ? list->model()->rowCount() : 0;
     };
 
     /**
@@ -134,9 +136,32 @@ class ListWidgetParent : public QWidget
 
     void showEvent( QShowEvent *event );
 
-    QTreeWidget*    list;
+    /**
+     * Sets the model of the list. Must be called by the subclass constructor.
+     */
+    void setListModel( PointListModel* model );
+
+    /**
+     * \return The model row of the current list entry or -1.
+     */
+    int currentRow() const;
+
+    /**
+     * \return The model rows of the selected list entries.
+     */
+    QList<int> selectedRows() const;
+
+    /**
+     * Makes the passed model row to the current list entry.
+     */
+    void setCurrentRow( const int row );
+
+    QTreeView*      list;
     ListViewFilter* filter;
 
+    /** Model of the list, owned by this widget. */
+    PointListModel* model;
+
     /** Up and down buttons for page moving */
     QPushButton* up;
     QPushButton* down;
@@ -156,7 +181,7 @@ class ListWidgetParent : public QWidget
     /**
      * Called from tree widget when an entry is tapped on.
      */
-    void slot_listItemClicked(QTreeWidgetItem*, int);
+    void slot_listItemClicked( const QModelIndex& index );
 
     /**
      * Called is the checkbox is toggled.
@@ -0,0 +1,198 @@
+/***********************************************************************
+ **
+ **   loaderpool.cpp
+ **
+ **   This file is part of Cumulus.
+ **
+ ************************************************************************
+ **
+ **   Copyright (c):  2026 by the Cumulus contributors
+ **
+ **   This file is distributed under the terms of the General Public
+ **   License. See the file COPYING for more information.
+ **
+ ***********************************************************************/
+
+#include <csignal>
+
+#include <QtCore>
+
+#include "loaderpool.h"
+
+LoaderPool::Job::Job() :
+  m_ok(false),
+  m_elapsed(0),
+  m_done(0)
+{
+  // The job is owned by the loader pool, which needs its results after
+  // the run.
+  setAutoDelete( false );
+}
+
+LoaderPool::Job::~Job()
+{
+}
+
+void LoaderPool::Job::run()
+{
+  sigset_t sigset;
+  sigfillset( &sigset );
+
+  // deactivate all signals in this thread
+  pthread_sigmask( SIG_SETMASK, &sigset, 0 );
+
+  QTime t;
+  t.start();
+
+  m_ok      = work();
+  m_elapsed = t.elapsed();
+
+  if( m_done != 0 )
+    {
+      m_done->release();
+    }
+}
+
+LoaderPool::LoaderPool( const QString& name ) :
+  m_name(name),
+  m_finished(0)
+{
+  m_totalTime.start();
+}
+
+LoaderPool::~LoaderPool()
+{
+  qDeleteAll( m_jobs );
+}
+
+int LoaderPool::maxThreads()
+{
+  return qBound( 1, QThread::idealThreadCount(), static_cast<int>(MaxThreads) );
+}
+
+QThreadPool* LoaderPool::threadPool()
+{
+  // One pool is shared by all loaders, which can run at the same time in
+  // different threads. So the number of workers stays bounded.
+  static QThreadPool pool;
+  static QMutex mutex;
+
+  QMutexLocker locker( &mutex );
+
+  if( pool.maxThreadCount() != maxThreads() )
+    {
+      pool.setMaxThreadCount( maxThreads() );
+    }
+
+  return &pool;
+}
+
+void LoaderPool::addJob( Job* job )
+{
+  m_jobs.append( job );
+}
+
+void LoaderPool::run()
+{
+  start();
+  waitForJobs();
+}
+
+void LoaderPool::start()
+{
+  startStage( QString("parse %1 files").arg(m_jobs.size()) );
+
+  m_finished = 0;
+
+  QThreadPool* pool = threadPool();
+
+  for( int i = 0; i < m_jobs.size(); i++ )
+    {
+      m_jobs[i]->m_done = &m_done;
+      pool->start( m_jobs[i] );
+    }
+}
+
+int LoaderPool::waitForJobs( const int msecs )
+{
+  if( m_finished == m_jobs.size() )
+    {
+      return m_finished;
+    }
+
+  // Wait only for the own jobs, other loaders can use the pool too.
+  if( msecs < 0 )
+    {
+      m_done.acquire( m_jobs.size() - m_finished );
+      m_finished = m_jobs.size();
+    }
+  else
+    {
+      if( m_done.tryAcquire( 1, msecs ) )
+        {
+          m_finished++;
+
+          // Collect all other jobs, which are already done.
+          while( m_finished < m_jobs.size() && m_done.tryAcquire( 1 ) )
+            {
+              m_finished++;
+            }
+        }
+
+      if( m_finished < m_jobs.size() )
+        {
+          return m_finished;
+        }
+    }
+
+  int sum = 0;
+  int max = 0;
+
+  for( int i = 0; i < m_jobs.size(); i++ )
+    {
+      m_jobs[i]->m_done = 0;
+      sum += m_jobs[i]->elapsed();
+      max = qMax( max, m_jobs[i]->elapsed() );
+    }
+
+  qDebug( "%s: %d jobs on %d threads, sum of jobs %dms, longest job %dms",
+          m_name.toLatin1().data(), m_jobs.size(), maxThreads(), sum, max );
+
+  return m_finished;
+}
+
+void LoaderPool::startStage( const QString& stage )
+{
+  finishStage();
+
+  m_stage = stage;
+  m_stageTime.start();
+}
+
+void LoaderPool::finishStage()
+{
+  if( m_stage.isEmpty() )
+    {
+      return;
+    }
+
+  if( m_report.isEmpty() == false )
+    {
+      m_report += ", ";
+    }
+
+  m_report += QString("%1 %2ms").arg(m_stage).arg(m_stageTime.elapsed());
+  m_stage.clear();
+}
+
+void LoaderPool::finish()
+{
+  finishStage();
+
+  qDebug( "%s: %s, total %dms",
+          m_name.toLatin1().data(),
+          m_report.toLatin1().data(),
+          m_totalTime.elapsed() );
+
+  m_report.clear();
+}
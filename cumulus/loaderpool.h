@@ -0,0 +1,188 @@
+/***********************************************************************
+ **
+ **   loaderpool.h
+ **
+ **   This file is part of Cumulus.
+ **
+ ************************************************************************
+ **
+ **   Copyright (c):  2026 by the Cumulus contributors
+ **
+ **   This file is distributed under the terms of the General Public
+ **   License. See the file COPYING for more information.
+ **
+ ***********************************************************************/
+
+#ifndef LOADER_POOL_H
+#define LOADER_POOL_H
+
+#include <QList>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QString>
+#include <QTime>
+
+class QThreadPool;
+
+/**
+ * \class LoaderPool
+ *
+ * \author Cumulus contributors
+ *
+ * \brief Runs independent file load jobs on a bounded worker pool.
+ *
+ * A loader splits its work into one job per source file, e.g. per country
+ * file. All jobs are executed in parallel on a thread pool, which is shared
+ * by all loaders and whose size is bounded by the number of cores. The
+ * caller is blocked until all of its jobs are done. Afterwards the results
+ * can be merged in the order, in which the jobs were added, hence the merge
+ * result does not depend on the thread scheduling.
+ *
+ * The pool measures the elapsed time of the loader stages and reports them
+ * together with the summed up job times via qDebug.
+ *
+ * \date 2026
+ */
+class LoaderPool
+{
+ public:
+
+  /**
+   * Base class of a load job. A job must not touch any data, which is
+   * shared with other jobs.
+   */
+  class Job : public QRunnable
+  {
+   public:
+
+    Job();
+
+    virtual ~Job();
+
+    /**
+     * @return The result of the method work.
+     */
+    bool ok() const
+    {
+      return m_ok;
+    };
+
+    /**
+     * @return The execution time of the job in milliseconds.
+     */
+    int elapsed() const
+    {
+      return m_elapsed;
+    };
+
+   protected:
+
+    /**
+     * Does the work of the job. Called by a worker thread.
+     *
+     * @return true in case of success otherwise false
+     */
+    virtual bool work() = 0;
+
+   private:
+
+    friend class LoaderPool;
+
+    void run();
+
+    bool m_ok;
+
+    int m_elapsed;
+
+    /** Released by the job, when its work is done. */
+    QSemaphore* m_done;
+  };
+
+  /**
+   * @param name Name of the loader used as prefix in the timing report
+   */
+  LoaderPool( const QString& name );
+
+  /**
+   * Deletes all added jobs.
+   */
+  virtual ~LoaderPool();
+
+  /**
+   * Adds a job. The pool takes the ownership of it.
+   */
+  void addJob( Job* job );
+
+  /**
+   * @return All added jobs in the order of their adding.
+   */
+  const QList<Job *>& jobs() const
+  {
+    return m_jobs;
+  };
+
+  /**
+   * Starts all added jobs and waits until they are done. The run is
+   * reported as an own stage.
+   */
+  void run();
+
+  /**
+   * Starts all added jobs and returns immediately. The caller must wait
+   * with \ref waitForJobs until all jobs are done.
+   */
+  void start();
+
+  /**
+   * Waits for finished jobs.
+   *
+   * @param msecs Maximum waiting time in milliseconds, -1 waits until all
+   *              jobs are done
+   * @return The number of finished jobs.
+   */
+  int waitForJobs( const int msecs=-1 );
+
+  /**
+   * Finishes the current stage and starts a new one.
+   */
+  void startStage( const QString& stage );
+
+  /**
+   * Finishes the current stage and reports the timing of all stages.
+   */
+  void finish();
+
+  /**
+   * @return The maximum number of worker threads.
+   */
+  static int maxThreads();
+
+ private:
+
+  /** Upper limit of worker threads, also on machines with many cores. */
+  enum { MaxThreads = 4 };
+
+  static QThreadPool* threadPool();
+
+  void finishStage();
+
+  QString m_name;
+
+  QList<Job *> m_jobs;
+
+  QSemaphore m_done;
+
+  /** Number of finished jobs of the current run. */
+  int m_finished;
+
+  QString m_stage;
+
+  QTime m_stageTime;
+
+  QTime m_totalTime;
+
+  /** Collected timing of the finished stages. */
+  QString m_report;
+};
+
+#endif
@@ -53,6 +53,7 @@
 #include "mapmatrix.h"
 #include "messagewidget.h"
 #include "preflightwidget.h"
+#include "replaybenchmark.h"
 #include "sound.h"
 #include "target.h"
 #include "time_cu.h"
@@ -232,6 +233,15 @@ MainWindow::MainWindow( Qt::WindowFlags flags ) :
   m_displayTrigger = static_cast<QTimer *> (0);
 #endif
 
+  // A recorded flight can be replayed as benchmark with -replay <file>.
+  QStringList args = QCoreApplication::arguments();
+  int replayIdx = args.indexOf( "-replay" );
+
+  if( replayIdx > 0 && replayIdx + 1 < args.size() )
+    {
+      m_replayFile = args.at( replayIdx + 1 );
+    }
+
   // This is used to make it possible to reset some user configuration items once
   // or to execute a necessary migration.
   int rc = GeneralConfig::instance()->getResetConfiguration();
@@ -949,6 +959,8 @@ void MainWindow::slotCreateApplicationWidgets()
            viewMap, SLOT( slot_Mc( const Speed& ) ) );
   connect( calculator, SIGNAL( newVario( const Speed& ) ),
            viewMap, SLOT( slot_Vario( const Speed& ) ) );
+  connect( calculator, SIGNAL( newNettoVario( const Speed&, const Speed& ) ),
+           viewMap, SLOT( slot_NettoVario( const Speed&, const Speed& ) ) );
   connect( calculator, SIGNAL( newWind( Vector& ) ),
            viewMap, SLOT( slot_Wind( Vector& ) ) );
   connect( calculator, SIGNAL( newLD( const double&, const double&) ),
@@ -957,8 +969,8 @@ void MainWindow::slotCreateApplicationWidgets()
            viewMap, SLOT( slot_glider( const QString&) ) );
   connect( calculator, SIGNAL( flightModeChanged(Calculator::FlightMode) ),
            viewMap, SLOT( slot_setFlightStatus(Calculator::FlightMode) ) );
-  connect( calculator, SIGNAL( taskpointSectorTouched() ),
-           m_logger, SLOT( slotTaskSectorTouched() ) );
+  connect( calculator, SIGNAL( taskpointSectorTouched( const QTime& ) ),
+           m_logger, SLOT( slotTaskSectorTouched( const QTime& ) ) );
   connect( calculator, SIGNAL( taskInfo( const QString&, const bool ) ),
            this, SLOT( slotNotification( const QString&, const bool ) ) );
   connect( calculator, SIGNAL( newSample() ),
@@ -968,6 +980,8 @@ void MainWindow::slotCreateApplicationWidgets()
 
   connect( ( QObject* ) calculator->getReachList(), SIGNAL( newReachList() ),
            this, SLOT( slotNewReachList() ) );
+  connect( _globalMapContents, SIGNAL( mapDataReloaded() ),
+           ( QObject* ) calculator->getReachList(), SLOT( slot_sitesChanged() ) );
 
 #ifdef INTERNET
   connect( calculator, SIGNAL( newSample() ),
@@ -1082,9 +1096,18 @@ void MainWindow::slotFinishStartUp()
   GpsNmea::gps->blockSignals( false );
 
 #ifndef ANDROID
-  GpsNmea::gps->startGpsReceiver();
+  if( m_replayFile.isEmpty() )
+    {
+      GpsNmea::gps->startGpsReceiver();
+    }
 #endif
 
+  if( m_replayFile.isEmpty() == false )
+    {
+      // The replay starts, when the event loop is idle.
+      QTimer::singleShot( 0, this, SLOT(slotRunReplay()) );
+    }
+
   // Get the language from the environment
   QString language = qgetenv("LANG");
 
@@ -1179,6 +1202,21 @@ void MainWindow::slotFinishStartUp()
   qDebug( "End startup Cumulus" );
 }
 
+void MainWindow::slotRunReplay()
+{
+  qDebug() << "MainWindow::slotRunReplay():" << m_replayFile;
+
+  ReplayBenchmark benchmark;
+
+  if( benchmark.run( m_replayFile ) )
+    {
+      benchmark.report();
+    }
+
+  // The benchmark is done, terminate without user query.
+  QCoreApplication::quit();
+}
+
 MainWindow::~MainWindow()
 {
   // qDebug ("MainWindow::~MainWindow()");
@@ -2681,16 +2719,9 @@ void MainWindow::slotRememberWaypoint()
 
   QPoint pos = calculator->getlastPosition();
 
-  QList<Waypoint>& wpList = _globalMapContents->getWaypointList();
-
-  for ( int i = 0; i < wpList.count(); i++ )
+  if ( _globalMapContents->isInWaypointList( pos ) )
     {
-      const Waypoint &wpItem = wpList.at(i);
-
-      if ( wpItem.wgsPoint == pos )
-        {
-          return ; // we have such position already
-        }
+      return ; // we have such position already
     }
 
   count++;
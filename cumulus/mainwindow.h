@@ -417,6 +417,12 @@ private slots:
    */
   void slotFinishStartUp();
 
+  /**
+   * Replays the file passed with the command line option -replay as
+   * benchmark and terminates the application afterwards.
+   */
+  void slotRunReplay();
+
   /**
    * Called to check for Welt2000 updates.
    */
@@ -575,6 +581,9 @@ private:
   /** A flag to indicate a first startup after the installation. */
   bool m_firstStartup;
 
+  /** File to be replayed as benchmark, empty in normal operation. */
+  QString m_replayFile;
+
 #if defined ANDROID || defined MAEMO
 
 private:
@@ -39,6 +39,7 @@
 #include "mapview.h"
 #include "radiopoint.h"
 #include "reachablelist.h"
+#include "replaybenchmark.h"
 #include "runway.h"
 #include "singlepoint.h"
 #include "wgspoint.h"
@@ -49,6 +50,7 @@
 #ifdef FLARM
 #include "flarm.h"
 #include "flarmdisplay.h"
+#include "flarmtraffictable.h"
 #endif
 
 extern MapContents *_globalMapContents;
@@ -88,7 +90,12 @@ Map::Map(QWidget* parent) : QWidget(parent),
   m_lastRelBearing = -999;
   m_mode = northUp;
   m_scheduledFromLayer = baseLayer;
+  m_baseContentDirty = true;
   m_ShowGlider = false;
+  m_airspaceIndexDirty = true;
+  m_airspaceIndexSize = 0;
+  m_airspaceDrawIndexDirty = true;
+  m_airspaceDrawIndexSize = 0;
   setMutex(false);
 
   //setup progressive zooming values
@@ -773,120 +780,109 @@ void Map::p_drawAirspaces( bool reset )
       m_airspaceRegionList.clear();
     }
 
-  GeneralConfig* settings     = GeneralConfig::instance();
-  bool fillAirspace           = settings->getAirspaceFillingEnabled();
-  bool drawingBorder          = settings->getAirspaceDrawBorderEnabled();
-  AirspaceWarningDistance awd = settings->getAirspaceWarningDistances();
-  AltitudeCollection alt      = calculator->getAltitudeCollection();
-  QPoint pos                  = calculator->getlastPosition();
+  GeneralConfig* settings = GeneralConfig::instance();
+  bool fillAirspace       = settings->getAirspaceFillingEnabled();
+  bool drawingBorder      = settings->getAirspaceDrawBorderEnabled();
 
-  qreal airspaceOpacity;
-
-  if( fillAirspace == true )
-    {
-      airspaceOpacity = 0.0; // full transparency in fill mode
-
-      if( m_airspaceRegionList.size() == 0 )
-        {
-          // The airspace region list can be cleared by the reloading procedure,
-          // if the projection has been changed. So setup a new list in such a case.
-          reset = true;
-        }
-    }
-  else
+  if( fillAirspace == true && m_airspaceRegionList.size() == 0 )
     {
-      airspaceOpacity = 100.0; // no transparency
+      // The airspace region list can be cleared by the reloading procedure,
+      // if the projection has been changed. So setup a new list in such a case.
+      reset = true;
     }
 
   // The border is stored as FL
   uint asBorder = (uint) rint(settings->getAirspaceDrawingBorder() * 100.0 * Distance::mFromFeet );
 
-  // Two airspace lists have to be processed.
-  SortableAirspaceList* asl[2];
+  SortableAirspaceList* asList  = _globalMapContents->getAirspaceList();
+  SortableAirspaceList* fazList = _globalMapContents->getFlarmAlertZoneList();
 
-  asl[0] = _globalMapContents->getAirspaceList();
-  asl[1] = _globalMapContents->getFlarmAlertZoneList();
+  if( m_airspaceDrawIndexDirty || m_airspaceDrawIndexSize != asList->size() )
+    {
+      // The airspace list was reloaded, rebuild the index.
+      m_airspaceDrawIndex.buildProjected( *asList );
+      m_airspaceDrawIndexSize  = asList->size();
+      m_airspaceDrawIndexDirty = false;
+    }
 
-  for( int i = 0; i < 2; i++ )
+  // Fetch only the airspaces in the visible map area.
+  QVector<Airspace *> visible;
+  visible.reserve( 256 );
+  m_airspaceDrawIndex.candidates( _globalMapMatrix->getMapBorder(), visible );
+
+  // Flarm alert zones are drawn on top. They are only a few.
+  for( int loop = 0; loop < fazList->size(); loop++ )
     {
-      for( int loop = 0; loop < asl[i]->size(); loop++ )
+      visible.append( fazList->at(loop) );
+    }
+
+  for( int loop = 0; loop < visible.size(); loop++ )
+    {
+      Airspace* currentAirS = visible.at(loop);
+
+      if( currentAirS->isDrawable() == false )
         {
-          AirRegion* region = 0;
-          SortableAirspaceList* asList = asl[i];
-          Airspace* currentAirS = dynamic_cast<Airspace *> (asList->value(loop));
+          // Not of interest, step away
+          continue;
+        }
 
-          if( currentAirS == 0 || currentAirS->isDrawable() == false )
+      if( drawingBorder == true )
+        {
+          // Ignore airspaces which lays with its lower border to high.
+          if( currentAirS->getLowerL() > asBorder )
             {
-              // Not of interest, step away
               continue;
             }
+        }
 
-          if( drawingBorder == true )
+      if( currentAirS->getTypeID() == BaseMapElement::AirFlarm )
+        {
+          // Filter out invalid and inactive Flarm alert zones
+          if( currentAirS->getFlarmAlertZone().isValid() == false ||
+              currentAirS->getFlarmAlertZone().isActive() == false )
             {
-              // Ignore airspaces which lays with its lower border to high.
-              if( currentAirS->getLowerL() > asBorder )
-                {
-                  continue;
-                }
+              continue;
             }
+        }
 
-          if( currentAirS->getTypeID() == BaseMapElement::AirFir )
-            {
-              // FIRs are always full transparent.
-              airspaceOpacity = 0.0;
-            }
+      if( reset == true || currentAirS->getAirRegion() == 0 )
+        {
+          // We have to create a new region for that airspace and put
+          // it in the airspace region list.
+          AirRegion* region = new AirRegion( currentAirS->createRegion(), currentAirS );
+          m_airspaceRegionList.append( region );
+        }
 
-          if( currentAirS->getTypeID() == BaseMapElement::AirFlarm )
-            {
-	      // Filter out invalid and inactive Flarm alert zones
-	      if( currentAirS->getFlarmAlertZone().isValid() == false ||
-		  currentAirS->getFlarmAlertZone().isActive() == false )
-		{
-		  continue;
-		}
-            }
+      // full transparency in fill mode, otherwise no transparency
+      qreal airspaceOpacity = fillAirspace ? 0.0 : 100.0;
 
-          if( reset == true || currentAirS->getAirRegion() == 0 )
+      if( currentAirS->getTypeID() == BaseMapElement::AirFir )
+        {
+          // FIRs are always full transparent.
+          airspaceOpacity = 0.0;
+        }
+      else if( fillAirspace == true )
+        {
+          // The conflicts are taken from the last airspace check, they are
+          // not calculated again during drawing.
+          Airspace::ConflictType lConflict = currentAirS->lastHConflict();
+
+          // load user settings for opacity
+          if( lConflict == Airspace::inside )
             {
-              // We have to create a new region for that airspace and put
-              // it in the airspace region list.
-              region = new AirRegion( currentAirS->createRegion(), currentAirS );
-              m_airspaceRegionList.append( region );
+              // We are inside from the lateral position out,
+              // vertical conflict has priority.
+              airspaceOpacity = (qreal) settings->getAirspaceFillingVertical( currentAirS->lastVConflict() );
             }
           else
             {
-              // try to reuse an existing region
-              region = currentAirS->getAirRegion();
-            }
-
-          if( region && currentAirS->getTypeID() != BaseMapElement::AirFir )
-            {
-              // determine lateral conflict
-              Airspace::ConflictType lConflict = region->conflicts( pos, awd );
-
-              // determine vertical conflict
-              Airspace::ConflictType vConflict = currentAirS->conflicts( alt, awd );
-
-              if( fillAirspace == true )
-                {
-                  // load user settings for opacity
-                  if( lConflict == Airspace::inside )
-                    {
-                      // We are inside from the lateral position out,
-                      // vertical conflict has priority.
-                      airspaceOpacity = (qreal) settings->getAirspaceFillingVertical( vConflict );
-                    }
-                  else
-                    {
-                      // We are not inside from the lateral position out,
-                      // lateral conflict has priority.
-                      airspaceOpacity = (qreal) settings->getAirspaceFillingLateral( lConflict );
-                    }
-                }
+              // We are not inside from the lateral position out,
+              // lateral conflict has priority.
+              airspaceOpacity = (qreal) settings->getAirspaceFillingLateral( lConflict );
             }
-
-          currentAirS->drawRegion( &cuAeroMapP, airspaceOpacity );
         }
+
+      currentAirS->drawRegion( &cuAeroMapP, airspaceOpacity );
     }
 
   cuAeroMapP.end();
@@ -1145,21 +1141,17 @@ void Map::p_calculateTrailPoints()
       return;
     }
 
-  QDateTime minTime = calculator->getLastSampleTime().addSecs(- TrailListLength );
+  const FlightSampleList& samples = calculator->samplelist;
 
-  int loop = 0;
-  int sampleCnt = calculator->samplelist.count();
+  int sampleCnt = qMin( samples.countWithin( TrailListLength * 1000 ), TrailListLength );
 
-  while( loop < sampleCnt &&
-          loop < TrailListLength &&
-          calculator->samplelist.at(loop).time >= minTime )
+  for( int loop = 0; loop < sampleCnt; loop++ )
     {
       // Map WGS84 position to map projection
-      const QPoint& pos = _globalMapMatrix->map(_globalMapMatrix->wgsToMap(calculator->samplelist.at(loop).position));
+      const QPoint& pos = _globalMapMatrix->map(_globalMapMatrix->wgsToMap(samples.position(loop)));
 
       // newest positions at first, oldest at last
       m_trailPoints.append( pos );
-      loop++;
     }
 }
 
@@ -1262,6 +1254,7 @@ void Map::p_redrawMap(mapLayer fromLayer, bool queueRequest)
           lastSize = size();
           // reinitialize the base pixmap
           m_pixBaseMap = QPixmap( size() );
+          m_baseContentDirty = true;
         }
 
       //actually start doing our drawing
@@ -1336,7 +1329,8 @@ void Map::p_redrawMap(mapLayer fromLayer, bool queueRequest)
  * Draws the base layer of the map.
  * The base layer consists of the basic map, containing everything up
  * to the features of the landscape.
- * It is drawn on an empty pixmap.
+ * It is drawn on an empty pixmap. After a pure movement of the map the
+ * last content is shifted and only the uncovered part is drawn.
  */
 void Map::p_drawBaseLayer()
 {
@@ -1348,19 +1342,30 @@ void Map::p_drawBaseLayer()
   m_drawnCityList.clear();
   QList<BaseMapElement *> drawnElements;
 
-  // Erase the base layer and fill it with the subterrain color. If there
-  // are no terrain map data available, this is the default map ground color.
-  m_pixBaseMap.fill( GeneralConfig::instance()->getTerrainColor(0) );
+  // After a pure map movement only the uncovered part must be drawn.
+  QRegion region = p_panBaseLayer();
 
   // make sure we have all the map files we need loaded
   _globalMapContents->proofeSection();
 
+  if( region.isEmpty() )
+    {
+      // The base layer content is still valid.
+      p_calculateTrailPoints();
+      return;
+    }
+
   double cs = _globalMapMatrix->getScale(MapMatrix::CurrentScale);
 
   // create a pixmap painter
   QPainter baseMapP;
 
   baseMapP.begin(&m_pixBaseMap);
+  baseMapP.setClipRegion( region );
+
+  // Erase the base layer and fill it with the subterrain color. If there
+  // are no terrain map data available, this is the default map ground color.
+  baseMapP.fillRect( m_pixBaseMap.rect(), GeneralConfig::instance()->getTerrainColor(0) );
 
   // first, draw the iso lines
   _globalMapContents->drawIsoList(&baseMapP);
@@ -1395,13 +1400,86 @@ void Map::p_drawBaseLayer()
   // draw the city labels if scale is not to high
   if( cs <= 60.0 )
     {
-      p_drawCityLabels( m_pixBaseMap );
+      p_drawCityLabels( m_pixBaseMap, region );
     }
 
   // calculate the tail points because projection has been changed
   p_calculateTrailPoints();
 }
 
+QRegion Map::p_panBaseLayer()
+{
+  const QRect all = m_pixBaseMap.rect();
+  const QTransform& matrix = _globalMapMatrix->getWorldMatrix();
+  const QTransform lastMatrix = m_baseMapMatrix;
+  const bool dirty = m_baseContentDirty;
+
+  // A full redraw draws the layer with the current matrix.
+  m_baseMapMatrix = matrix;
+  m_baseContentDirty = false;
+
+  if( dirty )
+    {
+      return QRegion( all );
+    }
+
+  // Map the screen points of the last drawing to the current screen. The
+  // base layer can only be reused, if all points are moved by the same
+  // offset. A change of scale or rotation is detected in this way too.
+  const QTransform toCurrent = lastMatrix.inverted() * matrix;
+
+  QPointF center( all.center() );
+  QPointF offset = toCurrent.map( center ) - center;
+
+  QPointF corners[4] = { QPointF( all.topLeft() ), QPointF( all.topRight() ),
+                         QPointF( all.bottomLeft() ), QPointF( all.bottomRight() ) };
+
+  for( int i = 0; i < 4; i++ )
+    {
+      QPointF diff = toCurrent.map( corners[i] ) - corners[i] - offset;
+
+      if( qAbs( diff.x() ) > 0.25 || qAbs( diff.y() ) > 0.25 )
+        {
+          return QRegion( all );
+        }
+    }
+
+  // The pixmap can only be scrolled by whole pixels.
+  QPoint shift( qRound( offset.x() ), qRound( offset.y() ) );
+
+  if( qAbs( shift.x() ) >= all.width() || qAbs( shift.y() ) >= all.height() )
+    {
+      // Nothing of the last drawing is visible anymore.
+      return QRegion( all );
+    }
+
+  // The kept content is placed by the last matrix moved by the applied
+  // shift. The rounding rest is not lost in this way but is taken into
+  // account by the next pan, so it cannot add up over many pans.
+  m_baseMapMatrix = lastMatrix * QTransform::fromTranslate( shift.x(), shift.y() );
+
+  if( shift.isNull() )
+    {
+      return QRegion();
+    }
+
+  QRegion exposed;
+
+  m_pixBaseMap.scroll( shift.x(), shift.y(), all, &exposed );
+
+  return exposed;
+}
+
+void Map::p_scheduleRecenter()
+{
+  const bool dirty = m_baseContentDirty;
+
+  scheduleRedraw( baseLayer );
+
+  // A recentering of the map does not change the content of the base layer.
+  m_baseContentDirty = dirty;
+}
+
 /**
  * Draws the aero layer of the map.
  * The aero layer consists of the airspace structures and the navigation
@@ -1460,10 +1538,6 @@ void Map::p_drawNavigationLayer()
   p_drawWaypoints(&navP, drawnWp);
   p_drawPlannedTask(&navP, drawnTp);
 
-  // Now the labels of the drawn objects will be drawn, if activated via options.
-  // Put all drawn labels into a set to avoid multiple drawing of them.
-  QSet<QString> labelSet;
-
   // determine icon size
   const bool useSmallIcons = _globalMapConfig->useSmallIcons();
 
@@ -1474,105 +1548,65 @@ void Map::p_drawNavigationLayer()
       iconSize = 16 * Layout::getIntScaledDensity();
     }
 
-  // qDebug("Af=%d, WP=%d", drawnAf.size(), drawnWp.size() );
-
-  // 1. draw all navaids, ... collected labels
-  for( int i = 0; i < drawnRp.size(); i++ )
+  // Now the labels of the drawn objects will be drawn, if activated via
+  // options. The labels are placed by priority, labels overlapping an
+  // already placed label are skipped.
+  if( cs < 120.0 )
     {
-      QString corrString = WGSPoint::coordinateString( drawnRp[i]->getWGSPosition() );
+      const int xShift = iconSize / 2 + 3;
 
-      if( labelSet.contains( corrString ) )
-        {
-          // A label with the same coordinates was already drawn.
-          // We do ignore the repeated drawing.
-          continue;
-        }
+      m_labelLayout.begin( size(), cs );
 
-      // store label to be drawn
-      labelSet.insert( corrString );
+      // qDebug("Af=%d, WP=%d", drawnAf.size(), drawnWp.size() );
 
-      p_drawLabel( &navP,
-                   iconSize / 2 + 3,
-                   drawnRp[i]->getWPName(),
-                   drawnRp[i]->getMapPosition(),
-                   drawnRp[i]->getWGSPosition(),
-                   true );
-    }
-
-  // 2. draw all airfield, ... collected labels
-  for( int i = 0; i < drawnAf.size(); i++ )
-    {
-      QString corrString = WGSPoint::coordinateString( drawnAf[i]->getWGSPosition() );
-
-      if( labelSet.contains( corrString ) )
+      for( int i = 0; i < drawnTp.size(); i++ )
         {
-          // A label with the same coordinates was already drawn.
-          // We do ignore the repeated drawing.
-          continue;
+          m_labelLayout.add( MapLabelLayout::TaskPoint,
+                             drawnTp[i]->getWPName(),
+                             _globalMapMatrix->map( drawnTp[i]->getPosition() ),
+                             drawnTp[i]->getWGSPosition(),
+                             xShift,
+                             false );
         }
 
-      // store label to be drawn
-      labelSet.insert( corrString );
-
-      p_drawLabel( &navP,
-                   iconSize / 2 + 3,
-                   drawnAf[i]->getWPName(),
-                   drawnAf[i]->getMapPosition(),
-                   drawnAf[i]->getWGSPosition(),
-                   true );
-    }
-
-  // 3. draw all collected waypoint point labels
-  for( int i = 0; i < drawnWp.size(); i++ )
-    {
-      QString corrString = WGSPoint::coordinateString( drawnWp[i]->wgsPoint );
-
-      if( labelSet.contains( corrString ) )
+      for( int i = 0; i < drawnAf.size(); i++ )
         {
-          // A label with the same coordinates was already drawn
-          // We do ignore the repeated drawing.
-          continue;
+          m_labelLayout.add( MapLabelLayout::Landable,
+                             drawnAf[i]->getWPName(),
+                             drawnAf[i]->getMapPosition(),
+                             drawnAf[i]->getWGSPosition(),
+                             xShift,
+                             true );
         }
 
-      // store label to be drawn
-      labelSet.insert( corrString );
-
-      bool isLandable = false;
-
-      if( drawnWp[i]->rwyList.size() > 0 )
+      for( int i = 0; i < drawnRp.size(); i++ )
         {
-          isLandable = drawnWp[i]->rwyList.at(0).m_isOpen;
+          m_labelLayout.add( MapLabelLayout::Navaid,
+                             drawnRp[i]->getWPName(),
+                             drawnRp[i]->getMapPosition(),
+                             drawnRp[i]->getWGSPosition(),
+                             xShift,
+                             true );
         }
 
-      p_drawLabel( &navP,
-                   iconSize / 2 + 3,
-                   drawnWp[i]->name,
-                   _globalMapMatrix->map( drawnWp[i]->projPoint ),
-                   drawnWp[i]->wgsPoint,
-                   isLandable );
-    }
+      for( int i = 0; i < drawnWp.size(); i++ )
+        {
+          bool isLandable = false;
 
-  // Second draw all collected task point labels
-  for( int i = 0; i < drawnTp.size(); i++ )
-    {
-      QString corrString = WGSPoint::coordinateString( drawnTp[i]->getWGSPosition() );
+          if( drawnWp[i]->rwyList.size() > 0 )
+            {
+              isLandable = drawnWp[i]->rwyList.at(0).m_isOpen;
+            }
 
-      if( labelSet.contains( corrString ) )
-        {
-          // A label with the same coordinates was already drawn
-          // We do ignore the repeated drawing.
-          continue;
+          m_labelLayout.add( isLandable ? MapLabelLayout::Landable : MapLabelLayout::Other,
+                             drawnWp[i]->name,
+                             _globalMapMatrix->map( drawnWp[i]->projPoint ),
+                             drawnWp[i]->wgsPoint,
+                             xShift,
+                             isLandable );
         }
 
-      // store label to be drawn
-      labelSet.insert( corrString );
-
-      p_drawLabel( &navP,
-                   iconSize / 2 + 3,
-                   drawnTp[i]->getWPName(),
-                   _globalMapMatrix->map( drawnTp[i]->getPosition() ),
-                   drawnTp[i]->getWGSPosition(),
-                   false );
+      m_labelLayout.draw( &navP );
     }
 
   // and finally draw a scale indicator on top of this
@@ -1817,141 +1851,7 @@ void Map::p_drawWaypoints(QPainter* painter, QList<Waypoint*> &drawnWp)
    }
 }
 
-/** Draws a label beside the map icon. It is assumed, that the icon is to see
- *  at the screen.
- */
-void Map::p_drawLabel( QPainter* painter,
-                       const int xShift,       // x offset from the center point
-                       const QString& name,    // name of point
-                       const QPoint& dispP,    // projected point at the display
-                       const WGSPoint& origP,  // WGS84 point
-                       const bool isLandable ) // is landable?
-{
-  // qDebug("LabelName=%s, xShift=%d", name.toLatin1().data(), xShift );
-  if( _globalMapMatrix->getScale(MapMatrix::CurrentScale) >= 120.0 )
-    {
-      return;
-    }
-
-  // save the current painter, must be restored before return!!!
-  painter->save();
-
-  // Set font size used for text painting a little bit bigger, that
-  // the labels are good to see at the map.
-  QFont font = painter->font();
-
-  // We use always the same point size independently from the screen size
-  font.setPointSize( MapLabelFontPointSize );
-
-  QString labelText = name;
-  Altitude alt = ReachableList::getArrivalAltitude( origP );
-  QColor reachColor = ReachableList::getReachColor( origP );
-
-  const bool drawLabelInfo = GeneralConfig::instance()->getMapShowLabelsExtraInfo();
-
-  if( drawLabelInfo )
-    {
-      // draw the name together with the additional information
-      if( isLandable )
-        {
-          Distance dist = ReachableList::getDistance( origP );
-
-          if( dist.isValid() )
-            { // check if the distance is valid...
-              labelText += "\n" +
-              dist.getText( false, uint(0), uint(0) ) +
-              " / " +
-              alt.getText( false, 0 );
-            }
-        }
-    }
-
-  // Consider reachability during drawing.
-  enum ReachablePoint::reachable reachable = ReachableList::getReachable( origP );
-
-  if( isLandable && reachable == ReachablePoint::yes)
-    { // land and reachable? then the label will become bold
-      font.setBold(true);
-    }
-  else
-    {
-      font.setBold(false);
-    }
-
-  // Check, if our point has a selection. In this case inverse drawing is used.
-  bool isSelected = false;
-
-  if( calculator && calculator->getTargetWp() )
-    {
-      if( calculator->getTargetWp()->name == name &&
-          calculator->getTargetWp()->wgsPoint == origP )
-        {
-          isSelected = true;
-        }
-    }
-
-  int pw = 2 * Layout::getIntScaledDensity();;
-
-  if( ! isSelected )
-    {
-      painter->setPen(QPen(Qt::black, pw, Qt::SolidLine));
-      painter->setBrush( Qt::white );
-    }
-  else
-    {
-      // draw selected waypoint label inverse
-      painter->setPen(QPen(Qt::white, pw, Qt::SolidLine));
-      painter->setBrush( Qt::black );
-    }
-
-  painter->setFont( font );
-
-  // calculate text bounding box
-  QRect dRec( 0, 0, 400, 400 );
-  QRect textBox;
-
-  textBox = painter->fontMetrics().boundingRect( dRec, Qt::AlignCenter, labelText );
-
-  // test, if rectangle is right calculated, when newline is in string
-  /* qDebug( "FontText=%s, w=%d, h=%d",
-          labelText.toLatin1().data(),
-          textBox.width(),
-          textBox.height() ); */
-
-  // add a little bit more space in the width and in the height
-  textBox.setRect( 0, 0, textBox.width() + 8, textBox.height() + 4 );
-
-  int xOffset = xShift;
-  int yOffset = 0;
-
-  if( origP.lon() < _globalMapMatrix->getMapCenter(false).y() )
-    {
-      // The point is on the left side of the map,
-      // so draw the text label on the right side.
-      yOffset = -textBox.height() / 2;
-    }
-  else
-    {
-      // The point is on the right side of the map,
-      // so draw the text label on the left side.
-      xOffset = -textBox.width() - xShift;
-      yOffset = -textBox.height() / 2;
-    }
-
-  // move the textbox at the right position on the display
-  textBox.setRect( dispP.x() + xOffset,
-                   dispP.y() + yOffset,
-                   textBox.width(), textBox.height() );
-
-  QPen cPen = painter->pen();
-  painter->setPen(QPen(reachColor, pw, Qt::SolidLine));
-  painter->drawRect( textBox );
-  painter->setPen( cPen );
-  painter->drawText( textBox, Qt::AlignCenter, labelText );
-  painter->restore();
-}
-
-void Map::p_drawCityLabels( QPixmap& pixmap )
+void Map::p_drawCityLabels( QPixmap& pixmap, const QRegion& region )
 {
   if( m_drawnCityList.size() == 0 )
     {
@@ -1961,6 +1861,7 @@ void Map::p_drawCityLabels( QPixmap& pixmap )
   QString labelText;
 
   QPainter painter(&pixmap);
+  painter.setClipRegion( region );
   QFont font = painter.font();
 
   // Uses on all screens the same font point size
@@ -2282,7 +2183,7 @@ void Map::slotPosition(const QPoint& newPos, const int source)
                 {
                   // qDebug("Map::slot_position:scheduleRedraw()");
                   // this is the slow redraw
-                  scheduleRedraw();
+                  p_scheduleRecenter();
                 }
               else
                 {
@@ -2319,7 +2220,7 @@ void Map::slotPosition(const QPoint& newPos, const int source)
           if( !_globalMapMatrix->isInCenterArea( newPos ) || mutex() )
             {
               // qDebug("Map::slot_position:scheduleRedraw()");
-              scheduleRedraw();
+              p_scheduleRecenter();
             }
           else
             {
@@ -2391,17 +2292,19 @@ void Map::p_drawOtherAircraft()
   // Load selected Flarm object. It is empty in case of no selection.
   QString& selectedObject = FlarmDisplay::getSelectedObject();
 
-  bool selectedObjectFound = false;
+  const QVector<Flarm::FlarmAcft> flarmAcfts = Flarm::getPflaaSnapshot();
 
-  if( ! selectedObject.isEmpty() && Flarm::getPflaaHash().contains(selectedObject) )
+  const Flarm::FlarmAcft* selectedAcft = 0;
+
+  if( ! selectedObject.isEmpty() )
     {
-      selectedObjectFound = true;
+      selectedAcft = FlarmTrafficTable::find( flarmAcfts, selectedObject );
     }
 
   // Check, if Flarm most relevant object is identical to selected object
-  if( selectedObjectFound )
+  if( selectedAcft != 0 )
     {
-      const Flarm::FlarmAcft& flarmAcft = Flarm::getPflaaHash().value( selectedObject );
+      const Flarm::FlarmAcft& flarmAcft = *selectedAcft;
 
       if( status.ID == flarmAcft.ID )
         {
@@ -2867,6 +2770,12 @@ void Map::scheduleRedraw(mapLayer fromLayer)
   // schedule requested layer
   m_scheduledFromLayer = qMin(m_scheduledFromLayer, fromLayer);
 
+  if( fromLayer < aeroLayer )
+    {
+      // The base layer content must be drawn completely.
+      m_baseContentDirty = true;
+    }
+
   if( mutex() )
     {
       // Map drawing is running therefore queue redraw request
@@ -3076,6 +2985,8 @@ void Map::p_drawRelBearingInfo()
  */
 void Map::checkAirspace(const QPoint& pos)
 {
+  ReplayBenchmark::Probe probe( ReplayBenchmark::StageAirspace );
+
   if ( mutex() )
     {
       return;
@@ -3121,10 +3032,73 @@ void Map::checkAirspace(const QPoint& pos)
 
   bool warn = false; // warning flag
 
+  SortableAirspaceList* asList  = _globalMapContents->getAirspaceList();
+  SortableAirspaceList* fazList = _globalMapContents->getFlarmAlertZoneList();
+
+  if( m_airspaceIndexDirty || m_airspaceIndexSize != asList->size() )
+    {
+      // The airspace list was reloaded, rebuild the index.
+      m_airspaceIndex.build( *asList );
+      m_airspaceIndexSize  = asList->size();
+      m_airspaceIndexDirty = false;
+      m_airspaceCandidates.clear();
+    }
+
+  // Warning distances in km
+  double veryNearDist = awd.horVeryClose.getKilometers();
+  double nearDist     = qMax( awd.horClose.getKilometers(), veryNearDist );
+
+  // Fetch only the airspaces in the range of the largest warning distance.
+  QVector<Airspace *> candidates;
+  candidates.reserve( 64 );
+  m_airspaceIndex.candidates( pos, nearDist, candidates );
+
+  // Flarm alert zones can move and are only a few, check all of them.
+  for( int loop = 0; loop < fazList->size(); loop++ )
+    {
+      candidates.append( fazList->at(loop) );
+    }
+
+  QSet<Airspace *> newCandidates;
+  newCandidates.reserve( candidates.size() );
+
+  for( int loop = 0; loop < candidates.size(); loop++ )
+    {
+      newCandidates.insert( candidates.at(loop) );
+    }
+
+  // Airspaces, which have left the search range, have no horizontal conflict
+  // anymore. Their former conflict state must be reset.
+  QSetIterator<Airspace *> ci( m_airspaceCandidates );
+
+  while( ci.hasNext() )
+    {
+      Airspace* pSpace = ci.next();
+
+      if( newCandidates.contains( pSpace ) == false &&
+          pSpace->lastHConflict() != Airspace::none )
+        {
+          pSpace->setLastHConflict( Airspace::none );
+          needAirspaceRedraw = true;
+        }
+    }
+
+  m_airspaceCandidates = newCandidates;
+
+  // The drawing border is stored as FL
+  bool drawingBorder = GeneralConfig::instance()->getAirspaceDrawBorderEnabled();
+  uint asBorder = (uint) rint( GeneralConfig::instance()->getAirspaceDrawingBorder() * 100.0 * Distance::mFromFeet );
+
   // check if there are overlaps between the region around our current position and airspaces
-  for( int loop = 0; loop < m_airspaceRegionList.count(); loop++ )
+  for( int loop = 0; loop < candidates.size(); loop++ )
     {
-      Airspace* pSpace = m_airspaceRegionList.at(loop)->m_airspace;
+      Airspace* pSpace = candidates.at(loop);
+
+      if( drawingBorder == true && pSpace->getLowerL() > asBorder )
+        {
+          // Airspaces above the drawing border are not shown and not checked.
+          continue;
+        }
 
       if( pSpace->getTypeID() == BaseMapElement::AirFir )
         {
@@ -3143,7 +3117,7 @@ void Map::checkAirspace(const QPoint& pos)
         }
 
       lastVConflict = pSpace->lastVConflict();
-      lastHConflict = m_airspaceRegionList.at(loop)->currentConflict();
+      lastHConflict = pSpace->lastHConflict();
       lastConflict = (lastHConflict < lastVConflict ? lastHConflict : lastVConflict);
 
       // check for vertical conflicts at first
@@ -3151,15 +3125,22 @@ void Map::checkAirspace(const QPoint& pos)
 
       needAirspaceRedraw |= (vConflict != lastVConflict);
 
+      // Check for horizontal conflicts also without an altitude conflict.
+      // The map drawing takes the lateral state from here.
+      hConflict = AirspaceIndex::horizontalConflict( pSpace->getWgsPolygon(),
+                                                     pos,
+                                                     veryNearDist,
+                                                     nearDist );
+      pSpace->setLastHConflict( hConflict );
+
+      needAirspaceRedraw |= (hConflict != lastHConflict);
+
       if ( vConflict == Airspace::none )
         {
           // No altitude conflict with airspace
           continue;
         }
 
-      // check for horizontal conflicts
-      hConflict = m_airspaceRegionList.at(loop)->conflicts(pos, awd);
-
       // the resulting conflict is always the lesser of the two
       conflict = (hConflict < vConflict ? hConflict : vConflict);
 
@@ -44,12 +44,17 @@
 #include <QEvent>
 #include <QResizeEvent>
 #include <QRect>
+#include <QRegion>
+#include <QSet>
 #include <QTime>
+#include <QTransform>
 #include <QWheelEvent>
 
 #include "airspace.h"
 #include "airregion.h"
+#include "airspaceindex.h"
 #include "flighttask.h"
+#include "maplabellayout.h"
 #include "speed.h"
 #include "vector.h"
 #include "waypoint.h"
@@ -203,6 +208,8 @@ public:
       qDeleteAll(m_airspaceRegionList);
       m_airspaceRegionList.clear();
       m_airspaceRegionList = QList<AirRegion *>();
+      m_airspaceIndexDirty = true;
+      m_airspaceDrawIndexDirty = true;
     };
 
 public slots:
@@ -365,10 +372,26 @@ private:
    * Draws the base layer of the map.
    * The base layer consists of the basic map, containing everything up
    * to the features of the landscape.
-   * It is drawn on an empty canvas.
+   * It is drawn on an empty canvas. After a pure movement of the map the
+   * last content is shifted and only the uncovered part is drawn.
    */
   void p_drawBaseLayer();
 
+  /**
+   * Checks, if the map was only moved since the last base layer drawing.
+   * In this case the content of the base layer is shifted by the pixel
+   * offset of the movement.
+   *
+   * @return The region of the base layer, which has to be drawn anew.
+   */
+  QRegion p_panBaseLayer();
+
+  /**
+   * Schedules a redraw of the base layer caused by a recentering of the
+   * map only. The current base layer content can be reused in this case.
+   */
+  void p_scheduleRecenter();
+
   /**
    * Draws the aero layer of the map.
    * The aero layer consists of the airspace structures and the navigation
@@ -438,19 +461,9 @@ private:
   void p_calculateTrailPoints();
 
   /**
-   * Draws a label with additional information on demand beside a map icon.
-   */
-  void p_drawLabel( QPainter* painter,          // painter to be used
-                    const int xShift,           // x offset from the center point
-                    const QString& name,        // name of point
-                    const QPoint& dispP,        // projected point at the display
-                    const WGSPoint& origP,      // WGS84 point
-                    const bool isLandable );    // is landable?
-
-  /**
-   * Draws the city labels at the map.
+   * Draws the city labels at the map inside of the passed region.
    */
-  void p_drawCityLabels( QPixmap& pixmap );
+  void p_drawCityLabels( QPixmap& pixmap, const QRegion& region );
 
   /**
    * Display Info about Airspace items
@@ -605,6 +618,13 @@ private: //members
   //the basic layer of the map
   QPixmap m_pixBaseMap;
 
+  // map matrix used for the current content of the basic layer
+  QTransform m_baseMapMatrix;
+
+  // Flag to signal, that the content of the basic layer has to be drawn
+  // completely and cannot be reused by a shift after a map movement.
+  bool m_baseContentDirty;
+
   //the map, but now including the aeronautical elements
   QPixmap m_pixAeroMap;
 
@@ -637,6 +657,33 @@ private: //members
    */
   QList<AirRegion*> m_airspaceRegionList;
 
+  /**
+   * Spatial index over all airspaces. It is used by the airspace conflict
+   * check to find the airspaces near to the current position.
+   */
+  AirspaceIndex m_airspaceIndex;
+
+  /** Set, if the airspace index must be rebuilt. */
+  bool m_airspaceIndexDirty;
+
+  /** Number of airspaces at the last index build. */
+  int m_airspaceIndexSize;
+
+  /** Airspaces returned by the last conflict check query. */
+  QSet<Airspace *> m_airspaceCandidates;
+
+  /**
+   * Index over the projected bounding boxes of all airspaces. It is used
+   * to draw only the airspaces in the visible map area.
+   */
+  AirspaceIndex m_airspaceDrawIndex;
+
+  /** Set, if the airspace drawing index must be rebuilt. */
+  bool m_airspaceDrawIndexDirty;
+
+  /** Number of airspaces at the last drawing index build. */
+  int m_airspaceDrawIndexSize;
+
   //contains the layer the next redraw should start from
   mapLayer m_scheduledFromLayer;
 
@@ -705,6 +752,9 @@ protected:
   /** List of drawn cities. */
   QList<BaseMapElement *> m_drawnCityList;
 
+  /** Places the point labels of the navigation layer. */
+  MapLabelLayout m_labelLayout;
+
   /** List of mapped positions for trail drawing */
   QList<QPoint> m_trailPoints;
 
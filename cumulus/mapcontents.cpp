@@ -19,6 +19,7 @@
 #include <unistd.h>
 
 #include <QtGui>
+#include <QBuffer>
 #include <QMessageBox>
 
 #include "airfield.h"
@@ -68,9 +69,59 @@ extern MapView*   _globalMapView;
   } else\
     ShortLoad(in, all);\
 
-// Minimum amount of required free memory to start loading of a map file.
-// Do not under run this limit, OS can freeze is such a case.
-#define MINIMUM_FREE_MEMORY 1024*25
+// Compiled point elements keep their WGS84 and their projected position.
+#define READ_POINT\
+  in >> lat_temp;\
+  in >> lon_temp;\
+  if (compiling) {\
+    single = _globalMapMatrix->wgsToMap(lat_temp, lon_temp);\
+    out << lat_temp;\
+    out << lon_temp;\
+    out << single;\
+  } else\
+    in >> single;\
+
+// Memory budget in bytes for the loaded map tiles. If it is exceeded, the
+// least recently used tiles outside of the visible map area are unloaded.
+#if defined ANDROID || defined MAEMO
+#define MAP_TILE_BUDGET 16*1024*1024
+#else
+#define MAP_TILE_BUDGET 64*1024*1024
+#endif
+
+// Tiles ahead along the track are preloaded above this ground speed in m/s.
+// One tile is loaded per interval in ms to keep the GUI responsive.
+#define PRELOAD_MIN_SPEED 5.0
+#define PRELOAD_INTERVAL  500
+
+/**
+ * Switches the input stream of an opened compiled map file to a memory
+ * mapping of the file. Reading continues at the current file position. If
+ * the file cannot be mapped, the stream is left unchanged.
+ */
+static bool mapStream( QFile& file, QBuffer& buffer, QDataStream& in )
+{
+  qint64 pos = file.pos();
+  uchar* data = file.map( 0, file.size() );
+
+  if( data == 0 )
+    {
+      return false;
+    }
+
+  // The raw data array does not copy the mapped file content.
+  buffer.setData( QByteArray::fromRawData( (const char *) data, file.size() ) );
+
+  if( buffer.open( QIODevice::ReadOnly ) == false || buffer.seek( pos ) == false )
+    {
+      buffer.close();
+      file.unmap( data );
+      return false;
+    }
+
+  in.setDevice( &buffer );
+  return true;
+}
 
 // List of used elevation levels in meters (51 in total):
 const short MapContents::isoLevels[] =
@@ -84,8 +135,8 @@ const short MapContents::isoLevels[] =
 
 MapContents::MapContents(QObject* parent, WaitScreen* waitscreen) :
     QObject(parent),
-    unloadDone(false),
-    memoryFull(false),
+    m_tileCache(MAP_TILE_BUDGET),
+    m_loadingTiles(false),
     isFirst(true),
     isReload(false)
 #ifdef INTERNET
@@ -108,11 +159,6 @@ MapContents::MapContents(QObject* parent, WaitScreen* waitscreen) :
       isoHash.insert( isoLevels[i], i );
     }
 
-  _nextIsoLevel=10000;
-  _lastIsoLevel=-1;
-  _isoLevelReset=true;
-  _lastIsoEntry=0;
-
   // read in waypoint list from catalog
   WaypointCatalog wpCat;
   int ok;
@@ -136,6 +182,15 @@ MapContents::MapContents(QObject* parent, WaitScreen* waitscreen) :
                << format << "catalog.";
     }
 
+  wpIndex.rebuild( wpList );
+
+  // Tiles ahead along the track are loaded one by one in idle times.
+  m_preloadTimer = new QTimer( this );
+  m_preloadTimer->setSingleShot( true );
+  m_preloadTimer->setInterval( PRELOAD_INTERVAL );
+
+  connect( m_preloadTimer, SIGNAL(timeout()), this, SLOT(slotPreloadTile()) );
+
   currentTask = 0;
 
   connect( this, SIGNAL(progress(int)), ws, SLOT(slot_Progress(int)) );
@@ -183,6 +238,9 @@ void MapContents::saveWaypointList()
  * Terrain files describe the surface above level 0m. If isoline drawing
  * is switched off, terrain files are never read in.
  *
+ * All isohypses of a file are added once to the elevation index. Only the
+ * isohypses intersecting the decode area are kept for the map drawing.
+ *
  * Thanks to Josua Dietze for his contribution of precomputed map files.
  *
  */
@@ -205,38 +263,6 @@ bool MapContents::readTerrainFile( const int fileSecID, const int fileTypeID )
       return true;
     }
 
-  if (memoryFull) //if we already know the memory if full and can't be emptied at this point, just return.
-    {
-      _globalMapView->message(tr("Out of memory! Map not loaded."));
-      return false;
-    }
-
-  // check free memory
-  int memFree = HwInfo::instance()->getFreeMemory();
-
-  if ( memFree < MINIMUM_FREE_MEMORY )
-    {
-      if ( !unloadDone)
-        {
-          unloadMaps();  // try freeing some memory
-          memFree = HwInfo::instance()->getFreeMemory();  //re-asses free memory
-          if ( memFree < MINIMUM_FREE_MEMORY )
-            {
-              memoryFull=true; //set flag to indicate that we need not try loading any more mapfiles now.
-              qWarning("Cumulus couldn't load file, low on memory! Memory needed: %d kB, free: %d kB", MINIMUM_FREE_MEMORY, memFree );
-              _globalMapView->message(tr("Out of memory! Map not loaded."));
-              return false;
-            }
-        }
-      else
-        {
-          memoryFull=true; //set flag to indicate that we need not try loading any more mapfiles now.
-          qWarning("Cumulus couldn't load file, low on memory! Memory needed: %d kB, free: %d kB", MINIMUM_FREE_MEMORY, memFree );
-          _globalMapView->message(tr("Out of memory! Map not loaded."));
-          return false;
-        }
-    }
-
   QString kflPathName, kfcPathName, pathName;
   QString kflName, kfcName;
 
@@ -546,6 +572,14 @@ bool MapContents::readTerrainFile( const int fileSecID, const int fileTypeID )
         }
     }
 
+  // The compiled file is decoded directly from its memory mapping.
+  QBuffer mappedFile;
+
+  if( ! compiling )
+    {
+      mapStream( mapfile, mappedFile, in );
+    }
+
   // Got to initialize "out" stream properly, even if write file is not needed
   QFile ausgabe(kfcPathName);
   QDataStream out(&ausgabe);
@@ -580,11 +614,21 @@ bool MapContents::readTerrainFile( const int fileSecID, const int fileTypeID )
 
   int loop = 0;
 
+  // Estimated memory usage of the tile
+  qint64 tileBytes = 0;
+
+  // The elevation index gets every isohypse of a file once. The map
+  // drawing gets only the isohypses, which intersect the decode area.
+  const char part = ( fileTypeID == FILE_TYPE_GROUND ) ? 1 : 2;
+  const bool indexed = ( m_indexedParts.value( fileSecID, 0 ) & part ) != 0;
+  const qint64 indexBytes = m_elevationIndex.usedBytes( fileSecID );
+
   while ( !in.atEnd() )
     {
       qint16 elevation;
       qint32 pointNumber, lat, lon;
       QPolygon isoline;
+      QRect box;
 
       in >> elevation;
 
@@ -627,16 +671,49 @@ bool MapContents::readTerrainFile( const int fileSecID, const int fileTypeID )
               continue;
             }
 
-          out << elevation;
           // And that is the whole trick: saving the computed result. Takes the same space!
-          ShortSave( out, isoline );
+          QByteArray record;
+          QDataStream recordOut( &record, QIODevice::WriteOnly );
+          recordOut.setVersion( QDataStream::Qt_4_7 );
+          ShortSave( recordOut, isoline );
+
+          // The bounding box and the record size allow to skip an isohypse
+          // without decoding it.
+          box = isoline.boundingRect();
+
+          out << elevation;
+          out << box;
+          out << quint32( record.size() );
+          out.writeRawData( record.constData(), record.size() );
         }
       else
         {
+          quint32 recordSize;
+
+          in >> box;
+          in >> recordSize;
+
+          if( indexed && ! isInDecodeArea( box ) )
+            {
+              in.skipRawData( recordSize );
+              continue;
+            }
+
           // Reading the computed result from kfc file
           ShortLoad( in, isoline );
         }
 
+      if( ! indexed )
+        {
+          // Make the isohypse known to the elevation finder.
+          m_elevationIndex.addIsohypse( fileSecID, isoline, elevation );
+        }
+
+      if( ! isInDecodeArea( box ) )
+        {
+          continue;
+        }
+
       // determine elevation index, 0 is returned as default for not existing values
       uchar elevationIdx = isoHash.value( elevation, 0 );
 
@@ -667,6 +744,8 @@ bool MapContents::readTerrainFile( const int fileSecID, const int fileTypeID )
           usedMap->insert( fileSecID, isoList );
         }
 
+      tileBytes += sizeof(Isohypse) + isoline.size() * sizeof(QPoint);
+
       // qDebug("Isohypse added: Size=%d, Elevation=%d, FileTypeID=%c",
       //       isoline.size(), elevation, fileTypeID );
 
@@ -686,6 +765,14 @@ bool MapContents::readTerrainFile( const int fileSecID, const int fileTypeID )
       ausgabe.close();
     }
 
+  if( ! indexed )
+    {
+      m_elevationIndex.finishTile( fileSecID );
+      m_indexedParts[fileSecID] |= part;
+      tileBytes += m_elevationIndex.usedBytes( fileSecID ) - indexBytes;
+    }
+
+  m_tileCache.addBytes( fileSecID, tileBytes );
   return true;
 }
 
@@ -701,38 +788,6 @@ bool MapContents::readBinaryFile(const int fileSecID, const char fileTypeID)
       return true;
     }
 
-  if (memoryFull)   //if we already know the memory if full and can't be emptied at this point, just return.
-    {
-      _globalMapView->message(tr("Out of memory! Map not loaded."));
-      return false;
-    }
-
-  //check free memory
-  int memFree = HwInfo::instance()->getFreeMemory();
-
-  if ( memFree < MINIMUM_FREE_MEMORY )
-    {
-      if ( !unloadDone)
-        {
-          unloadMaps();  //try freeing some memory
-          memFree = HwInfo::instance()->getFreeMemory();  //re-asses free memory
-          if ( memFree < MINIMUM_FREE_MEMORY )
-            {
-              memoryFull=true; //set flag to indicate that we need not try loading any more mapfiles now.
-              qWarning("Cumulus couldn't load file, low on memory! Memory needed: %d kB, free: %d kB", MINIMUM_FREE_MEMORY, memFree );
-              _globalMapView->message(tr("Out of memory! Map not loaded."));
-              return false;
-            }
-        }
-      else
-        {
-          memoryFull=true; //set flag to indicate that we need not try loading any more mapfiles now.
-          qWarning("Cumulus couldn't load file, low on memory! Memory needed: %d kB, free: %d kB", MINIMUM_FREE_MEMORY, memFree );
-          _globalMapView->message(tr("Out of memory! Map not loaded."));
-          return false;
-        }
-    }
-
   QString kflPathName, kfcPathName, pathName;
   QString kflName, kfcName;
 
@@ -1057,13 +1112,21 @@ bool MapContents::readBinaryFile(const int fileSecID, const char fileTypeID)
         }
     }
 
+  // The compiled file is decoded directly from its memory mapping.
+  QBuffer mappedFile;
+
+  if( ! compiling )
+    {
+      mapStream( mapfile, mappedFile, in );
+    }
+
   QFile ausgabe(kfcPathName);
-  QDataStream out(&ausgabe);
+  QDataStream fileOut(&ausgabe);
 
   if ( compiling )
     {
-      out.setDevice( &ausgabe );
-      out.setVersion( QDataStream::Qt_4_7 );
+      fileOut.setDevice( &ausgabe );
+      fileOut.setVersion( QDataStream::Qt_4_7 );
 
       if (!ausgabe.open(QIODevice::WriteOnly))
         {
@@ -1076,16 +1139,22 @@ bool MapContents::readBinaryFile(const int fileSecID, const char fileTypeID)
 
       qDebug("Writing file %s", kfcPathName.toLatin1().data());
 
-      out << magic;
+      fileOut << magic;
       loadTypeID = FILE_TYPE_MAP_C;
       formatID   = FILE_VERSION_MAP_C;
-      out << loadTypeID;
-      out << formatID;
-      out << loadSecID;
-      out << createDateTime.addSecs(1);   //set time one second later than the time of the original file;
-      SaveProjection(out, _globalMapMatrix->getProjection());
+      fileOut << loadTypeID;
+      fileOut << formatID;
+      fileOut << loadSecID;
+      fileOut << createDateTime.addSecs(1);   //set time one second later than the time of the original file;
+      SaveProjection(fileOut, _globalMapMatrix->getProjection());
     }
 
+  // A compiled element is collected in a record buffer first, because its
+  // bounding box and its size precede the element data in the file.
+  QBuffer record;
+  QDataStream out(&record);
+  out.setVersion( QDataStream::Qt_4_7 );
+
   quint8 lm_typ;
   qint8 sort, elev;
   qint32 lat_temp, lon_temp;
@@ -1095,13 +1164,38 @@ bool MapContents::readBinaryFile(const int fileSecID, const char fileTypeID)
   unsigned int gesamt_elemente = 0;
   uint loop = 0;
 
+  // Estimated memory usage of the tile
+  qint64 tileBytes = 0;
+
   while ( ! in.atEnd() )
     {
       BaseMapElement::objectType typeIn = BaseMapElement::NotSelected;
       in >> (quint8&)typeIn;
 
+      const quint8 recordType = typeIn;
+      qint64 recordEnd = 0;
+
       if ( compiling )
-        out << (quint8&)typeIn;
+        {
+          record.setData( QByteArray() );
+          record.open( QIODevice::WriteOnly );
+        }
+      else
+        {
+          QRect box;
+          quint32 recordSize;
+
+          in >> box;
+          in >> recordSize;
+          recordEnd = in.device()->pos() + recordSize;
+
+          // Elements outside of the decode area are skipped undecoded.
+          if( ! isInDecodeArea( box ) )
+            {
+              in.skipRawData( recordSize );
+              continue;
+            }
+        }
 
       locLength = 0;
       name = "";
@@ -1267,21 +1361,10 @@ bool MapContents::readBinaryFile(const int fileSecID, const char fileTypeID)
                   ShortLoad(in, name);
                 }
             }
-          in >> lat_temp;
-          in >> lon_temp;
+          READ_POINT
 
           if ( !GeneralConfig::instance()->getMapLoadCities() ) break;
 
-          if ( compiling )
-            {
-              single = _globalMapMatrix->wgsToMap(lat_temp, lon_temp);
-              out << single;
-            }
-          else
-            {
-              in >> single;
-            }
-
           villageList.append( SinglePoint( name,
                                            "",
                                            typeIn,
@@ -1303,21 +1386,10 @@ bool MapContents::readBinaryFile(const int fileSecID, const char fileTypeID)
                 out << elev;
             }
 
-          in >> lat_temp;
-          in >> lon_temp;
+          READ_POINT
 
           if ( !GeneralConfig::instance()->getMapLoadCities() ) break;
 
-          if ( compiling )
-            {
-              single = _globalMapMatrix->wgsToMap(lat_temp, lon_temp);
-              out << single;
-            }
-          else
-            {
-              in >> single;
-            }
-
           obstacleList.append( SinglePoint( "Spot",
                                             "",
                                             typeIn,
@@ -1346,21 +1418,10 @@ bool MapContents::readBinaryFile(const int fileSecID, const char fileTypeID)
                 }
             }
 
-          in >> lat_temp;
-          in >> lon_temp;
+          READ_POINT
 
           if ( !GeneralConfig::instance()->getMapLoadCities() ) break;
 
-          if ( compiling )
-            {
-              single = _globalMapMatrix->wgsToMap(lat_temp, lon_temp);
-              out << single;
-            }
-          else
-            {
-              in >> single;
-            }
-
           landmarkList.append( SinglePoint( name,
                                "",
                                typeIn,
@@ -1378,6 +1439,26 @@ bool MapContents::readBinaryFile(const int fileSecID, const char fileTypeID)
           break;
         }
 
+      if ( compiling )
+        {
+          record.close();
+
+          QRect box = all.isEmpty() ? QRect( single, QSize( 1, 1 ) ) : all.boundingRect();
+
+          fileOut << recordType;
+          fileOut << box;
+          fileOut << quint32( record.data().size() );
+          fileOut.writeRawData( record.data().constData(), record.data().size() );
+        }
+      else if ( in.device()->pos() != recordEnd )
+        {
+          // Not all data of the element were read, continue with the next one.
+          in.device()->seek( recordEnd );
+        }
+
+      tileBytes += sizeof(LineElement) + all.size() * sizeof(QPoint) +
+                   name.size() * sizeof(QChar);
+
       // @AP: Performance brake! emit progress calls waitscreen and
       // this steps into main loop
       if ( compiling && (++loop % 100) == 0 )
@@ -1394,6 +1475,7 @@ bool MapContents::readBinaryFile(const int fileSecID, const char fileTypeID)
       ausgabe.close();
     }
 
+  m_tileCache.addBytes( fileSecID, tileBytes );
   return true;
 }
 
@@ -1879,44 +1961,27 @@ void MapContents::proofeSection()
 {
   // qDebug("MapContents::proofeSection()");
 
-  // @AP: defined a static mutex variable, to prevent the recursive
-  // calling of this method
-  static bool mutex = false;
-
-  if( mutex )
+  // The tile loading must not be entered recursively, that can happen
+  // during the event processing of the wait screen.
+  if( m_loadingTiles )
     {
       // qDebug("MapContents::proofeSection(): is recursive called, returning");
       return; // return immediately, if reenter in method is not possible
     }
 
-  mutex = true;
+  m_loadingTiles = true;
 
   extern MapMatrix* _globalMapMatrix;
 
   // Get map borders in KFLog coordinates. X=Longitude, Y=Latitude.
-  QRect mapBorder = _globalMapMatrix->getViewBorder();
-
-  int westCorner = ( ( mapBorder.left() / 600000 / 2 ) * 2 + 180 ) / 2;
-  int eastCorner = ( ( mapBorder.right() / 600000 / 2 ) * 2 + 180 ) / 2;
-  int northCorner = ( ( mapBorder.top() / 600000 / 2 ) * 2 - 88 ) / -2;
-  int southCorner = ( ( mapBorder.bottom() / 600000 / 2 ) * 2 - 88 ) / -2;
-
-  if (mapBorder.left() < 0)
-    westCorner -= 1;
-  if (mapBorder.right() < 0)
-    eastCorner -= 1;
-  if (mapBorder.top() < 0)
-    northCorner += 1;
-  if (mapBorder.bottom() < 0)
-    southCorner += 1;
-
-  // qDebug( "MapBorderCorners: l=%d, r=%d, t=%d, b=%d",
-  //          westCorner, eastCorner, northCorner, southCorner );
+  QRect viewBorder = _globalMapMatrix->getViewBorder();
 
-  unloadDone = false;
-  memoryFull = false;
-  char step, hasstep; // used as small integers
-  TilePartMap::Iterator it;
+  // Elements of compiled map files are only decoded inside of the visible
+  // map area, extended by its size on all sides. So small map moves do not
+  // require a new decode of the tiles.
+  QRect mapBorder = _globalMapMatrix->getMapBorder();
+  QRect decodeArea = mapBorder.adjusted( -mapBorder.width(), -mapBorder.height(),
+                                          mapBorder.width(), mapBorder.height() );
 
   if( isReload )
     {
@@ -1931,94 +1996,40 @@ void MapContents::proofeSection()
       ws->slot_SetText1( tr( "Loading maps..." ) );
     }
 
-  for( int row = northCorner; row <= southCorner; row++ )
+  m_viewTiles = tilesOfBorder( viewBorder );
+
+  foreach( int secID, m_viewTiles )
     {
-      for( int col = westCorner; col <= eastCorner; col++ )
+      if( isFirst )
         {
-          int secID = row + (col + (row * 179));
-          // qDebug( "Needed BoxSecID=%d", secID );
-
-          if( isFirst )
-            {
-              // Animate a little bit during first load. Later on in flight,
-              // we need the time for GPS processing.
-              emit progress( 2 );
-            }
-
-          if( secID >= 0 && secID <= MAX_TILE_NUMBER )
-            {
-              // a valid tile (2x2 degree area) must be in the range 0 ... 16200
-              if( ! tileSectionSet.contains( secID ) )
-                {
-                  // qDebug(" Tile %d is missing", secID );
-                  // Tile is missing
-                  if( ! isFirst)
-                    {
-                      // @AP: remove of all unused maps to get place
-                      // in heap. That can be disabled here because
-                      // the loading routines will also check the
-                      // available memory and call the unloadMaps()
-                      // method is necessary. But the disadvantage
-                      // is in that case that the freeing needs a
-                      // lot of time (several seconds).
-                      if( GeneralConfig::instance()->getMapUnload() )
-                        {
-                          unloadMaps(0);
-                        }
-                    }
-
-                  // qDebug("Going to load sectionID %d", secID);
-
-                  step = 0;
-                  // check to see if parts of this tile has already been loaded before
-                  it = tilePartMap.find(secID);
-
-                  if (it == tilePartMap.end())
-                    {
-                      //not found
-                      hasstep = 0;
-                    }
-                  else
-                    {
-                      hasstep = it.value();
-                    }
+          // Animate a little bit during first load. Later on in flight,
+          // we need the time for GPS processing.
+          emit progress( 2 );
+        }
 
-                  //try loading the currently unloaded files
-                  if (!(hasstep & 1))
-                    {
-                      if (readTerrainFile(secID, FILE_TYPE_GROUND))
-                        step |= 1;
-                    }
+      m_tileCache.touch( secID );
 
-                  if (!(hasstep & 2))
-                    {
-                      if (readTerrainFile(secID, FILE_TYPE_TERRAIN))
-                        step |= 2;
-                    }
+      QHash<int, QRect>::const_iterator ait = m_tileAreas.constFind( secID );
 
-                  if (!(hasstep & 4))
-                    {
-                      if (readBinaryFile(secID, FILE_TYPE_MAP))
-                        step |= 4;
-                    }
+      if( ait != m_tileAreas.constEnd() && ! ait.value().contains( mapBorder ) )
+        {
+          // The view has left the decoded area of the tile.
+          unloadTile( secID );
+        }
 
-                  if (step == 7) //set the correct flags for this map tile
-                    {
-                      tileSectionSet.insert(secID);  // add section id to set
-                      tilePartMap.remove(secID); // make sure we don't leave it as partly loaded
-                    }
-                  else
-                    {
-                      if (step > 0)
-                        {
-                          tilePartMap.insert(secID, step);
-                        }
-                    }
-                }
-            }
+      if( ! tileSectionSet.contains( secID ) )
+        {
+          // qDebug(" Tile %d is missing", secID );
+          loadTile( secID, decodeArea );
         }
     }
 
+  schedulePreload( viewBorder );
+
+  // Free the memory of tiles, which are no longer needed. The visible and
+  // the preloaded tiles are always kept.
+  unloadMaps( m_viewTiles + m_preloadTiles );
+
   if( isFirst )
     {
       ws->slot_SetText2( tr( "Reading Airspace Data" ) );
@@ -2105,87 +2116,251 @@ void MapContents::proofeSection()
 
   isFirst  = false;
   isReload = false;
-  mutex    = false; // unlock mutex
+  m_loadingTiles = false;
 }
 
-// Distance unit is expected as meters. The bounding map rectangle will be
-// enlarged by distance.
-void MapContents::unloadMaps(unsigned int distance)
+QSet<int> MapContents::tilesOfBorder( const QRect& border ) const
 {
-  // qDebug("MapContents::unloadMaps() is called");
-
-  if( unloadDone )
-    {
-      return; // we only unload map data once (per map redrawing round)
-    }
-
-  extern MapMatrix* _globalMapMatrix;
-  QRect mapBorder = _globalMapMatrix->getViewBorder();
-
-  // scale uses unit meter/pixel
-  double scale = _globalMapMatrix->getScale(MapMatrix::CurrentScale);
-
-  int width  = (int) rint(scale * distance);
-  int height = width;
+  int westCorner = ( ( border.left() / 600000 / 2 ) * 2 + 180 ) / 2;
+  int eastCorner = ( ( border.right() / 600000 / 2 ) * 2 + 180 ) / 2;
+  int northCorner = ( ( border.top() / 600000 / 2 ) * 2 - 88 ) / -2;
+  int southCorner = ( ( border.bottom() / 600000 / 2 ) * 2 - 88 ) / -2;
 
-  //   qDebug("left=%d, right=%d, top=%d, bottom=%d, wight=%d, height=%d, scale=%f",
-  //   mapBorder.left(), mapBorder.right(), mapBorder.top(), mapBorder.bottom(),
-  //   width, height, scale );
-
-  int westCorner = ( ( ( mapBorder.left() - width ) / 600000 / 2 ) * 2 + 180 ) / 2;
-  int eastCorner = ( ( ( mapBorder.right() + width ) / 600000 / 2 ) * 2 + 180 ) / 2;
-  int northCorner = ( ( ( mapBorder.top() - height ) / 600000 / 2 ) * 2 - 88 ) / -2;
-  int southCorner = ( ( ( mapBorder.bottom() + height ) / 600000 / 2 ) * 2 - 88 ) / -2;
-
-  if (mapBorder.left() < 0)
+  if (border.left() < 0)
     westCorner -= 1;
-  if (mapBorder.right() < 0)
+  if (border.right() < 0)
     eastCorner -= 1;
-  if (mapBorder.top() < 0)
+  if (border.top() < 0)
     northCorner += 1;
-  if (mapBorder.bottom() < 0)
+  if (border.bottom() < 0)
     southCorner += 1;
 
-  QSet<int> currentTileSet; // tiles of the current box
+  // qDebug( "MapBorderCorners: l=%d, r=%d, t=%d, b=%d",
+  //          westCorner, eastCorner, northCorner, southCorner );
 
-  // Collect all valid tiles of the current box in a set.
-  for ( int row = northCorner; row <= southCorner; row++ )
+  QSet<int> tiles;
+
+  for( int row = northCorner; row <= southCorner; row++ )
     {
-      for (int col = westCorner; col <= eastCorner; col++)
+      for( int col = westCorner; col <= eastCorner; col++ )
         {
           int secID = row + (col + (row * 179));
 
-          if (secID >= 0 && secID <= MAX_TILE_NUMBER)
+          if( secID >= 0 && secID <= MAX_TILE_NUMBER )
             {
-              // qDebug( "unloadMaps-active-secId=%d",  secID );
-              currentTileSet.insert(secID);
+              // a valid tile (2x2 degree area) must be in the range 0 ... 16200
+              tiles.insert( secID );
             }
         }
     }
 
-  bool something2free = false;
+  return tiles;
+}
+
+void MapContents::loadTile( const int secID, const QRect& decodeArea )
+{
+  // qDebug("Going to load sectionID %d", secID);
+
+  char step = 0, hasstep = 0; // used as small integers
+
+  // check to see if parts of this tile has already been loaded before
+  TilePartMap::Iterator it = tilePartMap.find(secID);
+
+  if (it != tilePartMap.end())
+    {
+      hasstep = it.value();
+
+      // The missing parts are decoded for the same area as the loaded ones.
+      m_decodeArea = m_tileAreas.value( secID );
+    }
+  else
+    {
+      m_decodeArea = decodeArea;
+    }
+
+  //try loading the currently unloaded files
+  if (!(hasstep & 1))
+    {
+      if (readTerrainFile(secID, FILE_TYPE_GROUND))
+        step |= 1;
+    }
+
+  if (!(hasstep & 2))
+    {
+      if (readTerrainFile(secID, FILE_TYPE_TERRAIN))
+        step |= 2;
+    }
+
+  if (!(hasstep & 4))
+    {
+      if (readBinaryFile(secID, FILE_TYPE_MAP))
+        step |= 4;
+    }
+
+  step |= hasstep;
+
+  if (step == 7) //set the correct flags for this map tile
+    {
+      tileSectionSet.insert(secID);  // add section id to set
+      tilePartMap.remove(secID); // make sure we don't leave it as partly loaded
+    }
+  else if (step > 0)
+    {
+      tilePartMap.insert(secID, step);
+    }
+
+  if( m_decodeArea.isNull() )
+    {
+      m_tileAreas.remove( secID );
+    }
+  else
+    {
+      m_tileAreas.insert( secID, m_decodeArea );
+    }
+
+  m_decodeArea = QRect();
+}
+
+void MapContents::unloadTile( const int secID )
+{
+  QSet<int> tiles;
+  tiles.insert( secID );
+
+  tilePartMap.remove( secID );
+  tileSectionSet.remove( secID );
+  m_tileAreas.remove( secID );
+
+  // The elevation index of the tile is kept, it is not decoded again.
+  m_tileCache.remove( secID );
+  m_tileCache.addBytes( secID, m_elevationIndex.usedBytes( secID ) );
+
+  unloadMapObjects( cityList, tiles );
+  unloadMapObjects( hydroList, tiles );
+  unloadMapObjects( lakeList, tiles );
+  unloadMapObjects( groundMap, tiles );
+  unloadMapObjects( terrainMap, tiles );
+  unloadMapObjects( landmarkList, tiles );
+  unloadMapObjects( obstacleList, tiles );
+  unloadMapObjects( railList, tiles );
+  unloadMapObjects( motorwayList, tiles );
+  unloadMapObjects( roadList, tiles );
+  unloadMapObjects( topoList, tiles );
+  unloadMapObjects( villageList, tiles );
+}
+
+void MapContents::schedulePreload( const QRect& viewBorder )
+{
+  extern Calculator* calculator;
+
+  m_preloadTiles.clear();
+  m_preloadQueue.clear();
+
+  if( calculator == 0 || calculator->getLastSpeed().isValid() == false ||
+      calculator->getLastSpeed().getMps() < PRELOAD_MIN_SPEED )
+    {
+      m_preloadTimer->stop();
+      return;
+    }
+
+  // The map view moved by its own size along the current track. KFLog
+  // coordinates grow to the north and to the east.
+  double heading = calculator->getlastHeading() * M_PI / 180.0;
+
+  QRect ahead = viewBorder.translated( int( sin( heading ) * abs( viewBorder.width() ) ),
+                                       int( cos( heading ) * abs( viewBorder.height() ) ) );
+
+  m_preloadTiles = tilesOfBorder( ahead ) - m_viewTiles;
+
+  foreach( int secID, m_preloadTiles )
+    {
+      if( ! tileSectionSet.contains( secID ) )
+        {
+          m_preloadQueue.append( secID );
+        }
+
+      m_tileCache.touch( secID );
+    }
+
+  if( m_preloadQueue.isEmpty() )
+    {
+      m_preloadTimer->stop();
+    }
+  else
+    {
+      m_preloadTimer->start();
+    }
+}
+
+void MapContents::slotPreloadTile()
+{
+  if( m_preloadQueue.isEmpty() )
+    {
+      return;
+    }
+
+  if( m_loadingTiles )
+    {
+      // Tiles are loaded just now, try it later again.
+      m_preloadTimer->start();
+      return;
+    }
+
+  m_loadingTiles = true;
 
-  // Iterate over all loaded tiles (tileSectionSet) and remove all tiles,
-  // which are not contained in the current box.
-  foreach( int secID, tileSectionSet )
-  {
-    if ( !currentTileSet.contains( secID ) )
-      {
-        // remove not more needed element from related objects
-        tilePartMap.remove( secID );
-        tileSectionSet.remove( secID );
-        something2free = true;
-        continue;
-      }
-  }
+  int secID = m_preloadQueue.takeFirst();
+
+  if( ! tileSectionSet.contains( secID ) )
+    {
+      // A preloaded tile is decoded completely, because it is not yet known,
+      // which part of it will be visible.
+      loadTile( secID, QRect() );
+      m_tileCache.touch( secID );
+      unloadMaps( m_viewTiles + m_preloadTiles );
+    }
+
+  m_loadingTiles = false;
+
+  if( ! m_preloadQueue.isEmpty() )
+    {
+      m_preloadTimer->start();
+    }
+}
+
+void MapContents::unloadMaps( const QSet<int>& keepTiles )
+{
+  // qDebug("MapContents::unloadMaps() is called");
+
+  QSet<int> dropTiles;
+
+  if( GeneralConfig::instance()->getMapUnload() )
+    {
+      // All tiles outside of the visible map area are unloaded.
+      dropTiles = m_tileCache.tiles() + tileSectionSet;
+      dropTiles.subtract( keepTiles );
+    }
+  else
+    {
+      // Only unload the least recently used tiles to meet the budget.
+      dropTiles = m_tileCache.evictionCandidates( keepTiles );
+    }
 
   // @AP: check, if something is to free, otherwise we can return to spare
   // processing time
-  if ( ! something2free )
+  if( dropTiles.isEmpty() )
     {
       return;
     }
 
+  foreach( int secID, dropTiles )
+    {
+      // remove not more needed element from related objects
+      tilePartMap.remove( secID );
+      tileSectionSet.remove( secID );
+      m_tileAreas.remove( secID );
+      m_indexedParts.remove( secID );
+      m_tileCache.remove( secID );
+    }
+
 #ifdef DEBUG_UNLOAD_SUM
   // save free memory
   int memFreeBegin = HwInfo::instance()->getFreeMemory();
@@ -2194,86 +2369,88 @@ void MapContents::unloadMaps(unsigned int distance)
   QTime t;
   t.start();
 
-  unloadMapObjects( cityList );
+  unloadMapObjects( cityList, dropTiles );
 
 #ifdef DEBUG_UNLOAD
   uint sum = t.elapsed();
   qDebug("Unload cityList(%d), elapsed=%d", cityList.count(), t.restart());
 #endif
 
-  unloadMapObjects( hydroList );
+  unloadMapObjects( hydroList, dropTiles );
 
 #ifdef DEBUG_UNLOAD
   sum += t.elapsed();
   qDebug("Unload hydroList(%d), elapsed=%d", hydroList.count(), t.restart());
 #endif
 
-  unloadMapObjects( lakeList );
+  unloadMapObjects( lakeList, dropTiles );
 
 #ifdef DEBUG_UNLOAD
   sum += t.elapsed();
   qDebug("Unload lakeList(%d), elapsed=%d", lakeList.count(), t.restart());
 #endif
 
-  unloadMapObjects( groundMap );
-  unloadMapObjects( terrainMap );
+  unloadMapObjects( groundMap, dropTiles );
+  unloadMapObjects( terrainMap, dropTiles );
+
+  // Keep only the tiles in the elevation index, which are still loaded. A
+  // loaded tile may have no isohypses in the decode area.
+  m_elevationIndex.retainTiles( m_indexedParts.keys().toSet() );
 
 #ifdef DEBUG_UNLOAD
   sum += t.elapsed();
   qDebug("Unload isoList(%d), elapsed=%d", isoList.count(), t.restart());
 #endif
 
-  unloadMapObjects( landmarkList );
+  unloadMapObjects( landmarkList, dropTiles );
 
 #ifdef DEBUG_UNLOAD
   sum += t.elapsed();
   qDebug("Unload landmarkList(%d), elapsed=%d", landmarkList.count(), t.restart());
 #endif
 
-  unloadMapObjects( obstacleList );
+  unloadMapObjects( obstacleList, dropTiles );
 
 #ifdef DEBUG_UNLOAD
   sum += t.elapsed();
   qDebug("Unload obstacleList(%d), elapsed=%d", obstacleList.count(), t.restart());
 #endif
 
-  unloadMapObjects( railList );
+  unloadMapObjects( railList, dropTiles );
 
 #ifdef DEBUG_UNLOAD
   sum += t.elapsed();
   qDebug("Unload railList(%d), elapsed=%d", railList.count(), t.restart());
 #endif
 
-  unloadMapObjects( motorwayList );
+  unloadMapObjects( motorwayList, dropTiles );
 
 #ifdef DEBUG_UNLOAD
   sum += t.elapsed();
   qDebug("Unload motorwayList(%d), elapsed=%d", motorwayList.count(), t.restart());
 #endif
 
-  unloadMapObjects( roadList );
+  unloadMapObjects( roadList, dropTiles );
 
 #ifdef DEBUG_UNLOAD
   sum += t.elapsed();
   qDebug("Unload roadList(%d), elapsed=%d", roadList.count(), t.restart());
 #endif
 
-  unloadMapObjects( topoList );
+  unloadMapObjects( topoList, dropTiles );
 
 #ifdef DEBUG_UNLOAD
   sum += t.elapsed();
   qDebug("Unload topoList(%d), elapsed=%d", topoList.count(), t.restart());
 #endif
 
-  unloadMapObjects( villageList );
+  unloadMapObjects( villageList, dropTiles );
 
 #ifdef DEBUG_UNLOAD
   sum += t.elapsed();
   qDebug("Unload villageList(%d), elapsed=%d", villageList.count(), t.restart());
 #endif
 
-  unloadDone=true;
-
 #ifdef DEBUG_UNLOAD_SUM
   // save free memory
   int memFreeEnd = HwInfo::instance()->getFreeMemory();
@@ -2295,13 +2472,13 @@ void MapContents::updateProjectedCoordinates( QList<SinglePoint>& list )
     }
 }
 
-void MapContents::unloadMapObjects( QList<LineElement>& list )
+void MapContents::unloadMapObjects( QList<LineElement>& list, const QSet<int>& tiles )
 {
   bool renew = false;
 
   for (int i = list.count() - 1; i >= 0; i--)
     {
-       if ( !tileSectionSet.contains(list.at(i).getMapSegment()) )
+       if ( tiles.contains(list.at(i).getMapSegment()) )
         {
           list.removeAt(i);
           renew = true;
@@ -2317,13 +2494,13 @@ void MapContents::unloadMapObjects( QList<LineElement>& list )
     }
 }
 
-void MapContents::unloadMapObjects(QList<SinglePoint>& list)
+void MapContents::unloadMapObjects( QList<SinglePoint>& list, const QSet<int>& tiles )
 {
   bool renew = false;
 
   for (int i = list.count() - 1; i >= 0; i--)
     {
-      if ( !tileSectionSet.contains(list.at(i).getMapSegment()) )
+      if ( tiles.contains(list.at(i).getMapSegment()) )
         {
           list.removeAt(i);
           renew = true;
@@ -2339,30 +2516,24 @@ void MapContents::unloadMapObjects(QList<SinglePoint>& list)
     }
 }
 
-void MapContents::unloadMapObjects(QList<RadioPoint>& list)
+void MapContents::unloadMapObjects( QList<RadioPoint>& list, const QSet<int>& tiles )
 {
   for (int i = list.count() - 1; i >= 0; i--)
     {
-      if ( !tileSectionSet.contains(list.at(i).getMapSegment()) )
+      if ( tiles.contains(list.at(i).getMapSegment()) )
         {
           list.removeAt(i);
         }
     }
 }
 
-void MapContents::unloadMapObjects(QMap<int, QList<Isohypse> > isoMap)
+void MapContents::unloadMapObjects( QMap<int, QList<Isohypse> >& isoMap,
+                                    const QSet<int>& tiles )
 {
-
-  QList<int> keys = isoMap.keys();
-
-  for( int i = 0; i < keys.size(); i++ )
-   {
-     // Tile not in global list, remove it.
-     if( ! tileSectionSet.contains(keys.at(i)) )
-       {
-         isoMap.remove( keys.at(i) );
-       }
-     }
+  foreach( int secID, tiles )
+    {
+      isoMap.remove( secID );
+    }
 }
 
 /**
@@ -2617,10 +2788,17 @@ void MapContents::slotReloadMapData()
   // all isolines are cleared
   groundMap.clear();
   terrainMap.clear();
+  m_elevationIndex.clear();
 
   // tile maps are cleared
   tileSectionSet.clear();
   tilePartMap.clear();
+  m_tileAreas.clear();
+  m_indexedParts.clear();
+  m_tileCache.clear();
+  m_preloadTiles.clear();
+  m_preloadQueue.clear();
+  m_preloadTimer->stop();
 
   isFirst  = true;
   isReload = true;
@@ -3067,6 +3245,7 @@ void MapContents::slotNewFlarmAlertZoneData( FlarmBase::FlarmAlertZone& faz )
     {
       // The Flarm airspace object type is a circle
       QPolygon aspg;
+      QPolygon wgspg;
 
       // Distance of one arc minute along latitude and longitude
       double distLat = MapCalc::distC1( faz.Latitude, faz.Longitude, faz.Latitude + 10000, faz.Longitude );
@@ -3090,9 +3269,11 @@ void MapContents::slotNewFlarmAlertZoneData( FlarmBase::FlarmAlertZone& faz )
           x = rint(x);
           y = rint(y);
 
+          wgspg.append( QPoint( (int) x, (int) y ) );
           aspg.append( _globalMapMatrix->wgsToMap( x, y ) );
         }
 
+      as->setWgsPolygon( wgspg );
       as->setProjectedPolygon( aspg );
     }
 
@@ -3445,9 +3626,6 @@ void MapContents::drawIsoList(QPainter* targetP)
   t.start();
 
   extern MapMatrix* _globalMapMatrix;
-  _lastIsoEntry = 0;
-  _isoLevelReset = true;
-  pathIsoLines.clear();
   bool isolines = false;
   GeneralConfig *conf = GeneralConfig::instance();
 
@@ -3484,7 +3662,7 @@ void MapContents::drawIsoList(QPainter* targetP)
   for( int i = 0; i < count; i++ )
     {
       // assign the map to be drawn to the iterator
-      QMapIterator<int, QList<Isohypse> > it(*isoMaps[i]);
+      QMutableMapIterator<int, QList<Isohypse> > it(*isoMaps[i]);
 
       while (it.hasNext())
         {
@@ -3502,11 +3680,13 @@ void MapContents::drawIsoList(QPainter* targetP)
               continue;
             }
 
-          const QList<Isohypse> &isoList = it.value();
+          // The isolines are accessed by reference, so that their cached
+          // screen geometry is kept.
+          QList<Isohypse> &isoList = it.value();
 
           for (int j = 0; j < isoList.size(); j++)
             {
-              Isohypse isoLine = isoList.at(j);
+              Isohypse& isoLine = isoList[j];
 
               if( drawTerrain )
                 {
@@ -3550,35 +3730,14 @@ void MapContents::drawIsoList(QPainter* targetP)
                 }
 
               // draw the single isoline
-              QPainterPath* Path = isoLine.drawRegion( targetP, isolines);
-
-              if (Path)
-                {
-                  // store drawn path in extra list for elevation finding
-                  IsoListEntry entry(Path, isoLine.getElevation());
-                  pathIsoLines.append(entry);
-                  //qDebug("  added Iso: %04x, %d", (int)reg, iso2.getElevation() );
-                }
+              isoLine.drawRegion( targetP, isolines );
             }
         }
     }
 
   targetP->restore();
-  pathIsoLines.sort();
-  _isoLevelReset = false;
 
   qDebug( "IsoList, drawTime=%dms", t.elapsed() );
-
-#if 0
-  QString isos;
-
-  for ( int l = 0; l < pathIsoLines.count(); l++ )
-    {
-      isos += QString("%1, ").arg(pathIsoLines.at(l).height);
-    }
-
-  qDebug( isos.toLatin1().data() );
-#endif
 }
 
 /**
@@ -3732,31 +3891,71 @@ bool MapContents::restoreFlightTask()
  * matches one of the waypoints in the list. */
 bool MapContents::isInWaypointList(const QPoint& wgsCoord)
 {
-  for (int i=0; i < wpList.count(); i++)
+  return wpIndex.findByPosition( wgsCoord ) != 0;
+}
+
+/**
+ * @Returns true if the name of the waypoint in the argument
+ * matches one of the waypoints in the list.
+ */
+bool MapContents::isInWaypointList(const QString& name )
+{
+  return wpIndex.findByName( name ) != 0;
+}
+
+Waypoint* MapContents::getWaypointFromList( const Waypoint* wp )
+{
+  if( wp == 0 )
     {
-      const Waypoint& wpItem = wpList.at(i);
+      return 0;
+    }
 
-      if ( wgsCoord == wpItem.wgsPoint )
+  // Equal waypoints have the same name, only these candidates are compared.
+  QList<Waypoint *> candidates = wpIndex.findAllByName( wp->name );
+
+  for( int i = 0; i < candidates.size(); i++ )
+    {
+      if( *candidates.at(i) == *wp )
         {
-          return true;
+          return candidates.at(i);
         }
     }
 
-  return false;
+  return 0;
 }
 
 /**
- * @Returns true if the name of the waypoint in the argument
+ * @Returns how often the name of the waypoint in the argument
  * matches one of the waypoints in the list.
  */
-bool MapContents::isInWaypointList(const QString& name )
+unsigned short MapContents::countNameInWaypointList( const QString& name )
+{
+  return wpIndex.countName( name );
+}
+
+Waypoint& MapContents::addWaypointToList( const Waypoint& wp )
 {
-  for (int i=0; i < wpList.count(); i++)
+  wpList.append( wp );
+
+  Waypoint& newWp = wpList.last();
+  wpIndex.add( &newWp );
+
+  return newWp;
+}
+
+bool MapContents::removeWaypointFromList( Waypoint* wp )
+{
+  if( wp == 0 || wpIndex.remove( wp ) == false )
     {
-      const Waypoint& wpItem = wpList.at(i);
+      // Not an element of the waypoint list.
+      return false;
+    }
 
-      if ( name == wpItem.name )
+  for( int i = 0; i < wpList.size(); i++ )
+    {
+      if( &wpList.at(i) == wp )
         {
+          wpList.removeAt( i );
           return true;
         }
     }
@@ -3764,46 +3963,72 @@ bool MapContents::isInWaypointList(const QString& name )
   return false;
 }
 
-Waypoint* MapContents::getWaypointFromList( const Waypoint* wp )
+int MapContents::removeWaypointsFromList( const QList<Waypoint *>& wps )
 {
-  if( wp == 0 )
+  if( wps.size() == 1 )
     {
-      return 0;
+      return removeWaypointFromList( wps.first() ) ? 1 : 0;
     }
 
-  for( int i=0; i < wpList.count(); i++ )
+  QSet<const Waypoint *> removals;
+
+  for( int i = 0; i < wps.size(); i++ )
     {
-      Waypoint& wpItem = wpList[i];
+      if( wpIndex.remove( wps.at(i) ) )
+        {
+          removals.insert( wps.at(i) );
+        }
+    }
+
+  int removed = 0;
 
-      if( wpItem == *wp )
+  // One pass over the list, the other elements keep their addresses.
+  for( int i = wpList.size() - 1; i >= 0 && removed < removals.size(); i-- )
+    {
+      if( removals.contains( &wpList.at(i) ) )
         {
-          return &wpItem;
+          wpList.removeAt( i );
+          removed++;
         }
     }
 
-  return 0;
+  return removed;
 }
 
-/**
- * @Returns how often the name of the waypoint in the argument
- * matches one of the waypoints in the list.
- */
-unsigned short MapContents::countNameInWaypointList( const QString& name )
+QList<Waypoint *> MapContents::findEqualWaypoints( const Waypoint& wp )
 {
-  ushort number = 0;
+  // Equal waypoints have the same name, only these candidates are compared.
+  QList<Waypoint *> candidates = wpIndex.findAllByName( wp.name );
+  QList<Waypoint *> result;
 
-  for (int i=0; i < wpList.count(); i++)
+  for( int i = 0; i < candidates.size(); i++ )
     {
-      const Waypoint& wpItem = wpList.at(i);
-
-      if ( name == wpItem.name )
+      if( *candidates.at(i) == wp )
         {
-          number++;;
+          result.append( candidates.at(i) );
         }
     }
 
-  return number;
+  return result;
+}
+
+void MapContents::clearWaypointList()
+{
+  wpIndex.clear();
+  wpList.clear();
+}
+
+void MapContents::updateWaypointInList( Waypoint& wp, const Waypoint& newData )
+{
+  // The index keys of the waypoint can change, it is removed before.
+  bool indexed = wpIndex.remove( &wp );
+
+  wp = newData;
 
+  if( indexed )
+    {
+      wpIndex.add( &wp );
+    }
 }
 
 QDateTime MapContents::getDateFromMapFile( const QString& path )
@@ -3906,92 +4131,34 @@ int MapContents::findElevation(const QPoint& coordP, Distance* errorDist)
 {
   extern MapMatrix* _globalMapMatrix;
 
-  const IsoListEntry* entry = 0;
   int height = 0;
   double error = 0.0;
 
-  QPoint coordP1 = _globalMapMatrix->wgsToMap(coordP.x(), coordP.y());
-  QPoint coord = _globalMapMatrix->map(coordP1);
-
-  IsoList* list = getIsohypseRegions();
-
-  // qDebug("list->count() %d", list->count() );
-  //qDebug("==searching for elevation==");
-  //qDebug("_lastIsoLevel %d, _nextIsoLevel %d",_lastIsoLevel, _nextIsoLevel);
-  if (_isoLevelReset)
-    {
-      qDebug("findElevation: Busy rebuilding the isomap. Returning last known result...");
-      return _lastIsoLevel;
-    }
-
-  int cnt = list->count();
-
-  for ( int i=0; i<cnt; i++ )
-    {
-      entry = &(list->at(i));
-      // qDebug("i: %d entry->height %d contains %d",i,entry->height, entry->path->contains(coord) );
-      // qDebug("Point x:%d y:%d", coord.x(), coord.y() );
-      // qDebug("boundingRect l:%d r:%d t:%d b:%d", entry->path->boundingRect().left(),
-      //                                 entry->path->boundingRect().right(),
-      //                                 entry->path->boundingRect().top(),
-      //                                 entry->path->boundingRect().bottom() );
-
-      if (entry->height > height && /*there is no reason to search a lower level if we already have a hit on a higher one*/
-          entry->height <= _nextIsoLevel) /* since the odds of skipping a level between two fixes are not too high, we can ignore higher levels, making searching more efficient.*/
-        {
-          if (entry->height == _lastIsoLevel && _lastIsoEntry)
-            {
-              //qDebug("Trying previous entry...");
-              if (_lastIsoEntry->path->contains(coord))
-                {
-                  height = qMax(height, entry->height);
-                  //qDebug("Found on height %d",entry->height);
-                  break;
-                }
-            }
-
-          if (entry == _lastIsoEntry)
-            {
-              continue; //we already tried this one, and it wasn't it.
-            }
-
-          //qDebug("Probing on height %d...", entry->height);
-
-          if (entry->path->contains(coord))
-            {
-              height = qMax(height,entry->height);
-              //qDebug("Found on height %d",entry->height);
-              _lastIsoEntry = entry;
-              break;
-            }
-        }
-    }
+  // The index works in projected map coordinates, which are independent
+  // of the current map scale and the screen transformation.
+  QPoint coord = _globalMapMatrix->wgsToMap(coordP.x(), coordP.y());
 
-  _lastIsoLevel = height;
+  m_elevationIndex.findElevation( coord, height );
 
   // The real altitude is between the current and the next
   // isolevel, therefore reduce error by taking the middle
   if ( height <100 )
     {
-      _nextIsoLevel = height+25;
       height += 12;
       error=12.5;
     }
   else if ( (height >=100) && (height < 500) )
     {
-      _nextIsoLevel = height+50;
       height += 25;
       error=25.0;
     }
   else if ( (height >=500) && (height < 1000) )
     {
-      _nextIsoLevel = height+100;
       height += 50;
       error=50.0;
     }
   else
     {
-      _nextIsoLevel = height+250;
       height += 125;
       error = 125.0;
     }
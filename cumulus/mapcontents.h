@@ -42,17 +42,20 @@
 #include <QMap>
 #include <QMutex>
 #include <QString>
+#include <QTimer>
 
 #include "airfield.h"
 #include "airspace.h"
 #include "distance.h"
 #include "flarmbase.h"
+#include "elevationindex.h"
 #include "flighttask.h"
-#include "isolist.h"
 #include "map.h"
 #include "radiopoint.h"
 #include "singlepoint.h"
+#include "tilecache.h"
 #include "waitscreen.h"
+#include "waypointindex.h"
 
 #ifdef INTERNET
 #include "DownloadManager.h"
@@ -265,13 +268,76 @@ class MapContents : public QObject
     void drawIsoList(QPainter* targetP);
 
     /**
-     * @return the waypoint list
+     * @return the waypoint list. Elements may be modified in place, as long
+     * as their name and position are kept. All other changes
+     * must be done by the methods below, which keep the waypoint index up
+     * to date.
      */
     QList<Waypoint>& getWaypointList()
     {
       return wpList;
     };
 
+    /**
+     * Appends a waypoint to the waypoint list.
+     *
+     * \return A reference to the new list element.
+     */
+    Waypoint& addWaypointToList( const Waypoint& wp );
+
+    /**
+     * Removes the passed element from the waypoint list. Other waypoints,
+     * which are equal to it, are kept.
+     *
+     * \param wp Element of the waypoint list
+     *
+     * \return True, if the waypoint was an element of the list.
+     */
+    bool removeWaypointFromList( Waypoint* wp );
+
+    /**
+     * Removes the passed elements from the waypoint list.
+     *
+     * \return The number of removed waypoints.
+     */
+    int removeWaypointsFromList( const QList<Waypoint *>& wps );
+
+    /**
+     * @return All elements of the waypoint list, which are equal to the
+     * passed waypoint.
+     */
+    QList<Waypoint *> findEqualWaypoints( const Waypoint& wp );
+
+    /**
+     * Removes all waypoints from the waypoint list.
+     */
+    void clearWaypointList();
+
+    /**
+     * Overwrites a waypoint of the waypoint list with new data.
+     *
+     * \param wp Element of the waypoint list
+     * \param newData New content of the element
+     */
+    void updateWaypointInList( Waypoint& wp, const Waypoint& newData );
+
+    /**
+     * @return All waypoints of the waypoint list with the passed name.
+     */
+    QList<Waypoint *> findWaypointsByName( const QString& name )
+    {
+      return wpIndex.findAllByName( name );
+    };
+
+    /**
+     * @return All waypoints of the waypoint list with the passed ICAO
+     * identifier.
+     */
+    QList<Waypoint *> findWaypointsByIcao( const QString& icao )
+    {
+      return wpIndex.findByIcao( icao );
+    };
+
     /**
      * Saves the current waypoint list into a file.
      */
@@ -338,41 +404,77 @@ class MapContents : public QObject
        */
     void AddPointToRect(QRect& rect, const QPoint& point);
 
-    /** Returns list of IsoHypse Regions */
-    IsoList* getIsohypseRegions()
-    {
-      return &pathIsoLines;
-    };
-
     /** Returns the elevation index for an elevation step in meters
      */
     uchar getElevationIndex(const ushort elevation ) const;
 
     /** returns ground elevation in meters
      * If the error argument is given, it will be set to the error margin for the
-     * returned value.
+     * returned value. The result is taken from the elevation index and does
+     * not depend on the last map drawing.
      */
     int findElevation(const QPoint& coord, Distance* errorDist=0);
 
     /** Updates the projected coordinates of this map object type */
     void updateProjectedCoordinates( QList<SinglePoint>& list );
     /**
-     * Deletes all currently not-needed map sections from memory
+     * Deletes not-needed map tiles from memory. If the unload option is
+     * set, all tiles outside of the keep set are deleted. Otherwise only the
+     * least recently used tiles are deleted, until the map tile memory budget
+     * is met again.
+     *
+     * @param keepTiles Tiles, which are in use and must not be deleted
      */
-    void unloadMaps(unsigned int=0);
+    void unloadMaps( const QSet<int>& keepTiles );
 
     /**
-     * Deletes all map items that are not contained in the tile section set
-     * of the passed list.
+     * Deletes all map items of the passed list, which belong to one of the
+     * passed tiles.
      * Used by @ref unloadMaps to do the actual deleting.
      */
-    void unloadMapObjects(QList<LineElement>& list);
+    void unloadMapObjects( QList<LineElement>& list, const QSet<int>& tiles );
+
+    void unloadMapObjects( QList<SinglePoint>& list, const QSet<int>& tiles );
+
+    void unloadMapObjects( QList<RadioPoint>& list, const QSet<int>& tiles );
+
+    void unloadMapObjects( QMap<int, QList<Isohypse> >& isoMap, const QSet<int>& tiles );
+
+    /**
+     * @param border Map border in KFLog coordinates, X=Longitude, Y=Latitude
+     * @return The identifiers of all tiles covered by the border.
+     */
+    QSet<int> tilesOfBorder( const QRect& border ) const;
 
-    void unloadMapObjects(QList<SinglePoint>& list);
+    /**
+     * Loads the missing files of a tile. Only the elements of compiled map
+     * files inside of the decode area are stored. A null rectangle loads
+     * all elements.
+     */
+    void loadTile( const int secID, const QRect& decodeArea );
 
-    void unloadMapObjects(QList<RadioPoint>& list);
+    /**
+     * Removes all map elements of a tile, so that it can be decoded again
+     * for another area. The elevation index of the tile is kept.
+     */
+    void unloadTile( const int secID );
 
-    void unloadMapObjects(QMap<int, QList<Isohypse> > isoMap);
+    /**
+     * Determines the tiles ahead along the current track and starts their
+     * loading in idle times.
+     *
+     * @param viewBorder Visible map border in KFLog coordinates
+     */
+    void schedulePreload( const QRect& viewBorder );
+
+    /**
+     * @return true, if an element with the passed bounding box must be
+     * decoded from a compiled map file.
+     */
+    bool isInDecodeArea( const QRect& box ) const
+    {
+      return m_decodeArea.isNull() || m_decodeArea.intersects( box );
+    };
 
     /**
      * This function checks all possible map directories for the
@@ -532,6 +634,14 @@ class MapContents : public QObject
                                    QList<Airfield>* airfieldListIn,
                                    QList<Airfield>* gliderfieldListIn,
                                    QList<Airfield>* outlandingListIn );
+
+  private slots:
+
+    /**
+     * Loads the next tile ahead along the track, which is not yet loaded.
+     */
+    void slotPreloadTile();
+
   signals:
 
     /**
@@ -743,15 +853,50 @@ class MapContents : public QObject
     TilePartMap tilePartMap;
 
     /**
-     * True if an unload call has already been made this 'round' of map drawing.
+     * Memory bookkeeping of the loaded map tiles. It decides, which tiles
+     * are unloaded, if the map tile memory budget is exceeded.
      */
-    bool unloadDone;
+    TileCache m_tileCache;
 
     /**
-     * True if even after the unload, there is still not enough free memory, so new maps
-     * may not be loaded.
+     * Tiles covering the currently visible map area.
      */
-    bool memoryFull;
+    QSet<int> m_viewTiles;
+
+    /**
+     * Projected area, whose elements are decoded from compiled map files.
+     * A null rectangle decodes all elements.
+     */
+    QRect m_decodeArea;
+
+    /**
+     * Decode areas of the loaded tiles. Tiles without an entry have been
+     * decoded completely.
+     */
+    QHash<int, QRect> m_tileAreas;
+
+    /**
+     * Ground (1) and terrain (2) files of a tile, whose isohypses are
+     * contained in the elevation index.
+     */
+    QHash<int, char> m_indexedParts;
+
+    /**
+     * Tiles ahead along the track, which are kept loaded.
+     */
+    QSet<int> m_preloadTiles;
+
+    /**
+     * Tiles ahead along the track, which are still to be loaded.
+     */
+    QList<int> m_preloadQueue;
+
+    QTimer* m_preloadTimer;
+
+    /**
+     * Flag to prevent a recursive loading of map tiles.
+     */
+    bool m_loadingTiles;
 
     /**
      * Flag to signal first loading of map data
@@ -766,18 +911,9 @@ class MapContents : public QObject
     QPointer<WaitScreen> ws;
 
     /**
-     * List of all drawn isohypses.
-     */
-    IsoList pathIsoLines;
-
-    /**
-     * Elevation where the next search for the current elevation will start.
-     * Set to one level higher than the current level by findElevation().
+     * Index over all loaded isohypses used for elevation finding.
      */
-    int _nextIsoLevel;
-    int _lastIsoLevel;
-    bool _isoLevelReset;
-    const IsoListEntry* _lastIsoEntry;
+    ElevationIndex m_elevationIndex;
 
     /**
      * Array containing the used elevation levels in meters. Is used as help
@@ -800,6 +936,11 @@ class MapContents : public QObject
      */
     QList<Waypoint> wpList;
 
+    /**
+     * Name and position index of the waypoint list.
+     */
+    WaypointIndex wpIndex;
+
 #ifdef INTERNET
 
     /** Manager to handle downloads of missing map file. */
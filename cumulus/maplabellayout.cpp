@@ -0,0 +1,440 @@
+/***********************************************************************
+ **
+ **   maplabellayout.cpp
+ **
+ **   This file is part of Cumulus.
+ **
+ ************************************************************************
+ **
+ **   Copyright (c):  2026 by the Cumulus contributors
+ **
+ **   This file is distributed under the terms of the General Public
+ **   License. See the file COPYING for more information.
+ **
+ ***********************************************************************/
+
+#include <algorithm>
+
+#include <QtGui>
+
+#include "calculator.h"
+#include "distance.h"
+#include "generalconfig.h"
+#include "layout.h"
+#include "mapmatrix.h"
+#include "maplabellayout.h"
+#include "reachablelist.h"
+
+extern Calculator* calculator;
+extern MapMatrix*  _globalMapMatrix;
+
+MapLabelLayout::MapLabelLayout() :
+  m_columns(0),
+  m_rows(0),
+  m_scale(0.0),
+  m_minLineHeight(0),
+  m_penWidth(2)
+{
+  m_minCharWidth[0] = m_minCharWidth[1] = 0;
+}
+
+MapLabelLayout::~MapLabelLayout()
+{
+}
+
+void MapLabelLayout::begin( const QSize& screen, const double scale )
+{
+  m_candidates.clear();
+  m_candidateIndex.clear();
+
+  if( m_scale != scale )
+    {
+      // The cached labels contain distances and arrival altitudes, which
+      // are not reused after a scale change.
+      m_pixmaps.clear();
+      m_scale = scale;
+    }
+
+  m_columns = screen.width() / CellSize + 1;
+  m_rows    = screen.height() / CellSize + 1;
+
+  m_cells.clear();
+  m_cells.resize( m_columns * m_rows );
+}
+
+void MapLabelLayout::add( const enum Priority priority,
+                          const QString& name,
+                          const QPoint& dispP,
+                          const WGSPoint& wgsP,
+                          const int xShift,
+                          const bool isLandable )
+{
+  enum Priority prio = priority;
+
+  if( calculator && calculator->getTargetWp() &&
+      calculator->getTargetWp()->name == name &&
+      calculator->getTargetWp()->wgsPoint == wgsP )
+    {
+      // The selected target is placed at first.
+      prio = Target;
+    }
+
+  const qint64 key = ReachableList::coordinateKey( wgsP );
+
+  QHash<qint64, int>::const_iterator it = m_candidateIndex.constFind( key );
+
+  if( it != m_candidateIndex.constEnd() )
+    {
+      // A label with the same coordinates does already exist. Only the
+      // label with the higher priority is drawn.
+      Candidate& c = m_candidates[it.value()];
+
+      if( prio < c.priority )
+        {
+          c.priority = prio;
+          c.name = name;
+          c.dispP = dispP;
+          c.xShift = xShift;
+        }
+
+      c.isLandable = c.isLandable || isLandable;
+      return;
+    }
+
+  Candidate c;
+  c.priority = prio;
+  c.name = name;
+  c.dispP = dispP;
+  c.wgsP = wgsP;
+  c.xShift = xShift;
+  c.isLandable = isLandable;
+
+  m_candidateIndex.insert( key, m_candidates.size() );
+  m_candidates.append( c );
+}
+
+void MapLabelLayout::draw( QPainter* painter )
+{
+  if( m_candidates.isEmpty() )
+    {
+      return;
+    }
+
+  // We use always the same point size independently from the screen size
+  QFont font = painter->font();
+  font.setPointSize( MapLabelFontPointSize );
+  font.setBold( false );
+
+  m_penWidth = 2 * Layout::getIntScaledDensity();
+
+  if( font != m_font )
+    {
+      m_font = font;
+      m_boldFont = font;
+      m_boldFont.setBold( true );
+
+      QFontMetrics fm( m_font );
+      QFontMetrics bfm( m_boldFont );
+
+      m_minCharWidth[0] = narrowestGlyph( fm );
+      m_minCharWidth[1] = narrowestGlyph( bfm );
+      m_minLineHeight   = qMin( qMin( fm.height(), fm.lineSpacing() ),
+                                qMin( bfm.height(), bfm.lineSpacing() ) );
+
+      m_sizes.clear();
+      m_pixmaps.clear();
+    }
+
+  // Sort the candidates by priority. The original order is kept for equal
+  // priorities. The coordinate index is not needed anymore.
+  std::stable_sort( m_candidates.begin(), m_candidates.end(), lessPriority );
+  m_candidateIndex.clear();
+
+  const bool drawLabelInfo = GeneralConfig::instance()->getMapShowLabelsExtraInfo();
+  const int centerLon = _globalMapMatrix->getMapCenter(false).y();
+
+  for( int i = 0; i < m_candidates.size(); i++ )
+    {
+      const Candidate& c = m_candidates.at(i);
+
+      Altitude alt;
+      enum ReachablePoint::reachable reachable;
+
+      ReachableList::getArrivalInfo( c.wgsP, alt, reachable );
+
+      QString labelText = c.name;
+
+      if( drawLabelInfo && c.isLandable )
+        {
+          // draw the name together with the additional information
+          Distance dist = ReachableList::getDistance( c.wgsP );
+
+          if( dist.isValid() )
+            {
+              labelText += "\n" +
+                           dist.getText( false, uint(0), uint(0) ) +
+                           " / " +
+                           alt.getText( false, 0 );
+            }
+        }
+
+      // land and reachable? then the label will become bold
+      const bool bold = c.isLandable && reachable == ReachablePoint::yes;
+
+      // Points on the left side of the map get the label on the right side.
+      const bool right = c.wgsP.lon() < centerLon;
+
+      QString sizeKey = (bold ? "B" : "N") + labelText;
+      QSize size = m_sizes.value( sizeKey );
+
+      if( size.isEmpty() )
+        {
+          // The text was not measured up to now. If not even the lower
+          // bound of the label fits, the text is not measured at all.
+          QSize est = estimateSize( labelText, bold );
+
+          if( ! isFree( labelBox( c, est, right ) ) &&
+              ! isFree( labelBox( c, est, ! right ) ) )
+            {
+              continue;
+            }
+
+          size = textSize( labelText, bold );
+        }
+
+      QRect box = labelBox( c, size, right );
+
+      if( ! isFree( box ) )
+        {
+          box = labelBox( c, size, ! right );
+
+          if( ! isFree( box ) )
+            {
+              continue;
+            }
+        }
+
+      occupy( box );
+
+      QPixmap pm = labelPixmap( labelText, size, bold,
+                                c.priority == Target, reachable );
+
+      painter->drawPixmap( box.x() - m_penWidth / 2, box.y() - m_penWidth / 2, pm );
+    }
+}
+
+bool MapLabelLayout::lessPriority( const Candidate& c1, const Candidate& c2 )
+{
+  return c1.priority < c2.priority;
+}
+
+QRect MapLabelLayout::labelBox( const Candidate& c,
+                                const QSize& size,
+                                const bool right ) const
+{
+  int xOffset = c.xShift;
+
+  if( ! right )
+    {
+      xOffset = -size.width() - c.xShift;
+    }
+
+  return QRect( c.dispP.x() + xOffset,
+                c.dispP.y() - size.height() / 2,
+                size.width(), size.height() );
+}
+
+bool MapLabelLayout::cellRange( const QRect& box,
+                                int& x1, int& y1, int& x2, int& y2 ) const
+{
+  if( box.right() < 0 || box.bottom() < 0 )
+    {
+      return false;
+    }
+
+  x1 = qMax( 0, box.left() / CellSize );
+  y1 = qMax( 0, box.top() / CellSize );
+  x2 = qMin( m_columns - 1, box.right() / CellSize );
+  y2 = qMin( m_rows - 1, box.bottom() / CellSize );
+
+  return x1 <= x2 && y1 <= y2;
+}
+
+bool MapLabelLayout::isFree( const QRect& box ) const
+{
+  int x1, y1, x2, y2;
+
+  if( ! cellRange( box, x1, y1, x2, y2 ) )
+    {
+      // Outside of the screen, nothing can overlap.
+      return true;
+    }
+
+  for( int y = y1; y <= y2; y++ )
+    {
+      for( int x = x1; x <= x2; x++ )
+        {
+          const QVector<QRect>& cell = m_cells.at( y * m_columns + x );
+
+          for( int i = 0; i < cell.size(); i++ )
+            {
+              if( cell.at(i).intersects( box ) )
+                {
+                  return false;
+                }
+            }
+        }
+    }
+
+  return true;
+}
+
+void MapLabelLayout::occupy( const QRect& box )
+{
+  int x1, y1, x2, y2;
+
+  if( ! cellRange( box, x1, y1, x2, y2 ) )
+    {
+      return;
+    }
+
+  for( int y = y1; y <= y2; y++ )
+    {
+      for( int x = x1; x <= x2; x++ )
+        {
+          m_cells[y * m_columns + x].append( box );
+        }
+    }
+}
+
+QSize MapLabelLayout::estimateSize( const QString& text, const bool bold ) const
+{
+  QStringList lines = text.split( '\n' );
+
+  int chars = 0;
+
+  for( int i = 0; i < lines.size(); i++ )
+    {
+      // Only printable ASCII characters are counted, other characters can
+      // be narrower than the narrowest glyph.
+      const QString& line = lines.at(i);
+      int ascii = 0;
+
+      for( int j = 0; j < line.size(); j++ )
+        {
+          if( line.at(j).unicode() >= 0x20 && line.at(j).unicode() < 0x7f )
+            {
+              ascii++;
+            }
+        }
+
+      chars = qMax( chars, ascii );
+    }
+
+  // No counted character is narrower than the narrowest glyph and no line
+  // is lower than the smallest line height. The margins added to the
+  // measured size are left out, they cover a negative kerning of the text.
+  return QSize( chars * m_minCharWidth[bold ? 1 : 0],
+                lines.size() * m_minLineHeight );
+}
+
+int MapLabelLayout::narrowestGlyph( const QFontMetrics& fm )
+{
+  int width = fm.width( QChar(' ') );
+
+  for( ushort c = 0x21; c < 0x7f; c++ )
+    {
+      width = qMin( width, fm.width( QChar(c) ) );
+    }
+
+  return width;
+}
+
+QSize MapLabelLayout::textSize( const QString& text, const bool bold )
+{
+  QString key = (bold ? "B" : "N") + text;
+
+  QHash<QString, QSize>::const_iterator it = m_sizes.constFind( key );
+
+  if( it != m_sizes.constEnd() )
+    {
+      return it.value();
+    }
+
+  QFontMetrics fm( bold ? m_boldFont : m_font );
+
+  // calculate text bounding box
+  QRect textBox = fm.boundingRect( QRect( 0, 0, 400, 400 ), Qt::AlignCenter, text );
+
+  // add a little bit more space in the width and in the height
+  QSize size( textBox.width() + 8, textBox.height() + 4 );
+
+  m_sizes.insert( key, size );
+  return size;
+}
+
+QPixmap MapLabelLayout::labelPixmap( const QString& text,
+                                     const QSize& size,
+                                     const bool bold,
+                                     const bool selected,
+                                     const enum ReachablePoint::reachable reach )
+{
+  QString key = QString("%1%2%3").arg(bold).arg(selected).arg(reach) + text;
+
+  QHash<QString, QPixmap>::const_iterator it = m_pixmaps.constFind( key );
+
+  if( it != m_pixmaps.constEnd() )
+    {
+      return it.value();
+    }
+
+  if( m_pixmaps.size() >= MaxPixmaps )
+    {
+      m_pixmaps.clear();
+    }
+
+  QColor reachColor;
+
+  if( reach == ReachablePoint::yes )
+    {
+      reachColor = Qt::green;
+    }
+  else if( reach == ReachablePoint::belowSafety )
+    {
+      reachColor = Qt::magenta;
+    }
+  else
+    {
+      reachColor = Qt::red;
+    }
+
+  // The frame is drawn centered on the label box, therefore the pixmap is
+  // enlarged by the pen width.
+  QPixmap pm( size + QSize( m_penWidth, m_penWidth ) );
+  pm.fill( Qt::transparent );
+
+  QPainter painter( &pm );
+
+  QRect textBox( m_penWidth / 2, m_penWidth / 2, size.width(), size.height() );
+
+  painter.setFont( bold ? m_boldFont : m_font );
+  painter.setPen( QPen( reachColor, m_penWidth, Qt::SolidLine ) );
+
+  if( ! selected )
+    {
+      painter.setBrush( Qt::white );
+    }
+  else
+    {
+      // draw selected waypoint label inverse
+      painter.setBrush( Qt::black );
+    }
+
+  painter.drawRect( textBox );
+  painter.setPen( QPen( selected ? Qt::white : Qt::black, m_penWidth, Qt::SolidLine ) );
+  painter.drawText( textBox, Qt::AlignCenter, text );
+  painter.end();
+
+  m_pixmaps.insert( key, pm );
+  return pm;
+}
@@ -0,0 +1,209 @@
+/***********************************************************************
+ **
+ **   maplabellayout.h
+ **
+ **   This file is part of Cumulus.
+ **
+ ************************************************************************
+ **
+ **   Copyright (c):  2026 by the Cumulus contributors
+ **
+ **   This file is distributed under the terms of the General Public
+ **   License. See the file COPYING for more information.
+ **
+ ***********************************************************************/
+
+#ifndef MAP_LABEL_LAYOUT_H
+#define MAP_LABEL_LAYOUT_H
+
+#include <QFont>
+#include <QFontMetrics>
+#include <QHash>
+#include <QPixmap>
+#include <QPoint>
+#include <QRect>
+#include <QSize>
+#include <QString>
+#include <QVector>
+
+#include "reachablepoint.h"
+#include "wgspoint.h"
+
+class QPainter;
+
+/**
+ * \class MapLabelLayout
+ *
+ * \author Cumulus contributors
+ *
+ * \brief Places the point labels of the navigation layer without overlaps.
+ *
+ * The labels of the drawn map points are collected as candidates. When
+ * drawing, the candidates are placed in the order of their priority. A label
+ * is put on the preferred side of its point or, if that place is taken, on
+ * the other side. If both places are taken, the label is skipped. The taken
+ * places are registered in a grid over the screen, that only the labels in
+ * the touched cells must be checked.
+ *
+ * The size of a label is taken from a cache. If it is not known, a lower
+ * bound of it is checked at first, that the text of a losing label is not
+ * measured. A label, which does not fit with its lower bound, can never fit
+ * with its measured size, so the result does not depend on the cache. The rendered labels are cached as pixmaps, as long as the map
+ * scale is not changed.
+ *
+ * \date 2026
+ */
+class MapLabelLayout
+{
+ public:
+
+  /** Label priorities, lower values are placed first. */
+  enum Priority
+  {
+    Target = 0,   // the selected target
+    TaskPoint,    // points of the planned task
+    Landable,     // airfields, outlandings and landable waypoints
+    Navaid,       // navigation aids
+    Other         // all other waypoints
+  };
+
+  MapLabelLayout();
+
+  virtual ~MapLabelLayout();
+
+  /**
+   * Starts a new layout. All candidates of the last layout are removed.
+   * The pixmap cache is cleared, if the scale has been changed.
+   *
+   * @param screen Size of the map screen
+   * @param scale Current map scale
+   */
+  void begin( const QSize& screen, const double scale );
+
+  /**
+   * Adds a label candidate. If a candidate with the same coordinates does
+   * already exist, only the one with the higher priority is kept.
+   *
+   * @param priority Priority of the label
+   * @param name Name of the point
+   * @param dispP Projected point at the display
+   * @param wgsP WGS84 point
+   * @param xShift X offset of the label from the point
+   * @param isLandable Is the point landable?
+   */
+  void add( const enum Priority priority,
+            const QString& name,
+            const QPoint& dispP,
+            const WGSPoint& wgsP,
+            const int xShift,
+            const bool isLandable );
+
+  /**
+   * Places all candidates and draws the placed labels.
+   */
+  void draw( QPainter* painter );
+
+ private:
+
+  class Candidate
+  {
+   public:
+
+    Candidate() : priority(Other), xShift(0), isLandable(false) {};
+
+    enum Priority priority;
+    QString name;
+    QPoint dispP;
+    WGSPoint wgsP;
+    int xShift;
+    bool isLandable;
+  };
+
+  /** Cell size of the occupancy grid in pixels. */
+  enum { CellSize = 32 };
+
+  /** Maximum number of cached label pixmaps. */
+  enum { MaxPixmaps = 500 };
+
+  /**
+   * Sort function for the candidates.
+   */
+  static bool lessPriority( const Candidate& c1, const Candidate& c2 );
+
+  /**
+   * Returns the box of the label on the given side of its point.
+   */
+  QRect labelBox( const Candidate& c, const QSize& size, const bool right ) const;
+
+  /**
+   * Checks, if the box does not overlap an already placed label.
+   */
+  bool isFree( const QRect& box ) const;
+
+  /**
+   * Registers the box as taken.
+   */
+  void occupy( const QRect& box );
+
+  /**
+   * Returns the cell range covered by the box.
+   */
+  bool cellRange( const QRect& box, int& x1, int& y1, int& x2, int& y2 ) const;
+
+  /**
+   * Returns a lower bound of the label size without measuring the text.
+   */
+  QSize estimateSize( const QString& text, const bool bold ) const;
+
+  /**
+   * Returns the width of the narrowest printable ASCII glyph of the font.
+   */
+  static int narrowestGlyph( const QFontMetrics& fm );
+
+  /**
+   * Returns the measured label size. The result is cached.
+   */
+  QSize textSize( const QString& text, const bool bold );
+
+  /**
+   * Returns the rendered label. The result is cached.
+   */
+  QPixmap labelPixmap( const QString& text,
+                       const QSize& size,
+                       const bool bold,
+                       const bool selected,
+                       const enum ReachablePoint::reachable reach );
+
+  QVector<Candidate> m_candidates;
+
+  /** Indices of the candidates, the key is the coordinate key. */
+  QHash<qint64, int> m_candidateIndex;
+
+  /** Placed label boxes per grid cell. */
+  QVector< QVector<QRect> > m_cells;
+
+  int m_columns;
+  int m_rows;
+
+  double m_scale;
+
+  QFont m_font;
+  QFont m_boldFont;
+
+  /** Narrowest glyph width of the normal and the bold font. */
+  int m_minCharWidth[2];
+
+  /** Smallest line height of both fonts. */
+  int m_minLineHeight;
+
+  /** Pen width of the label frame. */
+  int m_penWidth;
+
+  /** Measured label sizes, the key is the font style and the text. */
+  QHash<QString, QSize> m_sizes;
+
+  /** Rendered labels of the current scale. */
+  QHash<QString, QPixmap> m_pixmaps;
+};
+
+#endif
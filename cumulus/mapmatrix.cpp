@@ -68,6 +68,7 @@
 
 MapMatrix::MapMatrix( QObject* parent ) :
   QObject(parent),
+  matrixGeneration(1),
   mapCenterLat(0), mapCenterLon(0),
   homeLat(0), homeLon(0), cScale(0), pScale(0), rotationArc(0)
 {
@@ -394,6 +395,8 @@ void MapMatrix::createMatrix(const QSize& newSize)
 
   worldMatrix *= translateMatrix;
 
+  matrixGeneration++;
+
   //trying to rotate around center
   /*
     QPoint curProjCenter= worldMatrix * QPoint(mapCenterLat, mapCenterLon);
@@ -367,6 +367,25 @@ public:
       return currentProjection;
     };
 
+  /**
+   * @returns the current transformation from projected map coordinates
+   * to screen coordinates
+   */
+  const QTransform& getWorldMatrix() const
+    {
+      return worldMatrix;
+    };
+
+  /**
+   * @returns a number, which is incremented each time the world matrix is
+   * changed. Map elements can use it to detect, if cached screen data are
+   * still valid.
+   */
+  uint getMatrixGeneration() const
+    {
+      return matrixGeneration;
+    };
+
   public slots:
 
   /** Sets all mapping parameters of the projection matrix. */
@@ -434,6 +453,11 @@ public:
    */
   QTransform invertMatrix;
 
+  /**
+   * Change counter of the world matrix.
+   */
+  uint matrixGeneration;
+
   /**
    * The mapCenter is the position displayed in the center of the map.
    * It is used in two different ways:
@@ -351,6 +351,8 @@ MapView::MapView(QWidget *parent) : QWidget(parent)
   _vario->setMapInfoBoxMaxHeight( textLabelBoxHeight );
   VALayout->addWidget(_vario, 2 );
   connect(_vario, SIGNAL(mouseShortPress()), this, SLOT(slot_VarioDialog()));
+  connect(_vario, SIGNAL(mouseLongPress()), this, SLOT(slot_toggleVarioMode()));
+  _varioMode = 0; // vario display is default
 
   sideLayout->addWidget( commonBar, 3 );
 
@@ -981,6 +983,52 @@ void MapView::slot_Mc (const Speed& mc)
 /** This slot is called if a new variometer value has been set */
 void MapView::slot_Vario (const Speed& vario)
 {
+  _lastVario = vario;
+
+  if( _varioMode == 0 )
+    {
+      show_Vario();
+    }
+}
+
+/** This slot is called if new netto and relative variometer values have been set */
+void MapView::slot_NettoVario (const Speed& netto, const Speed& relative)
+{
+  _lastNetto = netto;
+  _lastRelative = relative;
+
+  if( _varioMode != 0 )
+    {
+      show_Vario();
+    }
+}
+
+/** toggle between vario, netto and relative vario display on mouse signal */
+void MapView::slot_toggleVarioMode()
+{
+  _varioMode = (_varioMode + 1) % 3;
+
+  switch( _varioMode )
+    {
+      case 1:
+        _vario->setPreText("Net");
+        break;
+      case 2:
+        _vario->setPreText("Rel");
+        break;
+      default:
+        _vario->setPreText("Var");
+        break;
+    }
+
+  show_Vario();
+}
+
+void MapView::show_Vario()
+{
+  const Speed& vario = (_varioMode == 1) ? _lastNetto :
+                       (_varioMode == 2) ? _lastRelative : _lastVario;
+
   if( ! vario.isValid() )
     {
       _vario->setValue("-");
@@ -1408,6 +1456,8 @@ void MapView::slot_VarioDialog()
            calculator->getVario(), SLOT( slotNewTEKMode( bool ) ) );
   connect( vmDlg, SIGNAL( newTEKAdjust( int ) ),
            calculator->getVario(), SLOT( slotNewTEKAdjust( int ) ) );
+  connect( vmDlg, SIGNAL( newFilter( int ) ),
+           calculator->getVario(), SLOT( slotNewFilter( int ) ) );
 
   emit openingSubWidget();
   vmDlg->setVisible(true);
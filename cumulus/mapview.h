@@ -248,6 +248,12 @@ class MapView : public QWidget
      */
     void slot_Vario (const Speed& vario);
 
+    /**
+     * This slot is called if new netto and relative variometer values
+     * have been set
+     */
+    void slot_NettoVario (const Speed& netto, const Speed& relative);
+
     /**
      * This slot is called if a new wind value has been set
      */
@@ -327,6 +333,11 @@ class MapView : public QWidget
      */
     void slot_toggleGsTas();
 
+    /**
+     * toggle between vario, netto and relative vario display on mouse signal
+     */
+    void slot_toggleVarioMode();
+
     /**
      * toggle between wind and LD widget on mouse signal
      */
@@ -404,6 +415,11 @@ signals:
      */
     void show_ETA(const QTime& eta, bool immediately=false );
 
+    /**
+     * Sets the text in the vario display according to the vario mode.
+     */
+    void show_Vario();
+
     /**
      * pointer to the map widget
      */
@@ -489,6 +505,12 @@ signals:
     QTimer* m_infoTimer;
     /** Last reported ETA value. */
     QTime m_lastEta;
+    /** vario mode 0=vario, 1=netto vario, 2=relative vario */
+    int _varioMode;
+    /** Last reported vario values, used by the vario mode toggle. */
+    Speed _lastVario;
+    Speed _lastNetto;
+    Speed _lastRelative;
 };
 
 #endif
@@ -0,0 +1,236 @@
+/***********************************************************************
+ **
+ **   nmeatokenizer.h
+ **
+ **   This file is part of Cumulus.
+ **
+ ************************************************************************
+ **
+ **   Copyright (c):  2026 by the Cumulus contributors
+ **
+ **   This file is distributed under the terms of the General Public
+ **   License. See the file COPYING for more information.
+ **
+ ***********************************************************************/
+
+#ifndef NMEA_TOKENIZER_H
+#define NMEA_TOKENIZER_H
+
+#include <QDate>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QTime>
+
+/**
+ * \class NmeaTokenizer
+ *
+ * \author Cumulus contributors
+ *
+ * \brief Allocation free splitter and field parser for NMEA sentences.
+ *
+ * The tokenizer splits a sentence at every comma and at the checksum
+ * separator like QString::split does with QString::KeepEmptyParts. Only the
+ * start and the length of every field are stored in a fixed array, no
+ * strings are created. The numeric, time, date and coordinate parsers work
+ * directly on the characters of the sentence.
+ *
+ * The sentence identifier is mapped to a \ref Sentence number by packing
+ * its characters into an integer key, which is collision free for all
+ * identifiers of up to seven characters. The known keys are taken from a
+ * single table and are looked up by a perfect hash.
+ *
+ * The tokenizer only references the passed sentence, which must stay
+ * unchanged as long as the tokenizer is used.
+ *
+ * \date 2026
+ */
+class NmeaTokenizer
+{
+ public:
+
+  /**
+   * Known sentence identifiers. The numbers are the same as used by the
+   * former sentence hash of GpsNmea.
+   */
+  enum Sentence
+  {
+    Unknown = -1,
+    GPRMC = 0,
+    GPGLL = 1,
+    GPGGA = 2,
+    GPGSA = 3,
+    GPGSV = 4,
+    PGRMZ = 5,
+    PCAID = 6,
+    CambridgeW = 7,
+    PGCS = 8,
+    LXWP0 = 9,
+    LXWP2 = 10,
+    GPDTM = 11,
+    PFLAA = 20,
+    PFLAU = 21,
+    PFLAV = 22,
+    PFLAE = 23,
+    PFLAC = 24,
+    PFLAR = 25,
+    PFLAI = 26,
+    PFLAO = 27,
+    FlarmError = 29,
+    MAEMO0 = 40,
+    MAEMO1 = 41
+  };
+
+  /** Maximum number of fields of a sentence. */
+  enum { MaxFields = 64 };
+
+  NmeaTokenizer();
+
+  /**
+   * Splits the passed sentence into its fields. Trailing line end characters
+   * are ignored.
+   *
+   * @param sentence NMEA sentence to be split
+   * @return false, if the sentence is empty or has too many fields
+   */
+  bool tokenize( const QString& sentence );
+
+  /**
+   * @return The identifier of the sentence as \ref Sentence number.
+   */
+  int sentenceId() const
+  {
+    return m_id;
+  };
+
+  /**
+   * @return The number of fields including the identifier and the checksum.
+   */
+  int count() const
+  {
+    return m_count;
+  };
+
+  /**
+   * @return true, if the sentence contains a checksum separator.
+   */
+  bool hasChecksum() const
+  {
+    return m_checksumPos >= 0;
+  };
+
+  /**
+   * @return true, if the checksum of the sentence is valid.
+   */
+  bool checksumOk() const;
+
+  /**
+   * @return A reference to the field with the passed index. An empty
+   * reference is returned for an invalid index.
+   */
+  QStringRef field( const int i ) const;
+
+  bool isEmpty( const int i ) const
+  {
+    return i < 0 || i >= m_count || m_length[i] == 0;
+  };
+
+  /**
+   * Compares the field with a Latin-1 string.
+   */
+  bool fieldEquals( const int i, const char* latin1 ) const;
+
+  /**
+   * @return A copy of the field as string. Note, this allocates memory.
+   */
+  QString toString( const int i ) const
+  {
+    return field(i).toString();
+  };
+
+  /**
+   * @return All fields as string list for decoders, which were not
+   * ported to the tokenizer. Note, this allocates memory.
+   */
+  QStringList toStringList() const;
+
+  bool toInt( const int i, int& value ) const
+  {
+    return parseInt( field(i), value );
+  };
+
+  bool toDouble( const int i, double& value ) const
+  {
+    return parseDouble( field(i), value );
+  };
+
+  /**
+   * Parses a coordinate in the NMEA format ddmm.mmmm or dddmm.mmmm into
+   * the KFLog format.
+   *
+   * @param value Index of the coordinate field
+   * @param hemisphere Index of the field with N, S, E or W
+   * @param coordinate The parsed coordinate
+   * @return true in case of success otherwise false
+   */
+  bool toCoordinate( const int value, const int hemisphere, int& coordinate ) const;
+
+  /**
+   * Parses an integer number. Leading and trailing spaces are allowed.
+   */
+  static bool parseInt( const QStringRef& ref, int& value );
+
+  /**
+   * Parses a decimal number without exponent. Leading and trailing spaces
+   * are allowed.
+   */
+  static bool parseDouble( const QStringRef& ref, double& value );
+
+  /**
+   * Parses a time in the format hhmmss or hhmmss.sss. Fractions of a
+   * second are ignored.
+   */
+  static bool parseTime( const QStringRef& ref, QTime& time );
+
+  /**
+   * Parses a date in the format ddmmyy. The year is assumed to be after
+   * the year 2000.
+   */
+  static bool parseDate( const QStringRef& ref, QDate& date );
+
+  /**
+   * Maps a sentence identifier to a \ref Sentence number.
+   */
+  static int identify( const QStringRef& ref );
+
+  /**
+   * Fills the passed hash with all known sentence identifiers and their
+   * \ref Sentence numbers.
+   */
+  static void sentenceKeys( QHash<QString, short>& keys );
+
+ private:
+
+  const QString* m_sentence;
+
+  int m_count;
+
+  int m_id;
+
+  /** Position of the first checksum separator or -1. */
+  int m_checksumPos;
+
+  /** Computed checksum of the characters before the separator. */
+  uchar m_checksum;
+
+  /** Position of the last checksum separator or -1. */
+  int m_lastChecksumPos;
+
+  /** Length of the sentence without line end characters. */
+  int m_size;
+
+  int m_start[MaxFields];
+  int m_length[MaxFields];
+};
+
+#endif
@@ -405,6 +405,9 @@ void OpenAirParser::finishAirspace()
                                astPA,
                                asUpper, asUpperType,
                                asLower, asLowerType );
+
+  // Keep the unprojected border for the compiled file.
+  as->setWgsPolygon( asPA );
   _airlist.append(as);
   _objCounter++;
 
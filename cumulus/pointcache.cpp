@@ -0,0 +1,255 @@
+/***********************************************************************
+ **
+ **   pointcache.cpp
+ **
+ **   This file is part of Cumulus.
+ **
+ ************************************************************************
+ **
+ **   Copyright (c):  2026 by the Cumulus contributors
+ **
+ **   This file is distributed under the terms of the General Public
+ **   License. See the file COPYING for more information.
+ **
+ ***********************************************************************/
+
+#include <QtCore>
+
+#include "mapcalc.h"
+#include "pointcache.h"
+
+// Data stream version to be used for compiled files.
+#define Q_DATA_STREAM QDataStream::Qt_4_7
+
+PointCache::PointCache() :
+  m_mapped(0),
+  m_next(0)
+{
+  m_stream.setVersion( Q_DATA_STREAM );
+}
+
+PointCache::~PointCache()
+{
+  close();
+}
+
+bool PointCache::open( const QString& fileName )
+{
+  close();
+
+  m_file.setFileName( fileName );
+
+  if( m_file.open( QIODevice::ReadOnly ) == false )
+    {
+      return false;
+    }
+
+  m_mapped = m_file.map( 0, m_file.size() );
+
+  if( m_mapped != 0 )
+    {
+      m_data = QByteArray::fromRawData( reinterpret_cast<const char *>(m_mapped),
+                                        m_file.size() );
+    }
+  else
+    {
+      // Mapping is not supported, read the whole file.
+      m_data = m_file.readAll();
+    }
+
+  m_buffer.setBuffer( &m_data );
+  m_buffer.open( QIODevice::ReadOnly );
+  m_stream.setDevice( &m_buffer );
+  return true;
+}
+
+void PointCache::close()
+{
+  m_stream.setDevice( 0 );
+  m_buffer.close();
+  m_data.clear();
+  m_directory.clear();
+  m_next = 0;
+
+  if( m_mapped != 0 )
+    {
+      m_file.unmap( m_mapped );
+      m_mapped = 0;
+    }
+
+  if( m_file.isOpen() )
+    {
+      m_file.close();
+    }
+}
+
+bool PointCache::readDirectory()
+{
+  m_directory.clear();
+  m_next = 0;
+
+  quint32 buckets;
+  m_stream >> buckets;
+
+  if( m_stream.status() != QDataStream::Ok || buckets > 180 * 90 )
+    {
+      qWarning( "PointCache: wrong bucket number %u read!", buckets );
+      return false;
+    }
+
+  m_directory.resize( buckets );
+
+  QVector<quint32> sizes( buckets );
+
+  for( quint32 i = 0; i < buckets; i++ )
+    {
+      m_stream >> m_directory[i].key;
+      m_stream >> m_directory[i].count;
+      m_stream >> sizes[i];
+    }
+
+  if( m_stream.status() != QDataStream::Ok )
+    {
+      m_directory.clear();
+      return false;
+    }
+
+  // The bucket data follow the directory in the same order.
+  qint64 offset = m_buffer.pos();
+
+  for( quint32 i = 0; i < buckets; i++ )
+    {
+      m_directory[i].offset = offset;
+      offset += sizes[i];
+    }
+
+  if( offset > m_buffer.size() )
+    {
+      qWarning( "PointCache: file %s is truncated!",
+                m_file.fileName().toLatin1().data() );
+
+      m_directory.clear();
+      return false;
+    }
+
+  return true;
+}
+
+int PointCache::nextBucket( const QPoint& home, const double radius )
+{
+  while( m_next < m_directory.size() )
+    {
+      const Bucket& bucket = m_directory.at( m_next++ );
+
+      if( radius > 0.0 && isBucketInRange( bucket.key, home, radius ) == false )
+        {
+          continue;
+        }
+
+      m_buffer.seek( bucket.offset );
+      return bucket.count;
+    }
+
+  return -1;
+}
+
+int PointCache::bucketKey( const QPoint& wgsPos )
+{
+  // Same numbering as used by MapCalc::getTileBox. The tile row counts
+  // from north to south, the column from west to east.
+  int row = ( 90 * 600000 - wgsPos.x() ) / ( 2 * 600000 );
+  int col = ( wgsPos.y() + 180 * 600000 ) / ( 2 * 600000 );
+
+  row = qBound( 0, row, 89 );
+  col = qBound( 0, col, 179 );
+
+  return row * 180 + col;
+}
+
+bool PointCache::isBucketInRange( const int key, const QPoint& home, const double radius )
+{
+  // The tile box uses the x-axis as longitude and the y-axis as latitude.
+  QRect box = MapCalc::getTileBox( key );
+
+  if( box.isNull() )
+    {
+      return true;
+    }
+
+  int lonMin = box.x();
+  int lonMax = box.x() + 2 * 600000;
+  int latMax = box.y();
+  int latMin = box.y() - 2 * 600000;
+
+  QPoint center( (latMin + latMax) / 2, (lonMin + lonMax) / 2 );
+
+  // The distance to the farthest corner is the radius of a circle around
+  // the tile center, which covers the whole tile.
+  QPoint corners[4] = { QPoint( latMin, lonMin ), QPoint( latMin, lonMax ),
+                        QPoint( latMax, lonMin ), QPoint( latMax, lonMax ) };
+
+  double cover = 0.0;
+
+  for( int i = 0; i < 4; i++ )
+    {
+      cover = qMax( cover, MapCalc::dist( &center, &corners[i] ) );
+    }
+
+  QPoint pos( home );
+
+  return MapCalc::dist( &pos, &center ) <= radius + cover;
+}
+
+PointCache::Writer::Bucket::Bucket() :
+  stream( &data, QIODevice::WriteOnly ),
+  count(0)
+{
+  stream.setVersion( Q_DATA_STREAM );
+}
+
+PointCache::Writer::Writer() :
+  m_count(0)
+{
+}
+
+PointCache::Writer::~Writer()
+{
+  qDeleteAll( m_buckets );
+}
+
+QDataStream& PointCache::Writer::record( const QPoint& wgsPos )
+{
+  int key = PointCache::bucketKey( wgsPos );
+
+  Bucket* bucket = m_buckets.value( key, 0 );
+
+  if( bucket == 0 )
+    {
+      bucket = new Bucket;
+      m_buckets.insert( key, bucket );
+    }
+
+  bucket->count++;
+  m_count++;
+
+  return bucket->stream;
+}
+
+void PointCache::Writer::save( QDataStream& out )
+{
+  out << quint32( m_buckets.size() );
+
+  QMap<int, Bucket*>::const_iterator it;
+
+  for( it = m_buckets.constBegin(); it != m_buckets.constEnd(); ++it )
+    {
+      out << quint16( it.key() );
+      out << quint32( it.value()->count );
+      out << quint32( it.value()->data.size() );
+    }
+
+  for( it = m_buckets.constBegin(); it != m_buckets.constEnd(); ++it )
+    {
+      out.writeRawData( it.value()->data.constData(), it.value()->data.size() );
+    }
+}
@@ -0,0 +1,204 @@
+/***********************************************************************
+ **
+ **   pointcache.h
+ **
+ **   This file is part of Cumulus.
+ **
+ ************************************************************************
+ **
+ **   Copyright (c):  2026 by the Cumulus contributors
+ **
+ **   This file is distributed under the terms of the General Public
+ **   License. See the file COPYING for more information.
+ **
+ ***********************************************************************/
+
+#ifndef POINT_CACHE_H
+#define POINT_CACHE_H
+
+#include <QBuffer>
+#include <QByteArray>
+#include <QDataStream>
+#include <QFile>
+#include <QMap>
+#include <QPoint>
+#include <QString>
+#include <QVector>
+
+/**
+ * \class PointCache
+ *
+ * \author Cumulus contributors
+ *
+ * \brief Spatial bucket storage for compiled point files.
+ *
+ * The records of a compiled point file are stored with their WGS84
+ * coordinates only and are grouped into buckets. A bucket covers a map
+ * tile of 2x2 degrees. A directory in front of the records contains the
+ * tile number, the record count and the byte size of every bucket.
+ *
+ * During reading the file is memory mapped. Buckets, which are completely
+ * outside of the home radius, are skipped without decoding their records.
+ * Projection and home radius filtering are done by the loaders at load
+ * time, so a compiled file remains valid after a change of the home
+ * position, the filter settings or the map projection.
+ *
+ * \date 2026
+ */
+class PointCache
+{
+ public:
+
+  PointCache();
+
+  virtual ~PointCache();
+
+  /**
+   * Opens and memory maps the passed file for reading. If mapping is not
+   * supported, the file content is read into memory.
+   *
+   * @param fileName Full path of the compiled file
+   * @return true in case of success otherwise false
+   */
+  bool open( const QString& fileName );
+
+  /**
+   * Unmaps and closes the file.
+   */
+  void close();
+
+  /**
+   * @return The data stream to the opened file.
+   */
+  QDataStream& stream()
+  {
+    return m_stream;
+  };
+
+  /**
+   * Reads the bucket directory at the current stream position. Afterwards
+   * the records can be accessed bucket by bucket with \ref nextBucket.
+   *
+   * @return true in case of success otherwise false
+   */
+  bool readDirectory();
+
+  /**
+   * Positions the stream at the first record of the next bucket, which is
+   * inside of the passed radius around the home position. Buckets outside
+   * of the radius are skipped.
+   *
+   * @param home Home position as WGS84 coordinate
+   * @param radius Filter radius in km. Zero or less means no filter.
+   * @return Number of records in the bucket or -1, if no bucket is left.
+   */
+  int nextBucket( const QPoint& home, const double radius );
+
+  /**
+   * @return The bucket key of the passed WGS84 position. It is the number
+   * of the map tile containing the position.
+   */
+  static int bucketKey( const QPoint& wgsPos );
+
+  /**
+   * Checks, if a part of the bucket can be inside of the passed radius
+   * around the home position.
+   *
+   * @param key Bucket key
+   * @param home Home position as WGS84 coordinate
+   * @param radius Filter radius in km
+   * @return true, if the bucket can contain points within the radius
+   */
+  static bool isBucketInRange( const int key, const QPoint& home, const double radius );
+
+  /**
+   * \class Writer
+   *
+   * \brief Collects the records of a compiled point file in buckets.
+   */
+  class Writer
+  {
+   public:
+
+    Writer();
+
+    virtual ~Writer();
+
+    /**
+     * Returns the data stream of the bucket, to which the passed position
+     * belongs. The caller must write exactly one record to it.
+     *
+     * @param wgsPos WGS84 position of the record
+     * @return data stream of the bucket
+     */
+    QDataStream& record( const QPoint& wgsPos );
+
+    /**
+     * @return The number of collected records.
+     */
+    int count() const
+    {
+      return m_count;
+    };
+
+    /**
+     * Writes the bucket directory followed by the bucket data to the
+     * passed stream.
+     *
+     * @param out Stream of the compiled file
+     */
+    void save( QDataStream& out );
+
+   private:
+
+    class Bucket
+    {
+     public:
+
+      Bucket();
+
+      QByteArray data;
+      QDataStream stream;
+      quint32 count;
+    };
+
+    /** Buckets sorted by their tile number. */
+    QMap<int, Bucket*> m_buckets;
+
+    /** Number of all collected records. */
+    int m_count;
+  };
+
+ private:
+
+  /** Directory entry of a bucket. */
+  class Bucket
+  {
+   public:
+
+    Bucket() : key(0), count(0), offset(0) {};
+
+    quint16 key;
+    quint32 count;
+    qint64  offset;
+  };
+
+  QFile m_file;
+
+  /** Start of the memory mapped file or 0. */
+  uchar* m_mapped;
+
+  /** File content, wraps the mapped memory if possible. */
+  QByteArray m_data;
+
+  QBuffer m_buffer;
+
+  QDataStream m_stream;
+
+  QVector<Bucket> m_directory;
+
+  /** Index of the next bucket to be returned by nextBucket. */
+  int m_next;
+};
+
+#endif
@@ -0,0 +1,112 @@
+/***********************************************************************
+**
+**   pointlistmodel.cpp
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c):  2026 by the Cumulus contributors
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+#ifndef QT_5
+#include <QtGui>
+#else
+#include <QtWidgets>
+#endif
+
+#include "mapconfig.h"
+#include "pointlistmodel.h"
+
+extern MapConfig* _globalMapConfig;
+
+PointListModel::PointListModel( QObject *parent ) :
+  QAbstractTableModel( parent )
+{
+  m_header << tr("Name") << tr("Description") << tr("Country") << tr("ICAO");
+}
+
+PointListModel::~PointListModel()
+{
+}
+
+int PointListModel::columnCount( const QModelIndex& parent ) const
+{
+  if( parent.isValid() )
+    {
+      return 0;
+    }
+
+  return ColumnCount;
+}
+
+QVariant PointListModel::data( const QModelIndex& index, int role ) const
+{
+  if( ! index.isValid() || index.row() >= rowCount() )
+    {
+      return QVariant();
+    }
+
+  switch( role )
+    {
+      case Qt::DisplayRole:
+
+        return text( index.row(), index.column() );
+
+      case Qt::DecorationRole:
+
+        if( index.column() == Name )
+          {
+            int type = typeId( index.row() );
+
+            if( ! m_icons.contains( type ) )
+              {
+                m_icons.insert( type, QIcon( _globalMapConfig->getPixmap( type, false ) ) );
+              }
+
+            return m_icons.value( type );
+          }
+
+        break;
+
+      case Qt::TextAlignmentRole:
+
+        if( index.column() == Country )
+          {
+            return int(Qt::AlignCenter);
+          }
+
+        break;
+
+      default:
+        break;
+    }
+
+  return QVariant();
+}
+
+QVariant PointListModel::headerData( int section,
+                                     Qt::Orientation orientation,
+                                     int role ) const
+{
+  if( orientation == Qt::Horizontal && role == Qt::DisplayRole &&
+      section >= 0 && section < m_header.size() )
+    {
+      return m_header.at( section );
+    }
+
+  return QAbstractTableModel::headerData( section, orientation, role );
+}
+
+void PointListModel::setHeaderText( const int column, const QString& text )
+{
+  if( column >= 0 && column < m_header.size() )
+    {
+      m_header[column] = text;
+      emit headerDataChanged( Qt::Horizontal, column, column );
+    }
+}
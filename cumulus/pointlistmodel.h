@@ -0,0 +1,104 @@
+/***********************************************************************
+**
+**   pointlistmodel.h
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c):  2026 by the Cumulus contributors
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+#ifndef POINT_LIST_MODEL_H
+#define POINT_LIST_MODEL_H
+
+#include <QAbstractTableModel>
+#include <QHash>
+#include <QIcon>
+#include <QStringList>
+
+class Waypoint;
+
+/**
+ * \class PointListModel
+ *
+ * \author Cumulus contributors
+ *
+ * \brief Base class of the table models of the point lists.
+ *
+ * The model presents a point list with the columns name, description,
+ * country and a fourth column, which is ICAO or a comment. The texts are
+ * not copied, a subclass delivers them from the underlying list, when the
+ * view requests a row. Therefore only the visible rows are materialized.
+ *
+ * Used by \ref ListWidgetParent and its subclasses.
+ *
+ * \date 2026
+ */
+class PointListModel : public QAbstractTableModel
+{
+  Q_OBJECT
+
+ private:
+
+  Q_DISABLE_COPY( PointListModel )
+
+ public:
+
+  /** Columns of the point list. */
+  enum Column { Name = 0, Description, Country, Extra, ColumnCount };
+
+  PointListModel( QObject *parent = 0 );
+
+  virtual ~PointListModel();
+
+  virtual int columnCount( const QModelIndex& parent = QModelIndex() ) const;
+
+  virtual QVariant data( const QModelIndex& index, int role = Qt::DisplayRole ) const;
+
+  virtual QVariant headerData( int section,
+                               Qt::Orientation orientation,
+                               int role = Qt::DisplayRole ) const;
+
+  /**
+   * Sets the header text of a column.
+   */
+  void setHeaderText( const int column, const QString& text );
+
+  /**
+   * Removes all rows.
+   */
+  virtual void clear() = 0;
+
+  /**
+   * \return A waypoint with the data of the point in the passed row. The
+   *         waypoint can be a temporary object of the model, which is
+   *         overwritten by the next call.
+   */
+  virtual Waypoint* waypoint( const int row ) = 0;
+
+ protected:
+
+  /**
+   * \return The text of a row in the passed column.
+   */
+  virtual QString text( const int row, const int column ) const = 0;
+
+  /**
+   * \return The map element type of a row, used to select the icon.
+   */
+  virtual int typeId( const int row ) const = 0;
+
+ private:
+
+  QStringList m_header;
+
+  /** Icons of the map element types, created on demand. */
+  mutable QHash<int, QIcon> m_icons;
+};
+
+#endif
@@ -132,7 +132,8 @@ Polar::Polar (const Polar& polar) :
   _addLoad (polar._addLoad),
   _wingArea(polar._wingArea),
   _seats (polar._seats),
-  _maxWater (polar._maxWater)
+  _maxWater (polar._maxWater),
+  _glideTable (polar._glideTable)
 {}
 
 Polar::~Polar()
@@ -171,6 +172,8 @@ void Polar::recalculatePolarData()
 
   _c = _cc = W3 - _aa*V3*V3 - _bb*V3;
 
+  _glideTable.invalidate();
+
   if( _addLoad > 0 || _water > 0 || _bugs > 0 )
     {
       setLoad( _addLoad, _water, _bugs );
@@ -204,6 +207,8 @@ void Polar::setLoad( int addLoad, int water, int bugs )
   _b = _bb / B;      // positive
   _c = _cc * A * B;  // negative
   // we just increase the #sinking rate; this is not quite correct but gives reasonable results
+
+  _glideTable.invalidate();
 }
 
 /**
@@ -216,6 +221,22 @@ Speed Polar::getSink (const Speed& speed) const
   return -(speed*speed*_a + speed*_b + _c);
 }
 
+/**
+ * calculate the airspeed of minimum sink, that is the vertex of the polar
+ */
+Speed Polar::minSinkSpeed () const
+{
+  if( _a == 0.0 )
+    {
+      return v1();
+    }
+
+  double v = -_b / (2.0 * _a);
+
+  // The vertex must lie in a sensible range of the polar.
+  return Speed( qBound( v1().getMps() * 0.5, v, v3().getMps() ) );
+}
+
 /**
  * calculate best airspeed for given wind, lift and Mc
  */
@@ -245,6 +266,16 @@ Speed Polar::bestSpeed (const Speed& wind, const Speed& lift, const Speed& mc) c
   return speed;
 }
 
+const GlideTable& Polar::glideTable (const Speed& mc) const
+{
+  if( ! _glideTable.isValidFor( mc ) )
+    {
+      _glideTable.build( *this, mc );
+    }
+
+  return _glideTable;
+}
+
 /**
   * calculate best glide ratio for given wind and lift;
   */
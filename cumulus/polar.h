@@ -37,6 +37,7 @@
 #include <QWidget>
 #include <QString>
 
+#include "glidetable.h"
 #include "speed.h"
 
 class Polar
@@ -72,6 +73,11 @@ class Polar
 
   Speed getSink (const Speed& speed) const;
 
+  /**
+   * calculate the airspeed of minimum sink
+   */
+  Speed minSinkSpeed () const;
+
   /**
    * calculate best airspeed for given wind, lift and McCready value;
    */
@@ -82,6 +88,13 @@ class Polar
    */
   double bestLD (const Speed& speed, const Speed& wind, const Speed& lift) const;
 
+  /**
+   * Returns the speed to fly table for the given McCready value. The table
+   * is built on demand and is rebuilt only, if the load or the McCready
+   * value have been changed.
+   */
+  const GlideTable& glideTable (const Speed& mc) const;
+
   /** draw a graphical polar on the given widget;
    * draw glide path according to lift, wind and McCready value
    */
@@ -266,6 +279,9 @@ class Polar
   double _wingArea;
   int    _seats;
   int    _maxWater;
+
+  /** Speed to fly table of the current load state */
+  mutable GlideTable _glideTable;
 };
 
 #endif
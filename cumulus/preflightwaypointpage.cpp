@@ -626,37 +626,37 @@ void PreFlightWaypointPage::slotImportFile()
     }
 
   // We have to check, if a waypoint with the same name do exist. In this case
-  // we check the coordinates. If they are the same, we ignore it.
-  QHash<QString, QString> nameCoordDict;
-
-  QList<Waypoint>& wpGlobalList = _globalMapContents->getWaypointList();
-
-  for( int i = 0; i < wpGlobalList.size(); i++ )
-    {
-      nameCoordDict.insert( wpGlobalList.at(i).name,
-                     WGSPoint::coordinateString( wpGlobalList.at(i).wgsPoint ) );
-    }
-
+  // we check the coordinates. If they are the same, we ignore it. The name
+  // index of the global list delivers the candidates, also for the waypoints
+  // added by this import.
   int added = 0;
   int ignored = 0;
 
   for( int i = 0; i < wpList.size(); i++ )
     {
-      // Look, if name is known and fetch coordinate string
-      QString dcString = nameCoordDict.value( wpList.at(i).name, "" );
+      QList<Waypoint *> sameName =
+          _globalMapContents->findWaypointsByName( wpList.at(i).name );
 
       QString wpcString = WGSPoint::coordinateString( wpList.at(i).wgsPoint );
 
-      if( dcString != "" && dcString == wpcString )
+      bool known = false;
+
+      for( int j = 0; j < sameName.size(); j++ )
+        {
+          if( WGSPoint::coordinateString( sameName.at(j)->wgsPoint ) == wpcString )
+            {
+              known = true;
+              break;
+            }
+        }
+
+      if( known )
         {
           // Name and coordinates are identical, waypoint is ignored.
           ignored++;
           continue;
         }
 
-      // Add new waypoint to the dictionary
-      nameCoordDict.insert( wpList.at(i).name, wpcString );
-
       // Look, which waypoint priority has to be used for the import.
       int priority = m_wpPriorityBox->itemData(m_wpPriorityBox->currentIndex()).toInt();
 
@@ -666,7 +666,7 @@ void PreFlightWaypointPage::slotImportFile()
         }
 
       // Add new waypoint to the global list.
-      wpGlobalList.append( wpList.at(i) );
+      _globalMapContents->addWaypointToList( wpList.at(i) );
       added++;
     }
 
@@ -29,7 +29,7 @@
 
 //------- Used by Command/Response channel -------//
 
-#define MSG_PROTOCOL   "Cumulus-GPS_Client_IPC_V1.5_Axel@kflog.org"
+#define MSG_PROTOCOL   "Cumulus-GPS_Client_IPC_V1.7_Axel@kflog.org"
 
 #define MSG_MAGIC      "\\Magic\\"
 
@@ -40,7 +40,11 @@
 // open connection to the GPS device "Open" <device> <speed>
 #define MSG_OPEN       "\\Open\\"
 
-// close connection to the GPS device
+// open an additional input source "Open_Source" <device> <speed>. The
+// sentences of all sources are merged in the order of their arrival.
+#define MSG_OPEN_SOURCE "\\Open_Source\\"
+
+// close connection to the GPS device and to all additional sources
 #define MSG_CLOSE      "\\Close\\"
 
 // send message to GPS device
@@ -72,6 +76,10 @@
 // GPS data message
 #define MSG_GPS_DATA  "#Gps_Data#"
 
+// GPS data batch message, contains all sentences read from the GPS device
+// in one go. Every sentence is terminated by a newline.
+#define MSG_GPS_BATCH  "#Gps_Batch#"
+
 // Flarm flight list response
 #define MSG_FLARM_FLIGHT_LIST_RES  "#FFLR#"
 
@@ -85,4 +93,9 @@
 
 #define MSG_CON_ON      "#GPS_Connection_on#"
 
+// Statistics of the input sources, one line per source with device name,
+// sentences per second, bytes per second, bad sentences, mean and maximum
+// latency in microseconds between receive and forward.
+#define MSG_SOURCE_STATS  "#Source_Stats#"
+
 #endif  // #ifndef _Protocol_h_
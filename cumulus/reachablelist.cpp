@@ -37,6 +37,7 @@
 #include "mapcontents.h"
 #include "mapcalc.h"
 #include "polar.h"
+#include "replaybenchmark.h"
 #include "waypoint.h"
 #include "airfield.h"
 
@@ -44,8 +45,8 @@ extern MapContents *_globalMapContents;
 
 // Initialize static members
 int  ReachableList::safetyAlt = 0;
-QMap<QString, int> ReachableList::arrivalAltMap;
-QMap<QString, Distance> ReachableList::distanceMap;
+QHash<qint64, int> ReachableList::arrivalAltMap;
+QHash<qint64, Distance> ReachableList::distanceMap;
 bool ReachableList::modeAltitude = false;
 
 // Radius of reachables to be taken into account in kilometers
@@ -75,6 +76,16 @@ ReachableList::ReachableList(QObject *parent) : QObject(parent)
   modeAltitude = false;
   initValuesOK = false;
   calcMode = ReachableList::distance;
+
+  lastGlideAltitude = 0.0;
+  lastPolar = 0;
+  lastWater = 0;
+  lastBugs = 0;
+  lastLoad = 0;
+  lastSafetyAlt = safetyAlt;
+
+  siteIndexDirty = true;
+  siteListSizes[0] = siteListSizes[1] = siteListSizes[2] = 0;
 }
 
 ReachableList::~ReachableList()
@@ -90,6 +101,8 @@ ReachableList::~ReachableList()
 
 void ReachableList::calculate(bool always)
 {
+  ReplayBenchmark::Probe probe( ReplayBenchmark::StageReach );
+
   if ( !isOn() )
     {
       //qDebug("ReachableList::calculate is off");
@@ -106,8 +119,9 @@ void ReachableList::calculate(bool always)
 
   // qDebug("tick %d %d",tick, always );
   // The whole list is new computed, if the distance has become
-  // greater than 5km to the last computing point.
-  if ( dist2Last > 5.0 || always )
+  // greater than 5km to the last computing point or if the sites
+  // have been changed.
+  if ( dist2Last > 5.0 || always || siteIndexDirty )
     {
       // save position where new calculation has been done
       lastCalculationPosition = currentPosition;
@@ -115,12 +129,116 @@ void ReachableList::calculate(bool always)
       return;
     }
 
-  if ( (tick %10) == 0 )
+  // The arrival altitudes of the listed sites are updated, if one of
+  // the glide path parameters has been changed.
+  if ( updateGlideParameters() )
+    {
+      calculateDataInList( false );
+    }
+}
+
+void ReachableList::slot_sitesChanged()
+{
+  siteIndexDirty = true;
+}
+
+bool ReachableList::updateGlideParameters()
+{
+  bool changed = false;
+
+  QPoint position = calculator->getlastPosition();
+  double altitude = calculator->getlastAltitude().getMeters();
+  Vector wind     = calculator->getLastWind();
+  Speed mc        = calculator->getlastMc();
+  Polar* polar    = calculator->getPolar();
+  int safety      = (int) GeneralConfig::instance()->getSafetyAltitude().getMeters();
+
+  if( position != lastGlidePosition ||
+      fabs( altitude - lastGlideAltitude ) >= 1.0 ||
+      ! (lastWind == wind) ||
+      ! (mc == lastMc) ||
+      polar != lastPolar ||
+      safety != lastSafetyAlt )
+    {
+      changed = true;
+    }
+
+  if( polar &&
+      ( polar->water() != lastWater ||
+        polar->bugs() != lastBugs ||
+        polar->addLoad() != lastLoad ) )
+    {
+      changed = true;
+    }
+
+  lastGlidePosition = position;
+  lastGlideAltitude = altitude;
+  lastWind          = wind;
+  lastMc            = mc;
+  lastPolar         = polar;
+  lastSafetyAlt     = safety;
+
+  if( polar )
+    {
+      lastWater = polar->water();
+      lastBugs  = polar->bugs();
+      lastLoad  = polar->addLoad();
+    }
+
+  return changed;
+}
+
+Airfield* ReachableList::getAirfieldSite( const enum MapContents::ListID item,
+                                          const int index )
+{
+  if( index < 0 || index >= (int) _globalMapContents->getListLength( item ) )
+    {
+      return static_cast<Airfield *> (0);
+    }
+
+  switch( item )
     {
-      // Only update last computed list after 10 ticks,
-      // normally after 10s in GPS mode.
-      calculateDataInList();
+      case MapContents::AirfieldList:
+        return _globalMapContents->getAirfield( index );
+
+      case MapContents::GliderfieldList:
+        return _globalMapContents->getGliderfield( index );
+
+      case MapContents::OutLandingList:
+        return _globalMapContents->getOutlanding( index );
+
+      default:
+        break;
     }
+
+  return static_cast<Airfield *> (0);
+}
+
+void ReachableList::buildSiteIndex()
+{
+  const enum MapContents::ListID lists[3] = { MapContents::AirfieldList,
+                                              MapContents::GliderfieldList,
+                                              MapContents::OutLandingList };
+  siteIndex.clear();
+
+  for( int l = 0; l < 3; l++ )
+    {
+      int nr = _globalMapContents->getListLength( lists[l] );
+
+      siteListSizes[l] = nr;
+
+      for( int i = 0; i < nr; i++ )
+        {
+          Airfield* site = getAirfieldSite( lists[l], i );
+
+          if( site )
+            {
+              siteIndex.add( site->getWGSPosition(), lists[l], i );
+            }
+        }
+    }
+
+  siteIndexDirty = false;
 }
 
 void ReachableList::addItemsToList(enum MapContents::ListID item)
@@ -186,61 +304,32 @@ void ReachableList::addItemsToList(enum MapContents::ListID item)
     }
   else
     {
-      // get number of elements in the list
-      int nr = _globalMapContents->getListLength(item);
+      // Fetch only the sites in the bounding box from the site index.
+      QVector<SiteIndex::Site> sites;
+      siteIndex.query( bbox, sites );
 
-      // qDebug("No of sites: %d type %d", nr, item );
-      for (int i=0; i<nr; i++ )
+      // qDebug("No of sites: %d type %d", sites.size(), item );
+      for (int i=0; i<sites.size(); i++ )
         {
+          if( sites.at(i).list != item )
+            {
+              continue;
+            }
+
           // Get specific site data from current list. We have to distinguish
           // between AirfieldList, GilderSiteList and OutlandingList.
-          Airfield* site;
+          Airfield* site = getAirfieldSite( item, sites.at(i).index );
 
-          if( item == MapContents::AirfieldList )
-            {
-              // Fetch data from airport list
-              site = _globalMapContents->getAirfield(i);
-            }
-          else if( item == MapContents::GliderfieldList )
+          if( site == 0 || site->getWGSPosition() != sites.at(i).position )
             {
-              // fetch data from glider site list
-              site = _globalMapContents->getGliderfield(i);
-            }
-          else if( item == MapContents::OutLandingList )
-            {
-              // fetch data from glider site list
-              site = _globalMapContents->getOutlanding(i);
-            }
-          else
-            {
-              qWarning( "ReachableList::addItemsToList: ListType %d is unknown",
-                        item );
-              break;
+              // The list has been changed, the index must be rebuilt.
+              siteIndexDirty = true;
+              continue;
             }
 
-          QString siteName = site->getWPName();
-          QString siteIcao = site->getICAO();
-          QString siteDescription = site->getName();
-          QString siteCountry = site->getCountry();
-          short siteType = site->getTypeID();
-          float siteFrequency = site->getFrequency();
           WGSPoint siteWgsPosition = site->getWGSPosition();
-          QPoint sitePosition = site->getPosition();
-          float siteElevation = site->getElevation();
-          QString siteComment = site->getComment();
-          QList<Runway> siteRwyList = site->getRunwayList();
+          a++;
 
-          if (! bbox.contains(siteWgsPosition) )
-            {
-              //qDebug("Not in bounding box, so ignore! (distance: %d, (%d, %d), %s)", (int)distance.getKilometers(), pt.x(),pt.y(), site->getName().latin1());
-              r++;
-              continue;
-            }
-          else
-            {
-              a++;
-              //qDebug("In bounding box, so accept! (distance: %d, %s)", (int)distance.getKilometers(), site->getName().latin1());
-            }
           distance.setKilometers(MapCalc::dist(&lastPosition,&siteWgsPosition));
           // qDebug("%d  %f %f", i, (float)distance.getKilometers(),_maxReach );
           // check if point is a potential reachable candidate at best LD
@@ -255,21 +344,21 @@ void ReachableList::addItemsToList(enum MapContents::ListID item)
           Altitude altitude(0);
 
           // add all potential reachable points to the list, altitude is calculated later
-          ReachablePoint rp( siteName,
-                             siteIcao,
-                             siteDescription,
-                             siteCountry,
+          ReachablePoint rp( site->getWPName(),
+                             site->getICAO(),
+                             site->getName(),
+                             site->getCountry(),
                              true,
-                             siteType,
-                             siteFrequency,
+                             site->getTypeID(),
+                             site->getFrequency(),
                              siteWgsPosition,
-                             sitePosition,
-                             siteElevation,
-                             siteComment,
+                             site->getPosition(),
+                             site->getElevation(),
+                             site->getComment(),
                              distance,
                              bearing,
                              altitude,
-                             siteRwyList );
+                             site->getRunwayList() );
           append(rp);
 
           // qDebug("%s(%d) %f %d° %d", rp.getName().toLatin1().data(), rp.getElevation(),  rp.getDistance().getKilometers(), rp.getBearing(), (int)rp->getArrivalAlt().getMeters() );
@@ -281,15 +370,15 @@ void ReachableList::addItemsToList(enum MapContents::ListID item)
 
 QColor ReachableList::getReachColor( const QPoint& position )
 {
-  // qDebug("name: %s: %d", (const char *)name, arrivalAltMap[name] );
+  QHash<qint64, int>::const_iterator it = arrivalAltMap.constFind( coordinateKey( position ) );
 
-  if ( arrivalAltMap.contains( ReachableList::coordinateString( position ) ) )
+  if ( it != arrivalAltMap.constEnd() )
     {
-      if ( arrivalAltMap[ ReachableList::coordinateString ( position ) ] > safetyAlt )
+      if ( it.value() > safetyAlt )
         {
           return( Qt::green );
         }
-      else if ( arrivalAltMap[ ReachableList::coordinateString ( position ) ] > 0 )
+      else if ( it.value() > 0 )
         {
           return( Qt::magenta );
         }
@@ -298,17 +387,18 @@ QColor ReachableList::getReachColor( const QPoint& position )
           return( Qt::red );
         }
     }
+
   return( Qt::red );
 }
 
 
 int ReachableList::getArrivalAlt( const QPoint& position )
 {
-  // qDebug("name: %s: %d", (const char *)name, arrivalAltMap[name] );
+  QHash<qint64, int>::const_iterator it = arrivalAltMap.constFind( coordinateKey( position ) );
 
-  if ( arrivalAltMap.contains( coordinateString ( position ) ) )
+  if ( it != arrivalAltMap.constEnd() )
     {
-      return( arrivalAltMap[ coordinateString ( position ) ] - safetyAlt );
+      return( it.value() - safetyAlt );
     }
 
   return( -9999 );
@@ -316,11 +406,11 @@ int ReachableList::getArrivalAlt( const QPoint& position )
 
 Altitude ReachableList::getArrivalAltitude( const QPoint& position )
 {
-  // qDebug("name: %s: %d", (const char *)name, arrivalAltMap[name] );
+  QHash<qint64, int>::const_iterator it = arrivalAltMap.constFind( coordinateKey( position ) );
 
-  if ( arrivalAltMap.contains( coordinateString ( position ) ) )
+  if ( it != arrivalAltMap.constEnd() )
     {
-      return (Altitude( arrivalAltMap[ coordinateString ( position ) ]) - safetyAlt) ;
+      return (Altitude( it.value() ) - safetyAlt) ;
     }
 
   return Altitude(); //return an invalid altitude
@@ -328,25 +418,48 @@ Altitude ReachableList::getArrivalAltitude( const QPoint& position )
 
 Distance ReachableList::getDistance( const QPoint& position )
 {
-  // qDebug("name: %s: %d", (const char *)name, arrivalAltMap[name] );
+  QHash<qint64, Distance>::const_iterator it = distanceMap.constFind( coordinateKey( position ) );
 
-  if ( distanceMap.contains( coordinateString ( position ) ) )
+  if ( it != distanceMap.constEnd() )
     {
-      return( distanceMap[ coordinateString ( position ) ] );
+      return( it.value() );
     }
 
   return Distance();    //return an invalid distance
 }
 
+void ReachableList::getArrivalInfo( const QPoint& position,
+                                    Altitude& arrival,
+                                    ReachablePoint::reachable& reach )
+{
+  QHash<qint64, int>::const_iterator it = arrivalAltMap.constFind( coordinateKey( position ) );
+
+  if ( it == arrivalAltMap.constEnd() )
+    {
+      arrival = Altitude();
+      reach = ReachablePoint::no;
+      return;
+    }
+
+  arrival = Altitude( it.value() ) - safetyAlt;
+
+  if ( it.value() > safetyAlt )
+    reach = ReachablePoint::yes;
+  else if ( it.value() > 0 )
+    reach = ReachablePoint::belowSafety;
+  else
+    reach = ReachablePoint::no;
+}
+
 ReachablePoint::reachable ReachableList::getReachable( const QPoint& position )
 {
-  // qDebug("name: %s: %d", (const char *)name, arrivalAltMap[name] );
+  QHash<qint64, int>::const_iterator it = arrivalAltMap.constFind( coordinateKey( position ) );
 
-  if ( arrivalAltMap.contains( coordinateString ( position ) ) )
+  if ( it != arrivalAltMap.constEnd() )
     {
-      if ( arrivalAltMap[ coordinateString ( position ) ] > safetyAlt )
+      if ( it.value() > safetyAlt )
         return ReachablePoint::yes;
-      else if ( arrivalAltMap[ coordinateString ( position ) ] > 0 )
+      else if ( it.value() > 0 )
         return ReachablePoint::belowSafety;
       else
         return ReachablePoint::no;
@@ -361,23 +474,41 @@ ReachablePoint::reachable ReachableList::getReachable( const QPoint& position )
  * the glide path is taken into account and the arrival altitude is
  * calculated too.
  */
-void ReachableList::calculateDataInList()
+void ReachableList::calculateDataInList( const bool force )
 {
   // QTime t;
   // t.start();
   int counter = 0;
+  bool changed = force;
   setInitValues();
+  updateGlideParameters();
   arrivalAltMap.clear();
   distanceMap.clear();
 
+  // Order of the sites before the calculation
+  QVector<qint64> lastOrder;
+  lastOrder.reserve( count() );
+
+  // Reachability of the sites before the calculation
+  QVector<ReachablePoint::reachable> lastReachable;
+  lastReachable.reserve( count() );
+
+  // Glide path targets and the related list indexes
+  QVector<GlideTable::Target> targets;
+  QVector<int> targetIndexes;
+  targets.reserve( count() );
+  targetIndexes.reserve( count() );
+
   for (int i = 0; i < count(); i++)
     {
       // recalculate Distance
       ReachablePoint& p = (*this)[i];
       WGSPoint pt = p.getWaypoint()->wgsPoint;
-      Altitude arrivalAlt;
+
+      lastOrder.append( coordinateKey( pt ) );
+      lastReachable.append( p.getReachable() );
+
       Distance distance;
-      Speed bestSpeed;
 
       distance.setKilometers( MapCalc::dist(&lastPosition, &pt) );
 
@@ -397,29 +528,49 @@ void ReachableList::calculateDataInList()
           // recalculate Bearing
           p.setBearing( short (rint(MapCalc::getBearingWgs(lastPosition, pt) * 180/M_PI)) );
 
-          // Calculate glide path. Returns false, if no glider is known.
-          calculator->glidePath( p.getBearing(), p.getDistance(),
-                                 Altitude(p.getElevation()),
-                                 arrivalAlt, bestSpeed );
+          GlideTable::Target target;
+          target.bearing   = p.getBearing();
+          target.distance  = distance.getMeters();
+          target.elevation = p.getElevation();
 
-          // Save arrival altitude. Is set to invalid, if no glider is defined in calculator.
-          p.setArrivalAlt( arrivalAlt );
-        }
+          targets.append( target );
+          targetIndexes.append( i );
 
-      if ( arrivalAlt.isValid() )
-        {
-          // add only valid altitudes to the map
-          arrivalAltMap[ coordinateString ( pt ) ] = (int) arrivalAlt.getMeters() + safetyAlt;
+          // Is set to invalid, if no glider is defined in calculator.
+          p.setArrivalAlt( Altitude() );
         }
 
-      distanceMap[ coordinateString ( pt ) ] = distance;
+      distanceMap.insert( coordinateKey( pt ), distance );
+    }
 
-      if ( arrivalAlt.getMeters() > 0 )
+  // Calculate all glide paths by one call. Returns false, if no glider is known.
+  if( targets.isEmpty() == false &&
+      calculator->glidePaths( targets.data(), targets.size() ) )
+    {
+      for( int j = 0; j < targets.size(); j++ )
         {
-          counter++;
+          ReachablePoint& p = (*this)[targetIndexes.at(j)];
+          Altitude arrivalAlt( targets.at(j).arrival );
+
+          // Save arrival altitude.
+          p.setArrivalAlt( arrivalAlt );
+
+          // add only valid altitudes to the map
+          arrivalAltMap.insert( coordinateKey( p.getWaypoint()->wgsPoint ),
+                                (int) arrivalAlt.getMeters() + safetyAlt );
+
+          if ( arrivalAlt.getMeters() > 0 )
+            {
+              counter++;
+            }
         }
     }
 
+  for (int i = 0; changed == false && i < count(); i++)
+    {
+      changed = ( (*this)[i].getReachable() != lastReachable.at(i) );
+    }
+
   // sorting of items depends on the glider selection
   if ( calculator->glider() )
     {
@@ -431,9 +582,22 @@ void ReachableList::calculateDataInList()
     }
 
   std::sort( begin(), end() );
+
+  for (int i = 0; changed == false && i < count(); i++)
+    {
+      changed = ( coordinateKey( at(i).getWaypoint()->wgsPoint ) != lastOrder.at(i) );
+    }
+
   // qDebug("Number of reachable sites (arriv >0): %d", counter );
   // qDebug("Time for glide path calculation: %d msec", t.restart() );
-  emit newReachList();
+
+  // The list is announced, if the reachability or the order of the sites
+  // has been changed, otherwise at least after 10 ticks, normally after
+  // 10s in GPS mode.
+  if ( changed || (tick % 10) == 0 )
+    {
+      emit newReachList();
+    }
 }
 
 void ReachableList::setInitValues()
@@ -480,6 +644,14 @@ void ReachableList::calculateNewList()
   setInitValues();
   clearLists();  // clear all lists
 
+  if( siteIndexDirty ||
+      siteListSizes[0] != (int) _globalMapContents->getListLength( MapContents::AirfieldList ) ||
+      siteListSizes[1] != (int) _globalMapContents->getListLength( MapContents::GliderfieldList ) ||
+      siteListSizes[2] != (int) _globalMapContents->getListLength( MapContents::OutLandingList ) )
+    {
+      buildSiteIndex();
+    }
+
   // Now add items of different type to the list
   addItemsToList(MapContents::AirfieldList);
   addItemsToList(MapContents::GliderfieldList);
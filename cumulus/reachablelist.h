@@ -29,6 +29,12 @@
  * If no glider is defined only the nearest reachables in a radius of
  * 75 km are computed.
  *
+ * The landable sites of the airfield lists are found by a spatial index.
+ * The arrival altitudes of the listed sites are updated, when the position,
+ * the altitude, the wind, the McCready value or the polar have been changed.
+ * The results are stored with an integer coordinate key for fast lookups
+ * during map drawing.
+ *
  * It is assumed, that this class is a singleton.
  *
  * \date 2004-2008
@@ -40,8 +46,8 @@
 
 #include <QObject>
 #include <QPoint>
+#include <QHash>
 #include <QList>
-#include <QMap>
 
 #include "generalconfig.h"
 #include "mapmatrix.h"
@@ -51,6 +57,9 @@
 #include "vector.h"
 #include "speed.h"
 #include "reachablepoint.h"
+#include "siteindex.h"
+
+class Polar;
 
 class ReachableList : public QObject, QList<ReachablePoint>
 {
@@ -75,6 +84,14 @@ class ReachableList : public QObject, QList<ReachablePoint>
 
   void newReachList();
 
+ public slots:
+
+  /**
+   * Called, if the airfield lists have been reloaded. The site index is
+   * rebuilt at the next calculation.
+   */
+  void slot_sitesChanged();
+
  public:
 
   /**
@@ -137,6 +154,14 @@ class ReachableList : public QObject, QList<ReachablePoint>
     return calcMode;
   };
 
+  /**
+   * Returns a key, which identifies a site by its coordinates.
+   */
+  static qint64 coordinateKey(const QPoint& position)
+  {
+    return (qint64(position.x()) << 32) | quint32(position.y());
+  };
+
   /**
    * Removes all data in the different lists.
    */
@@ -177,6 +202,15 @@ class ReachableList : public QObject, QList<ReachablePoint>
    */
   static Distance getDistance( const QPoint& position );
 
+  /**
+   * Returns the arrival altitude and the reachability of a point by one
+   * lookup. If the point is not found, an invalid Altitude is returned and
+   * the point is not reachable.
+   */
+  static void getArrivalInfo( const QPoint& position,
+                              Altitude& arrival,
+                              ReachablePoint::reachable& reach );
+
   /**
    * @returns The safety altitude in meters
    */
@@ -200,8 +234,31 @@ class ReachableList : public QObject, QList<ReachablePoint>
     * to the elements contained in the limited list. If a glider is defined
     * the glide path is taken into account and the arrival altitude is
     * calculated too.
+    *
+    * @param force If true, the new list is always announced. Otherwise only,
+    *        if the reachability or the order of the sites has been changed.
     */
-  void calculateDataInList();
+  void calculateDataInList( const bool force=true );
+
+  /**
+   * Compares the parameters of the glide path calculation with the values
+   * used at the last calculation and saves the current values.
+   *
+   * @return true, if a parameter has been changed
+   */
+  bool updateGlideParameters();
+
+  /**
+   * Rebuilds the spatial index over the airfield, glider field and
+   * outlanding lists.
+   */
+  void buildSiteIndex();
+
+  /**
+   * @return The site at index of the passed airfield list or a null pointer.
+   */
+  static Airfield* getAirfieldSite( const enum MapContents::ListID item,
+                                    const int index );
 
   /**
    * Sets the initial values needed for the calculation.
@@ -226,11 +283,6 @@ class ReachableList : public QObject, QList<ReachablePoint>
    */
   void removeDoubles();
 
-  static QString coordinateString(const QPoint& position)
-  {
-    return QString("%1.%2").arg(position.x()).arg(position.y());
-  };
-
   QPoint      lastCalculationPosition; // position at last calculation
   QPoint      lastPosition;
   double      lastAltitude;
@@ -240,14 +292,28 @@ class ReachableList : public QObject, QList<ReachablePoint>
   int         tick;
   bool        initValuesOK;
 
+  // Glide path parameters of the last calculation
+  QPoint      lastGlidePosition;
+  double      lastGlideAltitude;
+  Polar*      lastPolar;
+  int         lastWater;
+  int         lastBugs;
+  int         lastLoad;
+  int         lastSafetyAlt;
+
+  // Spatial index over the airfield, glider field and outlanding lists
+  SiteIndex   siteIndex;
+  bool        siteIndexDirty;
+  int         siteListSizes[3];
+
   // Used mode for calculation of list. Can be altitude or distance.
   enum ReachableList::CalculationMode calcMode;
 
   static bool modeAltitude;
   static int safetyAlt;
 
-  static QMap<QString, int> arrivalAltMap;
-  static QMap<QString, Distance> distanceMap;
+  static QHash<qint64, int> arrivalAltMap;
+  static QHash<qint64, Distance> distanceMap;
 
   // number of created class instances
   static short instances;
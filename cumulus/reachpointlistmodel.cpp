@@ -0,0 +1,507 @@
+/***********************************************************************
+**
+**   reachpointlistmodel.cpp
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c):  2026 by the Cumulus contributors
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+#ifndef QT_5
+#include <QtGui>
+#else
+#include <QtWidgets>
+#endif
+
+#include <cmath>
+
+#include "calculator.h"
+#include "generalconfig.h"
+#include "mapcalc.h"
+#include "mapconfig.h"
+#include "reachablelist.h"
+#include "reachpointlistmodel.h"
+#include "sonne.h"
+
+extern Calculator* calculator;
+extern MapConfig* _globalMapConfig;
+
+ReachpointListModel::ReachpointListModel( QObject *parent ) :
+  QAbstractTableModel( parent ),
+  m_outlandShow( true ),
+  m_iconSize( 16 ),
+  m_safetyAlt( 0 )
+{
+  m_header << tr(" Name")
+           << tr("MHz")
+           << tr("Dist.")
+           << tr("Course")
+           << tr("Arrvial")
+           << tr("Length")
+           << tr(" SS");
+}
+
+ReachpointListModel::~ReachpointListModel()
+{
+}
+
+int ReachpointListModel::rowCount( const QModelIndex& parent ) const
+{
+  if( parent.isValid() )
+    {
+      return 0;
+    }
+
+  return m_rows.size();
+}
+
+int ReachpointListModel::columnCount( const QModelIndex& parent ) const
+{
+  if( parent.isValid() )
+    {
+      return 0;
+    }
+
+  return ColumnCount;
+}
+
+QVariant ReachpointListModel::headerData( int section,
+                                          Qt::Orientation orientation,
+                                          int role ) const
+{
+  if( orientation == Qt::Horizontal && role == Qt::DisplayRole &&
+      section >= 0 && section < m_header.size() )
+    {
+      return m_header.at( section );
+    }
+
+  return QAbstractTableModel::headerData( section, orientation, role );
+}
+
+void ReachpointListModel::collect( QVector<int>& rows, QVector<qint64>& keys ) const
+{
+  if( calculator == static_cast<Calculator *>(0) )
+    {
+      return;
+    }
+
+  QList<ReachablePoint> *pl = calculator->getReachList()->getList();
+
+  int nr = qMin( pl->size(), calculator->getReachList()->getMaxNrOfSites() );
+
+  rows.reserve( nr );
+  keys.reserve( nr );
+
+  // The list is sorted with the best site at the end, the view shows it first.
+  for( int i = nr - 1; i >= 0; i-- )
+    {
+      const ReachablePoint& rp = pl->at(i);
+
+      if( ! m_outlandShow && rp.getType() == BaseMapElement::Outlanding )
+        {
+          continue;
+        }
+
+      rows.append( i );
+      keys.append( ReachableList::coordinateKey( rp.getWaypoint()->wgsPoint ) );
+    }
+}
+
+bool ReachpointListModel::refresh()
+{
+  m_safetyAlt = (int) GeneralConfig::instance()->getSafetyAltitude().getMeters();
+
+  QVector<int> rows;
+  QVector<qint64> keys;
+
+  collect( rows, keys );
+
+  if( keys == m_keys )
+    {
+      // Same sites in the same order, only the shown values are updated.
+      m_rows = rows;
+
+      if( m_rows.size() > 0 )
+        {
+          emit dataChanged( index( 0, 0 ), index( m_rows.size() - 1, ColumnCount - 1 ) );
+        }
+
+      return false;
+    }
+
+  QHash<qint64, int> newRows;
+  newRows.reserve( keys.size() );
+
+  for( int i = 0; i < keys.size(); i++ )
+    {
+      newRows.insert( keys.at(i), i );
+    }
+
+  bool sameSites = ( keys.size() == m_keys.size() && newRows.size() == keys.size() );
+
+  for( int i = 0; sameSites && i < m_keys.size(); i++ )
+    {
+      sameSites = newRows.contains( m_keys.at(i) );
+    }
+
+  if( sameSites )
+    {
+      // The order of the sites has been changed. The persistent indexes of
+      // the view, e.g. the current row, are moved with their sites.
+      emit layoutAboutToBeChanged();
+
+      QModelIndexList from = persistentIndexList();
+      QModelIndexList to;
+
+      for( int i = 0; i < from.size(); i++ )
+        {
+          const QModelIndex& idx = from.at(i);
+          to.append( index( newRows.value( m_keys.at( idx.row() ) ), idx.column() ) );
+        }
+
+      m_rows = rows;
+      m_keys = keys;
+
+      changePersistentIndexList( from, to );
+
+      emit layoutChanged();
+      return false;
+    }
+
+  beginResetModel();
+  m_rows = rows;
+  m_keys = keys;
+  endResetModel();
+
+  return true;
+}
+
+void ReachpointListModel::clear()
+{
+  beginResetModel();
+  m_rows.clear();
+  m_keys.clear();
+  m_sunsets.clear();
+  m_siteIcons.clear();
+  endResetModel();
+}
+
+void ReachpointListModel::setOutlandShow( const bool show )
+{
+  m_outlandShow = show;
+}
+
+void ReachpointListModel::setIconSize( const int size )
+{
+  if( m_iconSize != size )
+    {
+      m_iconSize = size;
+      m_courseIcons.clear();
+    }
+}
+
+ReachablePoint* ReachpointListModel::site( const int row ) const
+{
+  if( row < 0 || row >= m_rows.size() || calculator == static_cast<Calculator *>(0) )
+    {
+      return static_cast<ReachablePoint *> (0);
+    }
+
+  QList<ReachablePoint> *pl = calculator->getReachList()->getList();
+
+  int idx = m_rows.at(row);
+
+  // The reachable list can be recalculated before the model is refreshed.
+  if( idx >= pl->size() ||
+      ReachableList::coordinateKey( pl->at(idx).getWaypoint()->wgsPoint ) != m_keys.at(row) )
+    {
+      return static_cast<ReachablePoint *> (0);
+    }
+
+  return &(*pl)[idx];
+}
+
+Distance ReachpointListModel::distanceTo( const ReachablePoint& rp ) const
+{
+  QPoint pos = calculator->getlastPosition();
+  QPoint pt  = rp.getWaypoint()->wgsPoint;
+
+  Distance distance;
+  distance.setKilometers( MapCalc::dist( &pos, &pt ) );
+
+  if( pos == pt || distance.getMeters() <= 100.0 )
+    {
+      distance.setMeters( 0.0 );
+    }
+
+  return distance;
+}
+
+int ReachpointListModel::bearingTo( const ReachablePoint& rp ) const
+{
+  if( distanceTo( rp ).getMeters() == 0.0 )
+    {
+      return 0;
+    }
+
+  return int( rint( MapCalc::getBearingWgs( calculator->getlastPosition(),
+                                            rp.getWaypoint()->wgsPoint ) * 180 / M_PI ) );
+}
+
+QVariant ReachpointListModel::data( const QModelIndex& index, int role ) const
+{
+  if( ! index.isValid() )
+    {
+      return QVariant();
+    }
+
+  ReachablePoint* rp = site( index.row() );
+
+  if( rp == 0 )
+    {
+      return QVariant();
+    }
+
+  switch( role )
+    {
+      case Qt::DisplayRole:
+
+        return text( *rp, index.column() );
+
+      case Qt::DecorationRole:
+
+        if( index.column() == Name )
+          {
+            return siteIcon( *rp );
+          }
+
+        if( index.column() == Course )
+          {
+            // Calculate relative bearing too, very cool feature
+            int relbearing = bearingTo( *rp ) - calculator->getlastHeading();
+
+            while( relbearing < 0 )
+              {
+                relbearing += 360;
+              }
+
+            return courseIcon( relbearing % 360 );
+          }
+
+        break;
+
+      case Qt::TextAlignmentRole:
+
+        if( index.column() == Name )
+          {
+            break;
+          }
+
+        if( index.column() == Sunset )
+          {
+            return int(Qt::AlignLeft|Qt::AlignVCenter);
+          }
+
+        return int(Qt::AlignRight|Qt::AlignVCenter);
+
+      case Qt::ForegroundRole:
+        {
+          Altitude arrival = rp->getArrivalAlt();
+
+          // list safely reachable sites in green
+          if( arrival.isValid() && arrival.getMeters() > 0 )
+            {
+              return QBrush( Qt::darkGreen );
+            }
+
+          // list narrowly reachable sites in magenta
+          if( arrival.isValid() && arrival.getMeters() > -m_safetyAlt )
+            {
+              return QBrush( Qt::darkMagenta );
+            }
+
+          // list other near sites in black
+          return QBrush( Qt::black );
+        }
+
+      default:
+        break;
+    }
+
+  return QVariant();
+}
+
+QString ReachpointListModel::text( ReachablePoint& rp, const int column ) const
+{
+  switch( column )
+    {
+      case Name:
+
+        return rp.getName();
+
+      case Frequency:
+
+        if( rp.getFrequency() > 0.0 )
+          {
+            return QString("%1").arg( rp.getFrequency(), 0, 'f', 3 );
+          }
+
+        return "   ";
+
+      case Dist:
+
+        return distanceTo( rp ).getText( false, 1 );
+
+      case Course:
+
+        return QString("%1%2").arg( bearingTo( rp ) ).arg( QString(Qt::Key_degree) );
+
+      case Arrival:
+
+        // Show arrival altitude or estimated time of arrival. It depends on
+        // the glider selection.
+        if( rp.getArrivalAlt().isValid() )
+          {
+            // there is a valid altitude defined
+            return rp.getArrivalAlt().getText( true, 0 );
+          }
+
+        if( calculator->getLastSpeed().getMps() > 0.5 )
+          {
+            // Check, if we are moving. In this case the ETA to the target is displayed.
+            // Moving is required to avoid division by zero!
+            int eta = (int) rint( distanceTo( rp ).getMeters() / calculator->getLastSpeed().getMps() );
+
+            if( eta < 100*3600 )
+              {
+                // display only eta if less than 100 hours
+                return QString("%1:%2").arg( eta/3600 ).arg( (eta%3600)/60, 2, 10, QChar('0') );
+              }
+          }
+
+        return "---";
+
+      case Length:
+
+        if( rp.getRunwayLength() > 0.0 )
+          {
+            return QString("%1").arg( rp.getRunwayLength(), 0, 'f', 0 ) + " m";
+          }
+
+        return QString();
+
+      case Sunset:
+        {
+          QDate date = QDate::currentDate();
+
+          if( m_sunsetDate != date )
+            {
+              m_sunsets.clear();
+              m_sunsetDate = date;
+            }
+
+          qint64 key = ReachableList::coordinateKey( rp.getWaypoint()->wgsPoint );
+
+          QHash<qint64, QString>::const_iterator it = m_sunsets.constFind( key );
+
+          if( it != m_sunsets.constEnd() )
+            {
+              return it.value();
+            }
+
+          QString sr, ss, tz;
+
+          Sonne::sonneAufUnter( sr, ss, date, rp.getWgsPos(), tz );
+
+          QString sunset = " " + ss + " " + tz;
+
+          m_sunsets.insert( key, sunset );
+          return sunset;
+        }
+
+      default:
+        break;
+    }
+
+  return QString();
+}
+
+QIcon ReachpointListModel::siteIcon( ReachablePoint& rp ) const
+{
+  ReachablePoint::reachable reach = rp.getReachable();
+
+  int key = rp.getType() * 4 + reach;
+
+  QHash<int, QIcon>::const_iterator it = m_siteIcons.constFind( key );
+
+  if( it != m_siteIcons.constEnd() )
+    {
+      return it.value();
+    }
+
+  QColor iconColor;
+
+  if( reach == ReachablePoint::yes )
+    {
+      iconColor = QColor(0, 255, 0);
+    }
+  else if( reach == ReachablePoint::belowSafety )
+    {
+      iconColor = QColor(255, 0, 255);
+    }
+  else
+    {
+      iconColor = Qt::transparent;
+    }
+
+  // create landing site type icon
+  QPixmap sitePm = _globalMapConfig->getPixmap( rp.getType(), false );
+  QPixmap icon( sitePm.size() + QSize(1, 1) );
+  icon.fill( iconColor );
+
+  QPainter painter;
+  painter.begin( &icon );
+  painter.drawPixmap( 1, 1, sitePm );
+  painter.end();
+
+  QIcon qi;
+  qi.addPixmap( icon );
+
+  m_siteIcons.insert( key, qi );
+  return qi;
+}
+
+QIcon ReachpointListModel::courseIcon( const int bearing ) const
+{
+  QHash<int, QIcon>::const_iterator it = m_courseIcons.constFind( bearing );
+
+  if( it != m_courseIcons.constEnd() )
+    {
+      return it.value();
+    }
+
+  QPixmap directionPm;
+
+  QPen pen(Qt::black);
+  pen.setWidth(0);
+
+  // Draw a triangle pointing into direction of landing site
+  MapConfig::createTriangle( directionPm,
+                             m_iconSize,
+                             Qt::black,
+                             bearing,
+                             1.0,
+                             Qt::transparent,
+                             pen );
+
+  QIcon qi( directionPm );
+
+  m_courseIcons.insert( bearing, qi );
+  return qi;
+}
@@ -0,0 +1,170 @@
+/***********************************************************************
+**
+**   reachpointlistmodel.h
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c):  2026 by the Cumulus contributors
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+#ifndef REACH_POINT_LIST_MODEL_H
+#define REACH_POINT_LIST_MODEL_H
+
+#include <QAbstractTableModel>
+#include <QDate>
+#include <QHash>
+#include <QIcon>
+#include <QPixmap>
+#include <QStringList>
+#include <QVector>
+
+#include "reachablepoint.h"
+
+/**
+ * \class ReachpointListModel
+ *
+ * \author Cumulus contributors
+ *
+ * \brief Table model over the list of reachable points.
+ *
+ * The model stores only the indexes of the shown entries of the reachable
+ * list of the calculator together with their coordinate keys. Distance,
+ * course and arrival are derived from the last position of the calculator,
+ * when a row is painted. A refresh updates the shown rows in place, if the
+ * entries of the reachable list are the same as before. A changed order
+ * is announced as layout change, that the current row is kept.
+ *
+ * \date 2026
+ */
+class ReachpointListModel : public QAbstractTableModel
+{
+  Q_OBJECT
+
+ private:
+
+  Q_DISABLE_COPY( ReachpointListModel )
+
+ public:
+
+  enum Column
+  {
+    Name = 0,
+    Frequency,
+    Dist,
+    Course,
+    Arrival,
+    Length,
+    Sunset,
+    ColumnCount
+  };
+
+  ReachpointListModel( QObject *parent = 0 );
+
+  virtual ~ReachpointListModel();
+
+  virtual int rowCount( const QModelIndex& parent = QModelIndex() ) const;
+
+  virtual int columnCount( const QModelIndex& parent = QModelIndex() ) const;
+
+  virtual QVariant data( const QModelIndex& index, int role = Qt::DisplayRole ) const;
+
+  virtual QVariant headerData( int section,
+                               Qt::Orientation orientation,
+                               int role = Qt::DisplayRole ) const;
+
+  /**
+   * Synchronizes the rows with the reachable list of the calculator.
+   *
+   * \return True, if the model was reset. In this case the selection of
+   *         the view is lost.
+   */
+  bool refresh();
+
+  /**
+   * Removes all rows.
+   */
+  void clear();
+
+  /**
+   * Enables or disables the display of outlandings. Takes effect with the
+   * next refresh.
+   */
+  void setOutlandShow( const bool show );
+
+  /**
+   * Sets the size of the course icons.
+   */
+  void setIconSize( const int size );
+
+  /**
+   * \return The reachable point in the passed row or null, if the row is
+   *         not valid or the reachable list was changed meanwhile.
+   */
+  ReachablePoint* site( const int row ) const;
+
+  /**
+   * \return The coordinate key of the passed row or 0.
+   */
+  qint64 key( const int row ) const
+  {
+    return ( row >= 0 && row < m_keys.size() ) ? m_keys.at(row) : 0;
+  };
+
+  /**
+   * \return The row of the passed coordinate key or -1.
+   */
+  int rowOf( const qint64 key ) const
+  {
+    return m_keys.indexOf( key );
+  };
+
+ private:
+
+  /** Collects the list indexes and keys of the entries to be shown. */
+  void collect( QVector<int>& rows, QVector<qint64>& keys ) const;
+
+  QString text( ReachablePoint& rp, const int column ) const;
+
+  QIcon siteIcon( ReachablePoint& rp ) const;
+
+  QIcon courseIcon( const int bearing ) const;
+
+  /** Distance from the last position to the point. */
+  Distance distanceTo( const ReachablePoint& rp ) const;
+
+  /** Course from the last position to the point in degrees. */
+  int bearingTo( const ReachablePoint& rp ) const;
+
+  /** Indexes of the shown entries in the reachable list. */
+  QVector<int> m_rows;
+
+  /** Coordinate keys of the shown entries. */
+  QVector<qint64> m_keys;
+
+  bool m_outlandShow;
+
+  int m_iconSize;
+
+  int m_safetyAlt;
+
+  QStringList m_header;
+
+  /** Site icons, key is the type multiplied by four plus the reachability. */
+  mutable QHash<int, QIcon> m_siteIcons;
+
+  /** Course icons, key is the relative bearing in degrees. */
+  mutable QHash<int, QIcon> m_courseIcons;
+
+  /** Sunset texts of the current day, key is the coordinate key. */
+  mutable QHash<qint64, QString> m_sunsets;
+
+  mutable QDate m_sunsetDate;
+};
+
+#endif
@@ -30,8 +30,8 @@
 #include "mapconfig.h"
 #include "mapcontents.h"
 #include "reachablelist.h"
+#include "reachpointlistmodel.h"
 #include "reachpointlistview.h"
-#include "sonne.h"
 #include "wpeditdialog.h"
 #include "waypointcatalog.h"
 #include "waypointlistview.h"
@@ -49,8 +49,11 @@ ReachpointListView::ReachpointListView( QWidget* parent ) :
 {
   setObjectName("ReachpointListView");
 
-  list = new QTreeWidget;
+  model = new ReachpointListModel( this );
+
+  list = new QTreeView;
   list->setObjectName("ReachpointView");
+  list->setModel( model );
 
   list->setRootIsDecorated(false);
   list->setItemsExpandable(false);
@@ -58,8 +61,6 @@ ReachpointListView::ReachpointListView( QWidget* parent ) :
   list->setAlternatingRowColors(true);
   list->setSortingEnabled(false);
   list->setSelectionMode(QAbstractItemView::SingleSelection);
-  list->setColumnCount(8);
-  list->hideColumn(7);
   list->setFocusPolicy(Qt::StrongFocus);
 
   list->setVerticalScrollMode( QAbstractItemView::ScrollPerPixel );
@@ -73,18 +74,6 @@ ReachpointListView::ReachpointListView( QWidget* parent ) :
   QtScroller::grabGesture( list->viewport(), QtScroller::LeftMouseButtonGesture );
 #endif
 
-  QStringList sl;
-
-  sl << tr(" Name")
-     << tr("MHz")
-     << tr("Dist.")
-     << tr("Course")
-     << tr("Arrvial")
-     << tr("Length")
-     << tr(" SS");
-
-  list->setHeaderLabels(sl);
-
   list->setColumnWidth( 0, 160 );
   list->setColumnWidth( 2, 74 );
 
@@ -161,7 +150,8 @@ ReachpointListView::ReachpointListView( QWidget* parent ) :
   connect(cmdHideOl, SIGNAL(pressed()), this, SLOT(slot_HideOl()));
   connect(cmdShowOl, SIGNAL(pressed()), this, SLOT(slot_ShowOl()));
   connect(cmdHome, SIGNAL(pressed()), this, SLOT(slot_Home()));
-  connect(list, SIGNAL(itemSelectionChanged()), this, SLOT(slot_Selected()));
+  connect(list->selectionModel(), SIGNAL(selectionChanged(const QItemSelection&, const QItemSelection&)),
+          this, SLOT(slot_Selected()));
   connect(cmdPageUp, SIGNAL(pressed()), this, SLOT(slot_PageUp()));
   connect(cmdPageDown, SIGNAL(pressed()), this, SLOT(slot_PageDown()));
 
@@ -172,6 +162,12 @@ ReachpointListView::ReachpointListView( QWidget* parent ) :
   QShortcut* scSelect = new QShortcut( this );
   scSelect->setKey( Qt::Key_Return );
   connect( scSelect, SIGNAL(activated()), this, SLOT( slot_Select() ));
+
+  // The distances are updated in place, as long as the list is shown.
+  refreshTimer = new QTimer( this );
+  refreshTimer->setInterval( 5000 );
+
+  connect( refreshTimer, SIGNAL(timeout()), this, SLOT(slot_Refresh()) );
 }
 
 ReachpointListView::~ReachpointListView()
@@ -180,35 +176,17 @@ ReachpointListView::~ReachpointListView()
 /** Retrieves the reachable points from the map contents, and fills the list. */
 void ReachpointListView::fillRpList()
 {
-  // qDebug() << "ReachpointListView::fillRpList() vvalue=" << list->verticalScrollBar()->value();
-
   if ( calculator == static_cast<Calculator *>(0) )
     {
       return;
     }
 
-  int safetyAlt = (int) GeneralConfig::instance()->getSafetyAltitude().getMeters();
-
-  // Save the vertical scrollbar position. It returns the number of hidden rows.
-  int vvalue = list->verticalScrollBar()->value();
-
-  QTreeWidgetItem* selectedItem = 0;
-  QString sname = "";
-  QPainter pnt;
-
   // calculate the needed icon size
   QFontMetrics qfm( font() );
   int iconSize = qfm.height() - 8;
 
   list->setIconSize( QSize(iconSize, iconSize) );
-
-  // Check, if an item selection has been made.
-  QList<QTreeWidgetItem *> il = list->selectedItems();
-
-  if ( il.size() > 0 )
-    {
-      sname = il.at(0)->text(0);
-    }
+  model->setIconSize( iconSize );
 
   // set row height at each list fill - has probably changed.
   // Note: rpMargin is a manifold of 2 to ensure symmetry
@@ -224,218 +202,37 @@ void ReachpointListView::fillRpList()
       list->setItemDelegate( rowDelegate );
     }
 
-  list->setUpdatesEnabled(false);
-  list->clear();
+  // Save the current site and the vertical scrollbar position. A model
+  // reset drops both.
+  qint64 selectedKey = model->key( list->currentIndex().row() );
+  int vvalue = list->verticalScrollBar()->value();
 
-  // Create a pointer to the list of nearest sites
-  QList<ReachablePoint> *pl = calculator->getReachList()->getList();
-  int num = 0;
-  QString key;
+  model->setOutlandShow( _outlandShow );
 
-  // Do loop over all entries in the table of nearest sites
-  for (int i = 0;
-       i < pl->count() && num < calculator->getReachList()->getMaxNrOfSites();
-       i++, num++)
+  if ( model->refresh() == false )
     {
-
-      ReachablePoint& rp = (*pl)[i];
-
-      if ( !_outlandShow && (rp.getType() == BaseMapElement::Outlanding) )
-        {
-          continue;
-        }
-
-      // Setup string for bearing
-      QString bearing = QString("%1%2").arg( rp.getBearing() ).arg( QString(Qt::Key_degree) );
-
-      // Calculate relative bearing too, very cool feature
-      int relbearing = rp.getBearing() - calculator->getlastHeading();
-
-      while (relbearing < 0)
-        {
-          relbearing += 360;
-        }
-
-      // Show arrival altitude or estimated time of arrival. It depends on
-      // the glider selection.
-      QString arrival = "---";
-
-      if ( rp.getArrivalAlt().isValid() )
-        {
-          // there is a valid altitude defined
-          arrival = rp.getArrivalAlt().getText( true, 0);
-        }
-      else if ( calculator->getLastSpeed().getMps() > 0.5 )
-        {
-          // Check, if we are moving. In this case the ETA to the target is displayed.
-          // Moving is required to avoid division by zero!
-          int eta = (int) rint(rp.getDistance().getMeters() / calculator->getLastSpeed().getMps());
-
-          if ( eta < 100*3600 )
-            {
-              // display only eta if less than 100 hours
-              arrival = QString("%1:%2").arg( eta/3600 ).arg( (eta%3600)/60, 2, 10, QChar('0') );
-            }
-        }
-
-      // calculate sunset
-      QString sr, ss, tz;
-      QDate date = QDate::currentDate();
-
-      Sonne::sonneAufUnter( sr, ss, date, rp.getWgsPos(), tz );
-
-      // hidden column for default sorting
-      key = QString("%1").arg(num, 3, 10, QLatin1Char('0') );
-
-      QString rLen("");
-
-      if( rp.getRunwayLength() > 0.0 )
-        {
-          rLen = QString("%1").arg( rp.getRunwayLength(), 0, 'f', 0 ) + " m";
-        }
-
-      QString frequency;
-
-      if( rp.getFrequency() > 0.0 )
-        {
-          frequency = QString("%1").arg( rp.getFrequency(), 0, 'f', 3 );
-        }
-      else
-        {
-          frequency = "   ";
-        }
-
-      QStringList sl;
-      sl << rp.getName()
-         << frequency
-         << rp.getDistance().getText(false,1)
-         << bearing
-         << arrival
-         << rLen
-         <<  " " + ss + " " + tz
-         << key;
-
-      QTreeWidgetItem* li = new QTreeWidgetItem( sl );
-
-      li->setTextAlignment( 1, Qt::AlignRight|Qt::AlignVCenter );
-      li->setTextAlignment( 2, Qt::AlignRight|Qt::AlignVCenter );
-      li->setTextAlignment( 3, Qt::AlignRight|Qt::AlignVCenter );
-      li->setTextAlignment( 4, Qt::AlignRight|Qt::AlignVCenter );
-      li->setTextAlignment( 5, Qt::AlignRight|Qt::AlignVCenter );
-      li->setTextAlignment( 6, Qt::AlignLeft|Qt::AlignVCenter );
-
-      list->addTopLevelItem( li );
-
-      QColor iconColor;
-
-      if ( rp.getReachable() == ReachablePoint::yes )
-        {
-          iconColor = QColor(0, 255, 0);
-        }
-      else if ( rp.getReachable() == ReachablePoint::belowSafety )
-        {
-          iconColor = QColor(255, 0, 255);
-        }
-      else
-        {
-          iconColor = Qt::transparent;
-        }
-
-      // create landing site type icon
-      QPixmap sitePm = _globalMapConfig->getPixmap(rp.getType(), false);
-      QPixmap icon( sitePm.size() + QSize(1, 1) );
-      icon.fill( iconColor );
-
-      QPainter painter;
-      painter.begin(&icon);
-      painter.drawPixmap( 1, 1, sitePm );
-      painter.end();
-
-      QIcon qi;
-      qi.addPixmap( icon );
-      li->setIcon( 0, qi );
-
-      QPixmap directionPm;
-
-      QPen pen(Qt::black);
-      pen.setWidth(0);
-
-      // Draw a triangle pointing into direction of landing site
-      MapConfig::createTriangle( directionPm,
-                                 iconSize,
-                                 Qt::black,
-                                 relbearing,
-                                 1.0,
-                                 Qt::transparent,
-                                 pen );
-
-      li->setIcon( 3, directionPm );
-
-      // store name of last selected to avoid jump to first element on each fill
-      if ( rp.getName() == sname )
-        {
-          selectedItem = li;
-        }
-
-      QColor c;
-      // list safely reachable sites in green
-      if ( rp.getArrivalAlt().isValid() && rp.getArrivalAlt().getMeters() > 0 )
-        {
-          c = QColor(Qt::darkGreen);
-        }
-      // list narrowly reachable sites in magenta
-      else if (rp.getArrivalAlt().isValid() && rp.getArrivalAlt().getMeters() > -safetyAlt)
-        {
-          c = QColor(Qt::darkMagenta);
-        }
-      // list other near sites in black
-      else
-        {
-          c = QColor(Qt::black);
-        }
-
-      for (int i=0; i < li->columnCount(); i++)
-        {
-          li->setForeground(i, QBrush(c));
-        }
+      // Rows have been updated in place, the view keeps its state.
+      return;
     }
 
-  // sort list
-  list->sortItems( 7, Qt::DescendingOrder );
-  list->resizeColumnToContents(0);
-  list->resizeColumnToContents(1);
-  list->resizeColumnToContents(2);
-  list->resizeColumnToContents(3);
-  list->resizeColumnToContents(4);
-  list->resizeColumnToContents(5);
-  list->resizeColumnToContents(6);
-
-#if 0
-  if ( selectedItem == 0 )
+  for ( int i = 0; i < ReachpointListModel::ColumnCount; i++ )
     {
-      list->scrollToTop();
-      list->setCurrentItem( list->topLevelItem(0) );
+      list->resizeColumnToContents( i );
     }
-  else
-    {
-       list->scrollToItem( selectedItem );
-       list->setCurrentItem( selectedItem );
-    }
-#endif
 
-  if ( selectedItem  )
-    {
-       list->setCurrentItem( selectedItem );
+  int row = model->rowOf( selectedKey );
 
-       QTreeWidgetItem* item = list->topLevelItem ( vvalue );
-
-       if( item )
-         {
-           list->scrollToItem( item, QAbstractItemView::PositionAtTop );
-         }
+  if ( selectedKey != 0 && row >= 0 )
+    {
+      // avoid jump to first element on each fill
+      list->setCurrentIndex( model->index( row, 0 ) );
+      list->verticalScrollBar()->setValue( vvalue );
     }
+}
 
-  list->setUpdatesEnabled(true);
+void ReachpointListView::clearList()
+{
+  model->clear();
 }
 
 void ReachpointListView::showEvent(QShowEvent *)
@@ -452,11 +249,8 @@ void ReachpointListView::showEvent(QShowEvent *)
       _newList = false;
     }
 
-  if( list->topLevelItemCount() )
-    {
-      // set list to the top.
-      list->scrollToItem( list->topLevelItem(0), QAbstractItemView::PositionAtTop );
-    }
+  // set list to the top.
+  list->scrollToTop();
 
   // Show the home button only if we are not to fast in move to avoid
   // usage during flight. The redefinition of the home position will trigger
@@ -472,6 +266,21 @@ void ReachpointListView::showEvent(QShowEvent *)
 
   // Reset home changed
   _homeChanged = false;
+
+  refreshTimer->start();
+}
+
+void ReachpointListView::hideEvent(QHideEvent *)
+{
+  refreshTimer->stop();
+}
+
+void ReachpointListView::slot_Refresh()
+{
+  if ( isVisible() )
+    {
+      fillRpList();
+    }
 }
 
 /** This slot is called to indicate that a selection has been made. */
@@ -565,25 +374,16 @@ void ReachpointListView::slot_Selected()
 /** Returns a pointer to the currently selected reachpoint. */
 Waypoint* ReachpointListView::getCurrentEntry()
 {
-  int n =  calculator->getReachList()->getNumberSites();
-  QTreeWidgetItem* li = list->currentItem();
+  ReachablePoint* rp = model->site( list->currentIndex().row() );
 
-  if (li)
+  if ( rp == static_cast<ReachablePoint *>(0) )
     {
-      for( int i=0; i < n; i++ )
-        {
-          const ReachablePoint rp = calculator->getReachList()->getSite(i);
-
-          if (rp.getName() == li->text(0))
-            {
-              selectedWp = *(rp.getWaypoint());
-              selectedWp.priority = Waypoint::Normal;  // set priority to normal
-              return &selectedWp;
-            }
-        }
+      return static_cast<Waypoint *>(0);
     }
 
-  return static_cast<Waypoint *>(0);
+  selectedWp = *(rp->getWaypoint());
+  selectedWp.priority = Waypoint::Normal;  // set priority to normal
+  return &selectedWp;
 }
 
 void ReachpointListView::slot_newList()
@@ -657,13 +457,13 @@ void ReachpointListView::slot_PageUp()
 {
   if( cmdPageUp->isDown() )
     {
-      if( list->topLevelItemCount() == 0 )
+      if( model->rowCount() == 0 )
         {
           return;
         }
 
       // That is the height of one row in the list
-      QRect rect = list->visualItemRect(list->topLevelItem(0));
+      QRect rect = list->visualRect( model->index(0, 0) );
 
       // Calculate rows per page. Headline must be subtracted.
       int pageRows = ( list->height() / rect.height() ) - 1;
@@ -692,13 +492,13 @@ void ReachpointListView::slot_PageDown()
 {
   if( cmdPageDown->isDown() )
     {
-      if( list->topLevelItemCount() == 0 )
+      if( model->rowCount() == 0 )
         {
           return;
         }
 
       // That is the height of one row in the list
-      QRect rect = list->visualItemRect(list->topLevelItem(0));
+      QRect rect = list->visualRect( model->index(0, 0) );
 
       // Calculate rows per page. Headline must be subtracted.
       int pageRows = ( list->height() / rect.height() ) - 1;
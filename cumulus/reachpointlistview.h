@@ -32,7 +32,7 @@
 #define REACH_POINT_LISTVIEW_H
 
 #include <QWidget>
-#include <QTreeWidget>
+#include <QTreeView>
 #include <QPixmap>
 #include <QBoxLayout>
 #include <QPushButton>
@@ -43,6 +43,8 @@
 
 class MainWindow;
 class QCheckBox;
+class QTimer;
+class ReachpointListModel;
 
 class ReachpointListView : public QWidget
 {
@@ -68,16 +70,16 @@ public:
   /**
    * Clears the widget list.
    */
-  void clearList()
-  {
-    list->clear();
-  }
+  void clearList();
 
 protected:
 
   /** This slot is called when the widget is displayed. */
   void showEvent(QShowEvent *event);
 
+  /** This slot is called when the widget is hidden. */
+  void hideEvent(QHideEvent *event);
+
 public slots:
 
   /**
@@ -137,6 +139,11 @@ private slots:
    */
   void slot_ScrollerBoxToggled( int state );
 
+  /**
+   * Called by the refresh timer to update the shown distances.
+   */
+  void slot_Refresh();
+
 signals:
 
   /**
@@ -167,7 +174,13 @@ signals:
 
 private:
 
-  QTreeWidget* list;
+  QTreeView* list;
+
+  /** Model over the reachable list of the calculator. */
+  ReachpointListModel* model;
+
+  /** Updates the distances of the shown list periodically. */
+  QTimer* refreshTimer;
 
   /** that stores a home position change */
   bool _homeChanged;
@@ -0,0 +1,378 @@
+/***********************************************************************
+ **
+ **   replaybenchmark.cpp
+ **
+ **   This file is part of Cumulus.
+ **
+ ************************************************************************
+ **
+ **   Copyright (c):  2026 by the Cumulus contributors
+ **
+ **   This file is distributed under the terms of the General Public
+ **   License. See the file COPYING for more information.
+ **
+ ***********************************************************************/
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <sys/time.h>
+
+#include <QtCore>
+
+#include "gpsnmea.h"
+#include "mapcalc.h"
+#include "replaybenchmark.h"
+#include "speed.h"
+
+ReplayBenchmark* ReplayBenchmark::ms_active = 0;
+
+ReplayBenchmark::Histogram::Histogram() :
+  count(0),
+  sum(0),
+  max(0)
+{
+  memset( buckets, 0, sizeof(buckets) );
+}
+
+void ReplayBenchmark::Histogram::add( const qint64 usecs )
+{
+  int bucket = 0;
+
+  while( bucket < Buckets - 1 && (Q_INT64_C(1) << bucket) <= usecs )
+    {
+      bucket++;
+    }
+
+  buckets[bucket]++;
+  count++;
+  sum += usecs;
+  max = qMax( max, usecs );
+}
+
+qint64 ReplayBenchmark::Histogram::percentile( const double p ) const
+{
+  quint32 limit = static_cast<quint32> (ceil( count * p ));
+  quint32 seen  = 0;
+
+  for( int i = 0; i < Buckets; i++ )
+    {
+      seen += buckets[i];
+
+      if( seen >= limit && seen > 0 )
+        {
+          return Q_INT64_C(1) << i;
+        }
+    }
+
+  return max;
+}
+
+ReplayBenchmark::ReplayBenchmark() :
+  m_runTime(0)
+{
+}
+
+ReplayBenchmark::~ReplayBenchmark()
+{
+  if( ms_active == this )
+    {
+      ms_active = 0;
+    }
+}
+
+qint64 ReplayBenchmark::now()
+{
+  // gettimeofday needs no extra library on the older Maemo systems.
+  struct timeval tv;
+  gettimeofday( &tv, 0 );
+
+  return qint64(tv.tv_sec) * 1000000 + tv.tv_usec;
+}
+
+void ReplayBenchmark::record( const Stage stage, const qint64 usecs )
+{
+  m_histograms[stage].add( usecs );
+}
+
+const char* ReplayBenchmark::stageName( const Stage stage )
+{
+  switch( stage )
+    {
+      case StageSentence:
+        return "Sentence";
+      case StageCalculator:
+        return "Calculator";
+      case StageVario:
+        return "Vario";
+      case StageWind:
+        return "Wind";
+      case StageReach:
+        return "ReachableList";
+      case StageAirspace:
+        return "Airspace";
+      case StageIgc:
+        return "IgcLogger";
+      default:
+        return "Unknown";
+    }
+}
+
+bool ReplayBenchmark::run( const QString& fileName )
+{
+  m_sentences.clear();
+
+  for( int i = 0; i < StageCount; i++ )
+    {
+      m_histograms[i] = Histogram();
+    }
+
+  bool ok;
+
+  if( QFileInfo(fileName).suffix().toLower() == "igc" )
+    {
+      ok = readIgcFile( fileName );
+    }
+  else
+    {
+      ok = readNmeaFile( fileName );
+    }
+
+  if( ok == false || m_sentences.isEmpty() || GpsNmea::gps == 0 )
+    {
+      qWarning() << "ReplayBenchmark: Nothing to replay from" << fileName;
+      return false;
+    }
+
+  qDebug() << "ReplayBenchmark: Replaying" << m_sentences.size()
+           << "sentences from" << fileName;
+
+  ms_active = this;
+
+  qint64 start = now();
+
+  for( int i = 0; i < m_sentences.size(); i++ )
+    {
+      Probe probe( StageSentence );
+
+      GpsNmea::gps->slot_sentence( m_sentences.at(i) );
+    }
+
+  m_runTime = now() - start;
+
+  ms_active = 0;
+
+  return true;
+}
+
+void ReplayBenchmark::report() const
+{
+  QStringList lines;
+
+  double seconds = m_runTime / 1000000.0;
+
+  lines << QString("Replay of %1 sentences in %2 ms, %3 sentences/s")
+           .arg( m_sentences.size() )
+           .arg( m_runTime / 1000.0, 0, 'f', 1 )
+           .arg( seconds > 0.0 ? m_sentences.size() / seconds : 0.0, 0, 'f', 0 );
+
+  lines << QString("%1 %2 %3 %4 %5 %6 %7")
+           .arg( "Stage", -14 )
+           .arg( "Calls", 8 )
+           .arg( "Mean/us", 9 )
+           .arg( "P50/us", 9 )
+           .arg( "P90/us", 9 )
+           .arg( "P99/us", 9 )
+           .arg( "Max/us", 9 );
+
+  for( int i = 0; i < StageCount; i++ )
+    {
+      const Histogram& h = m_histograms[i];
+
+      if( h.count == 0 )
+        {
+          continue;
+        }
+
+      lines << QString("%1 %2 %3 %4 %5 %6 %7")
+               .arg( stageName( static_cast<Stage>(i) ), -14 )
+               .arg( h.count, 8 )
+               .arg( double(h.sum) / h.count, 9, 'f', 1 )
+               .arg( h.percentile( 0.50 ), 9 )
+               .arg( h.percentile( 0.90 ), 9 )
+               .arg( h.percentile( 0.99 ), 9 )
+               .arg( h.max, 9 );
+
+      // The histogram, every bucket contains latencies below its limit.
+      QString hist = "  <";
+
+      for( int b = 0; b < Buckets; b++ )
+        {
+          if( h.buckets[b] > 0 )
+            {
+              hist += QString(" %1us:%2").arg( Q_INT64_C(1) << b ).arg( h.buckets[b] );
+            }
+        }
+
+      lines << hist;
+    }
+
+  for( int i = 0; i < lines.size(); i++ )
+    {
+      qDebug( "ReplayBenchmark: %s", lines.at(i).toLatin1().data() );
+      fprintf( stdout, "%s\n", lines.at(i).toLatin1().data() );
+    }
+
+  fflush( stdout );
+}
+
+bool ReplayBenchmark::readNmeaFile( const QString& fileName )
+{
+  QFile file( fileName );
+
+  if( ! file.open( QIODevice::ReadOnly ) )
+    {
+      qWarning() << "ReplayBenchmark: Cannot open file" << fileName;
+      return false;
+    }
+
+  QTextStream in( &file );
+
+  while( ! in.atEnd() )
+    {
+      QString line = in.readLine().trimmed();
+
+      if( line.startsWith( "$" ) || line.startsWith( "!" ) )
+        {
+          m_sentences.append( line );
+        }
+    }
+
+  file.close();
+  return true;
+}
+
+bool ReplayBenchmark::readIgcFile( const QString& fileName )
+{
+  QFile file( fileName );
+
+  if( ! file.open( QIODevice::ReadOnly ) )
+    {
+      qWarning() << "ReplayBenchmark: Cannot open file" << fileName;
+      return false;
+    }
+
+  QTextStream in( &file );
+
+  QString date = "010100";
+  QPoint lastPos;
+  QTime lastTime;
+
+  while( ! in.atEnd() )
+    {
+      QString line = in.readLine().trimmed();
+
+      if( line.startsWith( "HFDTE" ) )
+        {
+          // H-Record, Date, e.g. HFDTE270614 or HFDTEDATE:270614,01
+          QString digits = line.mid( 5 );
+          digits.remove( QRegExp( "[^0-9,]" ) );
+          date = digits.left( 6 );
+          continue;
+        }
+
+      // 0           1          2            3
+      // 0 123456 78901234 567890123 4 56789 01234 567 89
+      // B 155706 5229791N 01331393E A 00000 00081 001 08
+      if( line.startsWith( "B" ) == false || line.size() < 35 )
+        {
+          continue;
+        }
+
+      QString time = line.mid( 1, 6 );
+      QTime qtime = QTime::fromString( time, "HHmmss" );
+
+      if( ! qtime.isValid() )
+        {
+          continue;
+        }
+
+      QString latDeg = line.mid( 7, 4 ) + "." + line.mid( 11, 3 );
+      QString latHem = line.mid( 14, 1 );
+      QString lonDeg = line.mid( 15, 5 ) + "." + line.mid( 20, 3 );
+      QString lonHem = line.mid( 23, 1 );
+      QString status = line.mid( 24, 1 );
+
+      int baroAlt = line.mid( 25, 5 ).toInt();
+      int gnssAlt = line.mid( 30, 5 ).toInt();
+      QString sats = line.size() >= 40 ? line.mid( 38, 2 ) : "08";
+
+      // Position in KFLog units
+      int lat = line.mid( 7, 2 ).toInt() * 600000 + line.mid( 9, 5 ).toInt() * 10;
+      int lon = line.mid( 15, 3 ).toInt() * 600000 + line.mid( 18, 5 ).toInt() * 10;
+
+      if( latHem == "S" ) lat = -lat;
+      if( lonHem == "W" ) lon = -lon;
+
+      QPoint pos( lat, lon );
+
+      double speedKnots = 0.0;
+      double bearing = 0.0;
+
+      if( lastTime.isValid() )
+        {
+          int timeDiff = lastTime.secsTo( qtime );
+
+          if( timeDiff > 0 )
+            {
+              // Distance in meters
+              double dist = MapCalc::dist( &lastPos, &pos ) * 1000.0;
+
+              Speed speed( dist / double(timeDiff) );
+              speedKnots = speed.getKnots();
+
+              if( dist > 0.5 )
+                {
+                  bearing = MapCalc::getBearing( lastPos, pos ) * 180.0 / M_PI;
+                }
+            }
+        }
+
+      lastPos  = pos;
+      lastTime = qtime;
+
+      addSentence( "GPRMC," + time + "," + status + "," +
+                   latDeg + "," + latHem + "," +
+                   lonDeg + "," + lonHem + "," +
+                   QString::number( speedKnots, 'f', 1 ) + "," +
+                   QString::number( bearing, 'f', 0 ) + "," +
+                   date + ",,,A" );
+
+      addSentence( "GPGGA," + time + "," +
+                   latDeg + "," + latHem + "," +
+                   lonDeg + "," + lonHem + "," +
+                   (status == "A" ? "1" : "0") + "," +
+                   sats + ",1.0," +
+                   QString::number( gnssAlt ) + ",M,0.0,M,," );
+
+      if( baroAlt != 0 )
+        {
+          addSentence( "PGRMZ," +
+                       QString::number( qRound( baroAlt / 0.3048 ) ) + ",F,2" );
+        }
+    }
+
+  file.close();
+  return true;
+}
+
+void ReplayBenchmark::addSentence( const QString& body )
+{
+  QString sentence = "$" + body + "*";
+
+  uchar sum = GpsNmea::calcCheckSum( sentence.toLatin1().data() );
+
+  sentence += QString("%1").arg( sum, 2, 16, QChar('0') ).toUpper();
+
+  m_sentences.append( sentence );
+}
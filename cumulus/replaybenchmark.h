@@ -0,0 +1,173 @@
+/***********************************************************************
+ **
+ **   replaybenchmark.h
+ **
+ **   This file is part of Cumulus.
+ **
+ ************************************************************************
+ **
+ **   Copyright (c):  2026 by the Cumulus contributors
+ **
+ **   This file is distributed under the terms of the General Public
+ **   License. See the file COPYING for more information.
+ **
+ ***********************************************************************/
+
+#ifndef REPLAY_BENCHMARK_H
+#define REPLAY_BENCHMARK_H
+
+#include <QString>
+#include <QStringList>
+
+/**
+ * \class ReplayBenchmark
+ *
+ * \author Cumulus contributors
+ *
+ * \brief Replays a recorded flight through the fix pipeline at full speed.
+ *
+ * The benchmark reads a NMEA log file or an IGC file. IGC B-Records are
+ * converted into RMC, GGA and PGRMZ sentences. All sentences are prepared
+ * before the measurement starts and are then passed one after another to
+ * \ref GpsNmea::slot_sentence without any pauses. The time used by the
+ * pipeline is taken from the sentences only, so a replay is reproducible.
+ *
+ * The stages of the pipeline contain a \ref Probe, which measures the
+ * latency of a single call, if a benchmark is running. The latencies are
+ * collected in histograms with logarithmic buckets and reported together
+ * with the number of sentences processed per second.
+ *
+ * The benchmark is started with the command line option -replay <file>.
+ *
+ * \date 2026
+ */
+class ReplayBenchmark
+{
+ public:
+
+  /**
+   * The measured stages of the fix pipeline. The latency of a stage
+   * includes the latencies of the stages called by it.
+   */
+  enum Stage
+  {
+    StageSentence = 0,
+    StageCalculator,
+    StageVario,
+    StageWind,
+    StageReach,
+    StageAirspace,
+    StageIgc,
+    StageCount
+  };
+
+  /**
+   * Measures the latency of a stage during its lifetime. If no benchmark
+   * is running, nothing is measured.
+   */
+  class Probe
+  {
+   public:
+
+    Probe( const Stage stage ) :
+      m_stage(stage),
+      m_start(ms_active != 0 ? now() : 0)
+    {
+    };
+
+    ~Probe()
+    {
+      if( ms_active != 0 && m_start != 0 )
+        {
+          ms_active->record( m_stage, now() - m_start );
+        }
+    };
+
+   private:
+
+    Stage m_stage;
+
+    qint64 m_start;
+  };
+
+  ReplayBenchmark();
+
+  virtual ~ReplayBenchmark();
+
+  /**
+   * Replays the passed NMEA or IGC file.
+   *
+   * @param fileName Name of the file to be replayed
+   * @return true in case of success otherwise false
+   */
+  bool run( const QString& fileName );
+
+  /**
+   * Reports the results of the last run via qDebug and on stdout.
+   */
+  void report() const;
+
+  /**
+   * @return A time stamp in microseconds.
+   */
+  static qint64 now();
+
+ private:
+
+  /** Number of histogram buckets. Bucket i counts latencies < 2^i us. */
+  enum { Buckets = 24 };
+
+  class Histogram
+  {
+   public:
+
+    Histogram();
+
+    void add( const qint64 usecs );
+
+    /**
+     * @return The upper bound of the bucket, which contains the passed
+     * percentile.
+     */
+    qint64 percentile( const double p ) const;
+
+    quint32 buckets[Buckets];
+
+    quint32 count;
+
+    qint64 sum;
+
+    qint64 max;
+  };
+
+  void record( const Stage stage, const qint64 usecs );
+
+  /**
+   * Reads the sentences of a NMEA file.
+   */
+  bool readNmeaFile( const QString& fileName );
+
+  /**
+   * Reads the B-Records of an IGC file and converts them into NMEA sentences.
+   */
+  bool readIgcFile( const QString& fileName );
+
+  /**
+   * Appends the checksum to the sentence body and stores the sentence.
+   */
+  void addSentence( const QString& body );
+
+  static const char* stageName( const Stage stage );
+
+  QStringList m_sentences;
+
+  Histogram m_histograms[StageCount];
+
+  /** Wall time of the replay in microseconds. */
+  qint64 m_runTime;
+
+  /** The running benchmark or null. */
+  static ReplayBenchmark* ms_active;
+};
+
+#endif
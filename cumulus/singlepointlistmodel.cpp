@@ -0,0 +1,166 @@
+/***********************************************************************
+**
+**   singlepointlistmodel.cpp
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c):  2026 by the Cumulus contributors
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+#include <QtCore>
+
+#include "airfield.h"
+#include "radiopoint.h"
+#include "singlepointlistmodel.h"
+
+extern MapContents* _globalMapContents;
+
+SinglePointListModel::SinglePointListModel( const enum ExtraColumn extra,
+                                            QObject *parent ) :
+  PointListModel( parent ),
+  m_extra( extra )
+{
+  if( extra != IcaoOrComment )
+    {
+      setHeaderText( Extra, tr("Comment") );
+    }
+}
+
+SinglePointListModel::~SinglePointListModel()
+{
+}
+
+int SinglePointListModel::rowCount( const QModelIndex& parent ) const
+{
+  if( parent.isValid() )
+    {
+      return 0;
+    }
+
+  return m_rows.size();
+}
+
+void SinglePointListModel::clear()
+{
+  beginResetModel();
+  m_rows.clear();
+  endResetModel();
+}
+
+Waypoint* SinglePointListModel::waypoint( const int row )
+{
+  SinglePoint* site = point( row );
+
+  if( site == 0 )
+    {
+      return static_cast<Waypoint *> (0);
+    }
+
+  m_wp = Waypoint();
+  m_wp.name = site->getWPName();
+  m_wp.wgsPoint = site->getWGSPosition();
+  m_wp.projPoint = site->getPosition();
+  m_wp.description = site->getName();
+  m_wp.type = site->getTypeID();
+  m_wp.elevation = site->getElevation();
+  m_wp.comment = site->getComment();
+  m_wp.country = site->getCountry();
+
+  Airfield* af = dynamic_cast<Airfield *> (site);
+
+  if( af != 0 )
+    {
+      m_wp.icao = af->getICAO();
+      m_wp.frequency = af->getFrequency();
+      m_wp.rwyList = af->getRunwayList();
+      return &m_wp;
+    }
+
+  RadioPoint* rp = dynamic_cast<RadioPoint *> (site);
+
+  if( rp != 0 )
+    {
+      m_wp.icao = rp->getICAO();
+      m_wp.frequency = rp->getFrequency();
+      m_wp.comment = rp->getAdditionalText();
+    }
+
+  return &m_wp;
+}
+
+void SinglePointListModel::reload( const QVector<enum MapContents::ListID>& itemList )
+{
+  beginResetModel();
+
+  m_rows.clear();
+
+  for( int item = 0; item < itemList.size(); item++ )
+    {
+      int nr = _globalMapContents->getListLength( itemList.at(item) );
+
+      m_rows.reserve( m_rows.size() + nr );
+
+      for( int i = 0; i < nr; i++ )
+        {
+          SinglePoint* site = dynamic_cast<SinglePoint *> (_globalMapContents->getElement( itemList.at(item), i ));
+
+          if( site != 0 )
+            {
+              m_rows.append( site );
+            }
+        }
+    }
+
+  endResetModel();
+}
+
+QString SinglePointListModel::text( const int row, const int column ) const
+{
+  const SinglePoint* site = m_rows.at( row );
+
+  switch( column )
+    {
+      case Name:
+        return site->getWPName();
+      case Description:
+        return site->getName();
+      case Country:
+        return site->getCountry();
+      case Extra:
+        break;
+      default:
+        return QString();
+    }
+
+  if( m_extra == IcaoOrComment )
+    {
+      const Airfield* af = dynamic_cast<const Airfield *> (site);
+
+      if( af != 0 && af->getTypeID() != BaseMapElement::Outlanding )
+        {
+          return af->getICAO();
+        }
+    }
+  else if( m_extra == AdditionalText )
+    {
+      const RadioPoint* rp = dynamic_cast<const RadioPoint *> (site);
+
+      if( rp != 0 )
+        {
+          return rp->getAdditionalText();
+        }
+    }
+
+  return site->getComment();
+}
+
+int SinglePointListModel::typeId( const int row ) const
+{
+  return m_rows.at( row )->getTypeID();
+}
@@ -0,0 +1,106 @@
+/***********************************************************************
+**
+**   singlepointlistmodel.h
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c):  2026 by the Cumulus contributors
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+#ifndef SINGLE_POINT_LIST_MODEL_H
+#define SINGLE_POINT_LIST_MODEL_H
+
+#include <QVector>
+
+#include "mapcontents.h"
+#include "pointlistmodel.h"
+#include "singlepoint.h"
+#include "waypoint.h"
+
+/**
+ * \class SinglePointListModel
+ *
+ * \author Cumulus contributors
+ *
+ * \brief Table model over point lists of \ref MapContents.
+ *
+ * The model stores pointers to the airfields, navigation aids or other
+ * single points of one or more lists of \ref MapContents. The lists must
+ * not be modified, as long as the model is loaded. They are only reloaded
+ * after a projection change, before that the model has to be cleared.
+ *
+ * \date 2026
+ */
+class SinglePointListModel : public PointListModel
+{
+  Q_OBJECT
+
+ private:
+
+  Q_DISABLE_COPY( SinglePointListModel )
+
+ public:
+
+  /** Content of the fourth column. */
+  enum ExtraColumn
+  {
+    IcaoOrComment,  // ICAO code, the comment for outlandings
+    Comment,        // comment of the point
+    AdditionalText  // additional text of a navigation aid
+  };
+
+  SinglePointListModel( const enum ExtraColumn extra, QObject *parent = 0 );
+
+  virtual ~SinglePointListModel();
+
+  virtual int rowCount( const QModelIndex& parent = QModelIndex() ) const;
+
+  virtual void clear();
+
+  /**
+   * Returns the data of the point as waypoint. ICAO identifier, frequency
+   * and runways are taken over from airfields and radio points.
+   */
+  virtual Waypoint* waypoint( const int row );
+
+  /**
+   * Loads all points of the passed lists.
+   */
+  void reload( const QVector<enum MapContents::ListID>& itemList );
+
+  /**
+   * \return The point in the passed row or null.
+   */
+  SinglePoint* point( const int row ) const
+  {
+    if( row < 0 || row >= m_rows.size() )
+      {
+        return static_cast<SinglePoint *> (0);
+      }
+
+    return m_rows.at( row );
+  };
+
+ protected:
+
+  virtual QString text( const int row, const int column ) const;
+
+  virtual int typeId( const int row ) const;
+
+ private:
+
+  QVector<SinglePoint *> m_rows;
+
+  enum ExtraColumn m_extra;
+
+  /** Waypoint temporary storage. */
+  Waypoint m_wp;
+};
+
+#endif
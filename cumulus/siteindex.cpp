@@ -0,0 +1,80 @@
+/***********************************************************************
+ **
+ **   siteindex.cpp
+ **
+ **   This file is part of Cumulus.
+ **
+ ************************************************************************
+ **
+ **   Copyright (c):  2026 by the Cumulus contributors
+ **
+ **   This file is distributed under the terms of the General Public
+ **   License. See the file COPYING for more information.
+ **
+ ***********************************************************************/
+
+#include "siteindex.h"
+
+SiteIndex::SiteIndex()
+{
+}
+
+SiteIndex::~SiteIndex()
+{
+}
+
+void SiteIndex::clear()
+{
+  m_sites.clear();
+  m_cells.clear();
+}
+
+int SiteIndex::cellCoord( const int value )
+{
+  // Round down also for negative coordinates.
+  return value >= 0 ? value / CellSize : (value - CellSize + 1) / CellSize;
+}
+
+void SiteIndex::add( const QPoint& position, const int list, const int index )
+{
+  m_cells[cellKey( cellCoord( position.x() ), cellCoord( position.y() ) )].append( m_sites.size() );
+  m_sites.append( Site( position, list, index ) );
+}
+
+void SiteIndex::query( const QRect& box, QVector<Site>& result ) const
+{
+  if( m_sites.isEmpty() )
+    {
+      return;
+    }
+
+  int lat1 = cellCoord( box.left() );
+  int lat2 = cellCoord( box.right() );
+  int lon1 = cellCoord( box.top() );
+  int lon2 = cellCoord( box.bottom() );
+
+  for( int lat = lat1; lat <= lat2; lat++ )
+    {
+      for( int lon = lon1; lon <= lon2; lon++ )
+        {
+          QHash<int, QVector<int> >::const_iterator it = m_cells.constFind( cellKey( lat, lon ) );
+
+          if( it == m_cells.constEnd() )
+            {
+              continue;
+            }
+
+          const QVector<int>& cell = it.value();
+
+          for( int i = 0; i < cell.size(); i++ )
+            {
+              const Site& site = m_sites.at( cell.at(i) );
+
+              if( box.contains( site.position ) )
+                {
+                  result.append( site );
+                }
+            }
+        }
+    }
+}
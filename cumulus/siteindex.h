@@ -0,0 +1,112 @@
+/***********************************************************************
+ **
+ **   siteindex.h
+ **
+ **   This file is part of Cumulus.
+ **
+ ************************************************************************
+ **
+ **   Copyright (c):  2026 by the Cumulus contributors
+ **
+ **   This file is distributed under the terms of the General Public
+ **   License. See the file COPYING for more information.
+ **
+ ***********************************************************************/
+
+#ifndef SITE_INDEX_H
+#define SITE_INDEX_H
+
+#include <QHash>
+#include <QPoint>
+#include <QRect>
+#include <QVector>
+
+/**
+ * \class SiteIndex
+ *
+ * \author Cumulus contributors
+ *
+ * \brief Grid index over point sites in WGS84 coordinates.
+ *
+ * Every site is stored with its position, the identifier of the list it is
+ * taken from and its index in that list. A query returns all sites inside
+ * a WGS84 rectangle without walking the source lists. The index does not
+ * copy any site data, so it must be rebuilt, if a source list is changed.
+ *
+ * \date 2026
+ */
+class SiteIndex
+{
+ public:
+
+  /**
+   * An indexed site.
+   */
+  class Site
+  {
+   public:
+
+    Site() : list(-1), index(-1) {};
+
+    Site( const QPoint& pos, const int listId, const int idx ) :
+      position(pos), list(listId), index(idx) {};
+
+    /** WGS84 position, x is the latitude and y the longitude. */
+    QPoint position;
+
+    /** Identifier of the source list. */
+    int list;
+
+    /** Index of the site in the source list. */
+    int index;
+  };
+
+  SiteIndex();
+
+  virtual ~SiteIndex();
+
+  /**
+   * Removes all sites from the index.
+   */
+  void clear();
+
+  /**
+   * Adds a site to the index.
+   */
+  void add( const QPoint& position, const int list, const int index );
+
+  /**
+   * @return The number of indexed sites.
+   */
+  int count() const
+  {
+    return m_sites.size();
+  };
+
+  /**
+   * Collects all sites inside of the passed rectangle.
+   *
+   * @param box Rectangle in WGS84 coordinates, x is the latitude
+   * @param result List, to which the found sites are appended
+   */
+  void query( const QRect& box, QVector<Site>& result ) const;
+
+ private:
+
+  /** Cell size in KFLog units, that is one degree. */
+  enum { CellSize = 600000 };
+
+  static int cellCoord( const int value );
+
+  static int cellKey( const int lat, const int lon )
+  {
+    return lat * 512 + lon;
+  };
+
+  QVector<Site> m_sites;
+
+  /** Indices of the sites located in a cell. */
+  QHash<int, QVector<int> > m_cells;
+};
+
+#endif
@@ -13,6 +13,9 @@
  **
  ***********************************************************************/
 
+#include <algorithm>
+#include <cmath>
+
 #include <QtCore>
 
 #include "generalconfig.h"
@@ -26,6 +29,13 @@
 // Near check distance state as meters for a line figure
 #define NEAR_DISTANCE_LINE 2000.0
 
+// Maximum time in ms between two fixes, which are connected for the
+// segment test. Older fixes are not considered.
+#define MAX_SEGMENT_TIME 60000
+
+// Meters per KFLog unit, which is 1/10000 of an arc minute.
+#define METERS_PER_KFLOG_UNIT 0.1852
+
 TaskPoint::TaskPoint( enum TaskPointTypes::TaskPointType type ) :
   SinglePoint(),
   angle(0.0),
@@ -106,7 +116,8 @@ Waypoint* TaskPoint::getWaypointObject()
 }
 
 enum TaskPoint::PassageState TaskPoint::checkPassage( const Distance& dist2Tp,
-                                                      const QPoint& position )
+                                                      const QPoint& position,
+                                                      const QTime& fixTime )
 {
   // qDebug() << "TaskPoint::checkPassage: TP-IDX=" << m_flightTaskListIndex;
 
@@ -119,34 +130,104 @@ enum TaskPoint::PassageState TaskPoint::checkPassage( const Distance& dist2Tp,
   // get user defined scheme item
   const enum GeneralConfig::ActiveTaskFigureScheme scheme = getActiveTaskPointFigureScheme();
 
-  if( scheme == GeneralConfig::Line )
+  if( scheme != GeneralConfig::Line && scheme != GeneralConfig::Circle &&
+      scheme != GeneralConfig::Keyhole && scheme != GeneralConfig::Sector )
     {
-      return determineLinePassageState( dist2Tp, position );
+      qWarning() << "TaskPoint::checkPassage(): ActiveTaskFigureScheme"
+                 << scheme << "is unknown!";
+
+      // That should normally not happen
+      m_lastDistance = -1.0;
+      m_lastPassageState = Outside;
+      return Outside;
     }
 
-  if( scheme == GeneralConfig::Circle )
+  // Take over the previous fix and store the current one for the next call.
+  const QPoint lastFixPosition = m_lastFixPosition;
+  const QTime lastFixTime = m_lastFixTime;
+
+  m_lastFixPosition = position;
+  m_lastFixTime = fixTime;
+
+  const enum PassageState lastState = m_lastPassageState;
+
+  int segmentTime = -1;
+
+  if( fixTime.isValid() && lastFixTime.isValid() &&
+      lastFixPosition.isNull() == false && lastFixPosition != position )
     {
-      return determineCirclePassageState( dist2Tp.getMeters(),
-                                          m_taskCircleRadius.getMeters() );
+      segmentTime = lastFixTime.msecsTo( fixTime );
+
+      if( segmentTime < 0 )
+        {
+          // Midnight was passed.
+          segmentTime += 24 * 3600 * 1000;
+        }
     }
 
-  if( scheme == GeneralConfig::Keyhole )
+  // The segment between the last two fixes is tested against the zone as
+  // long as no touch is pending. So also a zone is detected, which was
+  // only clipped between the fixes.
+  double fraction = 1.0;
+  bool clipped = false;
+
+  if( segmentTime > 0 && segmentTime <= MAX_SEGMENT_TIME && lastState != Touched )
     {
-      return determineKeyholePassageState( dist2Tp.getMeters(), position );
+      prepareZoneGeometry();
+      clipped = checkSegment( lastFixPosition, position, fraction );
     }
 
-  if( scheme == GeneralConfig::Sector )
+  enum PassageState state;
+
+  switch( scheme )
     {
-      return determineSectorPassageState( dist2Tp.getMeters(), position );
+      case GeneralConfig::Line:
+        state = determineLinePassageState( dist2Tp, position );
+        break;
+
+      case GeneralConfig::Circle:
+        state = determineCirclePassageState( dist2Tp.getMeters(),
+                                             m_taskCircleRadius.getMeters() );
+        break;
+
+      case GeneralConfig::Keyhole:
+        state = determineKeyholePassageState( dist2Tp.getMeters(), position );
+        break;
+
+      default:
+        state = determineSectorPassageState( dist2Tp.getMeters(), position );
+        break;
     }
 
-  qWarning() << "TaskPoint::checkPassage(): ActiveTaskFigureScheme"
-             << scheme << "is unknown!";
+  if( state == Passed )
+    {
+      return Passed;
+    }
 
-  // That should normally not happen
-  m_lastDistance = -1.0;
-  m_lastPassageState = Outside;
-  return Outside;
+  if( clipped && state != Touched )
+    {
+      // The current fix is outside but the zone was entered or the line
+      // was crossed between the last two fixes. The minimum approach lies
+      // already behind us, so the nearest scheme reports the passage with
+      // the next fix.
+      m_lastDistance = 0.0;
+      m_lastPassageState = Touched;
+      state = Touched;
+    }
+
+  if( state == Touched && lastState != Touched )
+    {
+      if( clipped )
+        {
+          m_passageTime = lastFixTime.addMSecs( qRound( fraction * segmentTime ) );
+        }
+      else
+        {
+          m_passageTime = fixTime;
+        }
+    }
+
+  return state;
 }
 
 enum TaskPoint::PassageState
@@ -488,6 +569,229 @@ enum TaskPoint::PassageState
   return Outside;
 }
 
+void TaskPoint::prepareZoneGeometry()
+{
+  const enum GeneralConfig::ActiveTaskFigureScheme scheme = getActiveTaskPointFigureScheme();
+
+  if( m_zone.valid &&
+      m_zone.scheme == scheme &&
+      m_zone.center == getWGSPosition() &&
+      m_zone.circleRadius == m_taskCircleRadius.getMeters() &&
+      m_zone.innerRadius == m_taskSectorInnerRadius.getMeters() &&
+      m_zone.outerRadius == m_taskSectorOuterRadius.getMeters() &&
+      m_zone.minAngle == minAngle &&
+      m_zone.maxAngle == maxAngle &&
+      m_zone.lineBegin == m_taskLine.getLineBegin() &&
+      m_zone.lineEnd == m_taskLine.getLineEnd() &&
+      m_zone.lineDirection == m_taskLine.getDirection() )
+    {
+      // Nothing has been changed.
+      return;
+    }
+
+  m_zone.valid         = true;
+  m_zone.scheme        = scheme;
+  m_zone.center        = getWGSPosition();
+  m_zone.cosLat        = cos( m_zone.center.x() / 600000.0 * M_PI / 180.0 );
+  m_zone.circleRadius  = m_taskCircleRadius.getMeters();
+  m_zone.innerRadius   = m_taskSectorInnerRadius.getMeters();
+  m_zone.outerRadius   = m_taskSectorOuterRadius.getMeters();
+  m_zone.minAngle      = minAngle;
+  m_zone.maxAngle      = maxAngle;
+  m_zone.lineBegin     = m_taskLine.getLineBegin();
+  m_zone.lineEnd       = m_taskLine.getLineEnd();
+  m_zone.lineDirection = m_taskLine.getDirection();
+
+  m_zone.localLineBegin = toLocal( m_zone.lineBegin );
+  m_zone.localLineEnd   = toLocal( m_zone.lineEnd );
+
+  // The line has to be crossed in this direction.
+  const double direction = m_zone.lineDirection * M_PI / 180.0;
+
+  m_zone.localLineDirection = QPointF( sin( direction ), cos( direction ) );
+}
+
+QPointF TaskPoint::toLocal( const QPoint& position ) const
+{
+  return QPointF( (position.y() - m_zone.center.y()) * m_zone.cosLat * METERS_PER_KFLOG_UNIT,
+                  (position.x() - m_zone.center.x()) * METERS_PER_KFLOG_UNIT );
+}
+
+bool TaskPoint::isInsideSectorAngle( const QPointF& point ) const
+{
+  // Bearing from the task point, 0 is north and the angle runs clockwise.
+  double bearing = atan2( point.x(), point.y() );
+
+  if( bearing < 0.0 )
+    {
+      bearing += 2.0 * M_PI;
+    }
+
+  if( m_zone.minAngle > m_zone.maxAngle )
+    {
+      // The sector includes the north direction.
+      return bearing > m_zone.minAngle || bearing < m_zone.maxAngle;
+    }
+
+  return bearing > m_zone.minAngle && bearing < m_zone.maxAngle;
+}
+
+bool TaskPoint::isInsideZone( const QPointF& point ) const
+{
+  const double dist = sqrt( point.x() * point.x() + point.y() * point.y() );
+
+  switch( m_zone.scheme )
+    {
+      case GeneralConfig::Circle:
+        return dist < m_zone.circleRadius;
+
+      case GeneralConfig::Keyhole:
+        if( m_zone.innerRadius > 0.0 && dist < m_zone.innerRadius )
+          {
+            return true;
+          }
+
+        return dist <= m_zone.outerRadius && isInsideSectorAngle( point );
+
+      case GeneralConfig::Sector:
+        if( m_zone.innerRadius > 0.0 && dist < m_zone.innerRadius )
+          {
+            return false;
+          }
+
+        return dist <= m_zone.outerRadius && isInsideSectorAngle( point );
+
+      default:
+        return false;
+    }
+}
+
+bool TaskPoint::checkSegment( const QPoint& from, const QPoint& to, double& fraction )
+{
+  const QPointF p0 = toLocal( from );
+  const QPointF d  = toLocal( to ) - p0;
+
+  if( m_zone.scheme == GeneralConfig::Line )
+    {
+      if( m_zone.lineDirection == -1 || m_zone.lineBegin.isNull() ||
+          m_zone.lineEnd.isNull() )
+        {
+          // The line data are not initialized.
+          return false;
+        }
+
+      // The line must be crossed in the flight direction.
+      if( d.x() * m_zone.localLineDirection.x() +
+          d.y() * m_zone.localLineDirection.y() <= 0.0 )
+        {
+          return false;
+        }
+
+      const QPointF a = m_zone.localLineBegin;
+      const QPointF e = m_zone.localLineEnd - a;
+
+      const double denom = d.x() * e.y() - d.y() * e.x();
+
+      if( denom == 0.0 )
+        {
+          // Segment and line are parallel.
+          return false;
+        }
+
+      const QPointF w = a - p0;
+
+      const double t = ( w.x() * e.y() - w.y() * e.x() ) / denom;
+      const double u = ( w.x() * d.y() - w.y() * d.x() ) / denom;
+
+      if( t < 0.0 || t > 1.0 || u < 0.0 || u > 1.0 )
+        {
+          return false;
+        }
+
+      fraction = t;
+      return true;
+    }
+
+  // The zone boundaries are circles around the task point and the sector
+  // edges. Between two intersections of the segment with the boundaries the
+  // inside state cannot change. So it is sufficient to test one point of
+  // every part of the segment.
+  double cuts[8];
+  int count = 0;
+
+  cuts[count++] = 0.0;
+
+  const double radii[2] =
+    {
+      m_zone.scheme == GeneralConfig::Circle ? m_zone.circleRadius : m_zone.outerRadius,
+      m_zone.scheme == GeneralConfig::Circle ? 0.0 : m_zone.innerRadius
+    };
+
+  // |p0 + t*d| = r
+  const double qa = d.x() * d.x() + d.y() * d.y();
+  const double qb = 2.0 * ( p0.x() * d.x() + p0.y() * d.y() );
+  const double qc = p0.x() * p0.x() + p0.y() * p0.y();
+
+  for( int i = 0; i < 2; i++ )
+    {
+      const double disc = qb * qb - 4.0 * qa * ( qc - radii[i] * radii[i] );
+
+      if( radii[i] <= 0.0 || qa == 0.0 || disc < 0.0 )
+        {
+          continue;
+        }
+
+      const double root = sqrt( disc );
+
+      cuts[count++] = ( -qb - root ) / ( 2.0 * qa );
+      cuts[count++] = ( -qb + root ) / ( 2.0 * qa );
+    }
+
+  if( m_zone.scheme != GeneralConfig::Circle )
+    {
+      const double angles[2] = { m_zone.minAngle, m_zone.maxAngle };
+
+      for( int i = 0; i < 2; i++ )
+        {
+          // Intersection with the straight line through the task point in
+          // the direction of the sector edge.
+          const double ux = sin( angles[i] );
+          const double uy = cos( angles[i] );
+
+          const double denom = d.x() * uy - d.y() * ux;
+
+          if( denom != 0.0 )
+            {
+              cuts[count++] = ( p0.y() * ux - p0.x() * uy ) / denom;
+            }
+        }
+    }
+
+  cuts[count++] = 1.0;
+
+  std::sort( cuts, cuts + count );
+
+  for( int i = 0; i < count - 1; i++ )
+    {
+      if( cuts[i + 1] <= 0.0 || cuts[i] >= 1.0 || cuts[i] == cuts[i + 1] )
+        {
+          continue;
+        }
+
+      const double begin = qMax( 0.0, cuts[i] );
+      const double end   = qMin( 1.0, cuts[i + 1] );
+      const double mid   = ( begin + end ) / 2.0;
+
+      if( isInsideZone( QPointF( p0.x() + mid * d.x(), p0.y() + mid * d.y() ) ) )
+        {
+          fraction = begin;
+          return true;
+        }
+    }
+
+  return false;
+}
+
 QString TaskPoint::getTaskPointTypeString( bool detailed ) const
 {
   switch( m_taskPointType )
@@ -596,6 +900,11 @@ void TaskPoint::setConfigurationDefaults()
   m_lastPassageState = Outside;
   m_lastDistance = -1;
 
+  m_lastFixPosition = QPoint();
+  m_lastFixTime = QTime();
+  m_passageTime = QTime();
+  m_zone.valid = false;
+
   setAutoZoom( conf->getTaskPointAutoZoom() );
 
   // Reset user edited flag
@@ -16,6 +16,9 @@
 #ifndef TASK_POINT_H
 #define TASK_POINT_H
 
+#include <QPointF>
+#include <QTime>
+
 #include "distance.h"
 #include "generalconfig.h"
 #include "singlepoint.h"
@@ -89,13 +92,33 @@ class TaskPoint : public SinglePoint
   /**
    * Checks the task point passage according to the assigned schema.
    *
+   * If the fix time is valid, the segment between the previous and the
+   * current fix is tested against the observation zone too. So a zone, which
+   * is only clipped between two fixes, is not missed.
+   *
    * @param dist2Tp Distance to taskpoint
    *
    * @param position Current position as KFLOG WGS84 datum
    *
+   * @param fixTime UTC time of the current position
+   *
    * @return State of passage.
    */
-  enum PassageState checkPassage( const Distance& dist2Tp, const QPoint& position );
+  enum PassageState checkPassage( const Distance& dist2Tp,
+                                  const QPoint& position,
+                                  const QTime& fixTime=QTime() );
+
+  /**
+   * Gets the time, when the observation zone was entered or the line was
+   * crossed. The time is interpolated between the fixes around the passage.
+   * It is set, when the touched state is reported.
+   *
+   * @return The UTC time of the last passage.
+   */
+  const QTime& getPassageTime() const
+  {
+    return m_passageTime;
+  };
 
   /**
    * Determines the task point passage for a line figure.
@@ -234,6 +257,77 @@ class TaskPoint : public SinglePoint
   /** A waypoint object, filled with the taskpoint basic data.*/
   Waypoint m_wpObject;
 
+  /** Position of the previous fix passed to checkPassage. */
+  QPoint m_lastFixPosition;
+
+  /** Time of the previous fix passed to checkPassage. */
+  QTime m_lastFixTime;
+
+  /** Interpolated time of the last passage. */
+  QTime m_passageTime;
+
+  /**
+   * Observation zone geometry in a local flat projection around the task
+   * point. The x-axis points to the east, the y-axis to the north and the
+   * unit is meter. The geometry is only rebuilt, if the task point figure
+   * has been changed.
+   */
+  struct ZoneGeometry
+  {
+    bool valid;
+    enum GeneralConfig::ActiveTaskFigureScheme scheme;
+    QPoint center;
+    double cosLat;
+    double circleRadius;
+    double innerRadius;
+    double outerRadius;
+    double minAngle;
+    double maxAngle;
+    QPoint lineBegin;
+    QPoint lineEnd;
+    int    lineDirection;
+    QPointF localLineBegin;
+    QPointF localLineEnd;
+    QPointF localLineDirection;
+  };
+
+  ZoneGeometry m_zone;
+
+  /**
+   * Rebuilds the zone geometry, if the task point figure has been changed.
+   */
+  void prepareZoneGeometry();
+
+  /**
+   * Projects a KFLog position into the local zone coordinates.
+   */
+  QPointF toLocal( const QPoint& position ) const;
+
+  /**
+   * @return True, if the local point is inside of the observation zone.
+   */
+  bool isInsideZone( const QPointF& point ) const;
+
+  /**
+   * @return True, if the bearing of the local point lies inside of the
+   * sector angles.
+   */
+  bool isInsideSectorAngle( const QPointF& point ) const;
+
+  /**
+   * Tests the segment between two fixes against the observation zone.
+   *
+   * @param from Position of the previous fix
+   *
+   * @param to Position of the current fix
+   *
+   * @param fraction Fraction of the segment, where the zone was entered or
+   *                 the line was crossed.
+   *
+   * @return True, if the segment enters the zone or crosses the line.
+   */
+  bool checkSegment( const QPoint& from, const QPoint& to, double& fraction );
+
  public:
 
   /**
@@ -0,0 +1,110 @@
+/***********************************************************************
+ **
+ **   tilecache.cpp
+ **
+ **   This file is part of Cumulus.
+ **
+ ************************************************************************
+ **
+ **   Copyright (c):  2026 by the Cumulus contributors
+ **
+ **   This file is distributed under the terms of the General Public
+ **   License. See the file COPYING for more information.
+ **
+ ***********************************************************************/
+
+#include <QList>
+#include <QPair>
+#include <QtAlgorithms>
+
+#include "tilecache.h"
+
+TileCache::TileCache( const qint64 budget ) :
+  m_clock(0),
+  m_used(0),
+  m_budget(budget)
+{
+}
+
+TileCache::~TileCache()
+{
+}
+
+QSet<int> TileCache::tiles() const
+{
+  return m_tiles.keys().toSet();
+}
+
+void TileCache::addBytes( const int tile, const qint64 bytes )
+{
+  Entry& entry = m_tiles[tile];
+
+  entry.bytes  += bytes;
+  entry.lastUse = ++m_clock;
+  m_used       += bytes;
+}
+
+void TileCache::touch( const int tile )
+{
+  QHash<int, Entry>::iterator it = m_tiles.find( tile );
+
+  if( it != m_tiles.end() )
+    {
+      it.value().lastUse = ++m_clock;
+    }
+}
+
+void TileCache::remove( const int tile )
+{
+  QHash<int, Entry>::iterator it = m_tiles.find( tile );
+
+  if( it != m_tiles.end() )
+    {
+      m_used -= it.value().bytes;
+      m_tiles.erase( it );
+    }
+}
+
+void TileCache::clear()
+{
+  m_tiles.clear();
+  m_used  = 0;
+  m_clock = 0;
+}
+
+QSet<int> TileCache::evictionCandidates( const QSet<int>& keep ) const
+{
+  QSet<int> result;
+
+  if( m_used <= m_budget )
+    {
+      return result;
+    }
+
+  // Sort the unloadable tiles by their last use, oldest first.
+  QList< QPair<quint64, int> > lru;
+
+  QHashIterator<int, Entry> it( m_tiles );
+
+  while( it.hasNext() )
+    {
+      it.next();
+
+      if( keep.contains( it.key() ) == false )
+        {
+          lru.append( qMakePair( it.value().lastUse, it.key() ) );
+        }
+    }
+
+  qSort( lru );
+
+  qint64 used = m_used;
+
+  for( int i = 0; i < lru.size() && used > m_budget; i++ )
+    {
+      result.insert( lru.at(i).second );
+      used -= m_tiles.value( lru.at(i).second ).bytes;
+    }
+
+  return result;
+}
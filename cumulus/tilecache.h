@@ -0,0 +1,133 @@
+/***********************************************************************
+ **
+ **   tilecache.h
+ **
+ **   This file is part of Cumulus.
+ **
+ ************************************************************************
+ **
+ **   Copyright (c):  2026 by the Cumulus contributors
+ **
+ **   This file is distributed under the terms of the General Public
+ **   License. See the file COPYING for more information.
+ **
+ ***********************************************************************/
+
+#ifndef TILE_CACHE_H
+#define TILE_CACHE_H
+
+#include <QHash>
+#include <QSet>
+
+/**
+ * \class TileCache
+ *
+ * \author Cumulus contributors
+ *
+ * \brief Bookkeeping of the memory used by the loaded map tiles.
+ *
+ * The map loader reports the estimated number of bytes of every loaded
+ * map tile file. The drawing marks the tiles as used, which are visible.
+ * If the sum of all tiles exceeds the memory budget, the least recently
+ * used tiles are proposed for unloading. The cache does not store any map
+ * data itself.
+ *
+ * \date 2026
+ */
+class TileCache
+{
+ public:
+
+  /**
+   * @param budget Memory budget in bytes
+   */
+  TileCache( const qint64 budget );
+
+  virtual ~TileCache();
+
+  qint64 budget() const
+  {
+    return m_budget;
+  };
+
+  void setBudget( const qint64 budget )
+  {
+    m_budget = budget;
+  };
+
+  /**
+   * @return The estimated number of bytes of all loaded tiles.
+   */
+  qint64 usedBytes() const
+  {
+    return m_used;
+  };
+
+  /**
+   * @return true, if the used bytes exceed the budget.
+   */
+  bool isOverBudget() const
+  {
+    return m_used > m_budget;
+  };
+
+  bool contains( const int tile ) const
+  {
+    return m_tiles.contains( tile );
+  };
+
+  /**
+   * @return The identifiers of all known tiles.
+   */
+  QSet<int> tiles() const;
+
+  /**
+   * Adds bytes to a tile and marks it as used.
+   */
+  void addBytes( const int tile, const qint64 bytes );
+
+  /**
+   * Marks a tile as most recently used. Unknown tiles are ignored.
+   */
+  void touch( const int tile );
+
+  /**
+   * Removes a tile from the cache.
+   */
+  void remove( const int tile );
+
+  void clear();
+
+  /**
+   * Determines the least recently used tiles, which must be unloaded to
+   * come back under the budget. Tiles of the keep set are never proposed.
+   *
+   * @param keep Tiles, which are in use and must not be unloaded
+   * @return The tiles to be unloaded
+   */
+  QSet<int> evictionCandidates( const QSet<int>& keep ) const;
+
+ private:
+
+  class Entry
+  {
+   public:
+
+    Entry() : bytes(0), lastUse(0) {};
+
+    qint64 bytes;
+
+    quint64 lastUse;
+  };
+
+  QHash<int, Entry> m_tiles;
+
+  /** Logical clock, incremented at every use of a tile. */
+  quint64 m_clock;
+
+  qint64 m_used;
+
+  qint64 m_budget;
+};
+
+#endif
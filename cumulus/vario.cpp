@@ -16,12 +16,17 @@
 **
 ***********************************************************************/
 
+#include <cmath>
 #include <cstdlib>
 
 #include "vario.h"
 #include "altitude.h"
 #include "calculator.h"
 #include "generalconfig.h"
+#include "replaybenchmark.h"
+
+// Gravity acceleration in m/s^2
+#define GRAVITY 9.81
 
 Vario::Vario(QObject* parent) :
   QObject(parent),
@@ -29,13 +34,17 @@ Vario::Vario(QObject* parent) :
   m_TEKOn(false),
   m_energyAlt(0.0),
   m_TekAdjust(0.0),
-  m_sampleList( LimitedList<AltSample>( 61 ) )
+  m_filter(WindowFilter),
+  m_lastSource(NoSource),
+  m_lastTime(0),
+  m_lastAltitude(0.0)
 {
   GeneralConfig *conf = GeneralConfig::instance();
 
   m_intTime = conf->getVarioIntegrationTime() * 1000;
   m_TEKOn = conf->getVarioTekCompensation();
   m_TekAdjust = (100.0 + conf->getVarioTekAdjust()) / 100.0;
+  m_filter = conf->getVarioFilter() == KalmanFilter ? KalmanFilter : WindowFilter;
 
   // Timeout supervision of delivery of new altitude values
   connect( &m_timeOut, SIGNAL( timeout() ), this, SLOT( slotTimeout() ) );
@@ -46,94 +55,216 @@ Vario::~Vario()
   m_timeOut.stop();
 }
 
-void Vario::newAltitude()
+Vario::SlidingWindow::SlidingWindow() :
+  m_head(0),
+  m_count(0),
+  m_sum(0.0)
 {
-  // Start or restart the timer to supervise the calling of this
-  // method. If the timer expires the variometer is set to zero.
-  m_timeOut.setSingleShot( true );
-  m_timeOut.start( m_intTime + 2500 );
+}
+
+void Vario::SlidingWindow::add( const qint64 timeStamp, const double rate )
+{
+  if( m_count == Capacity )
+    {
+      removeOldest();
+    }
+
+  int index = (m_head + m_count) % Capacity;
 
-  int max = calculator->samplelist.count();
+  m_timeStamps[index] = timeStamp;
+  m_rates[index] = rate;
+  m_count++;
+  m_sum += rate;
+}
 
-  if( max < 10 )
+void Vario::SlidingWindow::expire( const qint64 limit )
+{
+  while( m_count > 0 && m_timeStamps[m_head] < limit )
     {
-      // to less samples in the list
-      return;
+      removeOldest();
     }
+}
 
-  int i = 1; // index for list access
-  double sum = 0.0;
+void Vario::SlidingWindow::removeOldest()
+{
+  m_sum -= m_rates[m_head];
+  m_head = (m_head + 1) % Capacity;
+  m_count--;
 
-  bool resultAvailable = false;
+  if( m_count == 0 )
+    {
+      // Avoid the accumulation of rounding errors.
+      m_sum = 0.0;
+    }
+}
 
-  // Step through the list. Note, the list is inverse ordered, last sample at
-  // first position.
-  QDateTime startTime = calculator->samplelist.at( 0 ).time;
+void Vario::SlidingWindow::clear()
+{
+  m_head  = 0;
+  m_count = 0;
+  m_sum   = 0.0;
+}
 
-  while( i < max )
+Vario::KalmanFilter3::KalmanFilter3()
+{
+  reset();
+}
+
+void Vario::KalmanFilter3::reset()
+{
+  m_valid = false;
+  m_timeStamp = 0;
+
+  for( int i = 0; i < 3; i++ )
     {
-      double energyAlt1 = 0.0;
-      double energyAlt2 = 0.0;
-      const FlightSample *sample1 = &calculator->samplelist.at( i - 1 );
-      const FlightSample *sample2 = &calculator->samplelist.at( i );
+      m_x[i] = 0.0;
 
-      // calculate energy altitude for both samples
-      if( m_TEKOn )
+      for( int j = 0; j < 3; j++ )
         {
-          double speed1 = sample1->airspeed.getMps();
-          double speed2 = sample2->airspeed.getMps();
-
-          if( (calculator->currentFlightMode() != Calculator::circlingL &&
-               calculator->currentFlightMode() != Calculator::circlingR) ||
-               speed1 == 0.0 || speed2 == 0.0 )
-            {
-              // If we do not circling or the calculated airspeed is zero
-              // we do take the ground speed as basis.
-              Vector v1 = sample1->vector;
-              Vector v2 = sample1->vector;
-              speed1 = v1.getSpeed().getMps();
-              speed2 = v2.getSpeed().getMps();
-            }
-
-          energyAlt1  = (speed1 * speed1) / (2 * 9.81);
-          energyAlt2  = (speed2 * speed2) / (2 * 9.81);
+          m_p[i][j] = 0.0;
         }
+    }
+}
 
-      // if( i == 2 )
-      // qDebug("Airspeed %f, EnergyAltitude %f, TekAdj %f",sample1->airspeed.getKph(), energyAlt1, _TekAdjust );
+void Vario::KalmanFilter3::update( const qint64 timeStamp,
+                                   const double altitude,
+                                   const bool pressure,
+                                   const double accelNoise )
+{
+  // Measurement variances of GPS and pressure altitudes in m^2
+  const double gpsVariance = 9.0;
+  const double pressureVariance = 0.1;
 
-      int timeDist = sample2->time.msecsTo( startTime );
+  // Variance increase of the pressure offset in m^2 per second
+  const double offsetNoise = 0.001;
 
-      if( timeDist > m_intTime )
-        {
-          // time difference to big
-          break;
-        }
+  if( m_valid == false )
+    {
+      // Initialize the state with the first altitude.
+      reset();
+
+      // The offset of the pressure altitude is unknown at the beginning.
+      m_x[0] = altitude;
+      m_p[0][0] = pressure ? pressureVariance : gpsVariance;
+      m_p[1][1] = 4.0;
+      m_p[2][2] = 10000.0;
+      m_timeStamp = timeStamp;
+      m_valid = true;
+      return;
+    }
 
-      i++;
+  double dt = (timeStamp - m_timeStamp) / 1000.0;
 
-      double diff = (sample1->altitude.getMeters() + energyAlt1 * m_TekAdjust) -
-                    (sample2->altitude.getMeters() + energyAlt2 * m_TekAdjust);
+  if( dt < 0.0 || dt > 10.0 )
+    {
+      // Time jump, start again.
+      m_valid = false;
+      update( timeStamp, altitude, pressure, accelNoise );
+      return;
+    }
 
-      int elapsed = sample2->time.msecsTo( sample1->time );
+  m_timeStamp = timeStamp;
 
-      sum += (1000.0 * diff / (double) elapsed);
+  // Prediction: altitude += climb rate * dt
+  m_x[0] += m_x[1] * dt;
 
-      resultAvailable = true;
+  // P = F * P * F^T + Q with F = [[1,dt,0],[0,1,0],[0,0,1]]
+  double p00 = m_p[0][0] + dt * (m_p[1][0] + m_p[0][1]) + dt * dt * m_p[1][1];
+  double p01 = m_p[0][1] + dt * m_p[1][1];
+  double p02 = m_p[0][2] + dt * m_p[1][2];
 
-      // qDebug("Vario: max=%d, i=%d, diff=%f, elapsed=%dms, sum=%f",
-      //	max, i, diff, elapsed, sum );
+  m_p[0][0] = p00 + accelNoise * dt * dt * dt * dt / 4.0;
+  m_p[0][1] = m_p[1][0] = p01 + accelNoise * dt * dt * dt / 2.0;
+  m_p[0][2] = m_p[2][0] = p02;
+  m_p[1][1] += accelNoise * dt * dt;
+  m_p[2][2] += offsetNoise * dt;
+
+  // Correction with H = [1,0,0] for GPS and H = [1,0,1] for pressure
+  double h[3] = { 1.0, 0.0, pressure ? 1.0 : 0.0 };
+
+  double ph[3];
+
+  for( int i = 0; i < 3; i++ )
+    {
+      ph[i] = m_p[i][0] * h[0] + m_p[i][2] * h[2];
     }
 
-  Speed lift;
+  double s = h[0] * ph[0] + h[2] * ph[2] +
+             (pressure ? pressureVariance : gpsVariance);
+
+  double y = altitude - (m_x[0] + h[2] * m_x[2]);
+
+  double k[3];
 
-  if( resultAvailable )
+  for( int i = 0; i < 3; i++ )
     {
-      lift.setMps( sum / (i - 1) );
+      k[i] = ph[i] / s;
+      m_x[i] += k[i] * y;
     }
 
-  // qDebug ("New vario=%s, samples=%d", lift.getTextVertical(true, 3).latin1(), i );
-  emit newVario( lift );
+  // P = P - K * (H * P)
+  for( int i = 0; i < 3; i++ )
+    {
+      for( int j = 0; j < 3; j++ )
+        {
+          m_p[i][j] -= k[i] * ph[j];
+        }
+    }
+}
+
+void Vario::newAltitude()
+{
+  ReplayBenchmark::Probe probe( ReplayBenchmark::StageVario );
+
+  // Start or restart the timer to supervise the calling of this
+  // method. If the timer expires the variometer is set to zero.
+  m_timeOut.setSingleShot( true );
+  m_timeOut.start( m_intTime + 2500 );
+
+  const FlightSampleList& samples = calculator->samplelist;
+
+  if( samples.count() < 10 )
+    {
+      // to less samples in the list
+      return;
+    }
+
+  double energyAlt = 0.0;
+  double airspeed = samples.airspeed( 0 );
+
+  // calculate energy altitude of the sample
+  if( m_TEKOn )
+    {
+      double speed = airspeed;
+
+      if( (calculator->currentFlightMode() != Calculator::circlingL &&
+           calculator->currentFlightMode() != Calculator::circlingR) ||
+           speed == 0.0 )
+        {
+          // If we do not circling or the calculated airspeed is zero
+          // we do take the ground speed as basis.
+          speed = samples.speed( 0 );
+        }
+
+      energyAlt = (speed * speed) / (2 * GRAVITY);
+    }
+
+  if( m_filter == KalmanFilter )
+    {
+      // The pressure altitudes are stamped by the arrival time, the fused
+      // GPS altitudes must use the same clock.
+      process( GpsSource,
+               samples.altitude( 0 ) + energyAlt * m_TekAdjust,
+               QDateTime::currentMSecsSinceEpoch(),
+               0.0, 1, airspeed );
+    }
+  else
+    {
+      process( GpsSource,
+               samples.altitude( 0 ) + energyAlt * m_TekAdjust,
+               samples.time( 0 ),
+               0.0, 1, airspeed );
+    }
 }
 
 void Vario::newPressureAltitude( const Altitude& altitude, const Speed& tas )
@@ -151,101 +282,114 @@ void Vario::newPressureAltitude( const Altitude& altitude, const Speed& tas )
   // say the difference is acceptable. The unit is m/s.
   const double limit = 0.35;
 
-  AltSample sample;
+  double alt = altitude.getMeters();
+  double speed = tas.getMps();
 
-  sample.altitude  = altitude.getMeters();
-  sample.tas       = tas.getMps();
-  sample.timeStamp = QDateTime::currentMSecsSinceEpoch();
+  if( m_TEKOn && speed > 0.0 )
+    {
+      alt += (speed * speed) / (2 * GRAVITY) * m_TekAdjust;
+    }
 
-  // Add the new sample to the list.
-  m_sampleList.add( sample );
+  process( PressureSource,
+           alt,
+           QDateTime::currentMSecsSinceEpoch(),
+           limit, 4, speed );
+}
 
-  // qDebug() << "m_sampleList.count()=" << m_sampleList.count();
+void Vario::process( const Source source,
+                     const double altitude,
+                     const qint64 timeStamp,
+                     const double noiseLimit,
+                     const int minPairs,
+                     const double airspeed )
+{
+  Speed lift;
 
-  if( m_sampleList.count() < 5 )
+  if( m_filter == KalmanFilter )
     {
-      // Too less samples in the list.
-      return;
-    }
+      // The spectral density of the vertical acceleration is derived from
+      // the integration time, a longer time gives a smoother result.
+      double intTime = m_intTime / 1000.0;
 
-  int i = 1; // index for list access
-  int max = m_sampleList.count();
-  double lift = 0.0;
+      m_kalman.update( timeStamp, altitude, source == PressureSource,
+                       4.0 / (intTime * intTime) );
 
-  bool resultAvailable = false;
+      lift.setMps( m_kalman.climbRate() );
 
-  // Step through the list. Note, the list is inverse ordered, last sample at
-  // first position.
-  qint64 elapsedTime = 0;
+      emit newVario( lift );
+      emitNetto( lift.getMps(), airspeed );
+      return;
+    }
 
-  while( i < max )
+  if( source != m_lastSource || timeStamp <= m_lastTime )
     {
-      double energyAlt1 = 0.0;
-      double energyAlt2 = 0.0;
+      // A new source or a time jump backwards, start again.
+      m_window.clear();
 
-      const AltSample& sample1 = m_sampleList.at( i - 1 );
-      const AltSample& sample2 = m_sampleList.at( i );
-
-      double tas1 = sample1.tas;
-      double tas2 = sample2.tas;
-
-      qint64 timeDist = sample1.timeStamp - sample2.timeStamp;
+      m_lastSource   = source;
+      m_lastTime     = timeStamp;
+      m_lastAltitude = altitude;
+      return;
+    }
 
-      elapsedTime += timeDist;
+  double rate = (altitude - m_lastAltitude) * 1000.0 / (double) (timeStamp - m_lastTime);
 
-      if( elapsedTime > m_intTime )
-        {
-          // The defined time period is reached, leave loop.
-          break;
-        }
+  if( fabs( rate ) <= noiseLimit )
+    {
+      // If the altitude difference to low, we take zero for that pair.
+      // That is done to filter out noise values.
+      rate = 0.0;
+    }
 
-      i++;
-      double altDiff;
+  m_window.add( m_lastTime, rate );
+  m_window.expire( timeStamp - m_intTime );
 
-      if( m_TEKOn && tas1 > 0.0 && tas2 > 0.0 )
-        {
-          energyAlt1  = (tas1 * tas1) / (2 * 9.81) * m_TekAdjust;
-          energyAlt2  = (tas2 * tas2) / (2 * 9.81) * m_TekAdjust;
+  m_lastTime     = timeStamp;
+  m_lastAltitude = altitude;
 
-          altDiff = (((sample1.altitude + energyAlt1) -
-                      (sample2.altitude + energyAlt2)) / (double) timeDist) * 1000.0;
-        }
-      else
-        {
-          altDiff = ((sample1.altitude - sample2.altitude) / (double) timeDist) * 1000.0;
-#if 0
-          qDebug() << "i=" << (i-2)
-                   << "timeDist" << timeDist << " ms"
-                   << "A1=" << sample1.altitude
-                   << "A2=" << sample2.altitude
-                   << "AltDiff=" << altDiff;
-#endif
-        }
+  if( m_window.count() < minPairs )
+    {
+      return;
+    }
 
-      if( fabs( altDiff ) > limit )
-        {
-          // If the altitude difference to low, we ignore that value in the
-          // calculation. That is done to filter out noise values.
-          lift += altDiff;
-        }
+  lift.setMps( m_window.mean() );
 
-      // qDebug() << "lastI=" << (i-1) << "lift=" << lift;
+  // qDebug ("New vario=%f, pairs=%d", lift.getMps(), m_window.count() );
+  emit newVario( lift );
+  emitNetto( lift.getMps(), airspeed );
+}
 
-      resultAvailable = true;
+void Vario::emitNetto( const double lift, const double airspeed )
+{
+  Polar* polar = 0;
 
-      // qDebug( "Vario: max=%d, i=%d, diff=%f, elapsed=%lldms, lift=%f",
-      //         max, i, (sample1.altitude - sample2.altitude), elapsedTime, lift );
+  if( airspeed > 0.0 && calculator->glider() != 0 )
+    {
+      polar = calculator->glider()->polar();
     }
 
-  Speed lifting;
-
-  if( resultAvailable )
+  if( polar == 0 )
     {
-      lifting.setMps( lift / (double) (i - 1) );
+      // Without polar and airspeed the values are unknown.
+      emit newNettoVario( Speed(), Speed() );
+      return;
     }
 
-  // qDebug ("New vario=%f, samples=%d", lifting.getMps(), i );
-  emit newVario( lifting );
+  // The sink of the glider is added to the lift to get the air mass movement.
+  double netto = lift + polar->getSink( Speed( airspeed ) ).getMps();
+
+  // Relative is the lift, which would be achieved when circling with
+  // minimum sink.
+  double relative = netto - polar->getSink( polar->minSinkSpeed() ).getMps();
+
+  emit newNettoVario( Speed( netto ), Speed( relative ) );
+}
+
+void Vario::reset()
+{
+  m_window.clear();
+  m_kalman.reset();
+  m_lastSource = NoSource;
 }
 
 /** This slot is called by the internal timer, to signal a
@@ -254,7 +398,7 @@ void Vario::slotTimeout()
 {
   // Reset all to defaults, due to no new data have arrived over the
   // whole integration period and the measurement is senseless now.
-  m_sampleList.clear();
+  reset();
   Speed lift;
   emit newVario( lift );
 }
@@ -271,6 +415,9 @@ void Vario::slotNewTEKMode( bool newMode )
 {
   // qDebug("Vario::slotNewTEKMode=%d", newMode );
   m_TEKOn = newMode;
+
+  // The stored altitudes are computed with the former mode.
+  reset();
 }
 
 void Vario::slotNewTEKAdjust(int adjust)
@@ -278,3 +425,12 @@ void Vario::slotNewTEKAdjust(int adjust)
   // qDebug("Vario::slotNewTEKAdjust");
   m_TekAdjust = (double)((100.0 + adjust) / 100.0);
 }
+
+void Vario::slotNewFilter( int newFilter )
+{
+  // qDebug("Vario::slotNewFilter=%d", newFilter );
+  m_filter = newFilter == KalmanFilter ? KalmanFilter : WindowFilter;
+
+  // The stored values belong to the former filter.
+  reset();
+}
@@ -23,7 +23,11 @@
  *
  * \brief Variometer calculations.
  *
- * This class executes the variometer calculations.
+ * This class executes the variometer calculations. The lift is either the
+ * mean climb rate over a sliding time window, that is kept up to date by
+ * running sums, or the climb rate state of a Kalman filter, which fuses GPS
+ * and pressure altitudes. If a glider polar is available, also the netto and
+ * the relative variometer values are provided.
  *
  *\date 2002-2013
  */
@@ -35,7 +39,6 @@
 #include <QTimer>
 
 #include "altitude.h"
-#include "limitedlist.h"
 #include "speed.h"
 
 /** Default integration time in seconds for variometer calculation. */
@@ -51,6 +54,15 @@ class Vario: public QObject
 
 public:
 
+  /**
+   * The variometer filters, which can be selected in the configuration.
+   */
+  enum Filter
+  {
+    WindowFilter = 0,
+    KalmanFilter = 1
+  };
+
   Vario( QObject* object );
 
   virtual ~Vario();
@@ -67,6 +79,15 @@ public:
    */
   void newPressureAltitude( const Altitude& altitude, const Speed& tas );
 
+  /**
+   * @return true, if GPS and pressure altitudes are fused. Then both kinds
+   * of altitudes should be passed.
+   */
+  bool isFusing() const
+  {
+    return m_filter == KalmanFilter;
+  };
+
 public slots:
 
   /**
@@ -90,6 +111,13 @@ public slots:
    */
   void slotNewTEKAdjust(int newAdjust);
 
+  /**
+   * This slot is called, if the filter has been changed in the UI.
+   *
+   * @param newFilter new filter, see \ref Filter
+   */
+  void slotNewFilter(int newFilter);
+
 signals:
 
   /**
@@ -99,31 +127,154 @@ signals:
    */
   void newVario(const Speed& newLift);
 
+  /**
+   * This signal is emitted after newVario. The passed values are invalid,
+   * if the glider polar or the airspeed are unknown.
+   *
+   * @param netto vertical movement of the air mass
+   * @param relative lift, which would be achieved when circling with minimum sink
+   */
+  void newNettoVario(const Speed& netto, const Speed& relative);
+
 private:
 
+  /** The sources of altitude values. */
+  enum Source
+  {
+    NoSource,
+    GpsSource,
+    PressureSource
+  };
+
+  /**
+   * Mean of the climb rates of the sample pairs, which lie in a time window.
+   * Pairs enter at the newest end and leave at the oldest end, the sum of the
+   * rates is kept up to date by that. So the mean costs O(1) per sample
+   * independent of the window length.
+   */
+  class SlidingWindow
+  {
+   public:
+
+    SlidingWindow();
+
+    /**
+     * Adds the climb rate of a sample pair.
+     *
+     * @param timeStamp time of the older sample of the pair in ms
+     * @param rate climb rate of the pair in m/s
+     */
+    void add( const qint64 timeStamp, const double rate );
+
+    /** Removes all pairs, whose older sample is older than limit. */
+    void expire( const qint64 limit );
+
+    void clear();
+
+    int count() const
+    {
+      return m_count;
+    };
+
+    double mean() const
+    {
+      return m_count > 0 ? m_sum / m_count : 0.0;
+    };
+
+   private:
+
+    /** Enough for 60s of 50Hz pressure altitudes. */
+    enum { Capacity = 4096 };
+
+    void removeOldest();
+
+    qint64 m_timeStamps[Capacity];
+    double m_rates[Capacity];
+    int    m_head;
+    int    m_count;
+    double m_sum;
+  };
+
+  /**
+   * Kalman filter with the states altitude, climb rate and the offset of the
+   * pressure altitude to the GPS altitude.
+   */
+  class KalmanFilter3
+  {
+   public:
+
+    KalmanFilter3();
+
+    void reset();
+
+    /**
+     * Predicts the state to the passed time and corrects it by the passed
+     * altitude.
+     *
+     * @param timeStamp time of the measurement in ms
+     * @param altitude measured altitude in meters
+     * @param pressure true for a pressure altitude, false for a GPS altitude
+     * @param accelNoise spectral density of the vertical acceleration
+     */
+    void update( const qint64 timeStamp, const double altitude,
+                 const bool pressure, const double accelNoise );
+
+    bool isValid() const
+    {
+      return m_valid;
+    };
+
+    double climbRate() const
+    {
+      return m_x[1];
+    };
+
+   private:
+
+    bool   m_valid;
+    qint64 m_timeStamp;
+    double m_x[3];
+    double m_p[3][3];
+  };
+
+  /**
+   * Processes a new altitude of the passed source.
+   *
+   * @param source the source of the altitude
+   * @param altitude the altitude in meters, energy compensated if required
+   * @param timeStamp time of the altitude in ms
+   * @param noiseLimit smaller climb rates of a pair are taken as zero
+   * @param minPairs minimum number of pairs in the window for a result
+   * @param airspeed airspeed for the netto calculation in m/s, can be zero
+   */
+  void process( const Source source,
+                const double altitude,
+                const qint64 timeStamp,
+                const double noiseLimit,
+                const int minPairs,
+                const double airspeed );
+
+  /** Emits the netto and relative variometer values, if possible. */
+  void emitNetto( const double lift, const double airspeed );
+
+  /** Resets the filter states. */
+  void reset();
+
   QTimer  m_timeOut; // calling supervision timer
   qint64  m_intTime; // integration time in ms
   bool    m_TEKOn;   // TEK compensated Mode
   double  m_energyAlt; // v*v/2g
   double  m_TekAdjust; // adjust TEK Compensation
+  Filter  m_filter;  // selected filter
 
-  class AltSample
-  {
-   public:
-
-    AltSample() :
-      altitude(0.0),
-      tas(0.0),
-      timeStamp(0)
-    {};
+  // Source, time and altitude of the last processed sample
+  Source  m_lastSource;
+  qint64  m_lastTime;
+  double  m_lastAltitude;
 
-    double altitude;  // unit is meters
-    double tas;       // unit is meters per second
-    qint64 timeStamp; // unit is milliseconds since the epoch
-  };
+  SlidingWindow m_window;
 
-  // List of altitude samples
-  LimitedList<AltSample> m_sampleList;
+  KalmanFilter3 m_kalman;
 
 private slots:
 
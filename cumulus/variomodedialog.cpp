@@ -102,6 +102,12 @@ VarioModeDialog::VarioModeDialog(QWidget *parent) :
 
   //---------------------------------------------------------------------
 
+  kalman = new QCheckBox (tr("Kalman Filter"), this);
+  kalman->setFocusPolicy(Qt::NoFocus);
+  gridLayout->addWidget(kalman, row++, 0, 1, 2);
+
+  //---------------------------------------------------------------------
+
   pplus   = new QPushButton("++", this);
   plus    = new QPushButton("+", this);
   mminus  = new QPushButton("--", this);
@@ -166,6 +172,7 @@ VarioModeDialog::VarioModeDialog(QWidget *parent) :
 
   connect(timer, SIGNAL(timeout()), this, SLOT(reject()));
   connect(tek,   SIGNAL(toggled(bool)), this, SLOT(slot_tekChanged(bool)));
+  connect(kalman, SIGNAL(toggled(bool)), timer, SLOT(stop()));
 
   connect (ok,     SIGNAL(released()), this, SLOT(slot_accept()));
   connect (cancel, SIGNAL(released()), this, SLOT(slot_reject()));
@@ -242,6 +249,8 @@ void VarioModeDialog::load()
   m_TEKAdjust = conf->getVarioTekAdjust();
   emit newTEKAdjust( m_TEKAdjust );
 
+  m_filter = conf->getVarioFilter();
+
   // let us take the user's defined info display time
   m_timeout = conf->getInfoDisplayTime();
 
@@ -249,6 +258,7 @@ void VarioModeDialog::load()
   spinTime->setValue( m_intTime );
   spinTEK->setValue( m_TEKAdjust );
   tek->setChecked( m_TEKComp );
+  kalman->setChecked( m_filter == Vario::KalmanFilter );
 
   slot_tekChanged( m_TEKComp );
 
@@ -276,6 +286,15 @@ void VarioModeDialog::save()
       emit newTEKAdjust( m_TEKAdjust );
     }
 
+  int filter = kalman->isChecked() ? Vario::KalmanFilter : Vario::WindowFilter;
+
+  if( filter != m_filter )
+    {
+      m_filter = filter;
+      conf->setVarioFilter( m_filter );
+      emit newFilter( m_filter );
+    }
+
   emit newVarioTime( spinTime->value() );
   conf->save();
 }
@@ -124,6 +124,13 @@ signals:
    */
   void newTEKAdjust(int newAdjust);
 
+  /**
+   * This signal is emitted, if the variometer filter has been changed.
+   *
+   * @param newFilter new filter, see Vario::Filter
+   */
+  void newFilter(int newFilter);
+
   /**
    * This signal is emitted, when the dialog is closed
    */
@@ -140,6 +147,7 @@ private:
   QSpinBox*    spinTime;
   QSpinBox*    spinTEK;
   QCheckBox*   tek;
+  QCheckBox*   kalman;
   QLabel*      TekAdj;
 
   QPushButton *plus;
@@ -155,6 +163,7 @@ private:
   int     m_intTime;
   bool    m_TEKComp;
   int     m_TEKAdjust;
+  int     m_filter;
 
   /** Auto sip flag storage. */
   bool m_autoSip;
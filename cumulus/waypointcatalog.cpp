@@ -15,6 +15,8 @@
  **
  ***********************************************************************/
 
+#include <cctype>
+#include <cstring>
 #include <unistd.h>
 
 #include <QtGui>
@@ -22,6 +24,7 @@
 
 #include "distance.h"
 #include "generalconfig.h"
+#include "loaderpool.h"
 #include "OpenAip.h"
 #include "mainwindow.h"
 #include "mapcalc.h"
@@ -45,7 +48,8 @@ extern MapMatrix* _globalMapMatrix;
 WaypointCatalog::WaypointCatalog() :
   _type(All),
   _radius(-1),
-  _showProgress(false)
+  _showProgress(false),
+  _codec(0)
 {
 }
 
@@ -1104,313 +1108,458 @@ int WaypointCatalog::readBgaDos( QString catalog,
       return 0;
     }
 
-  if (! file.open(QIODevice::ReadOnly | QIODevice::Text))
+  int wpCount = importTextFile( catalog, BgaDos, wpList );
+
+  if( wpCount == -1 )
     {
       errorInfo = QObject::tr("Cannot open File!");
-      return -1;
     }
 
-  QSet<QString> namesInUse;
-  int lineNo = 0;
-  int wpCount = 0;
+  return wpCount;
+}
 
-  WaitScreen *ws = static_cast<WaitScreen *>(0);
+/**
+ * Reads a Cambridge Aero Instruments or a Winpilot turnpoint file.
+ *
+ * \param catalog Catalog file name with directory path.
+ *
+ * \param wpList Waypoint list where the read waypoints are stored. If the
+ *               wpList is NULL, waypoints are counted only.
+ *
+ * \return Number of read waypoints. In error case -1.
+ */
+int WaypointCatalog::readDat( QString catalog, QList<Waypoint>* wpList )
+{
+  // Found a file format description here:
+  // http://www.gregorie.org/gliding/pna/cai_format.html
+  qDebug() << "WaypointCatalog::readDat" << catalog;
 
-  if( _showProgress )
+  QFile file(catalog);
+
+  if(!file.exists())
     {
-      ws = new WaitScreen( MainWindow::mainWindow() );
+      return -1;
+    }
 
-#ifdef ANDROID
-      // The waitscreen is not centered over the parent and not limited in
-      // its size under Android. Therefore this must be done by our self.
-      ws->setGeometry ( MainWindow::mainWindow()->width() / 2 - 250,
-                        MainWindow::mainWindow()->height() / 2 - 75,
-                        500, 150 );
-#endif
+  if(file.size() == 0)
+    {
+      return 0;
+    }
 
-      ws->slot_SetText1( QObject::tr("Reading file") );
-      ws->slot_SetText2( QFileInfo(catalog).fileName() );
-      QCoreApplication::processEvents( QEventLoop::ExcludeUserInputEvents|
-                                       QEventLoop::ExcludeSocketNotifiers );
+  return importTextFile( catalog, Dat, wpList );
+}
+
+/** read a waypoint catalog from a SeeYou cup file, only waypoint part */
+int WaypointCatalog::readCup( QString catalog, QList<Waypoint>* wpList )
+{
+  QFile file(catalog);
+
+  if( ! file.exists() )
+    {
+      return -1;
     }
 
-  QTextStream in(&file);
-  in.setCodec( "ISO 8859-15" );
+  if( file.size() == 0 )
+    {
+      return 0;
+    }
 
-  // Only 25 animations should be done because the animation is a performance
-  // blocker.
-  int wsMove = file.size() / 25;
-  int nextWsMove = wsMove;
-  int curPos = 0;
+  return importTextFile( catalog, Cup, wpList );
+}
 
-  /**
-    The DOS format is as follows.
+/**
+ * Part of a text line, points into the file data.
+ */
+struct TextField
+{
+  const char* data;
+  int size;
+};
 
-     0. Full Name
-     1. TriGraph
-     2. Category for findability (A-D) and airspace # and ##
-     3. Exact point
-     4. Description & Remarks
-     5. Dist from main feature, NMl
-     6. Direction from main feature
-     7. Main feature (one of several large towns and cities used as locators)
-     8. Grid ref km East and N of OS Datum
-     9. Lat/Long to WGS84 Geodetic Datum
-    10. Altitude (in Feet, accuracy not Guaranteed)
-    11. TriGraph
+static inline bool isSpace( const char c )
+{
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
 
-     0. Aboyne Bridge
-     1. AB1
-     2. A
-     3. Road Br over R Dee
-     4. S side of village bet A93 and B976, 2NMl E of airfield, under CTA base 3000
-     5. 22
-     6. W
-     7. Aberdeen
-     8. 352.36 797.96
-     9. 57 04.213N 002 47.239W
-    10. 450
-    11. AB1
-  */
+/** Removes white spaces at the begin and at the end. */
+static TextField trimmed( const char* data, int size )
+{
+  while( size > 0 && isSpace( *data ) )
+    {
+      data++;
+      size--;
+    }
 
-  while( true )
+  while( size > 0 && isSpace( data[size - 1] ) )
     {
-      QStringList record;
-      int readLines;
-      int start = lineNo + 1;
+      size--;
+    }
 
-      for( readLines = 0; readLines < 13; readLines++ )
-        {
-          QString line = in.readLine();
-          curPos += line.size() + 2;
-          record << line.trimmed();
-          lineNo++;
+  TextField field = { data, size };
+  return field;
+}
 
-          if( in.atEnd() )
-            {
-              break;
-            }
-        }
+/** Works like QString::mid. */
+static TextField mid( const TextField& field, int pos, int len=-1 )
+{
+  pos = qBound( 0, pos, field.size );
 
-      if( record.size() < 12 )
-        {
-          // EOF is reached
-          break;
-        }
+  if( len < 0 || pos + len > field.size )
+    {
+      len = field.size - pos;
+    }
 
-      if( _showProgress && curPos >= nextWsMove )
-        {
-          nextWsMove += wsMove;
-          ws->slot_Progress( 2 );
-          QCoreApplication::processEvents( QEventLoop::ExcludeUserInputEvents |
-                                           QEventLoop::ExcludeSocketNotifiers );
-        }
+  TextField part = { field.data + pos, len };
+  return part;
+}
 
-      if( record[1] != record[11] )
+/** Compares a field case insensitive with a lower case string. */
+static bool equals( const TextField& field, const char* lower )
+{
+  int i = 0;
+
+  for( ; i < field.size; i++ )
+    {
+      if( lower[i] == '\0' || tolower( field.data[i] ) != lower[i] )
         {
-          // Filter out corrupted lines
-          qWarning("DOS Read (%d): Short code unequal final code", start );
-          continue;
+          return false;
         }
+    }
+
+  return lower[i] == '\0';
+}
 
-      if( record[0].isEmpty() ||
-          record[1].isEmpty() ||
-          record[2].isEmpty() ||
-          record[9].isEmpty() ||
-          record[10].isEmpty() ||
-          record[11].isEmpty() )
+static bool equals( const TextField& f1, const TextField& f2 )
+{
+  return f1.size == f2.size && memcmp( f1.data, f2.data, f1.size ) == 0;
+}
+
+/** @return The last character in upper case or null, if the field is empty. */
+static char lastUpper( const TextField& field )
+{
+  return field.size > 0 ? toupper( field.data[field.size - 1] ) : '\0';
+}
+
+/** @return The index of the first character, which is contained in chars. */
+static int indexOfAny( const TextField& field, const char* chars )
+{
+  for( int i = 0; i < field.size; i++ )
+    {
+      if( field.data[i] != '\0' && strchr( chars, field.data[i] ) != 0 )
         {
-          qWarning( "DOS Read (%d): Record contains too less elements! Ignoring it.",
-                    start );
-          continue;
+          return i;
         }
+    }
 
-      Waypoint wp;
+  return -1;
+}
 
-      wp.type = BaseMapElement::Landmark;
-      wp.priority = Waypoint::Low;
-      wp.country = GeneralConfig::instance()->getHomeCountryCode();
+/**
+ * Converts a decimal number like 123.45 to a double. Exponents are not
+ * supported. In opposite to strtod the conversion does not depend on the
+ * locale.
+ */
+static bool toDouble( const TextField& field, double& value )
+{
+  TextField f = trimmed( field.data, field.size );
 
-      // Name is composed from TriGraph "-" and Category for findability (A-D)
-      // and airspace # and ##
-      wp.name = record[1] + "-" + record[2];
+  const char* p = f.data;
+  const char* end = f.data + f.size;
 
-      // Short name of a waypoint has only 8 characters and upper cases in Cumulus.
-      wp.name = wp.name.left(8).toUpper().trimmed();
-      wp.description = record[0];
+  bool negative = false;
 
-      // latitude and longitude as 57 04.213N 002 47.239W
-      QStringList latlon = record[9].split(" ");
+  if( p < end && (*p == '-' || *p == '+') )
+    {
+      negative = (*p == '-');
+      p++;
+    }
 
-      if( latlon.size() != 4 )
-        {
-          qWarning("DOS Read (%d): Format error WGS84 geodetic datum", start);
-          continue;
-        }
+  double result = 0.0;
+  int digits = 0;
 
-      bool ok;
+  while( p < end && *p >= '0' && *p <= '9' )
+    {
+      result = result * 10.0 + (*p++ - '0');
+      digits++;
+    }
 
-      // Extract latitude
-      double degree = latlon[0].toDouble(&ok);
+  if( p < end && *p == '.' )
+    {
+      p++;
+      double factor = 0.1;
 
-      if( ! ok )
+      while( p < end && *p >= '0' && *p <= '9' )
         {
-          qWarning("DOS Read (%d): Format error degree WGS84 latitude", start);
-          continue;
+          result += (*p++ - '0') * factor;
+          factor *= 0.1;
+          digits++;
         }
+    }
 
-      double minutes = latlon[1].left(latlon[1].size() - 1 ).toDouble(&ok);
+  if( digits == 0 || p != end )
+    {
+      return false;
+    }
 
-      if( ! ok )
-        {
-          qWarning("DOS Read (%d): Format error minutes WGS84 latitude", start);
-          continue;
-        }
+  value = negative ? -result : result;
+  return true;
+}
+
+static bool toInt( const TextField& field, int& value )
+{
+  TextField f = trimmed( field.data, field.size );
+
+  const char* p = f.data;
+  const char* end = f.data + f.size;
+
+  bool negative = false;
+
+  if( p < end && (*p == '-' || *p == '+') )
+    {
+      negative = (*p == '-');
+      p++;
+    }
+
+  if( p == end )
+    {
+      return false;
+    }
 
-      double latTmp = (degree * 600000.) + (10000. * minutes);
+  int result = 0;
 
-      if( latlon[1].right(1).toUpper() == "S" )
+  while( p < end )
+    {
+      if( *p < '0' || *p > '9' || result > 100000000 )
         {
-          latTmp = -latTmp;
+          return false;
         }
 
-      // Extract longitude
-      degree = latlon[2].toDouble(&ok);
+      result = result * 10 + (*p++ - '0');
+    }
+
+  value = negative ? -result : result;
+  return true;
+}
+
+/**
+ * Converts a field into a string. Quotation marks are removed on request.
+ */
+static QString toString( QTextCodec* codec,
+                         const TextField& field,
+                         const bool unquote=false )
+{
+  QString string = codec ? codec->toUnicode( field.data, field.size )
+                         : QString::fromLatin1( field.data, field.size );
+
+  if( unquote && string.contains( QChar('"') ) )
+    {
+      string.remove( QChar('"') );
+    }
+
+  return string;
+}
+
+/** @return The field content for a warning message. */
+static QByteArray bytes( const TextField& field )
+{
+  return QByteArray( field.data, field.size );
+}
+
+/**
+ * Splits a line into its fields. The fields are trimmed. If quotes are
+ * enabled, a field can be enclosed in quotation marks and can then contain
+ * the separator. The enclosing quotation marks are removed.
+ *
+ * \return The number of fields, from which at most maxFields are stored. In
+ *         case of a missing end quote -1.
+ */
+static int splitLine( const TextField& line,
+                      const char separator,
+                      const bool quotes,
+                      TextField* fields,
+                      const int maxFields )
+{
+  const char* p = line.data;
+  const char* end = line.data + line.size;
+  int count = 0;
+
+  while( true )
+    {
+      const char* start = p;
 
-      if( ! ok )
+      while( p < end && isSpace( *p ) )
         {
-          qWarning("DOS Read (%d): Format error degree WGS84 longitude", start);
-          continue;
+          p++;
         }
 
-      minutes = latlon[3].left(latlon[3].size() - 1 ).toDouble(&ok);
-
-      if( ! ok )
+      if( quotes && p < end && *p == '"' )
         {
-          qWarning("DOS Read (%d): Format error minutes WGS84 longitude", start);
-          continue;
+          // A comma inside a quoted string is no separator.
+          const char* quote = static_cast<const char *>
+                              ( memchr( p + 1, '"', end - p - 1 ) );
+
+          if( quote == 0 )
+            {
+              return -1;
+            }
+
+          p = quote;
         }
 
-      double lonTmp = (degree * 600000.) + (10000. * minutes);
+      const char* sep = static_cast<const char *>( memchr( p, separator, end - p ) );
+      const char* fieldEnd = sep ? sep : end;
 
-      if( latlon[3].right(1).toUpper() == "W" )
+      if( count < maxFields )
         {
-          lonTmp = -lonTmp;
+          TextField f = trimmed( start, fieldEnd - start );
+
+          if( quotes && f.size >= 2 && f.data[0] == '"' && f.data[f.size - 1] == '"' )
+            {
+              f.data++;
+              f.size -= 2;
+            }
+
+          fields[count] = f;
         }
 
-      wp.wgsPoint.setLat((int) rint(latTmp));
-      wp.wgsPoint.setLon((int) rint(lonTmp));
+      count++;
 
-      // Check radius filter
-      if( ! takePoint( wp.wgsPoint ) )
+      if( sep == 0 )
         {
-          // Distance is greater than the defined radius around the center point.
-          continue;
+          return count;
         }
 
-      // Sets the projected coordinates
-      wp.projPoint = _globalMapMatrix->wgsToMap( wp.wgsPoint );
+      p = sep + 1;
+    }
+}
 
-      // Altitude (in Feet, accuracy not Guaranteed)
-      float tmpElev = record[10].toFloat(&ok);
+/** Splits a field into its words, which are separated by white spaces. */
+static int splitWords( const TextField& line, TextField* words, const int maxWords )
+{
+  const char* p = line.data;
+  const char* end = line.data + line.size;
+  int count = 0;
 
-      if( ! ok )
+  while( true )
+    {
+      while( p < end && isSpace( *p ) )
         {
-          qWarning("DOS Read (%d): Error reading elevation value '%s'.",
-                    start, record[10].toLatin1().data());
-          continue;
+          p++;
         }
 
-      // Convert feet to meters
-      wp.elevation = tmpElev * 0.3048;
-
-      // Check filter, if type should be taken
-      if( ! takeType( (enum BaseMapElement::objectType) wp.type ) )
+      if( p == end )
         {
-          continue;
+          return count;
         }
 
-      wp.comment = record[3] + "\n\n" + record[4];
+      const char* start = p;
 
-      // We do check, if the waypoint name is already in use because DAT
-      // short names are not always unique.
-      if( wpList && namesInUse.contains( wp.name ) )
+      while( p < end && ! isSpace( *p ) )
         {
-          for( int i = 0; i < 100; i++ )
-            {
-              // Hope that not more as 100 same names will be exist.
-              QString number = QString::number(i);
-               wp.name = wp.name.left(wp.name.size() - number.size()) + number;
-
-              if( namesInUse.contains( wp.name ) == false )
-                {
-                  break;
-                }
-            }
+          p++;
         }
 
-      if( wpList )
+      if( count < maxWords )
         {
-          // Add waypoint to list
-          wp.wpListMember = true;
-          wpList->append( wp );
+          words[count].data = start;
+          words[count].size = p - start;
         }
 
-      wpCount++;
+      count++;
+    }
+}
 
-      // Store used waypoint name in set.
-      namesInUse.insert( wp.name );
+/**
+ * Parses a line aligned chunk of a waypoint text file in a worker thread.
+ */
+class WaypointParseJob : public LoaderPool::Job
+{
+ public:
+
+  WaypointParseJob( WaypointCatalog* catalog,
+                    const enum WaypointCatalog::TextFormat format,
+                    const char* data,
+                    const int size,
+                    const int firstLine ) :
+    m_catalog(catalog),
+    m_format(format),
+    m_data(data),
+    m_size(size),
+    m_firstLine(firstLine)
+  {
+  };
+
+  virtual ~WaypointParseJob()
+  {
+  };
+
+  /** The parsed waypoints of the chunk. */
+  QList<Waypoint> list;
+
+ protected:
+
+  bool work()
+  {
+    m_catalog->parseChunk( m_format, m_data, m_size, m_firstLine, list );
+    return true;
+  };
+
+ private:
+
+  WaypointCatalog* m_catalog;
+  enum WaypointCatalog::TextFormat m_format;
+  const char* m_data;
+  int m_size;
+  int m_firstLine;
+};
+
+int WaypointCatalog::importTextFile( const QString& catalog,
+                                     const enum TextFormat format,
+                                     QList<Waypoint>* wpList )
+{
+  QFile file(catalog);
+
+  if( ! file.open( QIODevice::ReadOnly ) )
+    {
+      return -1;
     }
 
-  file.close();
+  LoaderPool pool( "WPI" );
+  pool.startStage( "map" );
 
-  if( _showProgress )
+  // The file is mapped into the memory. Reading the whole file is only a
+  // fallback, if mapping is not supported.
+  QByteArray content;
+  const char* data = reinterpret_cast<const char *>( file.map( 0, file.size() ) );
+  int size = file.size();
+
+  if( data == 0 )
     {
-      ws->setVisible( false );
-      QCoreApplication::processEvents( QEventLoop::ExcludeUserInputEvents|
-                                       QEventLoop::ExcludeSocketNotifiers );
-      delete ws;
+      content = file.readAll();
+      data = content.constData();
+      size = content.size();
     }
 
-  return wpCount;
-}
+  if( format == Cup )
+    {
+      // The task part of a cup file is ignored.
+      QByteArray raw = QByteArray::fromRawData( data, size );
+      int idx = raw.indexOf( "-----Related Tasks-----" );
 
-/**
- * Reads a Cambridge Aero Instruments or a Winpilot turnpoint file.
- *
- * \param catalog Catalog file name with directory path.
- *
- * \param wpList Waypoint list where the read waypoints are stored. If the
- *               wpList is NULL, waypoints are counted only.
- *
- * \return Number of read waypoints. In error case -1.
- */
-int WaypointCatalog::readDat( QString catalog, QList<Waypoint>* wpList )
-{
-  // Found a file format description here:
-  // http://www.gregorie.org/gliding/pna/cai_format.html
-  qDebug() << "WaypointCatalog::readDat" << catalog;
-
-  QFile file(catalog);
-
-  if(!file.exists())
-    {
-      return -1;
-    }
-
-  if(file.size() == 0)
-    {
-      return 0;
-    }
+      while( idx > 0 && data[idx - 1] != '\n' )
+        {
+          idx = raw.indexOf( "-----Related Tasks-----", idx + 1 );
+        }
 
-  if (! file.open(QIODevice::ReadOnly | QIODevice::Text))
-    {
-      return -1;
+      if( idx >= 0 )
+        {
+          size = idx;
+        }
     }
 
-  QSet<QString> namesInUse;
-  int lineNo = 0;
-  int wpCount = 0;
+  // The jobs read these members only.
+  _homeCountry = GeneralConfig::instance()->getHomeCountryCode();
+  _codec = QTextCodec::codecForName( "ISO 8859-15" );
 
   WaitScreen *ws = static_cast<WaitScreen *>(0);
 
@@ -1432,837 +1581,859 @@ int WaypointCatalog::readDat( QString catalog, QList<Waypoint>* wpList )
                                        QEventLoop::ExcludeSocketNotifiers );
     }
 
-  // Estimate the number of entries in the file. The basic assumption is, that
-  // a single line is approximately 60 characters long. Only 20 animations
-  // should be done because the animation is a performance blocker.
-  int wsCycles = (file.size() / 60) / 20;
+  // Split the data into line aligned chunks. Some chunks per thread keep
+  // the workers busy, also if the line lengths differ. A BGA DOS record
+  // consists of several lines, which must not be separated.
+  pool.startStage( "split" );
 
-  if( wsCycles == 0 )
-    {
-      // avoid division by zero!
-      wsCycles++;
-    }
+  const int chunkSize = qMax( 64 * 1024, size / (LoaderPool::maxThreads() * 4) + 1 );
+  const int recordLines = (format == BgaDos) ? BgaDosRecordLines : 1;
 
-  QTextStream in(&file);
-  in.setCodec( "ISO 8859-15" );
+  const char* end = data + size;
+  const char* chunk = data;
+  const char* pos = data;
+  int chunkLine = 1;
+  int lines = 0;
 
-  while (!in.atEnd())
+  while( pos < end )
     {
-      QString line = in.readLine().trimmed();
+      const char* nl = static_cast<const char *>( memchr( pos, '\n', end - pos ) );
+      pos = nl ? nl + 1 : end;
+      lines++;
 
-      lineNo++;
+      if( (pos - chunk >= chunkSize && (lines % recordLines) == 0) || pos == end )
+        {
+          pool.addJob( new WaypointParseJob( this, format, chunk, pos - chunk, chunkLine ) );
+          chunkLine += lines;
+          lines = 0;
+          chunk = pos;
+        }
+    }
 
-      if( _showProgress && (lineNo % wsCycles) == 0 )
+  // Parse all chunks in parallel and animate the wait screen meanwhile.
+  pool.start();
+
+  while( pool.waitForJobs( 100 ) < pool.jobs().size() )
+    {
+      if( _showProgress )
         {
           ws->slot_Progress( 2 );
           QCoreApplication::processEvents( QEventLoop::ExcludeUserInputEvents|
                                            QEventLoop::ExcludeSocketNotifiers );
         }
+    }
 
-      if( line.size() == 0 || line.startsWith("*") )
-        {
-          // Filter out empty and comment lines
-          continue;
-        }
-
-      bool ok;
-      QStringList list = line.split( "," );
-
-      /*
-      Example turnpoints, two possible coordinate formats seems to be in use.
-      0 ,1         ,2          ,3   ,4,5           ,6
-      31,57:04.213N,002:47.239W,450F,T,AB1 AboynBrg,RdBroverRDee
-
-      0,1        ,2         ,3  ,4  ,5           ,6
-      1,52:08:39N,012:40:06E,66M,HAS,SP1 LUESSE  ,EDOJ
-      */
+  // Merge the results in file order. A waypoint, which repeats an already
+  // taken waypoint with the same name and position, is dropped. Other
+  // waypoints with an already used name get a number suffix, because the
+  // short names are not always unique.
+  pool.startStage( "merge" );
 
-      // Lines defining a turnpoint contain 7 fields, separated by commas.
-      // The final field is terminated by the newline. Field 7 is optional.
-      if( list.size() < 6 )
-        {
-          qWarning( "DAT Read (%d): Line contains too less elements! Ignoring it.",
-                    lineNo );
-          continue;
-        }
+  QSet<QString> namesInUse;
+  QSet< QPair<QString, qint64> > taken;
+  int wpCount = 0;
 
-      Waypoint wp;
+  const QList<LoaderPool::Job *>& jobs = pool.jobs();
 
-      wp.priority = Waypoint::Low;
-      wp.country = GeneralConfig::instance()->getHomeCountryCode();
+  for( int i = 0; i < jobs.size(); i++ )
+    {
+      QList<Waypoint>& list = static_cast<WaypointParseJob *>( jobs.at(i) )->list;
 
-      if( list[1].size() < 9 )
+      if( wpList )
         {
-          qWarning("DAT Read (%d): Format error latitude", lineNo);
-          continue;
+          wpList->reserve( wpList->size() + list.size() );
         }
 
-      // latitude as 57:04.213N|S or 52:08:39N|S
-      double degree = list[1].left(2).toDouble(&ok);
-
-      if( ! ok )
+      for( int j = 0; j < list.size(); j++ )
         {
-          qWarning("DAT Read (%d): Format error latitude degree", lineNo);
-          continue;
-        }
+          Waypoint& wp = list[j];
 
-      double minutes = 0.0;
-      double seconds = 0.0;
-
-      if( list[1][5] == QChar('.') )
-        {
-          minutes = list[1].mid(3, 6).toDouble(&ok);
-        }
-      else if( list[1][5] == QChar(':') )
-        {
-          minutes = list[1].mid(3, 2).toDouble(&ok);
+          QPair<QString, qint64> key( wp.name,
+                                      (qint64(wp.wgsPoint.lat()) << 32) |
+                                       quint32(wp.wgsPoint.lon()) );
 
-          if( ok )
+          if( taken.contains( key ) )
             {
-              seconds = list[1].mid(6, 2).toDouble(&ok);
+              continue;
             }
-        }
 
-      if( ! ok )
-        {
-          qWarning("DAT Read (%d): Format error latitude minutes/seconds", lineNo);
-          continue;
-        }
+          taken.insert( key );
 
-      double latTmp = (degree * 600000.) + (10000. * (minutes + seconds / 60. ));
+          if( wpList && namesInUse.contains( wp.name ) )
+            {
+              for( int k = 0; k < 100; k++ )
+                {
+                  // Hope that not more as 100 same names will be exist.
+                  QString number = QString::number(k);
+                   wp.name = wp.name.left(wp.name.size() - number.size()) + number;
 
-      if( list[1].right(1).toUpper() == "S" )
-        {
-          latTmp = -latTmp;
-        }
+                  if( namesInUse.contains( wp.name ) == false )
+                    {
+                      break;
+                    }
+                }
+            }
 
-      // longitude as 002:47.239E|W or 012:40:06E|W
-      if( list[2].size() < 10 )
-        {
-          qWarning("DAT Read (%d): Format error longitude", lineNo);
-          continue;
-        }
+          if( wpList )
+            {
+              // Sets the projected coordinates and adds the waypoint to the list
+              wp.projPoint = _globalMapMatrix->wgsToMap( wp.wgsPoint );
+              wp.wpListMember = true;
+              wpList->append( wp );
+            }
 
-      degree = list[2].left(3).toDouble(&ok);
+          wpCount++;
 
-      if( ! ok )
-        {
-          qWarning("DAT Read (%d): Format error longitude degree", lineNo);
-          continue;
+          // Store used waypoint name in set.
+          namesInUse.insert( wp.name );
         }
 
-      minutes = 0.0;
-      seconds = 0.0;
+      list.clear();
+    }
 
-      if( list[2][6] == QChar('.') )
-        {
-          minutes = list[2].mid(4, 6).toDouble(&ok);
-        }
-      else if( list[2][6] == QChar(':') )
-        {
-          minutes = list[2].mid(4, 2).toDouble(&ok);
+  pool.finish();
 
-          if( ok )
-            {
-              seconds = list[2].mid(7, 2).toDouble(&ok);
-            }
-        }
+  file.close();
 
-      if( ! ok )
-        {
-          qWarning("DAT Read (%d): Format error longitude minutes/seconds", lineNo);
-          continue;
-        }
+  if( _showProgress )
+    {
+      ws->setVisible( false );
+      QCoreApplication::processEvents( QEventLoop::ExcludeUserInputEvents|
+                                       QEventLoop::ExcludeSocketNotifiers );
+      delete ws;
+    }
 
-      double lonTmp = (degree * 600000.) + (10000. * (minutes + seconds / 60. ));
+  return wpCount;
+}
 
+void WaypointCatalog::parseChunk( const enum TextFormat format,
+                                  const char* data,
+                                  const int size,
+                                  const int firstLine,
+                                  QList<Waypoint>& list )
+{
+  const char* end = data + size;
+  const char* pos = data;
+  int lineNo = firstLine;
 
-      if( list[2].right(1).toUpper() == "W" )
-        {
-          lonTmp = -lonTmp;
-        }
+  TextField record[BgaDosRecordLines];
+  int recordLines = 0;
 
-      wp.wgsPoint.setLat((int) rint(latTmp));
-      wp.wgsPoint.setLon((int) rint(lonTmp));
+  while( pos < end )
+    {
+      const char* nl = static_cast<const char *>( memchr( pos, '\n', end - pos ) );
+      const char* lineEnd = nl ? nl : end;
 
-      // Check radius filter
-      if( ! takePoint( wp.wgsPoint ) )
-        {
-          // Distance is greater than the defined radius around the center point.
-          continue;
-        }
+      TextField line = trimmed( pos, lineEnd - pos );
+      pos = nl ? nl + 1 : end;
 
-      // Sets the projected coordinates
-      wp.projPoint = _globalMapMatrix->wgsToMap( wp.wgsPoint );
+      Waypoint wp;
 
-      // Height AMSL 9{1,5}[FM] 9=height, F=feet, M=metres.
-      // two units are possible:
-      // o meter: m
-      // o feet:  ft
-      if( list[3].size() ) // elevation in meter or feet
+      switch( format )
         {
-          QString unit = list[3].right(1).toUpper();
-
-          if( unit != "F" && unit != "M" )
-            {
-              qWarning("DAT Read (%d): Error reading elevation unit '%s'.",
-                       lineNo, list[3].toLatin1().data());
-              continue;
-            }
+          case Cup:
 
-          float tmpElev = list[3].left(list[3].size() - 1).toFloat(&ok);
+            if( parseCupLine( line, lineNo, wp ) )
+              {
+                list.append( wp );
+              }
 
-          if( ! ok )
-            {
-              qWarning("DAT Read (%d): Error reading elevation value '%s'.",
-                        lineNo,
-                        list[3].left(list[3].size() - 1).toLatin1().data());
-              continue;
-            }
+            break;
 
-          if( unit == "M" )
-            {
-              wp.elevation = tmpElev;
-            }
-          else if( unit == "F" )
-            {
-              // Convert feet to meters
-              wp.elevation = tmpElev * 0.3048;
-            }
-          else
-            {
-              qWarning("DAT Read (%d): Unknown elevation value '%s'.", lineNo,
-                       unit.toLatin1().data());
-              continue;
-            }
-        }
+          case Dat:
 
-      /*
-      Turnpoint attributes
+            if( parseDatLine( line, lineNo, wp ) )
+              {
+                list.append( wp );
+              }
 
-      Cambridge documentation defines the following:
-      Code    Meaning
-      A       Airfield (not necessarily landable). All turnpoints marked 'A' in the UK are landable.
-      L       Landable Point. Not necessarily an airfield.
-      S       Start Point
-      F       Finish Point
-      H       Home Point
-      M       Markpoint
-      R       Restricted Point
-      T       Turnpoint
-      W       Waypoint
-      */
+            break;
 
-      if( list[4].isEmpty() )
-        {
-          qWarning("DAT Read (%d): Missing turnpoint attributes", lineNo );
-          continue;
-        }
+          case BgaDos:
 
-      // That is the default
-      wp.type = BaseMapElement::Landmark;
+            record[recordLines++] = line;
 
-      list[4] = list[4].toUpper();
+            if( recordLines == BgaDosRecordLines )
+              {
+                if( parseBgaDosRecord( record, lineNo - recordLines + 1, wp ) )
+                  {
+                    list.append( wp );
+                  }
 
-      if( list[4].contains("T") )
-        {
-          wp.type = BaseMapElement::Turnpoint;
-        }
+                recordLines = 0;
+              }
 
-      if( list[4].contains("A") )
-        {
-          wp.type = BaseMapElement::Airfield;
+            break;
         }
 
-      if( list[4].contains("L") )
-        {
-          // wp.isLandable = true;
-        }
+      lineNo++;
+    }
 
-      // Check filter, if type should be taken
-      if( ! takeType( (enum BaseMapElement::objectType) wp.type ) )
-        {
-          continue;
-        }
+  // The separator line of the last record can be missing.
+  if( format == BgaDos && recordLines == BgaDosRecordLines - 1 )
+    {
+      Waypoint wp;
 
-      if( list[5].isEmpty() )
+      if( parseBgaDosRecord( record, lineNo - recordLines, wp ) )
         {
-          qWarning("DAT Read (%d): Missing turnpoint name", lineNo );
-          continue;
+          list.append( wp );
         }
+    }
+}
 
-      // Short name of a waypoint has only 8 characters and upper cases in Cumulus.
-      // That is handled in another way by Cambridge.
-      wp.name = list[5].left(8).toUpper().trimmed();
-      wp.description = list[5].trimmed();
+bool WaypointCatalog::parseCupLine( const TextField& line,
+                                    const int lineNo,
+                                    Waypoint& wp )
+{
+  if( line.size == 0 || line.data[0] == '#' )
+    {
+      return false;
+    }
 
-      if( list.size() >= 7 )
-        {
-          QString comment = list[6].trimmed();
+  // A cup line consists of the following elements:
+  //
+  // Name,Code,Country,Latitude,Longitude,Elevation,Style,Direction,Length,Frequency,Description
+  //
+  // See here for more info: http://download.naviter.com/docs/cup_format.pdf
+  TextField list[16];
 
-          if( ! comment.isEmpty() )
-            {
-              // A description is optional by Cambridge.
-              wp.comment += comment;
-            }
-        }
+  int count = splitLine( line, ',', true, list, 16 );
 
-      if( ! wp.comment.isEmpty() )
-        {
-          wp.comment.append("; ");
-        }
+  if( count == -1 )
+    {
+      qWarning("CUP Read (%d): Missing end quote. Ignoring it.", lineNo);
+      return false;
+    }
 
-      wp.comment.append( "DAT: ").append(list[4]);
+  // 10 elements are mandatory, element 11 description is optional
+  if( count < 10 ||
+      equals( list[0], "name" ) ||
+      equals( list[1], "code" ) ||
+      equals( list[2], "country" ) )
+    {
+      // too less elements or a description line, ignore this
+      return false;
+    }
 
-      // We do check, if the waypoint name is already in use because DAT
-      // short names are not always unique.
-      if( wpList && namesInUse.contains( wp.name ) )
-        {
-          for( int i = 0; i < 100; i++ )
-            {
-              // Hope that not more as 100 same names will be exist.
-              QString number = QString::number(i);
-               wp.name = wp.name.left(wp.name.size() - number.size()) + number;
+  Runway rwy;
 
-              if( namesInUse.contains( wp.name ) == false )
-                {
-                  break;
-                }
-            }
-        }
+  wp.priority = Waypoint::Low;
 
-      if( wpList )
-        {
-          // Add waypoint to list
-          wp.wpListMember = true;
-          wpList->append( wp );
-        }
+  // long name of waypoint
+  wp.description = toString( _codec, list[0], true );
 
-      wpCount++;
+  // If no code is set, we assign the long name as code to have a workaround.
+  const TextField& code = list[1].size ? list[1] : list[0];
 
-      // Store used waypoint name in set.
-      namesInUse.insert( wp.name );
-    }
+  // short name of a waypoint limited to 8 characters
+  wp.name = toString( _codec, code, true ).left(8).toUpper();
+  wp.country = toString( _codec, list[2], true ).left(2).toUpper();
+  wp.icao = "";
+  rwy.m_surface = Runway::Unknown;
 
-  file.close();
+  // waypoint type
+  int wpType;
 
-  if( _showProgress )
+  if( ! toInt( list[6], wpType ) || wpType < 0 )
     {
-      ws->setVisible( false );
-      QCoreApplication::processEvents( QEventLoop::ExcludeUserInputEvents|
-                                       QEventLoop::ExcludeSocketNotifiers );
-      delete ws;
+      qWarning("CUP Read (%d): Invalid waypoint type '%s'. Ignoring it.",
+               lineNo, bytes( list[6] ).data() );
+      return false;
     }
 
-  return wpCount;
-}
-
-/** read a waypoint catalog from a SeeYou cup file, only waypoint part */
-int WaypointCatalog::readCup( QString catalog, QList<Waypoint>* wpList )
-{
-  QFile file(catalog);
-
-  if( ! file.exists() )
+  switch( wpType )
     {
-      return -1;
+    case 1:
+      wp.type = BaseMapElement::Landmark;
+      break;
+    case 2:
+      wp.type = BaseMapElement::Airfield;
+      rwy.m_surface = Runway::Grass;
+      wp.priority = Waypoint::Normal;
+      break;
+    case 3:
+      wp.type = BaseMapElement::Outlanding;
+      wp.priority = Waypoint::Normal;
+      break;
+    case 4:
+      wp.type = BaseMapElement::Gliderfield;
+      wp.priority = Waypoint::Normal;
+      break;
+    case 5:
+      wp.type = BaseMapElement::Airfield;
+      rwy.m_surface = Runway::Concrete;
+      wp.priority = Waypoint::Normal;
+      break;
+    case 9:
+      wp.type = BaseMapElement::Ndb;
+      break;
+    case 10:
+      wp.type = BaseMapElement::Vor;
+      break;
+    case 11:
+      // Mapped to thermal hotspot defined by http://glidinghotspots.eu/
+      wp.type = BaseMapElement::Thermal;
+      break;
+    default:
+      wp.type = BaseMapElement::Landmark;
+      break;
     }
 
-  if( file.size() == 0 )
+  // Check filter, if type should be taken
+  if( ! takeType( (enum BaseMapElement::objectType) wp.type ) )
     {
-      return 0;
+      return false;
     }
 
-  if( ! file.open( QIODevice::ReadOnly | QIODevice::Text ) )
+  // latitude as ddmm.mmm(N|S)
+  double degree;
+  double minutes;
+
+  if( ! toDouble( mid( list[3], 0, 2 ), degree ) )
     {
-      return -1;
+      qWarning("CUP Read (%d): Error reading coordinate (N/S) (1)", lineNo);
+      return false;
     }
 
-  QSet<QString> namesInUse;
-  int lineNo = 0;
-  int wpCount = 0;
+  if( ! toDouble( mid( list[3], 2, 6 ), minutes ) )
+    {
+      qWarning("CUP Read (%d): Error reading coordinate (N/S) (2)", lineNo);
+      return false;
+    }
 
-  WaitScreen *ws = static_cast<WaitScreen *>(0);
+  double latTmp = (degree * 600000.) + (minutes * 10000.0);
 
-  if( _showProgress )
+  if( lastUpper( list[3] ) == 'S' )
     {
-      ws = new WaitScreen( MainWindow::mainWindow() );
+      latTmp = -latTmp;
+    }
 
-#ifdef ANDROID
-      // The waitscreen is not centered over the parent and not limited in
-      // its size under Android. Therefore this must be done by our self.
-      ws->setGeometry ( MainWindow::mainWindow()->width() / 2 - 250,
-                        MainWindow::mainWindow()->height() / 2 - 75,
-                        500, 150 );
-#endif
+  // longitude dddmm.mmm(E|W)
+  if( ! toDouble( mid( list[4], 0, 3 ), degree ) )
+    {
+      qWarning("CUP Read (%d): Error reading coordinate (E/W) (1)", lineNo);
+      return false;
+    }
 
-      ws->slot_SetText1( QObject::tr("Reading file") );
-      ws->slot_SetText2( QFileInfo(catalog).fileName() );
-      QCoreApplication::processEvents( QEventLoop::ExcludeUserInputEvents|
-                                       QEventLoop::ExcludeSocketNotifiers );
+  if( ! toDouble( mid( list[4], 3, 6 ), minutes ) )
+    {
+      qWarning("CUP Read (%d): Error reading coordinate (E/W) (2)", lineNo);
+      return false;
     }
 
-  // Estimate the number of entries in the file. The basic assumption is, that
-  // a single line is approximately 70 characters long. Only 20 animations
-  // should be done because the animation is a performance blocker.
-  int wsCycles = (file.size() / 70) / 20;
+  double lonTmp = (degree * 600000.) + (minutes * 10000.0);
 
-  if( wsCycles == 0 )
+  if( lastUpper( list[4] ) == 'W' )
     {
-      // avoid division by zero!
-      wsCycles++;
+      lonTmp = -lonTmp;
     }
 
-  QTextStream in(&file);
-  in.setCodec( "ISO 8859-15" );
+  wp.wgsPoint.setLat((int) rint(latTmp));
+  wp.wgsPoint.setLon((int) rint(lonTmp));
 
-  while( !in.atEnd() )
+  // Check radius filter
+  if( ! takePoint( wp.wgsPoint ) )
     {
-      QString line = in.readLine().trimmed();
+      // Distance is greater than the defined radius around the center point.
+      return false;
+    }
 
-      lineNo++;
+  // two units are possible:
+  // o meter: m
+  // o feet:  ft
+  if( list[5].size ) // elevation in meter or feet
+    {
+      int uStart = indexOfAny( list[5], "mf" );
 
-      if( _showProgress && (lineNo % wsCycles) == 0 )
+      if( uStart == -1 )
         {
-          ws->slot_Progress( 2 );
-          QCoreApplication::processEvents( QEventLoop::ExcludeUserInputEvents|
-                                           QEventLoop::ExcludeSocketNotifiers );
+          qWarning("CUP Read (%d): Error reading elevation unit '%s'.", lineNo,
+                   bytes( list[5] ).data());
+          return false;
         }
 
-      if( line.size() == 0 || line.startsWith("#") )
+      TextField unit = mid( list[5], uStart );
+      double tmpElev;
+
+      if( ! toDouble( mid( list[5], 0, uStart ), tmpElev ) )
         {
-          continue;
+          qWarning("CUP Read (%d): Error reading elevation value '%s'.", lineNo,
+                   bytes( mid( list[5], 0, uStart ) ).data());
+          return false;
         }
 
-      bool ok;
-
-      QList<QString> list = splitCupLine( line, ok );
-
-      if( list[0] == "-----Related Tasks-----" )
+      if( equals( unit, "m" ) )
         {
-          // Task part starts, we will ignore it and break up reading
-          break;
+          wp.elevation = tmpElev;
         }
-
-      // 10 elements are mandatory, element 11 description is optional
-      if( list.count() < 10 ||
-          list[0].toLower() == "name" ||
-          list[1].toLower() == "code" ||
-          list[2].toLower() == "country" )
-        {
-          // too less elements or a description line, ignore this
-          continue;
-        }
-
-      // A cup line consists of the following elements:
-      //
-      // Name,Code,Country,Latitude,Longitude,Elevation,Style,Direction,Length,Frequency,Description
-      //
-      // See here for more info: http://download.naviter.com/docs/cup_format.pdf
-      Waypoint wp;
-
-      Runway rwy;
-
-      wp.priority = Waypoint::Low;
-
-      if( list[0].length() ) // long name of waypoint
+      else if( equals( unit, "ft" ) )
         {
-          wp.description = list[0].replace( QRegExp("\""), "" );
+          wp.elevation = tmpElev * 0.3048;
         }
       else
         {
-          wp.description = "";
-        }
-
-      if( list[1].isEmpty() )
-        {
-          // If no code is set, we assign the long name as code to have a workaround.
-          list[1] = list[0];
+          qWarning("CUP Read (%d): Unknown elevation value '%s'.", lineNo,
+                   bytes( unit ).data());
+          return false;
         }
+    }
 
-      // short name of a waypoint limited to 8 characters
-      wp.name = list[1].replace( QRegExp("\""), "" ).left(8).toUpper();
-      wp.country = list[2].left(2).toUpper();
-      wp.icao = "";
-      rwy.m_surface = Runway::Unknown;
-
-      // waypoint type
-      uint wpType = list[6].toUInt(&ok);
+  if( list[9].size ) // airport frequency
+    {
+      double frequency;
 
-      if( ! ok )
+      if( toDouble( list[9], frequency ) )
         {
-          qWarning("CUP Read (%d): Invalid waypoint type '%s'. Ignoring it.",
-                   lineNo, list[6].toLatin1().data() );
-          continue;
+          wp.frequency = frequency;
         }
-
-      switch( wpType )
-        {
-        case 1:
-          wp.type = BaseMapElement::Landmark;
-          break;
-        case 2:
-          wp.type = BaseMapElement::Airfield;
-          rwy.m_surface = Runway::Grass;
-          wp.priority = Waypoint::Normal;
-          break;
-        case 3:
-          wp.type = BaseMapElement::Outlanding;
-          wp.priority = Waypoint::Normal;
-          break;
-        case 4:
-          wp.type = BaseMapElement::Gliderfield;
-          wp.priority = Waypoint::Normal;
-          break;
-        case 5:
-          wp.type = BaseMapElement::Airfield;
-          rwy.m_surface = Runway::Concrete;
-          wp.priority = Waypoint::Normal;
-          break;
-        case 9:
-          wp.type = BaseMapElement::Ndb;
-          break;
-        case 10:
-          wp.type = BaseMapElement::Vor;
-          break;
-        case 11:
-          // Mapped to thermal hotspot defined by http://glidinghotspots.eu/
-          wp.type = BaseMapElement::Thermal;
-          break;
-        default:
-          wp.type = BaseMapElement::Landmark;
-          break;
-        }
-
-      // Check filter, if type should be taken
-      if( ! takeType( (enum BaseMapElement::objectType) wp.type ) )
+      else
         {
-          continue;
+          wp.frequency = 0.0;
         }
+    }
 
-      // latitude as ddmm.mmm(N|S)
-      double degree = list[3].left(2).toDouble(&ok);
+  if( list[7].size ) // runway direction 010...360
+    {
+      int rdir;
 
-      if( ! ok )
+      if( toInt( list[7], rdir ) )
         {
-          qWarning("CUP Read (%d): Error reading coordinate (N/S) (1)", lineNo);
-          continue;
-        }
-
-      double minutes = list[3].mid(2,6).toDouble(&ok);
+          // Runway has only one direction entry 010...360.
+          // We split it into two parts.
+          int rwh1 = rdir;
+          int rwh2 = rwh1 <= 180 ? rwh1+180 : rwh1-180;
 
-      if( ! ok )
-        {
-          qWarning("CUP Read (%d): Error reading coordinate (N/S) (2)", lineNo);
-          continue;
+          // put both directions into one variable, each in a byte
+          rwy.m_heading = (rwh1/10) * 256 + (rwh2/10);
         }
+    }
 
-      double latTmp = (degree * 600000.) + (minutes * 10000.0);
+  if( list[8].size ) // runway length in meters
+    {
+      // three units are possible:
+      // o meter: m
+      // o nautical mile: nm
+      // o statute mile: ml
+      // o feet: ft, @AP: Note that is not conform to the SeeYou specification
+      //                  but I saw it in an south African file.
+      int uStart = indexOfAny( list[8], "fmn" );
+      double length;
 
-      if( list[3].right(1).toUpper() == "S" )
+      if( uStart != -1 && toDouble( mid( list[8], 0, uStart ), length ) )
         {
-          latTmp = -latTmp;
-        }
+          TextField unit = mid( list[8], uStart );
 
-      // longitude dddmm.mmm(E|W)
-      degree = list[4].left(3).toDouble(&ok);
+          if( equals( unit, "nm" ) ) // nautical miles
+            {
+              length *= 1852;
+            }
+          else if( equals( unit, "ml" ) ) // statute miles
+            {
+              length *= 1609.34;
+            }
+          else if( equals( unit, "ft" ) ) // feet
+            {
+              length *= 0.3048;
+            }
 
-      if( ! ok )
-        {
-          qWarning("CUP Read (%d): Error reading coordinate (E/W) (1)", lineNo);
-          continue;
+          rwy.m_length = length;
+          rwy.m_isOpen = true;
+          rwy.m_isBidirectional = true;
+
+          // Store runway in the runway list.
+          wp.rwyList.append( rwy );
         }
+    }
 
-      minutes = list[4].mid(3,6).toDouble(&ok);
+  if( count >= 11 && list[10].size ) // description, optional
+    {
+      wp.comment += toString( _codec, list[10], true );
+    }
 
-      if( ! ok )
-        {
-          qWarning("CUP Read (%d): Error reading coordinate (E/W) (2)", lineNo);
-          continue;
-        }
+  return true;
+}
 
-      double lonTmp = (degree * 600000.) + (minutes * 10000.0);
+bool WaypointCatalog::parseDatLine( const TextField& line,
+                                    const int lineNo,
+                                    Waypoint& wp )
+{
+  if( line.size == 0 || line.data[0] == '*' )
+    {
+      // Filter out empty and comment lines
+      return false;
+    }
 
+  TextField list[8];
 
-      if( list[4].right(1).toUpper() == "W" )
-        {
-          lonTmp = -lonTmp;
-        }
+  int count = splitLine( line, ',', false, list, 8 );
 
-      wp.wgsPoint.setLat((int) rint(latTmp));
-      wp.wgsPoint.setLon((int) rint(lonTmp));
+  /*
+  Example turnpoints, two possible coordinate formats seems to be in use.
+  0 ,1         ,2          ,3   ,4,5           ,6
+  31,57:04.213N,002:47.239W,450F,T,AB1 AboynBrg,RdBroverRDee
 
-      // Check radius filter
-      if( ! takePoint( wp.wgsPoint ) )
-        {
-          // Distance is greater than the defined radius around the center point.
-          continue;
-        }
+  0,1        ,2         ,3  ,4  ,5           ,6
+  1,52:08:39N,012:40:06E,66M,HAS,SP1 LUESSE  ,EDOJ
+  */
 
-      // Sets the projected coordinates
-      wp.projPoint = _globalMapMatrix->wgsToMap( wp.wgsPoint );
+  // Lines defining a turnpoint contain 7 fields, separated by commas.
+  // The final field is terminated by the newline. Field 7 is optional.
+  if( count < 6 )
+    {
+      qWarning( "DAT Read (%d): Line contains too less elements! Ignoring it.",
+                lineNo );
+      return false;
+    }
 
-      QString unit;
-      int uStart = list[8].indexOf( QRegExp("[lmn]") );
+  wp.priority = Waypoint::Low;
+  wp.country = _homeCountry;
 
-      if( uStart != -1 )
-        {
-          unit = list[8].mid( uStart ).toLower();
-          float length = list[8].left( list[8].length()-unit.length() ).toFloat(&ok);
+  if( list[1].size < 9 )
+    {
+      qWarning("DAT Read (%d): Format error latitude", lineNo);
+      return false;
+    }
 
-          if( ok )
-            {
-              if( unit == "nm" ) // nautical miles
-                {
-                  length *= 1852;
-                }
-              else if( unit == "ml" ) // statute miles
-                {
-                  length *= 1609.34;
-                }
+  // latitude as 57:04.213N|S or 52:08:39N|S
+  double degree;
 
-              rwy.m_length = length;
-            }
-        }
+  if( ! toDouble( mid( list[1], 0, 2 ), degree ) )
+    {
+      qWarning("DAT Read (%d): Format error latitude degree", lineNo);
+      return false;
+    }
 
-      // two units are possible:
-      // o meter: m
-      // o feet:  ft
-      if( list[5].length() ) // elevation in meter or feet
-        {
-          QString unit;
-          int uStart = list[5].indexOf( QRegExp("[mf]") );
+  double minutes = 0.0;
+  double seconds = 0.0;
+  bool ok = true;
 
-          if( uStart == -1 )
-            {
-              qWarning("CUP Read (%d): Error reading elevation unit '%s'.", lineNo,
-                       list[5].toLatin1().data());
-              continue;
-            }
+  if( list[1].data[5] == '.' )
+    {
+      ok = toDouble( mid( list[1], 3, 6 ), minutes );
+    }
+  else if( list[1].data[5] == ':' )
+    {
+      ok = toDouble( mid( list[1], 3, 2 ), minutes ) &&
+           toDouble( mid( list[1], 6, 2 ), seconds );
+    }
 
-          unit = list[5].mid( uStart ).toLower();
+  if( ! ok )
+    {
+      qWarning("DAT Read (%d): Format error latitude minutes/seconds", lineNo);
+      return false;
+    }
 
-          float tmpElev = (list[5].left(list[5].length() - unit.length())).toFloat(&ok);
+  double latTmp = (degree * 600000.) + (10000. * (minutes + seconds / 60. ));
 
-          if( ! ok )
-            {
-              qWarning("CUP Read (%d): Error reading elevation value '%s'.", lineNo,
-                       list[5].left(list[5].length() - unit.length()).toLatin1().data());
-              continue;
-            }
+  if( lastUpper( list[1] ) == 'S' )
+    {
+      latTmp = -latTmp;
+    }
 
-          if( unit == "m" )
-            {
-              wp.elevation = tmpElev;
-            }
-          else if( unit == "ft" )
-            {
-              wp.elevation = tmpElev * 0.3048;
-            }
-          else
-            {
-              qWarning("CUP Read (%d): Unknown elevation value '%s'.", lineNo,
-                       unit.toLatin1().data());
-              continue;
-            }
-        }
+  // longitude as 002:47.239E|W or 012:40:06E|W
+  if( list[2].size < 10 )
+    {
+      qWarning("DAT Read (%d): Format error longitude", lineNo);
+      return false;
+    }
 
-      if( list[9].trimmed().length() ) // airport frequency
-        {
-          float frequency = list[9].replace( QRegExp("\""), "" ).toFloat(&ok);
+  if( ! toDouble( mid( list[2], 0, 3 ), degree ) )
+    {
+      qWarning("DAT Read (%d): Format error longitude degree", lineNo);
+      return false;
+    }
 
-          if( ok )
-            {
-              wp.frequency = frequency;
-            }
-          else
-            {
-              wp.frequency = 0.0;
-            }
-        }
+  minutes = 0.0;
+  seconds = 0.0;
 
-      if( list[7].trimmed().length() ) // runway direction 010...360
-        {
-          uint rdir = list[7].toInt(&ok);
+  if( list[2].data[6] == '.' )
+    {
+      ok = toDouble( mid( list[2], 4, 6 ), minutes );
+    }
+  else if( list[2].data[6] == ':' )
+    {
+      ok = toDouble( mid( list[2], 4, 2 ), minutes ) &&
+           toDouble( mid( list[2], 7, 2 ), seconds );
+    }
 
-          if( ok )
-            {
-              // Runway has only one direction entry 010...360.
-              // We split it into two parts.
-              int rwh1 = rdir;
-              int rwh2 = rwh1 <= 180 ? rwh1+180 : rwh1-180;
+  if( ! ok )
+    {
+      qWarning("DAT Read (%d): Format error longitude minutes/seconds", lineNo);
+      return false;
+    }
 
-              // put both directions into one variable, each in a byte
-              rwy.m_heading = (rwh1/10) * 256 + (rwh2/10);
-            }
-        }
+  double lonTmp = (degree * 600000.) + (10000. * (minutes + seconds / 60. ));
 
-      if( list[8].trimmed().length() ) // runway length in meters
-        {
-          // three units are possible:
-          // o meter: m
-          // o nautical mile: nm
-          // o statute mile: ml
-          // o feet: ft, @AP: Note that is not conform to the SeeYou specification
-          //                  but I saw it in an south African file.
-          QString unit;
-          int uStart = list[8].indexOf( QRegExp("[fmn]") );
+  if( lastUpper( list[2] ) == 'W' )
+    {
+      lonTmp = -lonTmp;
+    }
 
-          if( uStart != -1 )
-            {
-              unit = list[8].mid( uStart ).toLower();
-              float length = list[8].left( list[8].length()-unit.length() ).toFloat(&ok);
+  wp.wgsPoint.setLat((int) rint(latTmp));
+  wp.wgsPoint.setLon((int) rint(lonTmp));
 
-              if( ok )
-                {
-                  if( unit == "nm" ) // nautical miles
-                    {
-                      length *= 1852;
-                    }
-                  else if( unit == "ml" ) // statute miles
-                    {
-                      length *= 1609.34;
-                    }
-                  else if( unit == "ft" ) // feet
-                    {
-                      length *= 0.3048;
-                    }
+  // Check radius filter
+  if( ! takePoint( wp.wgsPoint ) )
+    {
+      // Distance is greater than the defined radius around the center point.
+      return false;
+    }
 
-                  rwy.m_length = length;
-                  rwy.m_isOpen = true;
-                  rwy.m_isBidirectional = true;
+  // Height AMSL 9{1,5}[FM] 9=height, F=feet, M=metres.
+  // two units are possible:
+  // o meter: m
+  // o feet:  ft
+  if( list[3].size ) // elevation in meter or feet
+    {
+      char unit = lastUpper( list[3] );
 
-                  // Store runway in the runway list.
-                  wp.rwyList.append( rwy );
-                }
-            }
+      if( unit != 'F' && unit != 'M' )
+        {
+          qWarning("DAT Read (%d): Error reading elevation unit '%s'.",
+                   lineNo, bytes( list[3] ).data());
+          return false;
         }
 
-      if( list.count() == 11 && list[10].trimmed().length() ) // description, optional
+      double tmpElev;
+
+      if( ! toDouble( mid( list[3], 0, list[3].size - 1 ), tmpElev ) )
         {
-          wp.comment += list[10].replace( QRegExp("\""), "" );
+          qWarning("DAT Read (%d): Error reading elevation value '%s'.",
+                    lineNo,
+                    bytes( mid( list[3], 0, list[3].size - 1 ) ).data());
+          return false;
         }
 
-      // We do check, if the waypoint name is already in use because cup
-      // short names are not always unique.
-      if( wpList && namesInUse.contains( wp.name ) )
+      if( unit == 'M' )
         {
-          for( int i = 0; i < 100; i++ )
-            {
-              // Hope that not more as 100 same names will be exist.
-              QString number = QString::number(i);
-               wp.name = wp.name.left(wp.name.size() - number.size()) + number;
-
-              if( namesInUse.contains( wp.name ) == false )
-                {
-                  break;
-                }
-            }
+          wp.elevation = tmpElev;
         }
-
-      if( wpList )
+      else
         {
-          // Add waypoint to list
-          wp.wpListMember = true;
-          wpList->append( wp );
+          // Convert feet to meters
+          wp.elevation = tmpElev * 0.3048;
         }
+    }
 
-      wpCount++;
+  /*
+  Turnpoint attributes
 
-      // Store used waypoint name in set.
-      namesInUse.insert( wp.name );
+  Cambridge documentation defines the following:
+  Code    Meaning
+  A       Airfield (not necessarily landable). All turnpoints marked 'A' in the UK are landable.
+  L       Landable Point. Not necessarily an airfield.
+  S       Start Point
+  F       Finish Point
+  H       Home Point
+  M       Markpoint
+  R       Restricted Point
+  T       Turnpoint
+  W       Waypoint
+  */
+
+  if( list[4].size == 0 )
+    {
+      qWarning("DAT Read (%d): Missing turnpoint attributes", lineNo );
+      return false;
     }
 
-  file.close();
+  // That is the default
+  wp.type = BaseMapElement::Landmark;
 
-  if( _showProgress )
+  QString attributes = toString( _codec, list[4] ).toUpper();
+
+  if( attributes.contains("T") )
     {
-      ws->setVisible( false );
-      QCoreApplication::processEvents( QEventLoop::ExcludeUserInputEvents|
-                                       QEventLoop::ExcludeSocketNotifiers );
-      delete ws;
+      wp.type = BaseMapElement::Turnpoint;
     }
 
-  return wpCount;
+  if( attributes.contains("A") )
+    {
+      wp.type = BaseMapElement::Airfield;
+    }
+
+  // Check filter, if type should be taken
+  if( ! takeType( (enum BaseMapElement::objectType) wp.type ) )
+    {
+      return false;
+    }
+
+  if( list[5].size == 0 )
+    {
+      qWarning("DAT Read (%d): Missing turnpoint name", lineNo );
+      return false;
+    }
+
+  // Short name of a waypoint has only 8 characters and upper cases in Cumulus.
+  // That is handled in another way by Cambridge.
+  wp.description = toString( _codec, list[5] );
+  wp.name = wp.description.left(8).toUpper().trimmed();
+
+  if( count >= 7 && list[6].size )
+    {
+      // A description is optional by Cambridge.
+      wp.comment += toString( _codec, list[6] );
+    }
+
+  if( ! wp.comment.isEmpty() )
+    {
+      wp.comment.append("; ");
+    }
+
+  wp.comment.append( "DAT: ").append( attributes );
+
+  return true;
 }
 
-QList<QString> WaypointCatalog::splitCupLine( QString& line, bool &ok )
+bool WaypointCatalog::parseBgaDosRecord( const TextField* record,
+                                         const int lineNo,
+                                         Waypoint& wp )
 {
-  // A cup line consists of elements separated by commas. String elements
-  // are enclosed in quotation marks. Inside such a string element, a
-  // comma is allowed and is not to interpret as separator!
-  QList<QString> list;
+  /**
+    The DOS format is as follows.
 
-  int start, pos, len, idx;
-  start = pos = len = idx = 0;
+     0. Full Name
+     1. TriGraph
+     2. Category for findability (A-D) and airspace # and ##
+     3. Exact point
+     4. Description & Remarks
+     5. Dist from main feature, NMl
+     6. Direction from main feature
+     7. Main feature (one of several large towns and cities used as locators)
+     8. Grid ref km East and N of OS Datum
+     9. Lat/Long to WGS84 Geodetic Datum
+    10. Altitude (in Feet, accuracy not Guaranteed)
+    11. TriGraph
 
-  line = line.trimmed();
+     0. Aboyne Bridge
+     1. AB1
+     2. A
+     3. Road Br over R Dee
+     4. S side of village bet A93 and B976, 2NMl E of airfield, under CTA base 3000
+     5. 22
+     6. W
+     7. Aberdeen
+     8. 352.36 797.96
+     9. 57 04.213N 002 47.239W
+    10. 450
+    11. AB1
+  */
 
-  len = line.size();
+  if( ! equals( record[1], record[11] ) )
+    {
+      // Filter out corrupted lines
+      qWarning("DOS Read (%d): Short code unequal final code", lineNo );
+      return false;
+    }
 
-  while( true )
+  if( record[0].size == 0 ||
+      record[1].size == 0 ||
+      record[2].size == 0 ||
+      record[9].size == 0 ||
+      record[10].size == 0 ||
+      record[11].size == 0 )
     {
-      if( line[pos] == QChar('"') )
-        {
-          // Handle quoted string
-          pos++;
+      qWarning( "DOS Read (%d): Record contains too less elements! Ignoring it.",
+                lineNo );
+      return false;
+    }
 
-          if( pos >= len )
-            {
-              ok = false;
-              return list;
-            }
+  wp.type = BaseMapElement::Landmark;
+  wp.priority = Waypoint::Low;
+  wp.country = _homeCountry;
 
-          // Search the end quote
-          idx = line.indexOf( QChar('"'), pos );
+  // Name is composed from TriGraph "-" and Category for findability (A-D)
+  // and airspace # and ##
+  wp.name = toString( _codec, record[1] ) + "-" + toString( _codec, record[2] );
 
-          if( idx == -1 )
-            {
-              // Syntax error, abort split
-              ok = false;
-              return list;
-            }
+  // Short name of a waypoint has only 8 characters and upper cases in Cumulus.
+  wp.name = wp.name.left(8).toUpper().trimmed();
+  wp.description = toString( _codec, record[0] );
 
-          pos = idx; // set current position to index of quote sign
-        }
+  // latitude and longitude as 57 04.213N 002 47.239W
+  TextField latlon[4];
 
-      idx = line.indexOf( QChar(','), pos );
+  if( splitWords( record[9], latlon, 4 ) != 4 )
+    {
+      qWarning("DOS Read (%d): Format error WGS84 geodetic datum", lineNo);
+      return false;
+    }
 
-      if( idx == -1 )
-        {
-          // No comma found, maybe we are at the end
-          if( start < len )
-            {
-              list.append( line.mid( start, len-start ) );
-            }
-          else
-            {
-              list.append( QString("") );
-            }
+  // Extract latitude
+  double degree;
+  double minutes;
 
-          ok = true;
-          return list;
-        }
+  if( ! toDouble( latlon[0], degree ) )
+    {
+      qWarning("DOS Read (%d): Format error degree WGS84 latitude", lineNo);
+      return false;
+    }
 
-      if( start < idx )
-        {
-          list.append( line.mid( start, idx-start ) );
-        }
-      else
-        {
-          list.append( QString("") );
-        }
+  if( ! toDouble( mid( latlon[1], 0, latlon[1].size - 1 ), minutes ) )
+    {
+      qWarning("DOS Read (%d): Format error minutes WGS84 latitude", lineNo);
+      return false;
+    }
 
-      if( (idx + 1) >= len )
-        {
-          // No more data available
-          ok = true;
-          return list;
-        }
+  double latTmp = (degree * 600000.) + (10000. * minutes);
 
-      pos = start = idx + 1;
+  if( lastUpper( latlon[1] ) == 'S' )
+    {
+      latTmp = -latTmp;
     }
 
-  return list;
+  // Extract longitude
+  if( ! toDouble( latlon[2], degree ) )
+    {
+      qWarning("DOS Read (%d): Format error degree WGS84 longitude", lineNo);
+      return false;
+    }
+
+  if( ! toDouble( mid( latlon[3], 0, latlon[3].size - 1 ), minutes ) )
+    {
+      qWarning("DOS Read (%d): Format error minutes WGS84 longitude", lineNo);
+      return false;
+    }
+
+  double lonTmp = (degree * 600000.) + (10000. * minutes);
+
+  if( lastUpper( latlon[3] ) == 'W' )
+    {
+      lonTmp = -lonTmp;
+    }
+
+  wp.wgsPoint.setLat((int) rint(latTmp));
+  wp.wgsPoint.setLon((int) rint(lonTmp));
+
+  // Check radius filter
+  if( ! takePoint( wp.wgsPoint ) )
+    {
+      // Distance is greater than the defined radius around the center point.
+      return false;
+    }
+
+  // Altitude (in Feet, accuracy not Guaranteed)
+  double tmpElev;
+
+  if( ! toDouble( record[10], tmpElev ) )
+    {
+      qWarning("DOS Read (%d): Error reading elevation value '%s'.",
+                lineNo, bytes( record[10] ).data());
+      return false;
+    }
+
+  // Convert feet to meters
+  wp.elevation = tmpElev * 0.3048;
+
+  // Check filter, if type should be taken
+  if( ! takeType( (enum BaseMapElement::objectType) wp.type ) )
+    {
+      return false;
+    }
+
+  wp.comment = toString( _codec, record[3] ) + "\n\n" + toString( _codec, record[4] );
+
+  return true;
 }
 
 bool WaypointCatalog::takeType( enum BaseMapElement::objectType type )
@@ -40,6 +40,9 @@
 #include "waypoint.h"
 #include "wgspoint.h"
 
+class QTextCodec;
+struct TextField;
+
 class WaypointCatalog
 {
  public:
@@ -212,16 +215,73 @@ class WaypointCatalog
    */
   bool takePoint( WGSPoint& point );
 
+  /** Text file formats, which are read by the chunked importer. */
+  enum TextFormat { Cup, Dat, BgaDos };
+
+  /** Number of lines of a BGA DOS record including the separator line. */
+  enum { BgaDosRecordLines = 13 };
+
+  friend class WaypointParseJob;
+
+  /**
+   * Reads a CUP, DAT or BGA DOS file. The file is mapped into the memory and
+   * split into line aligned chunks, which are parsed in parallel. The
+   * results are merged in file order into the waypoint list.
+   *
+   * \param catalog Catalog file name with directory path.
+   *
+   * \param format Format of the file.
+   *
+   * \param wpList Waypoint list where the read waypoints are stored. If the
+   *               wpList is NULL, waypoints are counted only.
+   *
+   * \return Number of read waypoints. In error case -1.
+   */
+  int importTextFile( const QString& catalog,
+                      const enum TextFormat format,
+                      QList<Waypoint>* wpList );
+
+  /**
+   * Parses a line aligned chunk of a text file. Called by a worker thread.
+   *
+   * \param format Format of the file.
+   *
+   * \param data Begin of the chunk.
+   *
+   * \param size Size of the chunk in bytes.
+   *
+   * \param firstLine Line number of the first chunk line.
+   *
+   * \param list List, to which the parsed waypoints are appended.
+   */
+  void parseChunk( const enum TextFormat format,
+                   const char* data,
+                   const int size,
+                   const int firstLine,
+                   QList<Waypoint>& list );
+
+  /**
+   * Parses a single line of a cup file.
+   *
+   * \return True, if the line contains a waypoint, which has passed the filter.
+   */
+  bool parseCupLine( const TextField& line, const int lineNo, Waypoint& wp );
+
   /**
-   * Splits a cup file line into its single elements.
+   * Parses a single line of a DAT file.
    *
-   * \param line Line to be split.
+   * \return True, if the line contains a waypoint, which has passed the filter.
+   */
+  bool parseDatLine( const TextField& line, const int lineNo, Waypoint& wp );
+
+  /**
+   * Parses a record of a BGA DOS file.
    *
-   * \param ok True if split was ok otherwise false
+   * \param record The trimmed lines of the record.
    *
-   * \return A list with the split elements.
+   * \return True, if the record contains a waypoint, which has passed the filter.
    */
-  QList<QString> splitCupLine( QString& line, bool &ok );
+  bool parseBgaDosRecord( const TextField* record, const int lineNo, Waypoint& wp );
 
  private:
 
@@ -229,6 +289,12 @@ class WaypointCatalog
   int _radius;
   bool _showProgress;
   WGSPoint centerPoint;
+
+  /** Country code assigned to DAT and BGA DOS waypoints. */
+  QString _homeCountry;
+
+  /** Codec of the text files. */
+  QTextCodec* _codec;
 };
 
 #endif
@@ -0,0 +1,84 @@
+/***********************************************************************
+ **
+ **   waypointindex.cpp
+ **
+ **   This file is part of Cumulus.
+ **
+ ************************************************************************
+ **
+ **   Copyright (c):  2026 by the Cumulus contributors
+ **
+ **   This file is distributed under the terms of the General Public
+ **   License. See the file COPYING for more information.
+ **
+ ***********************************************************************/
+
+#include <QtCore>
+
+#include "waypointindex.h"
+
+WaypointIndex::WaypointIndex()
+{
+}
+
+WaypointIndex::~WaypointIndex()
+{
+}
+
+void WaypointIndex::clear()
+{
+  m_names.clear();
+  m_icaos.clear();
+  m_positions.clear();
+}
+
+void WaypointIndex::rebuild( QList<Waypoint>& list )
+{
+  clear();
+
+  m_names.reserve( list.size() );
+  m_positions.reserve( list.size() );
+
+  for( int i = 0; i < list.size(); i++ )
+    {
+      add( &list[i] );
+    }
+}
+
+void WaypointIndex::add( Waypoint* wp )
+{
+  if( wp == 0 )
+    {
+      return;
+    }
+
+  m_names.insert( wp->name, wp );
+
+  if( wp->icao.isEmpty() == false )
+    {
+      m_icaos.insert( wp->icao, wp );
+    }
+
+  m_positions.insert( positionKey( wp->wgsPoint ), wp );
+}
+
+bool WaypointIndex::remove( Waypoint* wp )
+{
+  if( wp == 0 )
+    {
+      return false;
+    }
+
+  if( m_names.remove( wp->name, wp ) == 0 )
+    {
+      return false;
+    }
+
+  if( wp->icao.isEmpty() == false )
+    {
+      m_icaos.remove( wp->icao, wp );
+    }
+
+  m_positions.remove( positionKey( wp->wgsPoint ), wp );
+  return true;
+}
@@ -0,0 +1,141 @@
+/***********************************************************************
+ **
+ **   waypointindex.h
+ **
+ **   This file is part of Cumulus.
+ **
+ ************************************************************************
+ **
+ **   Copyright (c):  2026 by the Cumulus contributors
+ **
+ **   This file is distributed under the terms of the General Public
+ **   License. See the file COPYING for more information.
+ **
+ ***********************************************************************/
+
+#ifndef WAYPOINT_INDEX_H
+#define WAYPOINT_INDEX_H
+
+#include <QList>
+#include <QMultiHash>
+#include <QPoint>
+#include <QString>
+
+#include "waypoint.h"
+
+/**
+ * \class WaypointIndex
+ *
+ * \author Cumulus contributors
+ *
+ * \brief Hash indexes over a waypoint list.
+ *
+ * The index stores pointers to the waypoints of a QList<Waypoint>. The
+ * elements of a QList keep their address, when other elements are added or
+ * removed, so the pointers stay valid as long as the waypoint is a member
+ * of the list.
+ *
+ * Waypoints can be found by name, ICAO identifier and position in constant
+ * time. The letter filter of the list view works on the sorted list model
+ * and needs no own index.
+ *
+ * The owner of the list must inform the index about every change of it.
+ * A waypoint must be removed from the index, before its name, ICAO
+ * identifier or position are modified.
+ *
+ * \date 2026
+ */
+class WaypointIndex
+{
+ public:
+
+  WaypointIndex();
+
+  virtual ~WaypointIndex();
+
+  /**
+   * Removes all waypoints from the index.
+   */
+  void clear();
+
+  /**
+   * Rebuilds the index from the passed list.
+   */
+  void rebuild( QList<Waypoint>& list );
+
+  /**
+   * Adds a waypoint to the index.
+   */
+  void add( Waypoint* wp );
+
+  /**
+   * Removes a waypoint from the index.
+   *
+   * @return true, if the waypoint was contained in the index
+   */
+  bool remove( Waypoint* wp );
+
+  /**
+   * @return The number of indexed waypoints.
+   */
+  int count() const
+  {
+    return m_positions.size();
+  };
+
+  /**
+   * @return A waypoint with the passed name or null.
+   */
+  Waypoint* findByName( const QString& name ) const
+  {
+    return m_names.value( name, 0 );
+  };
+
+  /**
+   * @return All waypoints with the passed name.
+   */
+  QList<Waypoint *> findAllByName( const QString& name ) const
+  {
+    return m_names.values( name );
+  };
+
+  /**
+   * @return The number of waypoints with the passed name.
+   */
+  int countName( const QString& name ) const
+  {
+    return m_names.count( name );
+  };
+
+  /**
+   * @return All waypoints with the passed ICAO identifier. Waypoints
+   * without an ICAO identifier are not indexed.
+   */
+  QList<Waypoint *> findByIcao( const QString& icao ) const
+  {
+    return m_icaos.values( icao );
+  };
+
+  /**
+   * @return A waypoint at the passed WGS84 position or null.
+   */
+  Waypoint* findByPosition( const QPoint& wgsCoord ) const
+  {
+    return m_positions.value( positionKey( wgsCoord ), 0 );
+  };
+
+ private:
+
+  static qint64 positionKey( const QPoint& wgsCoord )
+  {
+    return (qint64(wgsCoord.x()) << 32) | quint32(wgsCoord.y());
+  };
+
+  QMultiHash<QString, Waypoint *> m_names;
+
+  QMultiHash<QString, Waypoint *> m_icaos;
+
+  QMultiHash<qint64, Waypoint *> m_positions;
+};
+
+#endif
@@ -0,0 +1,191 @@
+/***********************************************************************
+**
+**   waypointlistmodel.cpp
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c):  2026 by the Cumulus contributors
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+#include <QtCore>
+
+#include "mapcontents.h"
+#include "waypointlistmodel.h"
+
+extern MapContents* _globalMapContents;
+
+WaypointListModel::WaypointListModel( QObject *parent ) :
+  PointListModel( parent ),
+  m_priority( Waypoint::Top )
+{
+}
+
+WaypointListModel::~WaypointListModel()
+{
+}
+
+int WaypointListModel::rowCount( const QModelIndex& parent ) const
+{
+  if( parent.isValid() )
+    {
+      return 0;
+    }
+
+  return m_rows.size();
+}
+
+void WaypointListModel::clear()
+{
+  beginResetModel();
+  m_rows.clear();
+  endResetModel();
+}
+
+Waypoint* WaypointListModel::waypoint( const int row )
+{
+  if( row < 0 || row >= m_rows.size() )
+    {
+      return static_cast<Waypoint *> (0);
+    }
+
+  return m_rows.at( row );
+}
+
+void WaypointListModel::reload( const enum Waypoint::Priority priority )
+{
+  beginResetModel();
+
+  m_priority = priority;
+  m_rows.clear();
+
+  QList<Waypoint> &wpList = _globalMapContents->getWaypointList();
+
+  m_rows.reserve( wpList.size() );
+
+  for( int i = 0; i < wpList.size(); i++ )
+    {
+      if( accepts( wpList.at(i) ) )
+        {
+          m_rows.append( &wpList[i] );
+        }
+    }
+
+  endResetModel();
+}
+
+void WaypointListModel::addWaypoint( Waypoint* wp )
+{
+  if( wp == 0 || ! accepts( *wp ) )
+    {
+      return;
+    }
+
+  beginInsertRows( QModelIndex(), m_rows.size(), m_rows.size() );
+  m_rows.append( wp );
+  endInsertRows();
+}
+
+void WaypointListModel::removeWaypoint( Waypoint* wp )
+{
+  int row = rowOf( wp );
+
+  if( row == -1 )
+    {
+      return;
+    }
+
+  beginRemoveRows( QModelIndex(), row, row );
+  m_rows.remove( row );
+  endRemoveRows();
+}
+
+void WaypointListModel::removeWaypoints( const QList<Waypoint *>& wpList )
+{
+  if( wpList.size() == 1 )
+    {
+      removeWaypoint( wpList.first() );
+      return;
+    }
+
+  // Removing many rows one by one would update the proxy models for every
+  // row, therefore the model is reset once.
+  QSet<Waypoint *> removals = wpList.toSet();
+
+  beginResetModel();
+
+  int j = 0;
+
+  for( int i = 0; i < m_rows.size(); i++ )
+    {
+      if( ! removals.contains( m_rows.at(i) ) )
+        {
+          m_rows[j++] = m_rows.at(i);
+        }
+    }
+
+  m_rows.resize( j );
+
+  endResetModel();
+}
+
+void WaypointListModel::waypointChanged( Waypoint* wp )
+{
+  int row = rowOf( wp );
+
+  if( row == -1 )
+    {
+      return;
+    }
+
+  if( ! accepts( *wp ) )
+    {
+      // The priority was changed, the waypoint is no longer shown.
+      removeWaypoint( wp );
+      return;
+    }
+
+  emit dataChanged( index( row, 0 ), index( row, ColumnCount - 1 ) );
+}
+
+int WaypointListModel::find( const Waypoint& wp ) const
+{
+  for( int i = 0; i < m_rows.size(); i++ )
+    {
+      if( *m_rows.at(i) == wp )
+        {
+          return i;
+        }
+    }
+
+  return -1;
+}
+
+QString WaypointListModel::text( const int row, const int column ) const
+{
+  const Waypoint* wp = m_rows.at( row );
+
+  switch( column )
+    {
+      case Name:
+        return wp->name;
+      case Description:
+        return wp->description.left(15);
+      case Country:
+        return wp->country;
+      case Extra:
+        return wp->icao;
+      default:
+        return QString();
+    }
+}
+
+int WaypointListModel::typeId( const int row ) const
+{
+  return m_rows.at( row )->type;
+}
@@ -0,0 +1,121 @@
+/***********************************************************************
+**
+**   waypointlistmodel.h
+**
+**   This file is part of Cumulus.
+**
+************************************************************************
+**
+**   Copyright (c):  2026 by the Cumulus contributors
+**
+**   This file is distributed under the terms of the General Public
+**   License. See the file COPYING for more information.
+**
+***********************************************************************/
+
+#ifndef WAYPOINT_LIST_MODEL_H
+#define WAYPOINT_LIST_MODEL_H
+
+#include <QVector>
+
+#include "pointlistmodel.h"
+#include "waypoint.h"
+
+/**
+ * \class WaypointListModel
+ *
+ * \author Cumulus contributors
+ *
+ * \brief Table model over the waypoint list of \ref MapContents.
+ *
+ * The model stores only pointers to the waypoints of the global waypoint
+ * list. They stay valid, as long as the waypoint is a member of the list.
+ * Changes of the list must be announced to the model, that it can update
+ * the affected rows in place.
+ *
+ * \date 2026
+ */
+class WaypointListModel : public PointListModel
+{
+  Q_OBJECT
+
+ private:
+
+  Q_DISABLE_COPY( WaypointListModel )
+
+ public:
+
+  WaypointListModel( QObject *parent = 0 );
+
+  virtual ~WaypointListModel();
+
+  virtual int rowCount( const QModelIndex& parent = QModelIndex() ) const;
+
+  virtual void clear();
+
+  virtual Waypoint* waypoint( const int row );
+
+  /**
+   * Loads the waypoints of the global waypoint list.
+   *
+   * \param priority Only waypoints of this priority are loaded. A priority
+   *                 above high loads all waypoints.
+   */
+  void reload( const enum Waypoint::Priority priority );
+
+  /**
+   * \return True, if the waypoint is shown with the current priority.
+   */
+  bool accepts( const Waypoint& wp ) const
+  {
+    return m_priority > Waypoint::High || m_priority == wp.priority;
+  };
+
+  /**
+   * Appends a waypoint of the global waypoint list.
+   */
+  void addWaypoint( Waypoint* wp );
+
+  /**
+   * Removes the row of the passed waypoint. Must be called before the
+   * waypoint is removed from the global waypoint list.
+   */
+  void removeWaypoint( Waypoint* wp );
+
+  /**
+   * Removes the rows of the passed waypoints by one model update.
+   */
+  void removeWaypoints( const QList<Waypoint *>& wpList );
+
+  /**
+   * Updates the row of a modified waypoint.
+   */
+  void waypointChanged( Waypoint* wp );
+
+  /**
+   * \return The row of the passed waypoint or -1.
+   */
+  int rowOf( const Waypoint* wp ) const
+  {
+    return m_rows.indexOf( const_cast<Waypoint *>(wp) );
+  };
+
+  /**
+   * \return The row of a waypoint equal to the passed one or -1.
+   */
+  int find( const Waypoint& wp ) const;
+
+ protected:
+
+  virtual QString text( const int row, const int column ) const;
+
+  virtual int typeId( const int row ) const;
+
+ private:
+
+  QVector<Waypoint *> m_rows;
+
+  enum Waypoint::Priority m_priority;
+};
+
+#endif
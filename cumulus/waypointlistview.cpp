@@ -189,7 +189,7 @@ void WaypointListView::slot_selectionChanged()
       cmdHome->setVisible(true);
     }
 
-  QList<QTreeWidgetItem *> itemList = listw->listWidget()->selectedItems();
+  QList<Waypoint *> itemList = listw->getSelectedWaypoints();
 
   if( itemList.isEmpty() )
     {
@@ -442,8 +442,8 @@ void WaypointListView::slot_wpEdited( Waypoint& wp )
       emit newWaypoint( &wp, true );
     }
 
+  // The list entry is updated in place.
   listw->updateCurrentWaypoint( wp );
-  listw->fillItemList();
 
   MainWindow::mainWindow()->viewMap->getMap()->scheduleRedraw( Map::waypoints );
 }
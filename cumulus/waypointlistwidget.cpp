@@ -23,11 +23,9 @@
 #include "waypointlistwidget.h"
 #include "generalconfig.h"
 #include "mapcontents.h"
-#include "mapconfig.h"
 #include "wpeditdialog.h"
 
 extern MapContents* _globalMapContents;
-extern MapConfig*   _globalMapConfig;
 
 WaypointListWidget::WaypointListWidget( QWidget *parent, bool showMovePage ) :
   ListWidgetParent( parent, showMovePage ),
@@ -35,6 +33,9 @@ WaypointListWidget::WaypointListWidget( QWidget *parent, bool showMovePage ) :
 {
   setObjectName("WaypointListWidget");
   list->setObjectName("WpTreeWidget");
+
+  wpModel = new WaypointListModel( this );
+  setListModel( wpModel );
 }
 
 WaypointListWidget::~WaypointListWidget()
@@ -46,60 +47,25 @@ void WaypointListWidget::fillItemList()
 {
   ListWidgetParent::fillItemList();
 
-  list->setUpdatesEnabled(false);
-  list->clear();
-
   configRowHeight();
 
-  QList<Waypoint> &wpList = _globalMapContents->getWaypointList();
-
-  for (int i=0; i < wpList.count(); i++)
-    {
-      Waypoint& wp = wpList[i];
-
-      if( priority > Waypoint::High )
-        {
-          // Show all waypoints.
-          list->addTopLevelItem( new WaypointItem(wp) );
-        }
-      else if( priority == wp.priority )
-        {
-          // Show only desired waypoints.
-          list->addTopLevelItem( new WaypointItem(wp) );
-        }
-    }
-
-  resizeListColumns();
+  // The model holds only pointers to the waypoints, the rows are
+  // materialized by the view on demand.
+  wpModel->reload( priority );
 
   filter->reset();
+  resizeListColumns();
 
-  if ( wpList.count() > 0 )
+  if ( wpModel->rowCount() > 0 )
     {
-      list->setCurrentItem(list->topLevelItem(0));
+      list->setCurrentIndex( list->model()->index( 0, 0 ) );
     }
-
-  list->setUpdatesEnabled(true);
 }
 
 /** Returns a pointer to the currently selected item. */
 Waypoint* WaypointListWidget::getCurrentWaypoint()
 {
-  QTreeWidgetItem* li = list->currentItem();
-
-  if( li == static_cast<QTreeWidgetItem *> ( 0 ) )
-    {
-      return static_cast<Waypoint *> ( 0 );
-    }
-
-  // Now we're left with the real waypoints
-  WaypointItem* wpi = dynamic_cast<WaypointItem *> ( li );
-
-  if( !wpi )
-    {
-      return static_cast<Waypoint *> ( 0 );
-    }
-
-  return &wpi->wp;
+  return wpModel->waypoint( currentRow() );
 }
 
 /**
@@ -109,20 +75,15 @@ QList<Waypoint *> WaypointListWidget::getSelectedWaypoints()
 {
   QList<Waypoint *> wpList;
 
-  QList<QTreeWidgetItem *> itemList = list->selectedItems();
+  QList<int> rows = selectedRows();
 
-  if( itemList.size() )
+  for( int i = 0; i < rows.size(); i++ )
     {
-      for( int i = 0; i < itemList.size(); i++ )
-        {
-          WaypointItem* wpi = dynamic_cast<WaypointItem *> (itemList.at(i));
-
-            if ( ! wpi )
-              {
-                continue;
-              }
+      Waypoint* wp = wpModel->waypoint( rows.at(i) );
 
-            wpList.append( &wpi->wp );
+      if ( wp )
+        {
+          wpList.append( wp );
         }
     }
 
@@ -134,43 +95,26 @@ QList<Waypoint *> WaypointListWidget::getSelectedWaypoints()
  */
 void WaypointListWidget::deleteSelectedWaypoints()
 {
-  QList<Waypoint *> wpList;
-
-  QList<QTreeWidgetItem *> itemList = list->selectedItems();
+  QList<Waypoint *> wpList = getSelectedWaypoints();
 
-  if( itemList.size() )
+  if( wpList.isEmpty() )
     {
-      list->setUpdatesEnabled(false);
-
-      QList<Waypoint>& wpList = _globalMapContents->getWaypointList();
-
-      for( int i = 0; i < itemList.size(); i++ )
-        {
-          WaypointItem* wpi = dynamic_cast<WaypointItem *> (itemList.at(i));
-
-          if( ! wpi )
-            {
-              continue;
-            }
-
-          // Get waypoint reference from item.
-          Waypoint& wp = wpi->wp;
+      return;
+    }
 
-          // At first remove waypoint from filter because there is a reference
-          // to the global waypoint list.
-          filter->removeListItem( itemList.at(i) );
+  // At first remove the waypoints from the model because there are
+  // references to the global waypoint list.
+  wpModel->removeWaypoints( wpList );
 
-          // At last remove waypoint from global list in MapContents
-          wpList.removeOne( wp );
-        }
+  // At last remove the selected waypoints from global list in MapContents.
+  // Only these elements are removed, equal waypoints are kept.
+  _globalMapContents->removeWaypointsFromList( wpList );
 
-      // save the modified catalog
-      _globalMapContents->saveWaypointList();
+  // save the modified catalog
+  _globalMapContents->saveWaypointList();
 
-      filter->reset();
-      resizeListColumns();
-      list->setUpdatesEnabled(true);
-    }
+  filter->reset();
+  resizeListColumns();
 }
 
 /**
@@ -178,13 +122,14 @@ void WaypointListWidget::deleteSelectedWaypoints()
  */
 void WaypointListWidget::deleteAllWaypoints()
 {
+  wpModel->clear();
+
   // remove all waypoints in the catalog
-  _globalMapContents->getWaypointList().clear();
+  _globalMapContents->clearWaypointList();
 
   // save the modified catalog
   _globalMapContents->saveWaypointList();
 
-  list->clear();
   filter->reset();
   resizeListColumns();
 }
@@ -195,13 +140,6 @@ void WaypointListWidget::deleteAllWaypoints()
 /** Called when the selected waypoint should be deleted from the catalog */
 void WaypointListWidget::deleteCurrentWaypoint()
 {
-  QTreeWidgetItem* li = list->currentItem();
-
-  if( li == 0 )
-    {
-      return;
-    }
-
   Waypoint *wp = getCurrentWaypoint();
 
   if( !wp )
@@ -209,80 +147,83 @@ void WaypointListWidget::deleteCurrentWaypoint()
       return;
     }
 
-  // remove waypoint from waypoint list in MapContents
-  _globalMapContents->getWaypointList().removeAll( *wp );
+  // remove waypoint and all equal ones from waypoint list in MapContents
+  removeEqualWaypoints( *wp );
   // save the modified catalog
   _globalMapContents->saveWaypointList();
 
-  // update the filter and reset the view
-  list->setUpdatesEnabled(false);
-  filter->removeListItem(li);
+  // reset the view
   filter->reset();
   resizeListColumns();
-  list->setUpdatesEnabled(true);
 }
 
 void WaypointListWidget::deleteWaypoint(Waypoint &wp)
 {
-  // Sets the waypoint to be deleted as the current item.
-  for( int i = 0; i < list->topLevelItemCount(); i++ )
-    {
-      WaypointItem* wpi = dynamic_cast<WaypointItem *> (list->topLevelItem(i));
+  int row = wpModel->find( wp );
 
-      if( ! wpi )
-        {
-          continue;
-        }
+  if( row != -1 )
+    {
+      // If the waypoints are identical remove the waypoint from the list.
+      removeEqualWaypoints( wp );
+      _globalMapContents->saveWaypointList();
 
-      if( wpi->wp == wp )
-        {
-          // If the waypoints are identical remove the waypoint from the list.
-          list->setCurrentItem( wpi );
-          deleteCurrentWaypoint();
-          return;
-        }
+      filter->reset();
+      resizeListColumns();
+      return;
     }
 
   // There is on waypoint in the waypoint list view.
   // Remove waypoint from global waypoint list in MapContents
-  _globalMapContents->getWaypointList().removeAll( wp );
+  removeEqualWaypoints( wp );
   // Save the modified waypoint list as file.
   _globalMapContents->saveWaypointList();
 }
 
-/** Called if a waypoint has been edited. */
-void WaypointListWidget::updateCurrentWaypoint(Waypoint& wp)
+void WaypointListWidget::removeEqualWaypoints( const Waypoint& wp )
 {
-  QTreeWidgetItem* li = list->currentItem();
+  // The passed waypoint can be an element of the list, take a copy of it.
+  const Waypoint pattern = wp;
 
-  if( li == 0 )
+  QList<Waypoint *> equals = _globalMapContents->findEqualWaypoints( pattern );
+
+  if( equals.isEmpty() )
     {
       return;
     }
 
-  list->setUpdatesEnabled(false);
+  // The model holds references to the global waypoint list. Therefore the
+  // waypoints are removed from the model at first.
+  wpModel->removeWaypoints( equals );
+  _globalMapContents->removeWaypointsFromList( equals );
+}
+
+/** Called if a waypoint has been edited. */
+void WaypointListWidget::updateCurrentWaypoint(Waypoint& wp)
+{
+  Q_UNUSED( wp )
 
-  li->setText(1, wp.description);
-  li->setText(2, wp.country);
-  li->setText(3, wp.icao);
-  li->setIcon(0, QIcon(_globalMapConfig->getPixmap(wp.type,false,true)));
+  QModelIndex current = list->currentIndex();
 
-  // JD: if the WP name was not changed we just update the item; otherwise
-  // we need to resort and therefore reset the filter and view
+  Waypoint* listWp = getCurrentWaypoint();
 
-  if (li->text(0) == wp.name)
+  if( listWp == 0 )
     {
-      li->setText(0, wp.name);
+      return;
     }
-  else
+
+  // The waypoint of the list was already updated by the editor. The row is
+  // updated in place and moved by the sort model, if the name was changed.
+  wpModel->waypointChanged( listWp );
+
+  // JD: if the WP name was not changed we just update the item; otherwise
+  // we need to resort and therefore reset the filter and view
+  if( list->currentIndex() != current )
     {
-      li->setText(0, wp.name);
       filter->reset();
       resizeListColumns();
+      setCurrentRow( wpModel->rowOf( listWp ) );
     }
 
-  list->setUpdatesEnabled(true);
-
   // save modified catalog
   _globalMapContents->saveWaypointList();
 }
@@ -290,43 +231,22 @@ void WaypointListWidget::updateCurrentWaypoint(Waypoint& wp)
 /** Called if a waypoint has been added. */
 void WaypointListWidget::addWaypoint( Waypoint& newWp )
 {
-  // put new waypoint into the global waypoint list
-  QList<Waypoint> &wpList = _globalMapContents->getWaypointList();
-
   // A waypoint name is limited to 8 characters and has only upper cases.
   newWp.name = newWp.name.left(8).toUpper();
   newWp.wpListMember = true;
 
-  wpList.append( newWp );
+  // put new waypoint into the global waypoint list and retrieve the
+  // reference of the appended waypoint
+  Waypoint& wp = _globalMapContents->addWaypointToList( newWp );
 
   // save the modified waypoint catalog
   _globalMapContents->saveWaypointList();
 
-  // retrieve the reference of the appended waypoint from the global list
-  Waypoint& wp = wpList.last();
-
-  filter->addListItem( new WaypointItem(wp) );
-
-  // resort WP list and reset filter and view
-  list->setUpdatesEnabled(false);
+  // The sort model inserts the new row at its sorted position.
+  wpModel->addWaypoint( &wp );
 
+  // reset filter and view
   filter->reset();
   resizeListColumns();
-
-  list->setUpdatesEnabled(true);
-}
-
-WaypointListWidget::WaypointItem::WaypointItem( Waypoint& waypoint ) :
-  QTreeWidgetItem(),  wp(waypoint)
-{
-  setText(0, wp.name);
-  setText(1, wp.description.left(15));
-  setText(2, wp.country);
-  setTextAlignment(2, Qt::AlignCenter);
-  setText(3, wp.icao);
-
-  QPixmap wpPm = _globalMapConfig->getPixmap(wp.type, false);
-
-  QIcon icon( wpPm );
-  setIcon( 0, icon );
+  setCurrentRow( wpModel->rowOf( &wp ) );
 }
@@ -37,10 +37,10 @@
 
 #include <QFont>
 #include <QList>
-#include <QTreeWidgetItem>
 
 #include "listwidgetparent.h"
 #include "waypoint.h"
+#include "waypointlistmodel.h"
 
 class WaypointListWidget : public ListWidgetParent
 {
@@ -121,26 +121,16 @@ public:
 
 private:
 
-  enum Waypoint::Priority priority;
-
   /**
-   * \class _WaypointItem
-   *
-   * \author André Somers, Axel Pauli
-   *
-   * \brief A user waypoint item element used by the \ref WaypointListWidget.
-   *
-   * \date 2002-2013
+   * Removes all waypoints, which are equal to the passed one, from the
+   * model and from the global waypoint list.
    */
+  void removeEqualWaypoints( const Waypoint& wp );
 
-  class WaypointItem : public QTreeWidgetItem
-    {
-      public:
-
-        WaypointItem(Waypoint& wp);
+  enum Waypoint::Priority priority;
 
-        Waypoint &wp;
-    };
+  /** Model over the global waypoint list. */
+  WaypointListModel* wpModel;
 };
 
 #endif
@@ -25,7 +25,7 @@
 #include "mapcalc.h"
 #include "mapcontents.h"
 #include "mapmatrix.h"
-#include "projectionbase.h"
+#include "pointcache.h"
 #include "resource.h"
 #include "runway.h"
 #include "wgspoint.h"
@@ -57,9 +57,7 @@ Welt2000::Welt2000() :
   h_fileType(0),
   h_fileVersion(0),
   h_homeRadius(0.0),
-  h_runwayLengthFilter(0.0),
   h_outlandings(false),
-  h_projection(static_cast<ProjectionBase *> (0)),
   h_headerIsValid(false)
 {
   // prepare base mappings of Cumulus
@@ -79,10 +77,6 @@ Welt2000::Welt2000() :
 
 Welt2000::~Welt2000()
 {
-  if( h_projection )
-    {
-      delete h_projection;
-    }
 }
 
 /**
@@ -229,65 +223,32 @@ bool Welt2000::load( QList<Airfield>& airfieldList,
             }
         }
 
-      // Check, if home position has been changed in the meantime. In this
-      // case a new parsing of the source should be started.
-      QPoint curHome = _globalMapMatrix->getHomeCoord();
-
-      if( curHome != h_homeCoord )
-        {
-          qDebug( "W2000: Home coordinates have been changed --> reparse welt2000.txt" );
-          // Home coordinates have been changed, make a reparsing of
-          // source file
-          QFile::remove( w2PathTxc );
-          return parse( w2PathTxt, airfieldList, gliderfieldList, outlandingList, true );
-        }
-
-      // Check, if the home radius has been changed in the mean time.
-      // In this case a new parsing of the source must be started.
-      // Get home radius from the configuration data in kilometers.
-      // If set to zero, no radius is defined
-      double dRadius = GeneralConfig::instance()->getAirfieldHomeRadius() / 1000.;
-
-      if( h_countryList.isEmpty() && dRadius == 0.0 )
-        {
-          // Define a default radius of 500Km, if no country filter is defined.
-          dRadius = 500.0;
-        }
-
-      if( fabs( dRadius - h_homeRadius ) > 0.5 )
-        {
-          qDebug( "W2000: Home radius has been changed --> reparse welt2000.txt" );
-          // Home radius has been changed, make a reparsing of the source file
-          QFile::remove( w2PathTxc );
-          return parse( w2PathTxt, airfieldList, gliderfieldList, outlandingList, true );
-        }
-
-      // Check, if the runway length filter has been changed.
-      if( GeneralConfig::instance()->getAirfieldRunwayLengthFilter() != h_runwayLengthFilter )
+      // Without a country filter the compiled file contains only the
+      // points inside the home radius. Check, if home position or radius
+      // have been changed in a way, that the file does not cover.
+      if( h_homeRadius > 0.0 )
         {
-          qDebug( "W2000: Runway length filter has been changed --> reparse welt2000.txt" );
-          // Home radius has been changed, make a reparsing of the source file
-          QFile::remove( w2PathTxc );
-          return parse( w2PathTxt, airfieldList, gliderfieldList, outlandingList, true );
-        }
+          QPoint curHome = _globalMapMatrix->getHomeCoord();
+          double dRadius = GeneralConfig::instance()->getAirfieldHomeRadius() / 1000.;
 
-      // Check, if the projection has been changed in the meantime
-      ProjectionBase *currentProjection = _globalMapMatrix->getProjection();
-
-      if( ! MapContents::compareProjections( h_projection, currentProjection ) )
-        {
-          qDebug( "W2000: Projection has been changed --> reparse welt2000.txt" );
-          // Projection has changed in the meantime
-          if(  h_projection )
+          if( dRadius == 0.0 )
             {
-              delete h_projection;
-              h_projection = 0;
+              // Define a default radius of 500Km, if no country filter is defined.
+              dRadius = 500.0;
             }
 
-          QFile::remove( w2PathTxc );
-          return parse( w2PathTxt, airfieldList, gliderfieldList, outlandingList, true );
+          if( curHome != h_homeCoord || dRadius - h_homeRadius > 0.5 )
+            {
+              qDebug( "W2000: Home position or radius have been changed --> reparse welt2000.txt" );
+              QFile::remove( w2PathTxc );
+              return parse( w2PathTxt, airfieldList, gliderfieldList, outlandingList, true );
+            }
         }
 
+      // Home radius, runway length filter and projection are applied
+      // during reading of the compiled file, their other changes do not
+      // require a reparsing.
+
       // Nothing has been changed, read in compiled file
       if( ! readCompiledFile( w2PathTxc, airfieldList, gliderfieldList, outlandingList ) )
         {
@@ -726,9 +687,9 @@ bool Welt2000::parse( QString& path,
   QString compileFile;
   QFile   compFile;
   QDataStream out;
-  QByteArray bufdata;
-  QBuffer buffer(&bufdata);
-  QDataStream outbuf;
+
+  // The compiled records are collected in spatial buckets.
+  PointCache::Writer writer;
 
   if( doCompile )
     {
@@ -744,12 +705,6 @@ bool Welt2000::parse( QString& path,
           qWarning("W2000: Cannot open file %s!", compileFile.toLatin1().data());
           doCompile = false;
         }
-      else
-        {
-          // create and prepare out buffer and the stream to it
-          buffer.open(QIODevice::ReadWrite);
-          outbuf.setDevice(&buffer);
-        }
     }
 
 #ifdef BOUNDING_BOX
@@ -762,7 +717,6 @@ bool Welt2000::parse( QString& path,
   // Contains the coordinates of the objects put in the lists. Used as filter
   // to avoid multiple entries at the same point.
   QSet<QString> pointFilter;
-  uint counter = 0;
 
   // statistics counter
   uint ul, gl, af, ol;
@@ -1139,6 +1093,13 @@ bool Welt2000::parse( QString& path,
           lon = -lon;
         }
 
+      // The compiled file contains also the points, which are rejected
+      // by the radius or runway filter. Therefore these filters decide
+      // only about the insertion into the lists. Without a country filter
+      // the radius limits also the compiled file, otherwise it would
+      // contain the whole world.
+      bool passedFilter = true;
+
       if( c_homeRadius > 0.0 )
         {
           // Home radius filter is defined, we will
@@ -1155,7 +1116,12 @@ bool Welt2000::parse( QString& path,
             {
               // Distance is greater than defined radius in GeneralConfig
               // qDebug("Ignoring Dist=%f, AF=%s", d, afName.toLatin1().data());
-              continue;
+              if( doCompile == false || countryDict.isEmpty() )
+                {
+                  continue;
+                }
+
+              passedFilter = false;
             }
         }
 
@@ -1304,7 +1270,13 @@ bool Welt2000::parse( QString& path,
         {
           qDebug( "W2000, Line %d: RWY Filter, %s (%s) RWY %.0fm too short!",
                   lineNo, afName.toLatin1().data(), country.toLatin1().data(), rwLen );
-          continue;
+
+          if( doCompile == false )
+            {
+              continue;
+            }
+
+          passedFilter = false;
         }
 
       // runway surface
@@ -1394,7 +1366,11 @@ bool Welt2000::parse( QString& path,
                    wgsPos, position, rwyList, elevation, fFrequency,
                    country, commentLong );
 
-      if( afType == BaseMapElement::Outlanding )
+      if( passedFilter == false )
+        {
+          // The point is only stored in the compiled file.
+        }
+      else if( afType == BaseMapElement::Outlanding )
         {
           // Add an outlanding site to the list.
           outlandingList.append( af );
@@ -1412,7 +1388,8 @@ bool Welt2000::parse( QString& path,
 
       if( doCompile )
         {
-          counter++;
+          QDataStream& outbuf = writer.record( wgsPos );
+
           // airfield type
           outbuf << quint8( afType );
           // airfield name with country
@@ -1423,8 +1400,6 @@ bool Welt2000::parse( QString& path,
           ShortSave(outbuf, gpsName.toUtf8());
           // WGS84 coordinates
           outbuf << wgsPos;
-          // projected WGS84 coordinates
-          outbuf << position;
           // elevation in meters
           outbuf << qint16( elevation);
           // frequency written as e.g. 126.575, is reduced to 16 bits
@@ -1455,9 +1430,7 @@ bool Welt2000::parse( QString& path,
 
   if( doCompile )
     {
-      buffer.close(); // close our output buffer
-
-      if( counter )
+      if( writer.count() )
         {
           qDebug("W2000: writing file %s", compileFile.toLatin1().data());
 
@@ -1467,9 +1440,8 @@ bool Welt2000::parse( QString& path,
           out << quint16( FILE_VERSION_AIRFIELD_C );
           out << QDateTime::currentDateTime();
           out << c_countryList;
-          out << c_homeRadius;
-          out << c_runwayLengthFilter;
-          out << QPoint( _globalMapMatrix->getHomeCoord() ); // home position
+          out << _globalMapMatrix->getHomeCoord();
+          out << (countryDict.isEmpty() ? c_homeRadius : 0.0);
           out << outlandings;
 
 #ifdef BOUNDING_BOX
@@ -1479,16 +1451,14 @@ bool Welt2000::parse( QString& path,
           out << boundingBox;
 #endif
 
-          SaveProjection( out, _globalMapMatrix->getProjection() );
-
           // write data counters to file
           out << quint32( af );
           out << quint32( gl );
           out << quint32( ul );
           out << quint32( ol );
 
-          // write data on airfields from buffer into the file
-          out << bufdata;
+          // write the bucket directory and the airfield data into the file
+          writer.save( out );
           compFile.close();
         }
       else
@@ -1520,47 +1490,41 @@ bool Welt2000::readCompiledFile( QString &path,
   // get outlanding load flag from configuration data
   bool loadOls = GeneralConfig::instance()->getWelt2000LoadOutlandings();
 
-  QFile inFile(path);
+  // The compiled file is memory mapped.
+  PointCache cache;
 
-  if( !inFile.open(QIODevice::ReadOnly) )
+  if( cache.open( path ) == false )
     {
       qWarning("W2000: Cannot open airfield file %s!", path.toLatin1().data());
       return false;
     }
 
-  QDataStream in(&inFile);
-  in.setVersion( QDataStream::Qt_4_7 );
+  QDataStream& in = cache.stream();
 
   quint32 magic;
   qint8 fileType;
   quint16 fileVersion;
   QDateTime creationDateTime;
   QStringList countryList;
-  double homeRadius;
-  float runwayLengthFilter;
   QPoint homeCoord;
+  double compiledRadius;
   bool outlandings;
 
 #ifdef BOUNDING_BOX
   QRect boundingBox;
 #endif
 
-  ProjectionBase *projectionFromFile;
-
   // Data counter
   quint32 af;
   quint32 gl;
   quint32 ul;
   quint32 ol;
 
-  qint32 buflen;
-
   quint8 afType;
   QString afName;
   QString icao;
   QString gpsName;
   WGSPoint wgsPos;
-  QPoint position;
   qint16 elevation;
   quint16 inFrequency;
   quint16 rwDir; // 0...36, one value in every byte
@@ -1576,7 +1540,6 @@ bool Welt2000::readCompiledFile( QString &path,
   if( magic != KFLOG_FILE_MAGIC )
     {
       qWarning( "W2000: wrong magic key %x read! Aborting ...", magic );
-      inFile.close();
       return false;
     }
 
@@ -1585,7 +1548,6 @@ bool Welt2000::readCompiledFile( QString &path,
   if( fileType != FILE_TYPE_AIRFIELD_C )
     {
       qWarning( "W2000: wrong file type %x read! Aborting ...", fileType );
-      inFile.close();
       return false;
     }
 
@@ -1594,15 +1556,13 @@ bool Welt2000::readCompiledFile( QString &path,
   if( fileVersion != FILE_VERSION_AIRFIELD_C )
     {
       qWarning( "W2000: wrong file version %x read! Aborting ...", fileVersion );
-      inFile.close();
       return false;
     }
 
   in >> creationDateTime;
   in >> countryList;
-  in >> homeRadius;
-  in >> runwayLengthFilter;
   in >> homeCoord;
+  in >> compiledRadius;
   in >> outlandings;
 
   if( loadOls == true && outlandings == false )
@@ -1610,7 +1570,6 @@ bool Welt2000::readCompiledFile( QString &path,
       // We should load outlandings but there are not contained in the
       // compiled file.
       qWarning( "W2000: compiled file contains no outlandings! Aborting ..." );
-      inFile.close();
       return false;
     }
 
@@ -1618,13 +1577,6 @@ bool Welt2000::readCompiledFile( QString &path,
   in >> boundingBox;
 #endif
 
-  projectionFromFile = LoadProjection(in);
-
-  // projectionFromFile is allocated dynamically, we don't need it
-  // here. Therefore it is immediately deleted to avoid memory leaks.
-  delete projectionFromFile;
-  projectionFromFile = 0;
-
   // read element counters
   in >> af;
   in >> gl;
@@ -1647,114 +1599,143 @@ bool Welt2000::readCompiledFile( QString &path,
       outlandingList.reserve( gliderfieldList.size() + ol );
     }
 
-  // Because we're used a buffer during output, the buffer length will
-  // be written too. Now we have to read it but don't need it because
-  // we access directly to the opened file.
-  in >> buflen;
+  if( cache.readDirectory() == false )
+    {
+      return false;
+    }
 
-  uint counter = 0;
+  // Get home radius from the configuration data in kilometers.
+  QPoint home = _globalMapMatrix->getHomeCoord();
+  double homeRadius = GeneralConfig::instance()->getAirfieldHomeRadius() / 1000.;
 
-  while( ! in.atEnd() )
+  if( countryList.isEmpty() && homeRadius == 0.0 )
     {
-      counter++;
-      in >> afType;
-      ShortLoad(in, utf8_temp);
-      afName=QString::fromUtf8(utf8_temp);
+      // Define a default radius of 500Km, if no country filter is defined.
+      homeRadius = 500.0;
+    }
 
-      ShortLoad(in, utf8_temp);
-      icao=QString::fromUtf8(utf8_temp);
-      ShortLoad(in, utf8_temp);
-      gpsName=QString::fromUtf8(utf8_temp);
-      in >> wgsPos;
-      in >> position;
-      in >> elevation;
-      in >> inFrequency;
+  float runwayLengthFilter = GeneralConfig::instance()->getAirfieldRunwayLengthFilter();
 
-      if( inFrequency == 0 )
-        {
-          frequency = 0.0;
-        }
-      else
+  uint counter = 0;
+  int records;
+
+  // Read all buckets within the home radius. The other ones are skipped.
+  while( (records = cache.nextBucket( home, homeRadius )) >= 0 )
+    {
+      for( int r = 0; r < records; r++ )
         {
-          frequency = (((float) inFrequency) / 1000.0) + 100.;
-        }
+          counter++;
+          in >> afType;
+          ShortLoad(in, utf8_temp);
+          afName=QString::fromUtf8(utf8_temp);
+
+          ShortLoad(in, utf8_temp);
+          icao=QString::fromUtf8(utf8_temp);
+          ShortLoad(in, utf8_temp);
+          gpsName=QString::fromUtf8(utf8_temp);
+          in >> wgsPos;
+          in >> elevation;
+          in >> inFrequency;
+
+          if( inFrequency == 0 )
+            {
+              frequency = 0.0;
+            }
+          else
+            {
+              frequency = (((float) inFrequency) / 1000.0) + 100.;
+            }
 
-      in >> rwDir;
-      in >> rwLen;
-      in >> rwSurface;
-      // create an runway object
-      Runway rwy( static_cast<float>(rwLen) ,rwDir, rwSurface, 1 );
+          in >> rwDir;
+          in >> rwLen;
+          in >> rwSurface;
+          // create an runway object
+          Runway rwy( static_cast<float>(rwLen) ,rwDir, rwSurface, 1 );
 
-      // read comment
-      ShortLoad(in, utf8_temp);
-      comment = QString::fromUtf8(utf8_temp);
+          // read comment
+          ShortLoad(in, utf8_temp);
+          comment = QString::fromUtf8(utf8_temp);
 
-      if( comment.startsWith( "FL" ) )
-        {
-          comment = QString( QObject::tr("Emergency Field No: ")) +
-                    comment.mid( 2, 2 );
-        }
+          if( comment.startsWith( "FL" ) )
+            {
+              comment = QString( QObject::tr("Emergency Field No: ")) +
+                        comment.mid( 2, 2 );
+            }
 
-      // read the 2 letter country code
-      ShortLoad(in, utf8_temp);
-      country = QString::fromUtf8(utf8_temp);
+          // read the 2 letter country code
+          ShortLoad(in, utf8_temp);
+          country = QString::fromUtf8(utf8_temp);
 
-      if( loadOls == false && afType == BaseMapElement::Outlanding )
-        {
-          // do not load outlandings
-          continue;
-        }
+          if( loadOls == false && afType == BaseMapElement::Outlanding )
+            {
+              // do not load outlandings
+              continue;
+            }
 
-      QList<Runway> rwyList;
+          if( runwayLengthFilter > 0.0 && rwLen < runwayLengthFilter )
+            {
+              // runway is too short
+              continue;
+            }
 
-      int rwDir1 = rwDir/256;
-      int rwDir2 = rwDir%256;
+          if( homeRadius > 0.0 && MapCalc::dist( &home, &wgsPos ) > homeRadius )
+            {
+              // too far away from home
+              continue;
+            }
 
-      // Check, how many runways do we have
-      if( rwDir == 0 )
-        {
-          // Runway directions undefined
-          rwyList.append( rwy );
-        }
-      else if( rwDir1 == rwDir2 || abs(rwDir1-rwDir2) == 18 )
-        {
-          // WE have only one runway
-          rwyList.append( rwy );
-        }
-      else
-        {
-          // We have two runways
-          int inverseDir = rwDir1 > 18 ? rwDir1-18 : rwDir1 + 18;
-          rwy.m_heading = rwDir1*256 + inverseDir;
-          rwyList.append( rwy );
+          // Project the position to the current map projection.
+          QPoint position = _globalMapMatrix->wgsToMap( wgsPos );
 
-          inverseDir = rwDir2 > 18 ? rwDir2-18 : rwDir2 + 18;
-          rwy.m_heading = rwDir2*256 + inverseDir;
-          rwyList.append( rwy );
-        }
+          QList<Runway> rwyList;
 
-      Airfield af( afName, icao, gpsName, (BaseMapElement::objectType) afType,
-                   wgsPos, position, rwyList, elevation, frequency, country, comment );
+          int rwDir1 = rwDir/256;
+          int rwDir2 = rwDir%256;
 
-      if( afType == BaseMapElement::Gliderfield )
-        {
-        // Add a glider site to the list.
-          gliderfieldList.append( af );
-        }
-      else if( afType == BaseMapElement::Outlanding )
-        {
-          // Add an outlanding site to the list.
-          outlandingList.append( af );
-        }
-      else
-        {
-          // Add an airfield site to the list.
-          airfieldList.append( af );
+          // Check, how many runways do we have
+          if( rwDir == 0 )
+            {
+              // Runway directions undefined
+              rwyList.append( rwy );
+            }
+          else if( rwDir1 == rwDir2 || abs(rwDir1-rwDir2) == 18 )
+            {
+              // WE have only one runway
+              rwyList.append( rwy );
+            }
+          else
+            {
+              // We have two runways
+              int inverseDir = rwDir1 > 18 ? rwDir1-18 : rwDir1 + 18;
+              rwy.m_heading = rwDir1*256 + inverseDir;
+              rwyList.append( rwy );
+
+              inverseDir = rwDir2 > 18 ? rwDir2-18 : rwDir2 + 18;
+              rwy.m_heading = rwDir2*256 + inverseDir;
+              rwyList.append( rwy );
+            }
+
+          Airfield af( afName, icao, gpsName, (BaseMapElement::objectType) afType,
+                       wgsPos, position, rwyList, elevation, frequency, country, comment );
+
+          if( afType == BaseMapElement::Gliderfield )
+            {
+            // Add a glider site to the list.
+              gliderfieldList.append( af );
+            }
+          else if( afType == BaseMapElement::Outlanding )
+            {
+              // Add an outlanding site to the list.
+              outlandingList.append( af );
+            }
+          else
+            {
+              // Add an airfield site to the list.
+              airfieldList.append( af );
+            }
         }
     }
 
-  inFile.close();
-
   qDebug( "W2000: %d airfields read from %s in %dms",
           counter, basename(path.toLatin1().data()), t.elapsed() );
 
@@ -1773,19 +1754,10 @@ bool Welt2000::setHeaderData( QString &path )
   h_fileType = 0;
   h_fileVersion = 0;
   h_countryList.clear();
+  h_homeCoord = QPoint();
   h_homeRadius = 0.0;
-  h_runwayLengthFilter = 0.0;
-  h_homeCoord.setX(0);
-  h_homeCoord.setY(0);
   h_outlandings = false;
 
-  if( h_projection )
-    {
-      // delete an older projection object
-      delete  h_projection;
-      h_projection = 0;
-    }
-
   QFile inFile(path);
   if( !inFile.open(QIODevice::ReadOnly) )
     {
@@ -1825,9 +1797,8 @@ bool Welt2000::setHeaderData( QString &path )
 
   in >> h_creationDateTime;
   in >> h_countryList;
-  in >> h_homeRadius;
-  in >> h_runwayLengthFilter;
   in >> h_homeCoord;
+  in >> h_homeRadius;
   in >> h_outlandings;
 
 #ifdef BOUNDING_BOX
@@ -1835,8 +1806,6 @@ bool Welt2000::setHeaderData( QString &path )
   in >> h_boundingBox;
 #endif
 
-  h_projection = LoadProjection(in);
-
   inFile.close();
   h_headerIsValid = true; // save read result here too
   return true;
@@ -46,12 +46,17 @@
  **      modification time. If one of them is younger a reparsing of the
  **      source file is started.
  **
- **   c) If the compiled file was generated by using 1000Km radius, home
- **      position change is checked. If true, a reparsing of the source
- **      file is started.
+ **   c) The country filter and the outlanding flag are checked against
+ **      the configuration. Differences cause a reparsing of the source.
  **
- **   d) If map projection type or data have been changed, a reparsing
- *       of the source file is started.
+ **   d) If no country filter is defined, the compiled file contains only
+ **      the points inside the home radius, otherwise it would contain the
+ **      whole world (about 2MB, which is memory mapped during reading). A
+ **      home position change or a greater home radius causes a reparsing.
+ **
+ **   The compiled file stores WGS84 coordinates only, grouped in spatial
+ **   buckets. Home radius, runway length filter and map projection are
+ **   applied during reading, so changes of them need no reparsing.
  **
  **   If a source file parsing is necessary, it is first checked, if a
  **   new original source file has been installed. Such a file
@@ -284,12 +289,10 @@ class Welt2000
   quint16 h_fileVersion;
   QDateTime h_creationDateTime;
   QStringList h_countryList;
-  double h_homeRadius;
-  float h_runwayLengthFilter;
-  QPoint h_homeCoord;
+  QPoint h_homeCoord;  // home position used at compile time
+  double h_homeRadius; // radius used at compile time, 0 if not limited
   QRect h_boundingBox;
   bool h_outlandings; // Flag to indicate outlandings contained or not
-  ProjectionBase *h_projection;
   bool h_headerIsValid;
 
   /** Mutex to ensure thread safety. */
@@ -15,57 +15,65 @@
  ***********************************************************************/
 
 #include <cmath>
+#include <cstring>
 
 #include <QtGlobal>
 
 #include "windanalyser.h"
 #include "mapcalc.h"
 #include "generalconfig.h"
+#include "replaybenchmark.h"
 
 /*
   About Wind analysis
 
-  Currently, the wind is analyzed by finding the minimum and the maximum
-  ground speeds measured while flying a circle. The direction of the wind is taken
-  to be the direction in which the speed reaches it's maximum value, the speed
-  is half the difference between the maximum and the minimum speeds measured.
-  A quality parameter, based on the number of circles already flown (the first
-  circles are taken to be less accurate) and the angle between the headings at
-  minimum and maximum speeds, is calculated in order to be able to weigh the
-  resulting measurement. This method do not more work for wind speeds < 5Km/h.
-
-  There are other options for determining the wind speed. You could for instance
-  add all the vectors in a circle, and take the resulting vector as the wind speed.
-  This is a more complex method, but because it is based on more heading/speed
-  measurements by the GPS, it is probably more accurate. If equipped with
-  instruments that pass along airspeed, the calculations can be compensated for
-  changes in airspeed, resulting in better measurements. We are now assuming
-  the pilot flies in perfect circles with constant airspeed, which is of course
-  not a safe assumption.
-  The quality indication we are calculation can also be approached differently,
-  by calculating how constant the speed in the circle would be if corrected for
-  the wind speed we just derived. The more constant, the better. This is again
-  more CPU intensive, but may produce better results.
+  During circling the ground speed vectors of a turn lie on a circle. The center
+  of the circle is the wind vector, the radius is the true air speed. The
+  vectors are collected in sectors of the ground track, every sector keeps the
+  mean of its vectors. After every half circle a circle is fitted to the sector
+  means by a linear least squares fit (Kasa method). The sectors keep their
+  content during the whole turn, so that every new measurement is based on all
+  flown circles. The sector means prevent an overweight of the slow upwind part
+  of the circle, where more samples are taken.
+
+  The quality of a measurement is derived from the deviation of the sector means
+  from the fitted circle. The first circle is taken to be less accurate.
+
+  During cruising the wind can only be determined, if the true air speed is
+  delivered by an external device. Then every sample fulfills the equation
+
+    |ground speed vector - wind vector| = true air speed
+
+  that is linear in the wind components and the square of the wind speed. The
+  equations of the last samples are solved in the least squares sense, whereby
+  older samples are weighted down. A solution needs some changes of the ground
+  track, hence the measurements have a lower quality as the circle fit.
 
   Some of the errors made here will be averaged-out by the WindStore, which keeps
   a number of wind measurements and calculates a weighted average based on quality.
 */
 
+// Forgetting factor per sample of the cruise estimator.
+#define CRUISE_FORGETTING 0.98
+
 WindAnalyser::WindAnalyser(QObject* parent) :
   QObject(parent),
   active(false),
-  circleCount(0),
+  halfCircles(0),
   circleLeft(false),
   circleDegrees(0),
-  circleSectors(0),
   lastHeading(-1),
   satCnt(0),
   minSatCnt(4),
   ciclingMode(false),
+  cruisingMode(false),
   gpsStatus(GpsNmea::notConnected)
 {
   // Initialization
   minSatCnt = GeneralConfig::instance()->getWindMinSatCount();
+
+  resetCircleFit();
+  resetCruiseFit();
 }
 
 WindAnalyser::~WindAnalyser()
@@ -74,12 +82,26 @@ WindAnalyser::~WindAnalyser()
 /** Called if a new sample is available in the sample list. */
 void WindAnalyser::slot_newSample()
 {
+  ReplayBenchmark::Probe probe( ReplayBenchmark::StageWind );
+
   if( ! active )
     {
       return; // do only work if we are in active mode
     }
 
-  Vector &curVec = calculator->samplelist[0].vector;
+  Vector curVec = calculator->samplelist.vector( 0 );
+
+  if( cruisingMode )
+    {
+      Speed& tas = calculator->getlastTas();
+
+      if( calculator->isTasMeasured() && tas.isValid() && tas.getMps() > 0.0 )
+        {
+          addCruiseSample( curVec, tas.getMps() );
+        }
+
+      return;
+    }
 
   // circle detection
   if( lastHeading != -1 )
@@ -94,84 +116,69 @@ void WindAnalyser::slot_newSample()
         }
 
       circleDegrees += diff;
-      circleSectors++;
-    }
-  else
-    {
-      minVector = curVec;
-      maxVector = curVec;
     }
 
   lastHeading = curVec.getAngleDeg();
 
-  if( curVec.getSpeed().getMps() < minVector.getSpeed().getMps() )
-    {
-      // New minimum speed detected
-      minVector = curVec;
-    }
-
-  if( curVec.getSpeed().getMps() > maxVector.getSpeed().getMps() )
-    {
-      // New maximum speed detected
-      maxVector = curVec;
-    }
-
-  /*
-  qDebug( "curVec: %.3f/%dGrad, minVec: %.3f/%dGrad, maxVec: %.3f/%dGrad",
-         curVec.getSpeed().getKph(), curVec.getAngleDeg(),
-         minVector.getSpeed().getKph(), minVector.getAngleDeg(),
-         maxVector.getSpeed().getKph(), maxVector.getAngleDeg() );
-  */
+  addCircleSample( curVec );
 
-  if( circleDegrees > 360 )
+  if( circleDegrees > 180 )
     {
-      // full circle made!
-      // increase the number of circles flown (used to determine the quality)
-      circleCount++;
+      // half circle made!
+      // increase the number of half circles flown (used to determine the quality)
+      halfCircles++;
+      circleDegrees -= 180;
 
-      // calculate the wind for this circle
-      _calcWind();
-
-      circleDegrees = 0;
-      circleSectors = 0;
-
-      minVector = curVec;
-      maxVector = curVec;
+      if( halfCircles >= 2 )
+        {
+          // calculate the wind from all circles of this turn
+          calcCircleWind();
+        }
     }
 }
 
 /** Called if the flight mode changes */
 void WindAnalyser::slot_newFlightMode( Calculator::FlightMode newFlightMode )
 {
-  // Reset the circle counter for each flight mode change. The important thing
+  // Reset the circle fit for each flight mode change. The important thing
   // to measure is the number of turns in a thermal per turn direction.
-  circleCount   = 0;
-  circleDegrees = 0;
-  circleSectors = 0;
-  lastHeading   = -1;
+  resetCircleFit();
 
   // We are inactive as default.
   active = false;
+  ciclingMode = false;
 
   if( newFlightMode == Calculator::circlingL )
     {
       circleLeft = true;
+      ciclingMode = true;
     }
   else if( newFlightMode == Calculator::circlingR )
     {
       circleLeft = false;
+      ciclingMode = true;
+    }
+
+  if( newFlightMode == Calculator::cruising )
+    {
+      if( cruisingMode == false )
+        {
+          resetCruiseFit();
+        }
+
+      cruisingMode = true;
     }
   else
     {
-      ciclingMode = false;
+      cruisingMode = false;
+    }
 
-      // Ok, so we are not circling.
+  if( ciclingMode == false && cruisingMode == false )
+    {
+      // Ok, so we are not flying.
       return;
     }
 
-  // Set circle mode to true.
-  ciclingMode = true;
-
   // Do we have enough satellites in view? The minimum should be four. Otherwise
   // the calculated wind results are very bad.
   if( satCnt < minSatCnt )
@@ -189,68 +196,325 @@ void WindAnalyser::slot_newFlightMode( Calculator::FlightMode newFlightMode )
   active = true;
 }
 
-void WindAnalyser::_calcWind()
+void WindAnalyser::resetCircleFit()
 {
-  // int degreePerStep = circleDegrees / circleSectors;
+  halfCircles   = 0;
+  circleDegrees = 0;
+  lastHeading   = -1;
 
-  int aDiff = rint(MapCalc::angleDiff( minVector.getAngleDeg(), maxVector.getAngleDeg() ));
+  for( int i = 0; i < Sectors; i++ )
+    {
+      sectors[i].count = 0;
+      sectors[i].vx = 0.0;
+      sectors[i].vy = 0.0;
+    }
+}
 
-  /*
-    Determine quality.
+void WindAnalyser::addCircleSample( Vector& groundVector )
+{
+  Sector& sector = sectors[ (MapCalc::normalize( groundVector.getAngleDeg() ) * Sectors / 360) % Sectors ];
 
-    Currently, we are using the question how well the min and the max vectors
-    are on opposing sides of the circle to determine the quality. 140 degrees is
-    the minimum separation, 180 is ideal.
-    Furthermore, the first two circles are considered to be of lesser quality.
-  */
+  // The mean becomes a moving average after some samples, so that a slow
+  // change of the wind is followed.
+  if( sector.count < SectorMemory )
+    {
+      sector.count++;
+    }
 
-  int quality = 5 - ((180 - abs( aDiff )) / 8);
+  sector.vx += (groundVector.getXMps() - sector.vx) / sector.count;
+  sector.vy += (groundVector.getYMps() - sector.vy) / sector.count;
+}
+
+void WindAnalyser::calcCircleWind()
+{
+  // Sums of the least squares fit of x^2 + y^2 + D*x + E*y + F = 0
+  double m[3][3] = { { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 0.0 } };
+  double b[3] = { 0.0, 0.0, 0.0 };
+  int filled = 0;
+
+  for( int i = 0; i < Sectors; i++ )
+    {
+      if( sectors[i].count == 0 )
+        {
+          continue;
+        }
+
+      double x = sectors[i].vx;
+      double y = sectors[i].vy;
+      double z = x * x + y * y;
+
+      m[0][0] += x * x;
+      m[0][1] += x * y;
+      m[0][2] += x;
+      m[1][1] += y * y;
+      m[1][2] += y;
+      m[2][2] += 1.0;
+
+      b[0] -= x * z;
+      b[1] -= y * z;
+      b[2] -= z;
+
+      filled++;
+    }
+
+  if( filled < MinSectors )
+    {
+      // The circle is not covered good enough.
+      return;
+    }
+
+  m[1][0] = m[0][1];
+  m[2][0] = m[0][2];
+  m[2][1] = m[1][2];
+
+  double def[3];
+
+  if( solve3( m, b, def ) == false )
+    {
+      return;
+    }
+
+  // Center of the circle is the wind, the radius is the true air speed.
+  double cx = -def[0] / 2.0;
+  double cy = -def[1] / 2.0;
+  double r2 = cx * cx + cy * cy - def[2];
 
-  if( circleCount < 2 )
+  if( r2 <= 0.0 )
     {
+      return;
+    }
+
+  double radius = sqrt( r2 );
+  double windSpeed = sqrt( cx * cx + cy * cy );
+
+  if( radius < 8.0 || radius > 60.0 || windSpeed > 0.8 * radius )
+    {
+      // Not plausible for a glider.
+      return;
+    }
+
+  // Determine the quality from the deviation of the sector means from the circle.
+  double sum = 0.0;
+
+  for( int i = 0; i < Sectors; i++ )
+    {
+      if( sectors[i].count > 0 )
+        {
+          double dx = sectors[i].vx - cx;
+          double dy = sectors[i].vy - cy;
+          double d  = sqrt( dx * dx + dy * dy ) - radius;
+
+          sum += d * d;
+        }
+    }
+
+  double ratio = sqrt( sum / filled ) / radius;
+
+  int quality;
+
+  if( ratio < 0.02 )
+    {
+      quality = 5;
+    }
+  else if( ratio < 0.04 )
+    {
+      quality = 4;
+    }
+  else if( ratio < 0.07 )
+    {
+      quality = 3;
+    }
+  else if( ratio < 0.11 )
+    {
+      quality = 2;
+    }
+  else if( ratio < 0.16 )
+    {
+      quality = 1;
+    }
+  else
+    {
+      return; // Measurement quality too low
+    }
+
+  if( halfCircles < 4 )
+    {
+      // The first circle is probably not very round.
       quality--;
     }
 
-  if( circleCount < 1 )
+  if( filled < Sectors )
     {
       quality--;
     }
 
-  // qDebug() << "WindQuality=" << quality;
+  // qDebug() << "WindQuality=" << quality << "ratio=" << ratio;
 
   if( quality < 1 )
     {
       return; // Measurement quality too low
     }
 
-  // 5 is maximum quality, make sure we honor that.
-  quality = qMin( quality, 5 );
+  // The wind vector points to the direction, where the wind comes from.
+  Vector result( -cx, -cy );
 
-  // Invert maxVector angle
-  maxVector.setAngle( MapCalc::normalize( maxVector.getAngleDeg() + 180 ) );
+  // Let the world know about our measurement!
+  // qDebug("### ComputedWind: %dGrad/%.0fKm/h", result.getAngleDeg(), result.getSpeed().getKph());
 
-  // take both directions for min and max vector into account
-  /*
-  qDebug( "maxAngle=%d/%.0f minAngle=%d/%.0f",
-           maxVector.getAngleDeg(), maxVector.getSpeed().getKph(),
-           minVector.getAngleDeg(), minVector.getSpeed().getKph() );
-  */
+  emit newMeasurement( result, quality );
+}
 
-  // create a vector object for the resulting wind
-  Vector result;
+void WindAnalyser::resetCruiseFit()
+{
+  memset( &cruise, 0, sizeof(cruise) );
+}
 
-  // the direction of the wind is the direction where the greatest speed occurred
-  result.setAngle( ( maxVector.getAngleDeg() + minVector.getAngleDeg() ) / 2);
+void WindAnalyser::addCruiseSample( Vector& groundVector, const double tas )
+{
+  double gx = groundVector.getXMps();
+  double gy = groundVector.getYMps();
 
-  // The speed of the wind is half the difference between the minimum and the maximum speeds.
-  result.setSpeed( (maxVector.getSpeed().getMps() - minVector.getSpeed().getMps()) / 2.0 );
+  // Equation of the sample: 2*gx*wx + 2*gy*wy - |w|^2 = |g|^2 - tas^2
+  double a[3] = { 2.0 * gx, 2.0 * gy, -1.0 };
+  double b = gx * gx + gy * gy - tas * tas;
 
-  // Let the world know about our measurement!
-  // qDebug("### ComputedWind: %dGrad/%.0fKm/h", result.getAngleDeg(), result.getSpeed().getKph());
+  const double f = CRUISE_FORGETTING;
+
+  for( int i = 0; i < 3; i++ )
+    {
+      for( int j = 0; j < 3; j++ )
+        {
+          cruise.aa[i][j] = f * cruise.aa[i][j] + a[i] * a[j];
+        }
+
+      cruise.ab[i] = f * cruise.ab[i] + a[i] * b;
+    }
+
+  cruise.bb     = f * cruise.bb + b * b;
+  cruise.ux     = f * cruise.ux + cos( groundVector.getAngleRad() );
+  cruise.uy     = f * cruise.uy + sin( groundVector.getAngleRad() );
+  cruise.weight = f * cruise.weight + 1.0;
+  cruise.samples++;
+
+  if( cruise.samples % CruiseInterval == 0 )
+    {
+      calcCruiseWind();
+    }
+}
+
+void WindAnalyser::calcCruiseWind()
+{
+  // The mean resultant length of the track directions is near to 1, if the
+  // track was nearly constant. Then the wind cannot be separated from the
+  // true air speed.
+  double spread = sqrt( cruise.ux * cruise.ux + cruise.uy * cruise.uy ) / cruise.weight;
+
+  if( spread > 0.97 )
+    {
+      return;
+    }
+
+  double x[3];
+
+  if( solve3( cruise.aa, cruise.ab, x ) == false )
+    {
+      return;
+    }
+
+  double tas = calculator->getlastTas().getMps();
+  double windSpeed2 = x[0] * x[0] + x[1] * x[1];
+
+  if( tas <= 0.0 || sqrt( windSpeed2 ) > 0.7 * tas )
+    {
+      // Not plausible.
+      return;
+    }
+
+  // Residual of the least squares solution and the consistency of the third
+  // unknown with the wind components, both converted into a speed error.
+  double sse = cruise.bb;
+
+  for( int i = 0; i < 3; i++ )
+    {
+      sse -= 2.0 * x[i] * cruise.ab[i];
+
+      for( int j = 0; j < 3; j++ )
+        {
+          sse += x[i] * cruise.aa[i][j] * x[j];
+        }
+    }
+
+  double error = qMax( sqrt( qMax( sse, 0.0 ) / cruise.weight ),
+                       fabs( x[2] - windSpeed2 ) ) / (2.0 * tas);
+
+  if( error > 2.0 )
+    {
+      return; // Measurement quality too low
+    }
+
+  // The cruise estimate is weaker as a circle fit.
+  int quality = 3;
+
+  if( spread > 0.85 )
+    {
+      quality--;
+    }
+
+  if( spread > 0.93 )
+    {
+      quality--;
+    }
+
+  if( error > 1.0 )
+    {
+      quality--;
+    }
+
+  if( quality < 1 )
+    {
+      return; // Measurement quality too low
+    }
+
+  // The wind vector points to the direction, where the wind comes from.
+  Vector result( -x[0], -x[1] );
+
+  // qDebug("### CruiseWind: %dGrad/%.0fKm/h Q=%d", result.getAngleDeg(), result.getSpeed().getKph(), quality);
 
   emit newMeasurement( result, quality );
 }
 
+bool WindAnalyser::solve3( const double m[3][3], const double b[3], double x[3] )
+{
+  // Cramer's rule is good enough for such a small system.
+  double det = m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1]) -
+               m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0]) +
+               m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+
+  if( fabs( det ) < 1e-9 )
+    {
+      return false;
+    }
+
+  for( int k = 0; k < 3; k++ )
+    {
+      double c[3][3];
+
+      for( int i = 0; i < 3; i++ )
+        {
+          for( int j = 0; j < 3; j++ )
+            {
+              c[i][j] = (j == k) ? b[i] : m[i][j];
+            }
+        }
+
+      x[k] = ( c[0][0] * (c[1][1] * c[2][2] - c[1][2] * c[2][1]) -
+               c[0][1] * (c[1][0] * c[2][2] - c[1][2] * c[2][0]) +
+               c[0][2] * (c[1][0] * c[2][1] - c[1][1] * c[2][0]) ) / det;
+    }
+
+  return true;
+}
+
 void WindAnalyser::slot_newConstellation( SatInfo& newConstellation )
 {
   satCnt = newConstellation.satsInView;
@@ -262,15 +526,13 @@ void WindAnalyser::slot_newConstellation( SatInfo& newConstellation )
       return;
     }
 
-  if( !active && ciclingMode && satCnt >= minSatCnt )
+  if( !active && (ciclingMode || cruisingMode) && satCnt >= minSatCnt )
     {
       // we are not active because we had low satellite count but that has been
       // changed now. So we become active.
       // Initialize analyzer-parameters
-      circleCount   = 0;
-      circleDegrees = 0;
-      circleSectors = 0;
-      lastHeading   = -1;
+      resetCircleFit();
+      resetCruiseFit();
     }
 }
 
@@ -285,14 +547,12 @@ void WindAnalyser::slot_gpsStatusChange( GpsNmea::GpsStatus newStatus )
       return;
     }
 
-  if( !active && ciclingMode )
+  if( !active && (ciclingMode || cruisingMode) )
     {
       // we are not active because we had no GPS fix but that has been
       // changed now. So we become active.
       // Initialize analyzer-parameters
-      circleCount   = 0;
-      circleDegrees = 0;
-      circleSectors = 0;
-      lastHeading   = -1;
+      resetCircleFit();
+      resetCruiseFit();
     }
 }
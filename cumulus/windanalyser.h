@@ -24,7 +24,10 @@
  * \brief wind analyzer
  *
  * The wind analyzer processes the list of flight samples looking
- * for wind speed and direction.
+ * for wind speed and direction. During circling a circle is fitted to the
+ * ground speed vectors of the turn. During cruising the wind is estimated
+ * from the true air speed and the ground track, if the true air speed is
+ * delivered by an external device.
  *
  * \date 2002-2010
  */
@@ -83,21 +86,83 @@ public slots:
 
 private:
 
-  void _calcWind();
+  /** Number of track sectors of the circle fit. */
+  enum { Sectors = 12 };
+
+  /** Minimum number of filled sectors for a circle fit. */
+  enum { MinSectors = 9 };
+
+  /** Number of samples, after that a sector mean becomes a moving average. */
+  enum { SectorMemory = 8 };
+
+  /** Number of cruise samples between two cruise wind measurements. */
+  enum { CruiseInterval = 30 };
+
+  /**
+   * Mean ground speed vector of all samples, whose track lies in the
+   * sector.
+   */
+  struct Sector
+  {
+    int    count;
+    double vx;
+    double vy;
+  };
+
+  /**
+   * Sums of the least squares problem of the cruise estimator. The unknowns
+   * are the wind components and the square of the wind speed. Older samples
+   * are weighted down by a forgetting factor.
+   */
+  struct CruiseSums
+  {
+    double aa[3][3];
+    double ab[3];
+    double bb;
+    double ux;
+    double uy;
+    double weight;
+    int    samples;
+  };
+
+  /** Resets the circle fit. */
+  void resetCircleFit();
+
+  /** Adds a ground speed vector to its sector. */
+  void addCircleSample( Vector& groundVector );
+
+  /** Fits a circle to the sector means and emits the resulting wind. */
+  void calcCircleWind();
+
+  /** Resets the cruise estimator. */
+  void resetCruiseFit();
+
+  /** Adds a ground speed vector together with the true air speed. */
+  void addCruiseSample( Vector& groundVector, const double tas );
+
+  /** Solves the cruise estimator and emits the resulting wind. */
+  void calcCruiseWind();
+
+  /**
+   * Solves the symmetric 3x3 equation system m * x = b.
+   *
+   * @return false, if the system is singular
+   */
+  static bool solve3( const double m[3][3], const double b[3], double x[3] );
 
   /** active is set to true or false by the slot_newFlightMode slot. */
   bool active;
-  int circleCount; // we are counting the number of circles, the first onces are probably not very round
+  int halfCircles; // we are counting the half circles, the first ones are probably not very round
   bool circleLeft; // true=left, false=right
-  int circleDegrees; // Degrees of current flown circle
-  int circleSectors; // Sectors of current flown circle
+  int circleDegrees; // Degrees of current flown half circle
   int lastHeading; // Last processed heading
   int satCnt;
   int minSatCnt;
   bool ciclingMode;
+  bool cruisingMode;
   GpsNmea::GpsStatus gpsStatus;
-  Vector minVector;
-  Vector maxVector;
+  Sector sectors[Sectors];
+  CruiseSums cruise;
 };
 
 #endif
@@ -222,8 +222,8 @@ void WpEditDialog::accept()
           return;
         }
 
-      // Update old waypoint object
-      *m_wp = newWp;
+      // Update old waypoint object and the waypoint index of the global list.
+      _globalMapContents->updateWaypointInList( *m_wp, newWp );
 
       // The modified waypoint is posted to the subscribers
       emit wpEdited( *m_wp );
@@ -25,6 +25,8 @@ CONFIG += flarm
 
 HEADERS = \
   gpsclient.h \
+  gpssource.h \
+  nmeaframer.h \
   ../cumulus/ipc.h \
   ../cumulus/protocol.h \
   ../cumulus/signalhandler.h
@@ -32,6 +34,8 @@ HEADERS = \
 SOURCES = \
   gpsclient.cpp \
   gpsmain.cpp \
+  gpssource.cpp \
+  nmeaframer.cpp \
   ../cumulus/ipc.cpp \
   ../cumulus/signalhandler.cpp
 
@@ -37,6 +37,8 @@ CONFIG += flarm
 
 HEADERS = \
   gpsclient.h \
+  gpssource.h \
+  nmeaframer.h \
   ../cumulus/ipc.h \
   ../cumulus/protocol.h \
   ../cumulus/signalhandler.h
@@ -44,6 +46,8 @@ HEADERS = \
 SOURCES = \
   gpsclient.cpp \
   gpsmain.cpp \
+  gpssource.cpp \
+  nmeaframer.cpp \
   ../cumulus/ipc.cpp \
   ../cumulus/signalhandler.cpp
 
@@ -61,6 +61,12 @@
 // Define connection lost timeout in milli seconds
 #define TO_CONLOST  10000
 
+// Define reopen delay of an additional source in milli seconds
+#define TO_RETRY     5000
+
+// Define report interval of the source statistics in milli seconds
+#define TO_STATS    60000
+
 
 GpsClient::GpsClient( const ushort portIn )
 {
@@ -72,11 +78,12 @@ GpsClient::GpsClient( const ushort portIn )
   forwardGpsData   = true;
   connectionLost   = true;
   shutdown         = false;
-  datapointer      = databuffer;
-  dbsize           = 0;
+  fdGeneration     = 0;
   badSentences     = 0;
   activateTimeout  = false;
 
+  statsTime.start();
+
   // establish a connection to the server
   if( ipcPort )
     {
@@ -106,23 +113,30 @@ GpsClient::GpsClient( const ushort portIn )
 
 GpsClient::~GpsClient()
 {
+  closeSources();
   closeGps();
   clientData.closeSock();
   clientForward.closeSock();
 }
 
 /**
- * Return all currently used read file descriptors as mask, usable by the
- * select call
+ * Return all currently used read file descriptors.
  */
-fd_set *GpsClient::getReadFdMask()
+void GpsClient::getReadFds( QVector<int>& fds )
 {
-  // Reset file descriptor mask bits
-  FD_ZERO( &fdMask );
+  fds.clear();
 
   if( fd != -1 ) // serial device
     {
-      FD_SET( fd, &fdMask );
+      fds.append( fd );
+    }
+
+  for( int i = 0; i < sources.size(); i++ ) // additional sources
+    {
+      if( sources.at(i)->getFd() != -1 )
+        {
+          fds.append( sources.at(i)->getFd() );
+        }
     }
 
   if( ipcPort ) // command data channel to server
@@ -131,59 +145,52 @@ fd_set *GpsClient::getReadFdMask()
 
       if( sfd != -1 )
         {
-          FD_SET( sfd, &fdMask );
+          fds.append( sfd );
         }
     }
-
-  return &fdMask;
 }
 
-// Processes incoming read events. They can come from the server or
+// Processes an incoming read event. It can come from the server or
 // from the GPS device.
-void GpsClient::processEvent( fd_set *fdMask )
+void GpsClient::processEvent( const int fdIn )
 {
-  if( ipcPort )
+  if( ipcPort && fdIn == clientData.getSock() )
     {
-      int sfd = clientData.getSock();
-
-      if( sfd != -1 && FD_ISSET( sfd, fdMask ) )
+      // The event loop is edge triggered, hence all messages must be read,
+      // which are in the socket receiver buffer.
+      while( true )
         {
-          int loops = 0;
+          readServerMsg();
 
-          // Try to process several messages from the client in order. That
-          // is more effective as to wait for a new select call.
-          while( loops++ < 32 )
+          if( shutdown == true )
             {
-              readServerMsg();
-
-              if( shutdown == true )
-                {
-                  break;
-                }
+              break;
+            }
 
-              // Check, if more bytes are available in the receiver buffer because we
-              // use blocking IO.
-              int bytes = 0;
+          // Check, if more bytes are available in the receiver buffer because we
+          // use blocking IO.
+          int bytes = 0;
 
-              // Number of bytes currently in the socket receiver buffer.
-              if( ioctl( sfd, FIONREAD, &bytes) == -1 )
-                {
-                  qWarning() << "GpsClient::processEvent():"
-                              << "ioctl() returns with Errno="
-                              << errno
-                              << "," << strerror(errno);
-                  break;
-                }
+          // Number of bytes currently in the socket receiver buffer.
+          if( ioctl( fdIn, FIONREAD, &bytes) == -1 )
+            {
+              qWarning() << "GpsClient::processEvent():"
+                          << "ioctl() returns with Errno="
+                          << errno
+                          << "," << strerror(errno);
+              break;
+            }
 
-              if( bytes <= 0 )
-                {
-                  break;
-                }
+          if( bytes <= 0 )
+            {
+              break;
             }
         }
+
+      return;
     }
 
-  if( fd != -1 && FD_ISSET( fd, fdMask ) )
+  if( fd != -1 && fdIn == fd )
     {
       if( readGpsData() == false )
         {
@@ -205,6 +212,17 @@ void GpsClient::processEvent( fd_set *fdMask )
               openGps( device.data(), ioSpeedDevice );
             }
         }
+
+      return;
+    }
+
+  for( int i = 0; i < sources.size(); i++ )
+    {
+      if( sources.at(i)->getFd() == fdIn )
+        {
+          readSourceData( sources.at(i) );
+          return;
+        }
     }
 }
 
@@ -216,45 +234,47 @@ bool GpsClient::readGpsData()
       return false;
     }
 
-  // First check, if enough space is available in the receiver buffer.
-  // If we read only trash for a while we can run in a dead lock.
-  int freeSpace = sizeof(databuffer) - dbsize;
+  bool result = true;
 
-  if( freeSpace < 10 )
+  // All available GPS data are read until the device would block. The
+  // sentences are collected and forwarded by forwardSentences().
+  while( true )
     {
-      // Reset buffer pointer because the minimal free buffer space is
-      // reached. That will discard all already read data but we never
-      // read a end of line. That is our emergency break.
-      datapointer = databuffer;
-      dbsize = 0;
-    }
+      int bytes = framer.readFrom( fd );
 
-  // all available GPS data lines are read successive
-  int bytes = 0;
+      if( bytes == -1 && errno == EINTR )
+        {
+          continue;
+        }
+
+      if( bytes == -1 && (errno == EAGAIN || errno == EWOULDBLOCK) )
+        {
+          // All data are read.
+          break;
+        }
 
-  bytes = read( fd, datapointer, sizeof(databuffer) - dbsize -1 );
+      if( bytes == 0 ) // Nothing read, should normally not happen
+        {
+          qWarning() << "GpsClient::readGpsData(): 0 bytes read!";
+          result = false;
+          break;
+        }
 
-  if( bytes == 0 ) // Nothing read, should normally not happen
-    {
-      qWarning() << "GpsClient::readGpsData(): 0 bytes read!";
-      return false;
-    }
+      if( bytes == -1 )
+        {
+          int error = errno;
 
-  if( bytes == -1 )
-    {
-      qWarning() << "GpsClient::readGpsData(): Read error"
-                  << errno << "," << strerror(errno);
-      return false;
-    }
+          qWarning() << "GpsClient::readGpsData(): Read error"
+                      << errno << "," << strerror(errno);
 
-  if( bytes > 0 )
-    {
-      dbsize      += bytes;
-      datapointer += bytes;
+          errno = error;
+          result = false;
+          break;
+        }
 
-      databuffer[dbsize] = '\0'; // terminate buffer with a null
+      primaryStats.bytes += bytes;
 
-      readSentenceFromBuffer();
+      collectSentences( framer, primaryStats, GpsSource::monotonicTime() );
 
 #ifdef FLARM
 
@@ -269,7 +289,96 @@ bool GpsClient::readGpsData()
       connectionLost = false;
     }
 
-  return true;
+  return result;
+}
+
+/**
+ * Reads all available data of an additional source. The source is closed
+ * in error case and reopened later by the timeout controller.
+ */
+void GpsClient::readSourceData( GpsSource* source )
+{
+  NmeaFramer& sourceFramer = source->getFramer();
+
+  while( true )
+    {
+      int bytes = sourceFramer.readFrom( source->getFd() );
+
+      if( bytes == -1 && errno == EINTR )
+        {
+          continue;
+        }
+
+      if( bytes == -1 && (errno == EAGAIN || errno == EWOULDBLOCK) )
+        {
+          // All data are read.
+          break;
+        }
+
+      if( bytes <= 0 )
+        {
+          // End of file or a refused TCP connection.
+          qWarning() << "GpsClient::readSourceData():" << source->getDevice()
+                     << "read error" << errno << "," << strerror(errno);
+
+          closeSource( source );
+          source->touch(); // set next retry time point
+          break;
+        }
+
+      source->getStats().bytes += bytes;
+      source->touch();
+
+      collectSentences( sourceFramer, source->getStats(),
+                        GpsSource::monotonicTime() );
+    }
+}
+
+/**
+ * Forwards all collected sentences of all sources as one batch message to
+ * the server. The sentences are ordered by their receive time.
+ */
+void GpsClient::forwardSentences()
+{
+  if( arrivals.isEmpty() )
+    {
+      return;
+    }
+
+  // A stable sort keeps the order of sentences with the same stamp, which
+  // were received by the same read.
+  qStableSort( arrivals.begin(), arrivals.end(), arrivedBefore );
+
+  forwardBatch.truncate( 0 );
+  forwardBatch.append( MSG_GPS_BATCH );
+  forwardBatch.append( ' ' );
+
+  const char* data = arrivalData.constData();
+
+  for( int i = 0; i < arrivals.size(); i++ )
+    {
+      const Arrival& arrival = arrivals.at(i);
+      forwardBatch.append( data + arrival.offset, arrival.length );
+    }
+
+  qint64 now = GpsSource::monotonicTime();
+
+  for( int i = 0; i < arrivals.size(); i++ )
+    {
+      arrivals.at(i).stats->addLatency( now - arrivals.at(i).stamp );
+    }
+
+  arrivals.clear();
+  arrivalData.truncate( 0 );
+
+  int error = errno;
+  writeForwardMsg( forwardBatch.constData(), forwardBatch.size() );
+  errno = error;
+}
+
+bool GpsClient::arrivedBefore( const Arrival& a1, const Arrival& a2 )
+{
+  return a1.stamp < a2.stamp;
 }
 
 // Sends a NMEA sentence to the GPS. Check sum will be calculated by
@@ -314,7 +423,7 @@ bool GpsClient::openGps( const char *deviceIn, const uint ioSpeedIn )
 
   device          = deviceIn;
   ioSpeedDevice   = ioSpeedIn;
-  ioSpeedTerminal = getBaudrate(ioSpeedIn);
+  ioSpeedTerminal = GpsSource::getBaudrate(ioSpeedIn);
   badSentences    = 0;
   unknownsReported.clear();
 
@@ -324,10 +433,8 @@ bool GpsClient::openGps( const char *deviceIn, const uint ioSpeedIn )
       return false;
     }
 
-  // reset buffer pointer
-  datapointer = databuffer;
-  dbsize      = 0;
-  memset( databuffer, 0, sizeof(databuffer) );
+  // discard all buffered data
+  framer.reset();
 
   if( fd != -1 )
     {
@@ -344,6 +451,7 @@ bool GpsClient::openGps( const char *deviceIn, const uint ioSpeedIn )
   if( QString(deviceIn).contains(QRegExp( regExp )) )
     {
       fd = socket( AF_BLUETOOTH, SOCK_STREAM, BTPROTO_RFCOMM );
+      fdGeneration++;
 
       // NON blocking io is requested!
       fcntl( fd, F_SETFL, O_NONBLOCK );
@@ -392,6 +500,7 @@ bool GpsClient::openGps( const char *deviceIn, const uint ioSpeedIn )
     }
 
   fd = open( device.data(), O_RDWR | O_NOCTTY | O_NDELAY | O_NONBLOCK );
+  fdGeneration++;
 
   if( fd == -1 )
     {
@@ -421,64 +530,7 @@ bool GpsClient::openGps( const char *deviceIn, const uint ioSpeedIn )
     }
   else
     {
-      tcgetattr(fd, &oldtio); // get current options from port
-
-      // copy current values into new structure for changes
-      memcpy( &newtio, &oldtio, sizeof(newtio) );
-
-      // http://www.mkssoftware.com/docs/man5/struct_termios.5.asp
-      //
-      // Prepare serial port settings for raw mode. That is important
-      // otherwise Flarm binary communication do not work!
-      //
-      // - no canonical input (no line oriented input)
-      // - 8 data bits
-      // - no parity
-      // - no interpretation of special characters
-      // - no hardware control
-
-      // Port control modes
-      // CS8    8 bits per byte
-      // CLOCAL Ignore modem status lines
-      // CREAD  Enable receiver
-      newtio.c_cflag = CS8 | CLOCAL | CREAD;
-
-      // Port input modes
-      // raw input without any special handling
-      newtio.c_iflag = 0;
-
-      // Port output modes
-      // raw output without any special handling
-      newtio.c_oflag = 0;
-
-      // Port local modes
-      // raw input/output without any special handling
-      newtio.c_lflag = 0;
-
-      // The values of the MIN and TIME members of the c_cc array of the termios
-      // structure are used to determine how to process the bytes received.
-      //
-      // MIN represents the minimum number of bytes that should be received when
-      // the read() function returns successfully.
-      //
-      // TIME is a timer of 0.1 second granularity (or as close to that value as
-      // can be accommodated) that is used to time out bursty and short-term data
-      // transmissions.
-      newtio.c_cc[VMIN]  = 1;
-      newtio.c_cc[VTIME] = 0;
-
-      // AP: Note, the setting of the speed must be done at last
-      // because the manipulation of the c_iflag and c_oflag can
-      // destroy the already assigned values! Needed me several hours
-      // to find out that. Setting the baud rate under c_cflag seems
-      // also to work.
-      cfsetispeed( &newtio, ioSpeedTerminal ); // set baud rate for input
-      cfsetospeed( &newtio, ioSpeedTerminal ); // set baud rate for output
-
-      tcflush(fd, TCIOFLUSH);
-      tcsetattr(fd, TCSANOW, &newtio);
-
-      fcntl(fd, F_SETFL, FNDELAY); // NON blocking io is requested
+      GpsSource::setRawMode( fd, ioSpeedTerminal, oldtio );
     }
 
   last.start(); // store time point for supervision control
@@ -486,71 +538,67 @@ bool GpsClient::openGps( const char *deviceIn, const uint ioSpeedIn )
 }
 
 /**
- * This method tries to read all lines contained in the receive buffer. A line
- * is always terminated by a newline and is taken over in the receiver queue,
- * if the checksum is valid and the GPS identifier is requested.
+ * This method takes all complete sentences out of the framer. A sentence is
+ * collected for forwarding with its receive time, if the checksum is valid
+ * and the GPS identifier is requested.
  */
-void GpsClient::readSentenceFromBuffer()
+void GpsClient::collectSentences( NmeaFramer& framer,
+                                  GpsSource::Stats& stats,
+                                  const qint64 stamp )
 {
-  char *start = databuffer;
-  char *end   = 0;
-
-  while(strlen(start))
+  while( framer.nextSentence() )
     {
-      // Search for a newline in the receiver buffer.
-      // That is the normal end of a GPS sentence.
-      if( ! (end = strchr( start, '\n' )) )
-        {
-          // No newline in the receiver buffer, wait for more characters
-          return;
-        }
+      const char* sentence = framer.sentence();
 
-      if( start == end )
+#ifdef DEBUG_NMEA
+      qDebug() << "GpsClient::read():" << sentence;
+#endif
+
+      switch( framer.status() )
         {
-          // skip newline and start at next position with a new search
-          start++;
-          continue;
-        }
+          case NmeaFramer::Valid:
 
-      // found a complete record in the buffer, it will be extracted now
-      char *record = (char *) malloc( end-start + 2 );
+            badSentences = 0;
 
-      memset( record, 0, end-start + 2 );
+            // Forward sentence to the server, if checksum is ok and
+            // processing is desired.
+            if( forwardGpsData == true &&
+                checkGpsMessageFilter( sentence, framer.keyLength() ) == true )
+              {
+                Arrival arrival;
+                arrival.stamp  = stamp;
+                arrival.offset = arrivalData.size();
+                arrival.length = framer.length();
+                arrival.stats  = &stats;
 
-      strncpy( record, start, end-start + 1);
+                arrivals.append( arrival );
+                arrivalData.append( sentence, framer.length() );
+              }
 
-      if( verifyCheckSum( record ) == true )
-        {
-          // Forward sentence to the server, if checksum is ok and
-          // processing is desired.
-          if( checkGpsMessageFilter( record ) == true && forwardGpsData == true )
-            {
-              QByteArray ba;
-              ba.append( MSG_GPS_DATA );
-              ba.append( ' ' );
-              ba.append( record );
-              writeForwardMsg( ba.data() );
-            }
-        }
-
-#ifdef DEBUG_NMEA
-      qDebug() << "GpsClient::read():" << record;
-#endif
+            break;
 
-      free(record);
-      record = 0;
+          case NmeaFramer::BadStart:
 
-      // remove queued record from receive buffer
-      memmove( databuffer, end+1,
-               databuffer + sizeof(databuffer)-1 - end );
+            // Filter out wrong data messages read in from the GPS port.
+            // Note: Flarm sends several debug text messages after a restart
+            // not starting with a dollar sign or an exclamation mark.
+            qWarning() << "GpsClient::CheckSumError:" << sentence;
+            badSentences++;
+            stats.bad++;
+            break;
 
-      datapointer -= (end+1 - databuffer);
+          case NmeaFramer::BadChecksum:
 
-      dbsize -= ( end+1 - databuffer);
+            badSentences = 0;
+            stats.bad++;
+            break;
 
-      start = databuffer;
+          case NmeaFramer::Overflow:
 
-      end = 0;
+            badSentences++;
+            stats.bad++;
+            break;
+        }
     }
 }
 
@@ -574,6 +622,7 @@ void GpsClient::closeGps()
 
       close(fd);
       fd = -1;
+      fdGeneration++;
     }
 
   connectionLost = true;
@@ -582,88 +631,159 @@ void GpsClient::closeGps()
 }
 
 /**
- * Check GPS message key, if it shall be processed or discarded.
- *
- * @returns true if processing desired otherwise false
+ * Opens an additional input source. A source, which cannot be opened, is
+ * kept and reopened later by the timeout controller.
  */
-bool GpsClient::checkGpsMessageFilter( const char *sentence )
+bool GpsClient::openSource( const char *deviceIn, const uint ioSpeedIn )
 {
-  QString msgKey( sentence );
-
-  int idx = msgKey.indexOf(",");
-
-  if( idx == -1 )
+  if( deviceIn == (const char *) 0 || strlen(deviceIn) == 0 )
     {
       return false;
     }
 
-  // Extract message key.
-  msgKey = msgKey.left(idx);
-
-  if( gpsMessageFilter.contains( msgKey ) || gpsMessageFilter.isEmpty() )
+  for( int i = 0; i < sources.size(); i++ )
     {
-      // message shall be processed.
-      return true;
+      if( sources.at(i)->getDevice() == deviceIn )
+        {
+          // Source is already known, open it again.
+          closeSource( sources.at(i) );
+          return openSource( sources.at(i) );
+        }
     }
 
-  if( unknownsReported.contains( msgKey ) == false )
+  GpsSource* source = new GpsSource( deviceIn, ioSpeedIn );
+  sources.append( source );
+
+  return openSource( source );
+}
+
+bool GpsClient::openSource( GpsSource* source )
+{
+  bool ok = source->open();
+
+  if( source->getFd() != -1 )
     {
-      // Message shall be discarded. We do report that only once.
-      unknownsReported.insert( msgKey );
-      qWarning() << "GPS sentence discarded!" << sentence;
+      fdGeneration++;
     }
 
-  return false;
+  return ok;
+}
+
+void GpsClient::closeSource( GpsSource* source )
+{
+  if( source->getFd() != -1 )
+    {
+      source->close();
+      fdGeneration++;
+    }
 }
 
 /**
- * Verify the checksum of the passed sentences.
- *
- * @returns true (success) or false (error occurred)
+ * Closes and removes all additional input sources.
  */
-bool GpsClient::verifyCheckSum( const char *sentence )
+void GpsClient::closeSources()
 {
-  // Filter out wrong data messages read in from the GPS port. Known messages
-  // do start with a dollar sign or an exclamation mark.
-  // Note: Flarm sends several debug text messages after a restart not starting
-  // with a dollar sign or an exclamation mark.
-  if( sentence[0] != '$' && sentence[0] != '!' )
-    {
-      qWarning() << "GpsClient::CheckSumError:" << sentence;
-      badSentences++;
-      return false;
+  // The collected sentences refer to the counters of the sources.
+  forwardSentences();
+
+  for( int i = 0; i < sources.size(); i++ )
+    {
+      closeSource( sources.at(i) );
     }
 
-  badSentences = 0;
+  qDeleteAll( sources );
+  sources.clear();
+}
 
-  for( int i = strlen(sentence) - 1; i >= 0; i-- )
+/**
+ * Supervises the additional input sources. A source without data is closed
+ * and reopened after a delay.
+ */
+void GpsClient::checkSources()
+{
+  for( int i = 0; i < sources.size(); i++ )
     {
-      if( sentence[i] == '*' )
+      GpsSource* source = sources.at(i);
+
+      int idle = source->idleTime();
+
+      if( source->getFd() == -1 )
         {
-          if( (strlen(sentence) - 1 - i) < 2 )
+          if( idle == -1 || idle > TO_RETRY )
             {
-              // too less characters
-              return false;
+              openSource( source );
             }
 
-          char checkBytes[3];
-          checkBytes[0] = sentence[i+1];
-          checkBytes[1] = sentence[i+2];
-          checkBytes[2] = '\0';
+          continue;
+        }
 
-          uchar checkSum = (uchar) QString( checkBytes ).toUShort( 0, 16 );
+      if( idle > TO_CONLOST )
+        {
+#ifdef ERROR_LOG
+          qWarning() << "GpsClient::checkSources():" << source->getDevice()
+                     << "seems to be dead, trying restart.";
+#endif
 
-          if( checkSum == calcCheckSum( sentence ) )
-            {
-              return true;
-            }
-          else
-            {
-              return false;
-            }
+          closeSource( source );
+          source->touch(); // set next retry time point
         }
     }
 
+  if( statsTime.elapsed() < TO_STATS )
+    {
+      return;
+    }
+
+  // Report the counters of all sources to the server.
+  int msecs = statsTime.restart();
+
+  QByteArray report( MSG_SOURCE_STATS );
+
+  report += ' ';
+  report += primaryStats.report( device, msecs );
+  primaryStats.reset();
+
+  for( int i = 0; i < sources.size(); i++ )
+    {
+      report += '\n';
+      report += sources.at(i)->getStats().report( sources.at(i)->getDevice(), msecs );
+      sources.at(i)->getStats().reset();
+    }
+
+  if( forwardGpsData == true )
+    {
+      writeForwardMsg( report.constData(), report.size() );
+    }
+}
+
+/**
+ * Check GPS message key, if it shall be processed or discarded.
+ *
+ * @returns true if processing desired otherwise false
+ */
+bool GpsClient::checkGpsMessageFilter( const char *sentence, const int keyLength )
+{
+  if( keyLength == -1 )
+    {
+      return false;
+    }
+
+  // The key is not copied for the lookup.
+  QByteArray msgKey = QByteArray::fromRawData( sentence, keyLength );
+
+  if( gpsMessageFilter.contains( msgKey ) || gpsMessageFilter.isEmpty() )
+    {
+      // message shall be processed.
+      return true;
+    }
+
+  if( unknownsReported.contains( msgKey ) == false )
+    {
+      // Message shall be discarded. We do report that only once.
+      unknownsReported.insert( QByteArray( sentence, keyLength ) );
+      qWarning() << "GPS sentence discarded!" << sentence;
+    }
+
   return false;
 }
 
@@ -695,6 +815,8 @@ uchar GpsClient::calcCheckSum( const char *sentence )
 // Timeout controller
 void GpsClient::toController()
 {
+  checkSources();
+
   // Null time is used to switch off the timeout control.
   if( last.isNull() )
     {
@@ -861,9 +983,34 @@ void GpsClient::readServerMsg()
             }
         }
     }
+  else if( MSG_OPEN_SOURCE == args[0] )
+    {
+      QStringList devArgs = args[1].split(QChar(' '));
+
+      if( devArgs.size() == 2 )
+        {
+          // An additional input source is requested. The message consists
+          // of the device name and the io speed separated by a space.
+          bool res = openSource( devArgs[0].toLatin1().data(), devArgs[1].toUInt() );
+
+          if( res )
+            {
+              writeServerMsg( MSG_POS );
+            }
+          else
+            {
+              writeServerMsg( MSG_NEG );
+            }
+        }
+      else
+        {
+          writeServerMsg( MSG_NEG );
+        }
+    }
   else if( MSG_CLOSE == args[0] )
     {
-      // Close GPS device is requested
+      // Close GPS device and all additional sources is requested
+      closeSources();
       closeGps();
       writeServerMsg( MSG_POS );
     }
@@ -903,7 +1050,7 @@ void GpsClient::readServerMsg()
 
       for( int i = 0; i < keys.size(); i++ )
         {
-          gpsMessageFilter.insert( keys.at(i) );
+          gpsMessageFilter.insert( keys.at(i).toLatin1() );
         }
 
       // qDebug() << "GPS-Keys:" << gpsMessageFilter;
@@ -976,14 +1123,19 @@ void GpsClient::writeServerMsg( const char *msg )
  * after that the actual message as 8 bit character string.
  */
 void GpsClient::writeForwardMsg( const char *msg )
+{
+  writeForwardMsg( msg, strlen( msg ) );
+}
+
+void GpsClient::writeForwardMsg( const char *msg, const int length )
 {
   static QString method = "GpsClient::writeForwardMsg():";
 
   // The message to be transfered starts with the message length.
-  uint msgLen = strlen( msg );
+  uint msgLen = length;
 
   QByteArray ba = QByteArray::fromRawData( (const char *) &msgLen, sizeof(msgLen) );
-  ba.append( msg );
+  ba.append( msg, length );
 
   // We use non blocking IO for the transfer. Therefore we have to consider some
   // special return codes.
@@ -1012,38 +1164,6 @@ void GpsClient::writeForwardMsg( const char *msg )
   return;
 }
 
-/**
- * Translates the baud rate to a terminal speed definition.
- */
-uint GpsClient::getBaudrate(int rate)
-{
-  switch (rate)
-    {
-    case 600:
-      return B600;
-    case 1200:
-      return B1200;
-    case 2400:
-      return B2400;
-    case 4800:
-      return B4800;
-    case 9600:
-      return B9600;
-    case 19200:
-      return B19200;
-    case 38400:
-      return B38400;
-    case 57600:
-      return B57600;
-    case 115200:
-      return B115200;
-    case 230400:
-      return B230400;
-    default:
-      return B4800;
-    }
-}
-
 #ifdef FLARM
 
 bool GpsClient::flarmBinMode()
@@ -34,6 +34,10 @@
  * c) a named pipe
  * d) Bluetooth via RFCOMM
  *
+ * Additional NMEA sources, e.g. a separate Flarm or variometer, can be read
+ * at the same time. Their sentences are stamped with the receive time and
+ * merged with the sentences of the GPS device into one ordered stream.
+ *
  * The communication between this client class and the Cumulus main
  * process is realized via two sockets. One socket for NMEA data message
  * transfer and a second socket for command exchange.
@@ -47,11 +51,15 @@
 
 #include <QDateTime>
 #include <QByteArray>
+#include <QList>
 #include <QQueue>
 #include <QSet>
 #include <QTime>
+#include <QVector>
 
 #include "ipc.h"
+#include "gpssource.h"
+#include "nmeaframer.h"
 
 //++++++++++++++++++++++ CLASS GpsClient +++++++++++++++++++++++++++
 
@@ -73,28 +81,45 @@ public:
   virtual ~GpsClient();
 
   /**
-   * Processes incoming read events. They can come from the server or
-   * from the GPS device.
+   * Processes an incoming read event. It can come from the server or
+   * from the GPS device. The file descriptor is read until no more data
+   * are available, as required by an edge triggered event loop.
    *
-   * \param fdMaskIn A mask of file descriptors ready for read.
+   * \param fdIn A file descriptor ready for read.
    */
-  void processEvent( fd_set *fdMaskIn );
+  void processEvent( const int fdIn );
 
   /**
-   * Returns all currently used read file descriptors as mask, usable by the
-   * select call.
+   * Returns all currently used read file descriptors.
    *
-   * \return A file descriptor set to be checked for read events.
+   * \param fds List, into which the file descriptors are stored.
    */
-  fd_set *getReadFdMask();
+  void getReadFds( QVector<int>& fds );
 
   /**
-   * Reads data from the connected GPS device.
+   * \return A counter, which is incremented, when a file descriptor is
+   * opened or closed. The event loop must then update its file descriptors.
+   */
+  uint getFdGeneration() const
+  {
+    return fdGeneration;
+  };
+
+  /**
+   * Reads all available data from the connected GPS device. The sentences
+   * are collected and sent by \ref forwardSentences.
    *
    * @return true=success / false=unsuccess
    */
   bool readGpsData();
 
+  /**
+   * Forwards the collected sentences of all sources ordered by their
+   * receive time as one batch to the server. Should be called after all
+   * pending read events have been processed.
+   */
+  void forwardSentences();
+
   int writeGpsData( const char *dataIn );
 
   /**
@@ -111,6 +136,21 @@ public:
    */
   void closeGps();
 
+  /**
+   * Opens an additional input source. Its sentences are merged with the
+   * sentences of the GPS device.
+   *
+   * \param deviceIn Name of the device, named pipe or tcp:address:port.
+   * \param ioSpeedIn Speed of the device.
+   * \return True on success otherwise false.
+   */
+  bool openSource( const char *deviceIn, const uint ioSpeedIn );
+
+  /**
+   * Closes and removes all additional input sources.
+   */
+  void closeSources();
+
   /**
    * GPS device data timeout controller.
    */
@@ -124,19 +164,14 @@ public:
    */
   uchar calcCheckSum( const char *sentence );
 
-  /**
-   * Verify the checksum of the passed sentences.
-   *
-   * @returns true (success) or false (error occurred)
-   */
-  bool verifyCheckSum( const char *sentence );
-
   /**
    * Check GPS message key, if it shall be processed or filtered out.
    *
+   * \param sentence NMEA sentence to be checked.
+   * \param keyLength Length of the sentence key.
    * @returns true if processing desired otherwise false
    */
-  bool checkGpsMessageFilter( const char *sentence );
+  bool checkGpsMessageFilter( const char *sentence, const int keyLength );
 
   /**
    * \param newState The new value for the shutdown state.
@@ -172,9 +207,35 @@ public:
 
   void writeForwardMsg( const char *msg );
 
-  uint getBaudrate( int rate );
+  void writeForwardMsg( const char *msg, const int length );
+
+  /** A received sentence waiting for forwarding. */
+  struct Arrival
+  {
+    // Monotonic receive time in microseconds
+    qint64 stamp;
+
+    // Position of the sentence in the arrival data
+    int offset;
+    int length;
+
+    // Counters of the source, which has delivered the sentence
+    GpsSource::Stats* stats;
+  };
+
+  void collectSentences( NmeaFramer& framer,
+                         GpsSource::Stats& stats,
+                         const qint64 stamp );
+
+  void readSourceData( GpsSource* source );
+
+  bool openSource( GpsSource* source );
+
+  void closeSource( GpsSource* source );
 
-  void readSentenceFromBuffer();
+  void checkSources();
+
+  static bool arrivedBefore( const Arrival& a1, const Arrival& a2 );
 
 #ifdef FLARM
 
@@ -224,24 +285,36 @@ public:
   // RX/TX rate of serial device
   uint ioSpeedTerminal, ioSpeedDevice;
 
-  // data buffers and pointers
-  char* datapointer;
+  // Ring buffer and sentence framer of the GPS data
+  NmeaFramer framer;
+
+  // Counters of the GPS device
+  GpsSource::Stats primaryStats;
+
+  // Additional input sources
+  QList<GpsSource *> sources;
+
+  // Collected sentences of all sources and their receive times
+  QVector<Arrival> arrivals;
+  QByteArray arrivalData;
 
-  char  databuffer[1024];
+  // Buffer of the batch message, which is forwarded to the server
+  QByteArray forwardBatch;
 
-  int   dbsize;
+  // Start of the current statistics period
+  QTime statsTime;
 
   // file descriptor to GPS device
   int fd;
 
   // terminal info data
-  struct termios oldtio, newtio;
+  struct termios oldtio;
 
   // Socket port for IPC to server process
   ushort ipcPort;
 
-  // read file descriptor set in use by GPS and IPC
-  fd_set fdMask;
+  // Incremented, when a GPS or source file descriptor is opened or closed
+  uint fdGeneration;
 
   // IPC instance to server process as data channel
   Ipc::Client clientData;
@@ -269,13 +342,13 @@ public:
    * Filter set with well known GPS message keys. Only GPS messages starting
    * with such a key are processed and forwarded.
    */
-  QSet<QString> gpsMessageFilter;
+  QSet<QByteArray> gpsMessageFilter;
 
   /**
    * Set containing reported unknown GPS message keys to avoid an endless error
    * reporting.
    */
-  QSet<QString> unknownsReported;
+  QSet<QByteArray> unknownsReported;
 
   /** activate flag for timeout after Flarm reset. */
   bool activateTimeout;
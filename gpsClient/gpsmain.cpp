@@ -24,6 +24,7 @@ using namespace std;
 #include <cstring>
 #include <libgen.h>
 #include <netinet/in.h>
+#include <sys/epoll.h>
 #include <sys/socket.h>
 #include <sys/time.h>
 #include <iostream>
@@ -40,6 +41,42 @@ using namespace std;
 
 extern bool shutdownState;
 
+// Maximum number of events fetched by one epoll_wait call
+#define MAX_EVENTS 16
+
+/**
+ * Registers the current read file descriptors of the client at the epoll
+ * instance. Closed file descriptors are removed by the kernel automatically.
+ * A reopened descriptor can have the same number as a closed one, therefore
+ * all descriptors are registered again.
+ */
+static void updateEpollFds( int epfd, GpsClient *client, QVector<int>& fds )
+{
+  for( int i = 0; i < fds.size(); i++ )
+    {
+      // can fail, if the descriptor was already closed
+      epoll_ctl( epfd, EPOLL_CTL_DEL, fds[i], 0 );
+    }
+
+  client->getReadFds( fds );
+
+  for( int i = 0; i < fds.size(); i++ )
+    {
+      struct epoll_event ev;
+      memset( &ev, 0, sizeof(ev) );
+
+      // Edge triggered, the client reads a descriptor until it is empty.
+      ev.events  = EPOLLIN | EPOLLET;
+      ev.data.fd = fds[i];
+
+      if( epoll_ctl( epfd, EPOLL_CTL_ADD, fds[i], &ev ) == -1 )
+        {
+          cerr << "epoll_ctl add of fd " << fds[i] << " failed, errno="
+               << errno << ", " << strerror(errno) << endl;
+        }
+    }
+}
+
 // ===========================================================================
 // Usage of programm
 // ===========================================================================
@@ -143,7 +180,23 @@ int main( int argc, char* argv[] )
   // GPS client module, manages the connection to the GPS and to cumulus
   GpsClient *client = new GpsClient( ipcPort );
 
-  struct timeval timerInterval;
+  int epfd = epoll_create( MAX_EVENTS );
+
+  if( epfd == -1 )
+    {
+      cerr << "Fatal Error of epoll_create call, errno=" << errno
+           << ", " << strerror(errno)
+           << "\n +++ TERMINATE PROCESS +++" << endl;
+
+      delete client;
+      return 1;
+    }
+
+  struct epoll_event events[MAX_EVENTS];
+
+  // Registered file descriptors and the client state of them
+  QVector<int> fds;
+  uint fdGeneration = client->getFdGeneration() + 1;
 
   // ==========================================================================
   // main loop of Gps Client process
@@ -171,51 +224,58 @@ int main( int argc, char* argv[] )
           break;
         }
 
-      int maxFds = getdtablesize();  // getdtablehi() better but not provided
-
-      // get all session file descriptors
-      fd_set *readFds = client->getReadFdMask();
-
-      // main loop timeout set to one second
-      timerInterval.tv_sec  =  1;
-      timerInterval.tv_usec =  0;
-
-      // Wait for read events or timeout
+      // The GPS device was opened or closed, update the registered
+      // file descriptors.
+      if( fdGeneration != client->getFdGeneration() )
+        {
+          fdGeneration = client->getFdGeneration();
+          updateEpollFds( epfd, client, fds );
+        }
 
-      int result = select( maxFds, readFds, (fd_set *) 0,
-                          (fd_set *) 0, &timerInterval );
+      // Wait for read events or timeout, main loop timeout set to one second
+      int result = epoll_wait( epfd, events, MAX_EVENTS, 1000 );
 
-      if( result == -1 ) // Select returned with error
+      if( result == -1 ) // epoll_wait returned with error
         {
           if( errno == EINTR )
             {
-              continue; // interrupted select call, ignore it
+              continue; // interrupted call, ignore it
             }
           else
             {
               // other error occurred, report it
-              cerr << "Fatal Error of select call, errno=" << errno
+              cerr << "Fatal Error of epoll_wait call, errno=" << errno
                    << ", " << strerror(errno)
                    << "\n +++ TERMINATE PROCESS +++" << endl;
               break;
             }
         }
 
-      else if( result > 0 ) // read event occurred
+      for( int i = 0; i < result; i++ ) // read events occurred
         {
+          // A descriptor can be closed by the processing of a former event.
+          if( client->getShutdownFlag() ||
+              fdGeneration != client->getFdGeneration() )
+            {
+              break;
+            }
+
           // call gps client for event processing
-          client->processEvent( readFds );
-        }
-      else if( result == 0 ) // timeout, do low prioritized things
-        {
+          client->processEvent( events[i].data.fd );
         }
 
+      // forward the sentences of all read sources in the order of
+      // their arrival
+      client->forwardSentences();
+
       // call timeout control at last after all events have been
       // processed
       client->toController();
 
     } // End of while
 
+  close( epfd );
+
   if( !strcmp(client->getDevice(), NMEASIM_DEVICE) )
     {
       // delete fifo: we leave the system as we found;
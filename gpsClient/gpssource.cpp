@@ -0,0 +1,332 @@
+/***********************************************************************
+**
+**   gpssource.cpp
+**
+**   This file is part of Cumulus
+**
+************************************************************************
+**
+**   Copyright (c):  2026 by the Cumulus contributors
+**
+**   This program is free software; you can redistribute it and/or modify
+**   it under the terms of the GNU General Public License as published by
+**   the Free Software Foundation; either version 2 of the License, or
+**   (at your option) any later version.
+**
+***********************************************************************/
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+#include <QtCore>
+
+#include "gpssource.h"
+
+void GpsSource::Stats::reset()
+{
+  bytes      = 0;
+  sentences  = 0;
+  bad        = 0;
+  latencySum = 0;
+  latencyMax = 0;
+}
+
+void GpsSource::Stats::addLatency( const qint64 latency )
+{
+  sentences++;
+  latencySum += latency;
+
+  if( latency > latencyMax )
+    {
+      latencyMax = latency;
+    }
+}
+
+QByteArray GpsSource::Stats::report( const QByteArray& device, const int msecs ) const
+{
+  double seconds = qMax( msecs, 1 ) / 1000.0;
+  qint64 mean    = sentences ? latencySum / sentences : 0;
+
+  char buf[256];
+
+  snprintf( buf, sizeof(buf),
+            "%s %.1f sentences/s %.0f bytes/s %u bad latency %lld/%lld us",
+            device.constData(),
+            sentences / seconds,
+            bytes / seconds,
+            bad,
+            (long long) mean,
+            (long long) latencyMax );
+
+  return QByteArray( buf );
+}
+
+GpsSource::GpsSource( const QByteArray& deviceIn, const uint ioSpeedIn ) :
+  device(deviceIn),
+  ioSpeed(ioSpeedIn),
+  fd(-1)
+{
+  memset( &oldtio, 0, sizeof(oldtio) );
+}
+
+GpsSource::~GpsSource()
+{
+  close();
+}
+
+bool GpsSource::open()
+{
+  close();
+
+  framer.reset();
+
+  // store time point for restart control
+  last.start();
+
+  if( device.isEmpty() )
+    {
+      return false;
+    }
+
+  if( isTcp() )
+    {
+      return openTcp();
+    }
+
+  // create a fifo, if device starts not with /dev/
+  if( ! device.startsWith( "/dev/" ) )
+    {
+      int ret = mkfifo( device.data(), S_IRUSR | S_IWUSR );
+
+      if( ret && errno != EEXIST )
+        {
+          perror("mkfifo");
+        }
+    }
+
+  fd = ::open( device.data(), O_RDWR | O_NOCTTY | O_NDELAY | O_NONBLOCK );
+
+  if( fd == -1 )
+    {
+#ifdef ERROR_LOG
+      qWarning() << "GpsSource::open(): Unable to open" << device
+                 << errno << "," << strerror(errno);
+#endif
+      return false;
+    }
+
+  if( isatty(fd) )
+    {
+      setRawMode( fd, getBaudrate( ioSpeed ), oldtio );
+    }
+
+  return true;
+}
+
+/**
+ * Opens a TCP connection to a source given as tcp:address:port. The connect
+ * call does not block, a refused connection is reported by the first read.
+ * Host names are not resolved, because a name lookup can block the event
+ * loop of the client for the resolver timeout on every retry.
+ */
+bool GpsSource::openTcp()
+{
+  QByteArray address = device.mid( strlen("tcp:") );
+
+  int colon = address.lastIndexOf( ':' );
+
+  if( colon <= 0 )
+    {
+      qWarning() << "GpsSource::openTcp(): Wrong address" << device;
+      return false;
+    }
+
+  QByteArray host = address.left( colon );
+  QByteArray port = address.mid( colon + 1 );
+
+  if( host == "localhost" )
+    {
+      // The only name, which is known without a lookup.
+      host = "127.0.0.1";
+    }
+
+  struct addrinfo hints;
+  struct addrinfo *result = 0;
+
+  memset( &hints, 0, sizeof(hints) );
+  hints.ai_family   = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  hints.ai_flags    = AI_NUMERICHOST | AI_NUMERICSERV;
+
+  int error = getaddrinfo( host.data(), port.data(), &hints, &result );
+
+  if( error != 0 )
+    {
+      qWarning() << "GpsSource::openTcp():" << device
+                 << gai_strerror( error )
+                 << "(a numeric address and port are expected)";
+      return false;
+    }
+
+  fd = socket( result->ai_family, result->ai_socktype, result->ai_protocol );
+
+  if( fd == -1 )
+    {
+      qWarning() << "GpsSource::openTcp(): socket error"
+                 << errno << "," << strerror(errno);
+
+      freeaddrinfo( result );
+      return false;
+    }
+
+  // NON blocking io is requested!
+  fcntl( fd, F_SETFL, O_NONBLOCK );
+
+  if( connect( fd, result->ai_addr, result->ai_addrlen ) == -1 &&
+      errno != EINPROGRESS )
+    {
+#ifdef ERROR_LOG
+      qWarning() << "GpsSource::openTcp(): connect error" << device
+                 << errno << "," << strerror(errno);
+#endif
+
+      ::close( fd );
+      fd = -1;
+    }
+
+  freeaddrinfo( result );
+
+  return fd != -1;
+}
+
+void GpsSource::close()
+{
+  if( fd == -1 )
+    {
+      return;
+    }
+
+  if( isatty(fd) )
+    {
+      tcflush( fd, TCIOFLUSH );
+    }
+
+  ::close( fd );
+  fd = -1;
+}
+
+qint64 GpsSource::monotonicTime()
+{
+  struct timespec ts;
+
+  clock_gettime( CLOCK_MONOTONIC, &ts );
+
+  return qint64(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+}
+
+/**
+ * Translates the baud rate to a terminal speed definition.
+ */
+uint GpsSource::getBaudrate(int rate)
+{
+  switch (rate)
+    {
+    case 600:
+      return B600;
+    case 1200:
+      return B1200;
+    case 2400:
+      return B2400;
+    case 4800:
+      return B4800;
+    case 9600:
+      return B9600;
+    case 19200:
+      return B19200;
+    case 38400:
+      return B38400;
+    case 57600:
+      return B57600;
+    case 115200:
+      return B115200;
+    case 230400:
+      return B230400;
+    default:
+      return B4800;
+    }
+}
+
+void GpsSource::setRawMode( const int fd,
+                            const uint ioSpeedTerminal,
+                            struct termios& oldtio )
+{
+  struct termios newtio;
+
+  tcgetattr(fd, &oldtio); // get current options from port
+
+  // copy current values into new structure for changes
+  memcpy( &newtio, &oldtio, sizeof(newtio) );
+
+  // http://www.mkssoftware.com/docs/man5/struct_termios.5.asp
+  //
+  // Prepare serial port settings for raw mode. That is important
+  // otherwise Flarm binary communication do not work!
+  //
+  // - no canonical input (no line oriented input)
+  // - 8 data bits
+  // - no parity
+  // - no interpretation of special characters
+  // - no hardware control
+
+  // Port control modes
+  // CS8    8 bits per byte
+  // CLOCAL Ignore modem status lines
+  // CREAD  Enable receiver
+  newtio.c_cflag = CS8 | CLOCAL | CREAD;
+
+  // Port input modes
+  // raw input without any special handling
+  newtio.c_iflag = 0;
+
+  // Port output modes
+  // raw output without any special handling
+  newtio.c_oflag = 0;
+
+  // Port local modes
+  // raw input/output without any special handling
+  newtio.c_lflag = 0;
+
+  // The values of the MIN and TIME members of the c_cc array of the termios
+  // structure are used to determine how to process the bytes received.
+  //
+  // MIN represents the minimum number of bytes that should be received when
+  // the read() function returns successfully.
+  //
+  // TIME is a timer of 0.1 second granularity (or as close to that value as
+  // can be accommodated) that is used to time out bursty and short-term data
+  // transmissions.
+  newtio.c_cc[VMIN]  = 1;
+  newtio.c_cc[VTIME] = 0;
+
+  // AP: Note, the setting of the speed must be done at last
+  // because the manipulation of the c_iflag and c_oflag can
+  // destroy the already assigned values! Needed me several hours
+  // to find out that. Setting the baud rate under c_cflag seems
+  // also to work.
+  cfsetispeed( &newtio, ioSpeedTerminal ); // set baud rate for input
+  cfsetospeed( &newtio, ioSpeedTerminal ); // set baud rate for output
+
+  tcflush(fd, TCIOFLUSH);
+  tcsetattr(fd, TCSANOW, &newtio);
+
+  fcntl(fd, F_SETFL, FNDELAY); // NON blocking io is requested
+}
@@ -0,0 +1,211 @@
+/***********************************************************************
+**
+**   gpssource.h
+**
+**   This file is part of Cumulus
+**
+************************************************************************
+**
+**   Copyright (c):  2026 by the Cumulus contributors
+**
+**   This program is free software; you can redistribute it and/or modify
+**   it under the terms of the GNU General Public License as published by
+**   the Free Software Foundation; either version 2 of the License, or
+**   (at your option) any later version.
+**
+***********************************************************************/
+
+/**
+ * \class GpsSource
+ *
+ * \author Cumulus contributors
+ *
+ * \date 2026
+ *
+ * \brief Additional NMEA input source of the GPS client.
+ *
+ * Beside the main GPS device the client can read further devices, e.g. a
+ * separate Flarm or variometer. A source can be
+ *
+ * a) a serial device like /dev/ttyUSB0
+ * b) a named pipe
+ * c) a TCP connection in the form tcp:address:port, where the address
+ *    must be a numeric IPv4 or IPv6 address or localhost
+ *
+ * Every source has its own ring buffer and sentence framer. The received
+ * sentences are stamped with a monotonic time and merged by the client
+ * into one ordered stream. The source counts the received data and the
+ * latency between receive and forward of its sentences.
+ */
+
+#ifndef _GpsSource_hh_
+#define _GpsSource_hh_ 1
+
+#include <termios.h>
+
+#include <QByteArray>
+#include <QTime>
+
+#include "nmeaframer.h"
+
+class GpsSource
+{
+public:
+
+  /** Receive and forward counters of a source. */
+  class Stats
+  {
+  public:
+
+    Stats()
+    {
+      reset();
+    };
+
+    void reset();
+
+    /**
+     * Adds the latency of a forwarded sentence.
+     *
+     * \param latency Time between receive and forward in microseconds.
+     */
+    void addLatency( const qint64 latency );
+
+    /**
+     * Formats the counters as one report line.
+     *
+     * \param device Name of the source.
+     * \param msecs Length of the measurement period in milli seconds.
+     * \return The report line without a line end.
+     */
+    QByteArray report( const QByteArray& device, const int msecs ) const;
+
+    // Number of received bytes
+    uint bytes;
+
+    // Number of forwarded sentences
+    uint sentences;
+
+    // Number of sentences with a bad start, checksum or length
+    uint bad;
+
+    // Sum and maximum of the forward latencies in microseconds
+    qint64 latencySum;
+    qint64 latencyMax;
+  };
+
+  /**
+   * \param device Name of the device, named pipe or tcp:address:port.
+   * \param ioSpeed Speed of a serial device.
+   */
+  GpsSource( const QByteArray& device, const uint ioSpeed );
+
+  virtual ~GpsSource();
+
+  /**
+   * Opens the source. A TCP connection is established in the background.
+   *
+   * \return True on success otherwise false.
+   */
+  bool open();
+
+  /**
+   * Closes the source.
+   */
+  void close();
+
+  /** \return The file descriptor of the source or -1, if it is closed. */
+  int getFd() const
+  {
+    return fd;
+  };
+
+  /** \return The name of the source. */
+  const QByteArray& getDevice() const
+  {
+    return device;
+  };
+
+  /** \return The sentence framer of the source. */
+  NmeaFramer& getFramer()
+  {
+    return framer;
+  };
+
+  /** \return The counters of the source. */
+  Stats& getStats()
+  {
+    return stats;
+  };
+
+  /** \return True, if the source is a TCP connection. */
+  bool isTcp() const
+  {
+    return device.startsWith( "tcp:" );
+  };
+
+  /** Restarts the supervision timer after received data. */
+  void touch()
+  {
+    last.start();
+  };
+
+  /**
+   * \return The milli seconds since the last data or the last open try.
+   *         -1 is returned, if the source was never opened.
+   */
+  int idleTime() const
+  {
+    return last.isNull() ? -1 : last.elapsed();
+  };
+
+  /**
+   * \return The current monotonic time in microseconds. It is not affected
+   *         by changes of the system clock.
+   */
+  static qint64 monotonicTime();
+
+  /**
+   * Translates the baud rate to a terminal speed definition.
+   */
+  static uint getBaudrate( int rate );
+
+  /**
+   * Puts a serial device into the raw mode with 8 data bits, no parity
+   * and the passed speed.
+   *
+   * \param fd File descriptor of the serial device.
+   * \param ioSpeedTerminal Terminal speed definition.
+   * \param oldtio Here the former settings of the device are stored.
+   */
+  static void setRawMode( const int fd,
+                          const uint ioSpeedTerminal,
+                          struct termios& oldtio );
+
+private:
+
+  bool openTcp();
+
+  // Name of the device, named pipe or TCP end point
+  QByteArray device;
+
+  // Speed of a serial device
+  uint ioSpeed;
+
+  // File descriptor of the source
+  int fd;
+
+  // Ring buffer and sentence framer of the source
+  NmeaFramer framer;
+
+  // Time point of the last data or of the last open try
+  QTime last;
+
+  // Receive and forward counters
+  Stats stats;
+
+  // Former settings of a serial device
+  struct termios oldtio;
+};
+
+#endif
@@ -0,0 +1,207 @@
+/***********************************************************************
+**
+**   nmeaframer.cpp
+**
+**   This file is part of Cumulus
+**
+************************************************************************
+**
+**   Copyright (c):  2026 by the Cumulus contributors
+**
+**   This program is free software; you can redistribute it and/or modify
+**   it under the terms of the GNU General Public License as published by
+**   the Free Software Foundation; either version 2 of the License, or
+**   (at your option) any later version.
+**
+***********************************************************************/
+
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "nmeaframer.h"
+
+NmeaFramer::NmeaFramer()
+{
+  reset();
+}
+
+NmeaFramer::~NmeaFramer()
+{
+}
+
+void NmeaFramer::reset()
+{
+  m_head = 0;
+  m_tail = 0;
+  m_status = BadChecksum;
+
+  startSentence();
+  m_line[0] = '\0';
+}
+
+void NmeaFramer::startSentence()
+{
+  m_length   = 0;
+  m_sum      = 0;
+  m_star     = -1;
+  m_comma    = -1;
+  m_overflow = false;
+  m_complete = false;
+}
+
+int NmeaFramer::readFrom( const int fd )
+{
+  unsigned int free = RingSize - (m_head - m_tail);
+
+  if( free == 0 )
+    {
+      // The ring is full, because nobody takes the sentences out. That is
+      // our emergency break, all buffered data are discarded.
+      m_tail = m_head;
+      free = RingSize;
+    }
+
+  // The free space can wrap around the end of the ring.
+  unsigned int pos = m_head & (RingSize - 1);
+  unsigned int first = RingSize - pos;
+
+  struct iovec iov[2];
+  int count = 1;
+
+  iov[0].iov_base = m_ring + pos;
+  iov[0].iov_len  = first < free ? first : free;
+
+  if( free > first )
+    {
+      iov[1].iov_base = m_ring;
+      iov[1].iov_len  = free - first;
+      count = 2;
+    }
+
+  int bytes = readv( fd, iov, count );
+
+  if( bytes > 0 )
+    {
+      m_head += bytes;
+    }
+
+  return bytes;
+}
+
+bool NmeaFramer::nextSentence()
+{
+  while( m_tail != m_head )
+    {
+      if( m_complete )
+        {
+          startSentence();
+        }
+
+      const char c = m_ring[m_tail++ & (RingSize - 1)];
+
+      if( m_length < MaxLength )
+        {
+          m_line[m_length++] = c;
+        }
+      else
+        {
+          m_overflow = true;
+        }
+
+      if( c == '\n' )
+        {
+          m_complete = true;
+
+          if( m_length == 1 )
+            {
+              // Skip an empty line.
+              continue;
+            }
+
+          finishSentence();
+          return true;
+        }
+
+      if( m_length == 1 || m_overflow )
+        {
+          // The start sign is not part of the checksum.
+          continue;
+        }
+
+      if( m_star == -1 )
+        {
+          if( c == '*' )
+            {
+              m_star = m_length - 1;
+            }
+          else if( c != '$' && c != '!' )
+            {
+              m_sum ^= (unsigned char) c;
+            }
+        }
+
+      if( c == ',' && m_comma == -1 )
+        {
+          m_comma = m_length - 1;
+        }
+    }
+
+  return false;
+}
+
+/** Converts a hexadecimal digit into its value. Returns -1 in error case. */
+static inline int hexValue( const char c )
+{
+  if( c >= '0' && c <= '9' )
+    {
+      return c - '0';
+    }
+
+  if( c >= 'A' && c <= 'F' )
+    {
+      return c - 'A' + 10;
+    }
+
+  if( c >= 'a' && c <= 'f' )
+    {
+      return c - 'a' + 10;
+    }
+
+  return -1;
+}
+
+void NmeaFramer::finishSentence()
+{
+  m_line[m_length] = '\0';
+
+  if( m_overflow )
+    {
+      m_status = Overflow;
+      return;
+    }
+
+  // Known messages do start with a dollar sign or an exclamation mark.
+  if( m_line[0] != '$' && m_line[0] != '!' )
+    {
+      m_status = BadStart;
+      return;
+    }
+
+  // Two hex digits must follow the star before the line end.
+  if( m_star == -1 || m_star + 2 >= m_length - 1 )
+    {
+      m_status = BadChecksum;
+      return;
+    }
+
+  int high = hexValue( m_line[m_star + 1] );
+  int low  = hexValue( m_line[m_star + 2] );
+
+  if( high == -1 || low == -1 || ((high << 4) | low) != m_sum )
+    {
+      m_status = BadChecksum;
+      return;
+    }
+
+  m_status = Valid;
+}
@@ -0,0 +1,144 @@
+/***********************************************************************
+**
+**   nmeaframer.h
+**
+**   This file is part of Cumulus
+**
+************************************************************************
+**
+**   Copyright (c):  2026 by the Cumulus contributors
+**
+**   This program is free software; you can redistribute it and/or modify
+**   it under the terms of the GNU General Public License as published by
+**   the Free Software Foundation; either version 2 of the License, or
+**   (at your option) any later version.
+**
+***********************************************************************/
+
+/**
+ * \class NmeaFramer
+ *
+ * \author Cumulus contributors
+ *
+ * \date 2026
+ *
+ * \brief Splits the byte stream of a GPS device into NMEA sentences.
+ *
+ * The data of the device is read into a ring buffer. The framer takes the
+ * bytes out of the ring and assembles them to sentences. The checksum and
+ * the position of the sentence key are determined during the assembling,
+ * so every byte is touched only once. No memory is allocated.
+ */
+
+#ifndef _NmeaFramer_hh_
+#define _NmeaFramer_hh_ 1
+
+class NmeaFramer
+{
+public:
+
+  /** Result of the sentence check. */
+  enum Status
+  {
+    Valid,       // sentence with a correct checksum
+    BadStart,    // sentence does not start with $ or !
+    BadChecksum, // checksum is missing or wrong
+    Overflow     // sentence is too long
+  };
+
+  NmeaFramer();
+
+  virtual ~NmeaFramer();
+
+  /**
+   * Discards all buffered data.
+   */
+  void reset();
+
+  /**
+   * Reads the available bytes of the file descriptor into the ring buffer.
+   *
+   * \param fd File descriptor to read from.
+   * \return The number of read bytes, 0 at end of file or -1 in error case.
+   *         In the error case errno is set by the read call.
+   */
+  int readFrom( const int fd );
+
+  /**
+   * Takes the next complete sentence out of the ring buffer.
+   *
+   * \return True, if a sentence is available otherwise false.
+   */
+  bool nextSentence();
+
+  /**
+   * \return The current sentence including its line end. It is terminated
+   *         by a null.
+   */
+  const char* sentence() const
+  {
+    return m_line;
+  };
+
+  /**
+   * \return The length of the current sentence.
+   */
+  int length() const
+  {
+    return m_length;
+  };
+
+  /**
+   * \return The check result of the current sentence.
+   */
+  Status status() const
+  {
+    return m_status;
+  };
+
+  /**
+   * \return The length of the sentence key, e.g. $GPRMC, that is the
+   *         position of the first comma. If the sentence contains no comma
+   *         -1 is returned.
+   */
+  int keyLength() const
+  {
+    return m_comma;
+  };
+
+private:
+
+  /** Resets the state of the current sentence. */
+  void startSentence();
+
+  /** Checks the completed sentence. */
+  void finishSentence();
+
+  /** Ring size, must be a power of two. */
+  enum { RingSize = 4096, MaxLength = 512 };
+
+  char m_ring[RingSize];
+
+  /** Write and read counters of the ring, they are masked on access. */
+  unsigned int m_head;
+  unsigned int m_tail;
+
+  char m_line[MaxLength + 1];
+
+  int m_length;
+
+  /** Running checksum of the current sentence. */
+  unsigned char m_sum;
+
+  /** Positions of the checksum star and of the first comma or -1. */
+  int m_star;
+  int m_comma;
+
+  bool m_overflow;
+
+  bool m_complete;
+
+  Status m_status;
+};
+
+#endif